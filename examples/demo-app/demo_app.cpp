@@ -8,8 +8,10 @@
 #include "polyscope/file_helpers.h"
 #include "polyscope/floating_quantity_structure.h"
 #include "polyscope/implicit_surface.h"
+#include "polyscope/mesh_io.h"
 #include "polyscope/pick.h"
 #include "polyscope/point_cloud.h"
+#include "polyscope/scene_file.h"
 #include "polyscope/surface_mesh.h"
 #include "polyscope/types.h"
 #include "polyscope/view.h"
@@ -23,9 +25,6 @@
 #include "happly.h"
 #include "json/json.hpp"
 
-#include "simple_dot_mesh_parser.h"
-#include "surface_mesh_io.h"
-
 #define GLM_ENABLE_EXPERIMENTAL
 #include "glm/gtx/string_cast.hpp"
 
@@ -91,15 +90,13 @@ void processFileOBJ(std::string filename) {
   // Get a nice name for the file
   std::string niceName = polyscope::guessNiceNameFromPath(filename);
 
-  // Load mesh and polygon soup data
-  std::vector<std::array<double, 3>> vertexPositions;
-  std::vector<std::vector<size_t>> faceIndices;
-  polyscope::loadPolygonSoup_OBJ(filename, vertexPositions, faceIndices);
-  std::vector<glm::vec3> vertexPositionsGLM;
-  for (std::array<double, 3> p : vertexPositions) {
-    vertexPositionsGLM.push_back(glm::vec3{p[0], p[1], p[2]});
-  }
-  auto psMesh = polyscope::registerSurfaceMesh(niceName, vertexPositionsGLM, faceIndices);
+  // Load the mesh
+  polyscope::SurfaceMesh* psMesh = polyscope::loadSurfaceMesh(niceName, filename);
+  const std::vector<glm::vec3>& vertexPositionsGLM = psMesh->vertexPositions.data;
+
+  // Faces, as pointers in to the mesh's flat face index list
+  auto faceDegree = [&](size_t iF) { return psMesh->faceIndsStart[iF + 1] - psMesh->faceIndsStart[iF]; };
+  auto faceInds = [&](size_t iF) { return &psMesh->faceIndsEntries[psMesh->faceIndsStart[iF]]; };
 
   // Useful data
   size_t nVertices = psMesh->nVertices();
@@ -135,11 +132,12 @@ void processFileOBJ(std::string filename) {
   std::vector<double> zero(nFaces);
   std::vector<std::array<double, 3>> fColor(nFaces);
   for (size_t iF = 0; iF < nFaces; iF++) {
-    std::vector<size_t>& face = faceIndices[iF];
+    const uint32_t* face = faceInds(iF);
+    size_t D = faceDegree(iF);
 
     // Compute something like area
     double area = 0;
-    for (size_t iV = 1; iV < face.size() - 1; iV++) {
+    for (size_t iV = 1; iV < D - 1; iV++) {
       glm::vec3 p0 = vertexPositionsGLM[face[0]];
       glm::vec3 p1 = vertexPositionsGLM[face[iV]];
       glm::vec3 p2 = vertexPositionsGLM[face[iV + 1]];
@@ -164,12 +162,13 @@ void processFileOBJ(std::string filename) {
   std::unordered_set<std::pair<size_t, size_t>, polyscope::hash_combine::hash<std::pair<size_t, size_t>>> seenEdges;
   std::vector<uint32_t> edgeOrdering;
   for (size_t iF = 0; iF < nFaces; iF++) {
-    std::vector<size_t>& face = faceIndices[iF];
+    const uint32_t* face = faceInds(iF);
+    size_t D = faceDegree(iF);
 
-    for (size_t iV = 0; iV < face.size(); iV++) {
+    for (size_t iV = 0; iV < D; iV++) {
       size_t i0 = face[iV];
-      size_t i1 = face[(iV + 1) % face.size()];
-      size_t im1 = face[(iV + face.size() - 1) % face.size()];
+      size_t i1 = face[(iV + 1) % D];
+      size_t im1 = face[(iV + D - 1) % D];
       glm::vec3 p0 = vertexPositionsGLM[i0];
       glm::vec3 p1 = vertexPositionsGLM[i1];
       glm::vec3 pm1 = vertexPositionsGLM[im1];
@@ -222,19 +221,20 @@ void processFileOBJ(std::string filename) {
   std::vector<glm::vec3> fCenters(nFaces);
   std::vector<glm::vec3> vNormals(nVertices, glm::vec3{0., 0., 0.});
   for (size_t iF = 0; iF < nFaces; iF++) {
-    std::vector<size_t>& face = faceIndices[iF];
+    const uint32_t* face = faceInds(iF);
+    size_t D = faceDegree(iF);
 
     // Compute a center (used below)
     glm::vec3 C = {0., 0., 0.};
-    for (size_t iV = 0; iV < face.size(); iV++) {
+    for (size_t iV = 0; iV < D; iV++) {
       C += vertexPositionsGLM[face[iV]];
     }
-    C /= face.size();
+    C /= D;
     fCenters[iF] = C;
 
     // Compute something like a normal
     glm::vec3 N = {0., 0., 0.};
-    for (size_t iV = 1; iV < face.size() - 1; iV++) {
+    for (size_t iV = 1; iV < D - 1; iV++) {
       glm::vec3 p0 = vertexPositionsGLM[face[0]];
       glm::vec3 p1 = vertexPositionsGLM[face[iV]];
       glm::vec3 p2 = vertexPositionsGLM[face[iV + 1]];
@@ -244,7 +244,7 @@ void processFileOBJ(std::string filename) {
     fNormals[iF] = N;
 
     // Accumulate at vertices
-    for (size_t iV = 0; iV < face.size(); iV++) {
+    for (size_t iV = 0; iV < D; iV++) {
       vNormals[face[iV]] += N;
     }
   }
@@ -339,18 +339,19 @@ void processFileOBJ(std::string filename) {
     size_t iEdge = 0;
     seenEdges.clear();
     for (size_t iF = 0; iF < nFaces; iF++) {
-      std::vector<size_t>& face = faceIndices[iF];
+      const uint32_t* face = faceInds(iF);
+      size_t D = faceDegree(iF);
 
-      if (face.size() != 3) {
+      if (D != 3) {
         isTriangle = false;
         break;
       }
 
       glm::vec3 pos = fCenters[iF];
 
-      for (size_t j = 0; j < face.size(); j++) {
+      for (size_t j = 0; j < D; j++) {
         size_t vA = face[j];
-        size_t vB = face[(j + 1) % face.size()];
+        size_t vB = face[(j + 1) % D];
         size_t iMin = std::min(vA, vB);
         size_t iMax = std::max(vA, vB);
         auto p = std::make_pair(iMin, iMax);
@@ -372,8 +373,9 @@ void processFileOBJ(std::string filename) {
   { // Parameterizations
     std::vector<std::array<double, 2>> cornerParam;
     for (size_t iF = 0; iF < nFaces; iF++) {
-      std::vector<size_t>& face = faceIndices[iF];
-      for (size_t iC = 0; iC < face.size(); iC++) {
+      const uint32_t* face = faceInds(iF);
+      size_t D = faceDegree(iF);
+      for (size_t iC = 0; iC < D; iC++) {
         size_t iV = face[iC];
         std::array<double, 2> p = {{vertexPositionsGLM[iV].x, vertexPositionsGLM[iV].y}};
         cornerParam.push_back(p);
@@ -417,11 +419,12 @@ void processFileOBJ(std::string filename) {
   { // Add a curve network from the edges
     std::vector<std::array<size_t, 2>> edges;
     for (size_t iF = 0; iF < nFaces; iF++) {
-      std::vector<size_t>& face = faceIndices[iF];
+      const uint32_t* face = faceInds(iF);
+      size_t D = faceDegree(iF);
 
-      for (size_t iV = 0; iV < face.size(); iV++) {
+      for (size_t iV = 0; iV < D; iV++) {
         size_t i0 = face[iV];
-        size_t i1 = face[(iV + 1) % face.size()];
+        size_t i1 = face[(iV + 1) % D];
         if (i0 < i1) {
           edges.push_back({i0, i1});
         }
@@ -559,14 +562,13 @@ void dropCameraView() {
 }
 
 void processFileDotMesh(std::string filename) {
-  std::vector<std::array<double, 3>> verts;
-  std::vector<std::array<int64_t, 8>> cells;
-  parseVolumeDotMesh(filename, verts, cells);
   std::string niceName = polyscope::guessNiceNameFromPath(filename);
 
-  std::cout << "parsed mesh with " << verts.size() << " verts and " << cells.size() << " cells\n";
+  polyscope::VolumeMesh* ps_vol = polyscope::loadVolumeMesh(niceName, filename);
+  const std::vector<glm::vec3>& verts = ps_vol->vertexPositions.data;
+  const std::vector<std::array<uint32_t, 8>>& cells = ps_vol->cells;
 
-  auto ps_vol = polyscope::registerVolumeMesh(niceName, verts, cells);
+  std::cout << "parsed mesh with " << verts.size() << " verts and " << cells.size() << " cells\n";
 
   // Add some scalar quantities
   std::vector<std::array<double, 3>> randColorV(verts.size());
@@ -660,6 +662,8 @@ void processFile(std::string filename) {
   } else if (endsWith(filename, ".ply")) {
     // PLY files get loaded as point clouds
     processFilePLY(filename);
+  } else if (endsWith(filename, ".psb")) {
+    polyscope::loadSceneFile(filename);
   } else {
     std::cerr << "Unrecognized file type for " << filename << std::endl;
   }
@@ -737,6 +741,10 @@ void callback() {
     dropCameraView();
   }
 
+  if (ImGui::Button("save scene")) {
+    polyscope::writeSceneFile("scene.psb");
+  }
+
   ImGui::PopItemWidth();
 }
 
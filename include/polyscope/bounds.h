@@ -0,0 +1,69 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace polyscope {
+
+// Compute the bounding box of a set of points, along with a length scale defined as twice the largest distance from
+// the center of that box. This is what structures use for their object-space bounds. Large inputs are processed in
+// parallel; the length scale pass skips any block of points whose own bounding box cannot increase it.
+// If blockBoxes is given, it is also filled with the bounding box of each block of pointBoundsBlockSize points.
+const size_t pointBoundsBlockSize = 4096;
+void computePointBounds(const glm::vec3* points, size_t n, std::tuple<glm::vec3, glm::vec3>& bbox, float& lengthScale,
+                        std::vector<std::tuple<glm::vec3, glm::vec3>>* blockBoxes = nullptr);
+void computePointBounds(const std::vector<glm::vec3>& points, std::tuple<glm::vec3, glm::vec3>& bbox,
+                        float& lengthScale, std::vector<std::tuple<glm::vec3, glm::vec3>>* blockBoxes = nullptr);
+
+// Grow existing bounds (as computed above) to also contain some new points, without revisiting the old ones. The
+// bounding box is exact, but the length scale is conservative: it may be larger than a full recompute would give.
+void expandPointBounds(const glm::vec3* points, size_t n, std::tuple<glm::vec3, glm::vec3>& bbox, float& lengthScale);
+
+// Bounding boxes of consecutive blocks of blockSize points, resized to cover all n points. Only the blocks overlapping
+// entries [start, end) are recomputed.
+void updateBlockBounds(const glm::vec3* points, size_t n, size_t blockSize, size_t start, size_t end,
+                       std::vector<std::tuple<glm::vec3, glm::vec3>>& blockBoxes);
+
+// Like updateBlockBounds(), recomputing all blocks, but the entries are indices in to `points` (e.g. triangle corners)
+void computeIndexedBlockBounds(const std::vector<glm::vec3>& points, const std::vector<uint32_t>& inds,
+                               size_t blockSize, std::vector<std::tuple<glm::vec3, glm::vec3>>& blockBoxes);
+
+// == Visibility tests, used for culling
+
+// The six planes of the view frustum of a view-projection matrix, as (normal, offset) with normals pointing inwards
+std::array<glm::vec4, 6> frustumPlanes(const glm::mat4& viewProjection);
+
+// Conservative test of whether a box, mapped by an affine transform and then padded by a margin (in the transformed
+// space), might intersect the frustum. Returns false only if it is certainly outside.
+bool boxMayIntersectFrustum(const std::array<glm::vec4, 6>& planes, const glm::mat4& transform, glm::vec3 boxMin,
+                            glm::vec3 boxMax, float margin = 0.);
+
+// A depth buffer (window depths in [0,1], bottom row first) reduced to a pyramid holding the farthest depth of each
+// cell, for testing boxes against the depth of a previous frame rendered with viewProjection. Level 0 is the buffer
+// itself, and each further level halves the resolution (rounding up), down to a single cell.
+struct OcclusionDepthMap {
+  glm::mat4 viewProjection{1.};
+  std::vector<std::vector<float>> levels;
+  std::vector<glm::uvec2> levelSizes;
+  bool isValid() const { return !levels.empty(); }
+};
+void buildOcclusionDepthMap(const std::vector<float>& depth, size_t width, size_t height,
+                            const glm::mat4& viewProjection, OcclusionDepthMap& map);
+
+// Conservative test of whether a box (transformed and padded as for boxMayIntersectFrustum()) might be in front of the
+// depth stored in the map, at some pixel it covers. Returns false only if it is certainly hidden. Boxes which cross the
+// near plane, and invalid maps, always pass.
+bool boxMayBeUnoccluded(const OcclusionDepthMap& map, const glm::mat4& transform, glm::vec3 boxMin, glm::vec3 boxMax,
+                        float margin = 0.);
+
+// Merge the indices of consecutive visible blocks (in increasing order) in to (start, count) ranges of entries
+std::vector<std::pair<size_t, size_t>> blockIndicesToRanges(const std::vector<size_t>& blockInds, size_t blockSize,
+                                                           size_t n);
+
+} // namespace polyscope
@@ -4,7 +4,11 @@ namespace polyscope {
 
 template <typename QuantityT>
 ColorQuantity<QuantityT>::ColorQuantity(QuantityT& quantity_, const std::vector<glm::vec3>& colors_)
-    : quantity(quantity_), colors(quantity.uniquePrefix() + "#colors", colorsData), colorsData(colors_) {}
+    : quantity(quantity_), colors(quantity.uniquePrefix() + "#colors", colorsData), colorsData(colors_) {
+  if (options::compactRenderBuffers) {
+    colors.setDeviceQuantization(BufferQuantization::UNorm8);
+  }
+}
 
 template <typename QuantityT>
 void ColorQuantity<QuantityT>::buildColorUI() {}
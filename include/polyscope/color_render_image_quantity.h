@@ -25,6 +25,11 @@ public:
 
   virtual std::string niceName() override;
 
+  // Replace the depth, normal and color data, which must have the same size as before. Existing textures are updated
+  // in place.
+  void updateBuffers(const std::vector<float>& newDepthData, const std::vector<glm::vec3>& newNormalData,
+                     const std::vector<glm::vec3>& newColorData);
+
   // == Setters and getters
 
 
@@ -35,6 +35,9 @@ struct QuantityTypeHelper<CurveNetwork> {
   typedef CurveNetworkQuantity type;
 };
 
+// Largest number of edges in each block of the line strips, which choose their level of detail separately
+const size_t lineLODBlockEdges = 256;
+
 class CurveNetwork : public QuantityStructure<CurveNetwork> {
 public:
   // === Member functions ===
@@ -42,6 +45,10 @@ public:
   // Construct a new curve network structure
   CurveNetwork(std::string name, std::vector<glm::vec3> nodes, std::vector<std::array<size_t, 2>> edges);
 
+  // Re-create a curve network written by writeToSceneFile() (see scene_file.h)
+  static CurveNetwork* createFromSceneFile(const SceneFileReader& reader, const std::string& prefix,
+                                           std::string name);
+
   // === Overloads
 
   // Build the imgui display
@@ -54,9 +61,12 @@ public:
   virtual void drawPick() override;
 
   virtual void updateObjectSpaceBounds() override;
+  virtual bool isCullable() override;
+  virtual float cullingMargin() override;
   virtual std::string typeName() override;
 
   virtual void refresh() override;
+  virtual bool writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) override;
 
   // === Geometry members
 
@@ -70,6 +80,12 @@ public:
   // internally-computed geometry
   render::ManagedBuffer<glm::vec3> edgeCenters;
 
+  // Polyline strips used by the Line render mode, as node indices separated by INVALID_IND_32. Chains of degree-2 nodes
+  // are split in to blocks of up to lineLODBlockEdges edges, and each block is drawn at its own level of detail for the
+  // current view: level k keeps every 2^k-th node of the block (plus its endpoints), and blocks outside the view are
+  // left out. Populated lazily, the first time the network is drawn as lines, and updated when the view changes.
+  std::vector<uint32_t> lineStripInds;
+
   // === Quantities
 
   // Scalars
@@ -115,10 +131,14 @@ public:
   // Small utilities
   void setCurveNetworkNodeUniforms(render::ShaderProgram& p);
   void setCurveNetworkEdgeUniforms(render::ShaderProgram& p);
+  void setCurveNetworkLineUniforms(render::ShaderProgram& p);
   void fillEdgeGeometryBuffers(render::ShaderProgram& program);
   void fillNodeGeometryBuffers(render::ShaderProgram& program);
+  void fillLineGeometryBuffers(render::ShaderProgram& program);
+  void setLineIndex(render::ShaderProgram& program);
   std::vector<std::string> addCurveNetworkNodeRules(std::vector<std::string> initRules);
   std::vector<std::string> addCurveNetworkEdgeRules(std::vector<std::string> initRules);
+  std::vector<std::string> addCurveNetworkLineRules(std::vector<std::string> initRules);
 
   // === Mutate
   template <class V>
@@ -149,6 +169,24 @@ public:
   CurveNetwork* setMaterial(std::string name);
   std::string getMaterial();
 
+  // Render mode. Tube draws raycast spheres & cylinders, Line draws constant-width polylines through chains of degree-2
+  // nodes, which is much cheaper for large curve sets.
+  CurveNetwork* setRenderMode(CurveNetworkRenderMode newVal);
+  CurveNetworkRenderMode getRenderMode();
+
+  // The width of lines in the Line render mode, in pixels
+  CurveNetwork* setLineWidth(float newVal);
+  float getLineWidth();
+
+  // Distance-based simplification in the Line render mode: each block of the strips uses the coarsest level of detail
+  // whose segments still span at most this many pixels on screen. 0 disables simplification.
+  CurveNetwork* setLineSimplificationTolerance(float newVal);
+  float getLineSimplificationTolerance();
+
+  // The level of detail of each block of the strips for the current view: 0 is full detail and each level halves it.
+  // Blocks outside the view are INVALID_IND.
+  std::vector<size_t> getLineLODLevels();
+
 
 private:
   // Storage for the managed buffers above. You should generally interact with these through the managed buffers, not
@@ -159,11 +197,15 @@ private:
   std::vector<glm::vec3> edgeCentersData;
 
   void computeEdgeCenters();
+  void computeLineStrips();
 
   // === Visualization parameters
   PersistentValue<glm::vec3> color;
   PersistentValue<ScaledValue<float>> radius;
   PersistentValue<std::string> material;
+  PersistentValue<std::string> renderMode;
+  PersistentValue<float> lineWidth;
+  PersistentValue<float> lineSimplificationTolerance;
 
   // Drawing related things
   // if nullptr, prepare() (resp. preparePick()) needs to be called
@@ -171,12 +213,33 @@ private:
   std::shared_ptr<render::ShaderProgram> nodeProgram;
   std::shared_ptr<render::ShaderProgram> edgePickProgram;
   std::shared_ptr<render::ShaderProgram> nodePickProgram;
+  std::shared_ptr<render::ShaderProgram> lineProgram;
+  std::shared_ptr<render::ShaderProgram> linePickProgram;
+
+  // Blocks of the line strips, each with its own level of detail. The bounds are refreshed lazily, when the node
+  // positions change (tracked by their buffer version).
+  struct LineBlock {
+    std::vector<uint32_t> nodes; // consecutive nodes of a chain
+    std::tuple<glm::vec3, glm::vec3> bounds;
+    float maxEdgeLength;
+  };
+  std::vector<LineBlock> lineBlocks;
+  std::vector<size_t> lineBlockLevels; // the levels lineStripInds was built with
+  bool lineBlocksComputed = false;
+  uint64_t lineBlockPositionsVersion = 0;
 
   // === Helpers
 
   // Do setup work related to drawing, including allocating openGL data
   void prepare();
   void preparePick();
+  void prepareLine();
+  void prepareLinePick();
+
+  // Choose the level of detail of each block for the current view, and rebuild the strips if any changed
+  void ensureLineBlocksComputed();
+  std::vector<size_t> computeLineLODLevels();
+  void updateLineLOD();
 
   void recomputeGeometryIfPopulated();
   float computeRadiusMultiplierUniform();
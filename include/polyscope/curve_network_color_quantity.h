@@ -20,15 +20,18 @@ public:
   virtual std::string niceName() override;
 
   virtual void refresh() override;
+  virtual void updateLineIndex() override;
 
 protected:
   // UI internals
   const std::string definedOn;
   std::shared_ptr<render::ShaderProgram> nodeProgram;
   std::shared_ptr<render::ShaderProgram> edgeProgram;
+  std::shared_ptr<render::ShaderProgram> lineProgram;
 
   // Helpers
   virtual void createProgram() = 0;
+  virtual void createLineProgram() = 0;
 };
 
 // ========================================================
@@ -40,6 +43,7 @@ public:
   CurveNetworkNodeColorQuantity(std::string name, std::vector<glm::vec3> values_, CurveNetwork& network_);
 
   virtual void createProgram() override;
+  virtual void createLineProgram() override;
 
   void buildNodeInfoGUI(size_t vInd) override;
 };
@@ -53,6 +57,7 @@ public:
   CurveNetworkEdgeColorQuantity(std::string name, std::vector<glm::vec3> values_, CurveNetwork& network_);
 
   virtual void createProgram() override;
+  virtual void createLineProgram() override;
 
   void buildEdgeInfoGUI(size_t eInd) override;
 
@@ -19,6 +19,9 @@ public:
   // Build GUI info an element
   virtual void buildNodeInfoGUI(size_t vInd);
   virtual void buildEdgeInfoGUI(size_t fInd);
+
+  // Called when the parent switches to a different level of detail in the Line render mode
+  virtual void updateLineIndex();
 };
 
 
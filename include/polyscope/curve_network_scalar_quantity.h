@@ -19,15 +19,18 @@ public:
   virtual void buildCustomUI() override;
   virtual std::string niceName() override;
   virtual void refresh() override;
+  virtual void updateLineIndex() override;
 
 protected:
   // UI internals
   const std::string definedOn;
   std::shared_ptr<render::ShaderProgram> nodeProgram;
   std::shared_ptr<render::ShaderProgram> edgeProgram;
+  std::shared_ptr<render::ShaderProgram> lineProgram;
 
   // Helpers
   virtual void createProgram() = 0;
+  virtual void createLineProgram() = 0;
 };
 
 // ========================================================
@@ -40,6 +43,7 @@ public:
                                  DataType dataType_ = DataType::STANDARD);
 
   virtual void createProgram() override;
+  virtual void createLineProgram() override;
 
   void buildNodeInfoGUI(size_t nInd) override;
 };
@@ -55,6 +59,7 @@ public:
                                  DataType dataType_ = DataType::STANDARD);
 
   virtual void createProgram() override;
+  virtual void createLineProgram() override;
 
   void buildEdgeInfoGUI(size_t edgeInd) override;
 
@@ -2,10 +2,40 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 
 namespace polyscope {
 
 std::string promptForFilename(std::string filename = "out");
-}
+
+// A read-only memory mapping of an entire file. The contents are paged in from disk by the OS as they are accessed.
+class MemoryMappedFile {
+public:
+  MemoryMappedFile(std::string filename); // throws if the file cannot be opened or mapped
+  ~MemoryMappedFile();
+
+  // No copy constructor/assignment
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  const std::string filename;
+  const char* data() const; // null for an empty file
+  size_t size() const;      // in bytes
+
+  // Hint that the bytes [offset, offset+length) will be read soon, so the OS can start reading them from disk
+  void prefetch(size_t offset, size_t length) const;
+
+private:
+  const char* mappedData = nullptr;
+  size_t mappedSize = 0;
+#ifdef _WIN32
+  void* fileHandle = nullptr;
+  void* mappingHandle = nullptr;
+#else
+  int fileDescriptor = -1;
+#endif
+};
+
+} // namespace polyscope
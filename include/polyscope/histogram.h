@@ -4,6 +4,7 @@
 
 #include "polyscope/render/color_maps.h"
 #include "polyscope/render/engine.h"
+#include "polyscope/scalar_statistics.h"
 
 #include <vector>
 
@@ -19,6 +20,7 @@ public:
   ~Histogram();
 
   void buildHistogram(const std::vector<double>& values);
+  void buildHistogram(const ScalarStatistics& stats); // from precomputed statistics, without revisiting the data
   void updateColormap(const std::string& newColormap);
 
   // Width = -1 means set automatically
@@ -31,7 +33,7 @@ private:
 
   // Manage the actual histogram
   void fillBuffers();
-  size_t rawHistBinCount = 51;
+  size_t rawHistBinCount = statisticsHistogramBinCount; // so ScalarStatistics has exact counts for it
 
   std::vector<float> rawHistCurveY;
   std::vector<std::array<float, 2>> rawHistCurveX;
@@ -4,6 +4,7 @@
 
 #include "polyscope/polyscope.h"
 
+#include "polyscope/camera_parameters.h"
 #include "polyscope/floating_quantity.h"
 
 #include "polyscope/color_render_image_quantity.h"
@@ -11,7 +12,10 @@
 #include "polyscope/scalar_render_image_quantity.h"
 #include "polyscope/scaled_value.h"
 #include "polyscope/structure.h"
+#include "polyscope/widget.h"
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,6 +23,8 @@ namespace polyscope {
 
 // A collection of functions for rendering implicit surfaces
 
+struct ImplicitWarmStart;
+
 struct ImplicitRenderOpts {
   ImplicitRenderMode mode = ImplicitRenderMode::SphereMarch;
   ScaledValue<float> missDist = ScaledValue<float>::relative(20.);
@@ -28,6 +34,33 @@ struct ImplicitRenderOpts {
   ScaledValue<float> stepSize = ScaledValue<float>::relative(1e-2); // used for fixed-size stepping
   size_t nMaxSteps = 1024;
   int subsampleFactor = 1;
+  bool parallel = false; // march tiles of rays concurrently on a thread pool, opt-in (see below)
+
+  // Acceleration (see "Acceleration" below)
+  bool useBoundingBox = false; // if true, the surface must lie within the box, and rays are only marched inside it
+  glm::vec3 boundingBoxMin{0., 0., 0.};
+  glm::vec3 boundingBoxMax{0., 0., 0.};
+  int conePrepassFactor = 0;                  // if > 1, sphere march cones through blocks of this many pixels first
+  std::shared_ptr<ImplicitWarmStart> warmStart; // if set, start rays near the surface found by the previous render
+
+  // used for progressive rendering only
+  int progressiveInitialStride = 8;        // pixel spacing of the rays in the first, coarse pass
+  float progressiveDepthThreshold = 0.02;  // march new rays where neighboring depths differ by this fraction...
+  float progressiveNormalThreshold = 0.95; // ...or where the cosine between neighboring normals is below this
+};
+
+// State carried between renders of the current view, so that each ray can start near the surface found by the
+// previous render. Create one and pass it in ImplicitRenderOpts::warmStart for every render of the same function. This
+// is a heuristic meant for small camera motions: a ray whose warm starting point turns out to be inside the surface is
+// marched from the beginning instead, but thin features which were not visible in the previous render may be missed.
+struct ImplicitWarmStart {
+  float backoff = 0.05; // start rays this fraction of the previous depth in front of the previous surface
+  ScaledValue<float> maxCameraMove = ScaledValue<float>::relative(0.1); // don't warm start after moving further
+
+  // Filled in by each render
+  bool valid = false;
+  glm::vec3 cameraPos;
+  std::vector<glm::vec3> hitPos;
 };
 
 // =======================================================
@@ -43,6 +76,18 @@ struct ImplicitRenderOpts {
 // function", i.e. function is positive outside the surface, negative inside the surface, and the magnitude gives the
 // distance to the surface (or technically, an upper bound on that distance). Alternately, ImplicitRenderOpts::FixedStep
 // handles more general implicit functions. See the options struct for other options.
+//
+// By default all of the work happens on the calling thread, and batch functions receive all of the active rays in each
+// call. If you set ImplicitRenderOpts::parallel, the image is split into square tiles of pixels which are processed
+// concurrently on a thread pool, so your function (and any color or scalar function) will be called from several
+// threads at once, with the active rays of one tile per call, and must be safe to call that way.
+//
+// Acceleration: by default every ray is marched from the camera. Setting ImplicitRenderOpts::useBoundingBox skips rays
+// which miss the box and starts the rest where they enter it. With SphereMarch, conePrepassFactor = N first marches one
+// cone per NxN block of pixels, at the same cost per step as a ray; since the function is a distance bound, the depth
+// where the cone meets the surface is a safe place to start every ray in the block. Finally, ImplicitWarmStart reuses
+// the previous render's depths when re-rendering during camera motion. The first two give the same image as marching
+// from the camera.
 template <class Func, class S>
 DepthRenderImageQuantity* renderImplicitSurface(QuantityStructure<S>* parent, std::string name, Func&& func,
                                                 ImplicitRenderOpts opts = ImplicitRenderOpts());
@@ -56,6 +101,36 @@ template <class Func>
 DepthRenderImageQuantity* renderImplicitSurfaceBatch(std::string name, Func&& func,
                                                      ImplicitRenderOpts opts = ImplicitRenderOpts());
 
+// Like renderImplicitSurface(), but normals are computed from `funcGradient`, which returns the gradient of the
+// implicit function at a point, instead of from four extra evaluations of `func` per pixel. It need not be normalized.
+// For the batch variant, `funcGradient` takes a std::vector<glm::vec3> and produces a std::vector<glm::vec3>.
+template <class Func, class FuncGradient, class S>
+DepthRenderImageQuantity* renderImplicitSurfaceWithGradient(QuantityStructure<S>* parent, std::string name,
+                                                            Func&& func, FuncGradient&& funcGradient,
+                                                            ImplicitRenderOpts opts = ImplicitRenderOpts());
+template <class Func, class FuncGradient>
+DepthRenderImageQuantity* renderImplicitSurfaceWithGradient(std::string name, Func&& func, FuncGradient&& funcGradient,
+                                                            ImplicitRenderOpts opts = ImplicitRenderOpts());
+template <class Func, class FuncGradient, class S>
+DepthRenderImageQuantity* renderImplicitSurfaceWithGradientBatch(QuantityStructure<S>* parent, std::string name,
+                                                                 Func&& func, FuncGradient&& funcGradient,
+                                                                 ImplicitRenderOpts opts = ImplicitRenderOpts());
+template <class Func, class FuncGradient>
+DepthRenderImageQuantity* renderImplicitSurfaceWithGradientBatch(std::string name, Func&& func,
+                                                                 FuncGradient&& funcGradient,
+                                                                 ImplicitRenderOpts opts = ImplicitRenderOpts());
+
+// Like renderImplicitSurfaceBatch(), but `func` takes its points as separate coordinate arrays and writes in to a
+// preallocated output, as in
+//   void func(const float* x, const float* y, const float* z, float* valsOut, size_t n)
+// which suits vectorized implementations.
+template <class Func, class S>
+DepthRenderImageQuantity* renderImplicitSurfaceBatchSoA(QuantityStructure<S>* parent, std::string name, Func&& func,
+                                                        ImplicitRenderOpts opts = ImplicitRenderOpts());
+template <class Func>
+DepthRenderImageQuantity* renderImplicitSurfaceBatchSoA(std::string name, Func&& func,
+                                                        ImplicitRenderOpts opts = ImplicitRenderOpts());
+
 // =======================================================
 // === Colored surface render functions
 // =======================================================
@@ -105,6 +180,185 @@ ScalarRenderImageQuantity* renderImplicitSurfaceScalarBatch(std::string name, Fu
                                                             DataType dataType = DataType::STANDARD);
 
 
+// =======================================================
+// === Progressive render functions
+// =======================================================
+
+class ImplicitProgressiveRenderer;
+
+// Like renderImplicitSurface() and renderImplicitSurfaceColor(), but the image is computed progressively so expensive
+// functions stay interactive; see ImplicitProgressiveRenderer below. The returned renderer must be kept alive for as
+// long as the image should keep refining. Only the pointwise (non-batch) function forms are accepted.
+
+template <class Func, class S>
+std::unique_ptr<ImplicitProgressiveRenderer>
+renderImplicitSurfaceProgressive(QuantityStructure<S>* parent, std::string name, Func&& func,
+                                 ImplicitRenderOpts opts = ImplicitRenderOpts());
+template <class Func>
+std::unique_ptr<ImplicitProgressiveRenderer>
+renderImplicitSurfaceProgressive(std::string name, Func&& func, ImplicitRenderOpts opts = ImplicitRenderOpts());
+
+template <class Func, class FuncColor, class S>
+std::unique_ptr<ImplicitProgressiveRenderer>
+renderImplicitSurfaceColorProgressive(QuantityStructure<S>* parent, std::string name, Func&& func,
+                                      FuncColor&& funcColor, ImplicitRenderOpts opts = ImplicitRenderOpts());
+template <class Func, class FuncColor>
+std::unique_ptr<ImplicitProgressiveRenderer>
+renderImplicitSurfaceColorProgressive(std::string name, Func&& func, FuncColor&& funcColor,
+                                      ImplicitRenderOpts opts = ImplicitRenderOpts());
+
+// =======================================================
+// === Rendering from other cameras
+// =======================================================
+
+// A camera to render an implicit surface from, other than the current view. Use the named constructors.
+struct ImplicitRenderCamera {
+  // A perspective camera with the extrinsics, field of view and aspect ratio of the given parameters
+  static ImplicitRenderCamera perspective(const CameraParameters& params, size_t dimX, size_t dimY);
+
+  // An orthographic camera with the given extrinsics, whose image spans viewHeight world-space units vertically (the
+  // horizontal span follows from the image size)
+  static ImplicitRenderCamera orthographic(const CameraExtrinsics& extrinsics, float viewHeight, size_t dimX,
+                                           size_t dimY);
+
+  glm::mat4 viewMat;
+  glm::mat4 projMat;
+  ProjectionMode projectionMode = ProjectionMode::Perspective;
+  size_t dimX = 0; // image size, in pixels
+  size_t dimY = 0;
+};
+
+struct ImplicitRenderResult {
+  size_t dimX = 0;
+  size_t dimY = 0;
+  std::vector<float> depth;      // distance along the ray, infinity for rays which missed
+  std::vector<glm::vec3> pos;    // world-space hit position
+  std::vector<glm::vec3> normal; // view-space normal, zero for rays which missed
+};
+
+// Render an implicit surface from the given camera(s) and return the image, without using the current view or adding
+// any quantities (so this works headless). `func` is a batch function, as in renderImplicitSurfaceBatch(). Perspective
+// depths are measured from the camera position, orthographic depths from the plane through the camera position.
+// opts.subsampleFactor is ignored, the image size comes from the camera. When there are enough cameras, several images
+// are rendered at once with opts.parallel, so the same thread-safety requirements apply.
+template <class Func>
+ImplicitRenderResult renderImplicitSurfaceFromCamera(Func&& func, const ImplicitRenderCamera& camera,
+                                                     ImplicitRenderOpts opts = ImplicitRenderOpts());
+template <class Func>
+std::vector<ImplicitRenderResult> renderImplicitSurfaceFromCameras(Func&& func,
+                                                                   const std::vector<ImplicitRenderCamera>& cameras,
+                                                                   ImplicitRenderOpts opts = ImplicitRenderOpts());
+
+// =======================================================
+// === Internals
+// =======================================================
+
+// Evaluate the implicit function at a batch of points, writing one value per point in to vals
+using ImplicitBatchFunc = std::function<void(const std::vector<glm::vec3>& pos, std::vector<float>& vals)>;
+
+// Evaluate the gradient of the implicit function at a batch of points, writing one value per point in to grads
+using ImplicitGradientBatchFunc = std::function<void(const std::vector<glm::vec3>& pos, std::vector<glm::vec3>& grads)>;
+
+// Per-pixel marching intervals from the acceleration options, as (start, end) depths along each ray. Empty vectors mean
+// no bound. warm holds heuristic starting depths from a previous render, negative for none.
+struct ImplicitRayBounds {
+  std::vector<float> start;
+  std::vector<float> end;
+  std::vector<float> warm;
+};
+
+// Evaluate the implicit function at n points given as coordinate arrays, writing n values in to vals
+using ImplicitSoABatchFunc = std::function<void(const float* x, const float* y, const float* z, float* vals, size_t n)>;
+ImplicitBatchFunc implicitBatchFuncFromSoA(ImplicitSoABatchFunc funcSoA);
+
+// March a ray through each pixel of the current view, as used by all of the render functions above
+// (if gradFunc is given, it is used for normals rather than finite differences)
+ImplicitRenderResult
+renderImplicitSurfaceFromCurrentViewImpl(const ImplicitBatchFunc& func, const ImplicitRenderOpts& opts,
+                                         const ImplicitGradientBatchFunc& gradFunc = ImplicitGradientBatchFunc());
+std::vector<ImplicitRenderResult>
+renderImplicitSurfaceFromCamerasImpl(const ImplicitBatchFunc& func, const std::vector<ImplicitRenderCamera>& cameras,
+                                     const ImplicitRenderOpts& opts,
+                                     const ImplicitGradientBatchFunc& gradFunc = ImplicitGradientBatchFunc());
+
+// Evaluate a color at a batch of points, writing one value per point in to colors
+using ImplicitColorBatchFunc = std::function<void(const std::vector<glm::vec3>& pos, std::vector<glm::vec3>& colors)>;
+
+// Renders an implicit surface a little more each frame. The first pass marches rays only every
+// progressiveInitialStride pixels and fills in the gaps, so an image appears immediately. Each later pass halves the
+// spacing: a new pixel is marched only if the neighboring samples around it differ in hit/miss, depth or normal (see
+// the progressive* options), and is interpolated from them otherwise. Once the spacing reaches one pixel the image is
+// complete. If the camera changes, rendering starts over from the coarse pass.
+//
+// The renderer is a Widget, so it refines once per frame while Polyscope is showing; refine() may also be called
+// directly. Each pass hands the full image to the publish function, which typically updates a render image quantity
+// in place.
+class ImplicitProgressiveRenderer : public Widget {
+public:
+  using PublishFunc = std::function<void(const ImplicitRenderResult& result, const std::vector<glm::vec3>& colors)>;
+
+  // colorFunc may be empty, in which case no colors are computed
+  ImplicitProgressiveRenderer(ImplicitBatchFunc func, ImplicitColorBatchFunc colorFunc, PublishFunc publish,
+                              ImplicitRenderOpts opts);
+
+  // Run the next pass (or start over, if the view has changed). Returns true if the image is complete.
+  bool refine();
+
+  // Start over from the coarse pass, e.g. after the implicit function has changed
+  void restart();
+
+  bool isComplete() const;
+  size_t getCurrentStride() const; // pixel spacing of the rays in the latest pass
+
+  virtual void draw() override;
+
+private:
+  ImplicitBatchFunc func;
+  ImplicitColorBatchFunc colorFunc;
+  PublishFunc publish;
+  ImplicitRenderOpts opts;
+
+  // The view the current image was started from
+  glm::mat4 startViewMat;
+  glm::mat4 startProjMat;
+  int startBufferWidth = -1;
+  int startBufferHeight = -1;
+
+  bool started = false;
+  size_t stride = 0;
+  ImplicitRenderResult result;
+  std::vector<glm::vec3> colors;
+  ImplicitRayBounds rayBounds;
+
+  bool viewChanged() const;
+  void refinePass();
+  void finishPass(const std::vector<size_t>& newPixels);
+};
+
+// Add a render image quantity, or if one with the same name, size and origin already exists, update it in place
+template <class S>
+DepthRenderImageQuantity* addOrUpdateDepthRenderImageQuantity(QuantityStructure<S>* parent, std::string name,
+                                                              size_t dimX, size_t dimY,
+                                                              const std::vector<float>& depthData,
+                                                              const std::vector<glm::vec3>& normalData);
+template <class S>
+ColorRenderImageQuantity* addOrUpdateColorRenderImageQuantity(QuantityStructure<S>* parent, std::string name,
+                                                              size_t dimX, size_t dimY,
+                                                              const std::vector<float>& depthData,
+                                                              const std::vector<glm::vec3>& normalData,
+                                                              const std::vector<glm::vec3>& colorData);
+template <class S>
+ScalarRenderImageQuantity* addOrUpdateScalarRenderImageQuantity(QuantityStructure<S>* parent, std::string name,
+                                                                size_t dimX, size_t dimY,
+                                                                const std::vector<float>& depthData,
+                                                                const std::vector<glm::vec3>& normalData,
+                                                                const std::vector<double>& scalarData,
+                                                                DataType dataType);
+
+// Apply a per-point function to each entry of inPos, in parallel chunks if requested
+template <class T, class Func>
+std::vector<T> evaluatePointwise(const std::vector<glm::vec3>& inPos, Func&& func, bool parallel);
+
 } // namespace polyscope
 
 #include "polyscope/implicit_surface.ipp"
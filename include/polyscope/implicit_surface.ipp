@@ -5,177 +5,101 @@
 
 #include "polyscope/floating_quantity_structure.h"
 #include "polyscope/messages.h"
+#include "polyscope/parallel.h"
 #include "polyscope/view.h"
 
+#include <memory>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace polyscope {
 
 
-template <class Func>
-std::tuple<size_t, size_t, std::vector<float>, std::vector<glm::vec3>, std::vector<glm::vec3>>
-renderImplicitSurfaceFromCurrentView(Func&& func, ImplicitRenderOpts opts) {
-
-  // == Get current camera/image parameters
-  if (view::projectionMode != ProjectionMode::Perspective) {
-    // TODO to support orthographic, need to add view functions to get ray origins
-    warning("implicit surface rendering only supports perspective projection");
-    return std::tuple<size_t, size_t, std::vector<float>, std::vector<glm::vec3>, std::vector<glm::vec3>>{
-        0, 0, std::vector<float>(), std::vector<glm::vec3>(), std::vector<glm::vec3>()};
-  }
-
-  // Read out option values
-  const float missDist = opts.missDist.asAbsolute();
-  const float hitDist = opts.hitDist.asAbsolute();
-  const float stepFactor = opts.stepFactor;          // used for sphere march only
-  const float stepSize = opts.stepSize.asAbsolute(); // used for fixed step only
-  const size_t nMaxSteps = opts.nMaxSteps;
-  const float normalSampleEps = opts.normalSampleEps;
-  const ImplicitRenderMode mode = opts.mode;
-  const int subsampleFactor = opts.subsampleFactor;
-
-
-  glm::vec3 cameraLoc = view::getCameraWorldPosition();
-  glm::mat4x4 viewMat = view::viewMat;
-  size_t dimX = view::bufferWidth;
-  size_t dimY = view::bufferHeight;
-  size_t dimXsub = dimX / subsampleFactor;
-  size_t dimYsub = dimY / subsampleFactor;
-  size_t nPix = dimXsub * dimYsub;
-
-  // Generate rays corresponding to each pixel
-  // (this is a working set which will be shrunk as computation proceeds)
-  std::vector<glm::vec3> rayRoots(nPix);
-  std::vector<glm::vec3> rayDirs(nPix);
-  std::vector<size_t> rayInds(nPix); // index of the ray
-  for (size_t iY = 0; iY < dimYsub; iY++) {
-    for (size_t iX = 0; iX < dimXsub; iX++) {
-      size_t ind = iY * dimXsub + iX;
-      rayRoots[ind] = cameraLoc;
-      rayDirs[ind] = view::bufferCoordsToWorldRay(glm::vec2{iX * subsampleFactor, iY * subsampleFactor});
-      rayInds[ind] = ind;
+template <class T, class Func>
+std::vector<T> evaluatePointwise(const std::vector<glm::vec3>& inPos, Func&& func, bool parallel) {
+  std::vector<T> outVals(inPos.size());
+  auto evaluateRange = [&](size_t, size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      outVals[i] = static_cast<T>(func(inPos[i]));
     }
+  };
+  if (parallel) {
+    parallelForChunks(inPos.size(), 1024, evaluateRange);
+  } else {
+    evaluateRange(0, 0, inPos.size());
   }
+  return outVals;
+}
 
-  // Sample the first value at each ray (to check for sign changes)
-  std::vector<float> currVals = func(rayRoots);
-  std::vector<bool> initSigns(nPix);
-  for (size_t iP = 0; iP < nPix; iP++) {
-    initSigns[iP] = std::signbit(currVals[iP]);
-  }
-
-  // Write output data here
-
-  // March along the ray to compute depth
-  std::vector<float> rayDepth(nPix, 0.); // working data, gets shrunk and repacked
-  std::vector<glm::vec3> currPos(nPix);
-  std::vector<float> rayDepthOut(nPix, -1.);                        // output values
-  std::vector<glm::vec3> rayPosOut(nPix, glm::vec3{0.f, 0.f, 0.f}); // output values
-  // size_t iFinished = 0;
-  for (size_t iStep = 0; iStep < nMaxSteps; iStep++) {
-
-    // Check for convergence & write/compact
-    size_t iPack = 0;
-    for (size_t iP = 0; iP < rayDepth.size(); iP++) {
-
-      // Check for termination
-      bool missTerminated = rayDepth[iP] > missDist;
-      bool terminated =
-          missTerminated || (std::abs(currVals[iP]) < hitDist) || (std::signbit(currVals[iP]) != initSigns[iP]);
-
-      if (terminated) {
-        // Write to the output buffer
-        size_t outInd = rayInds[iP];
-        glm::vec3 finalPos = rayRoots[iP] + rayDepth[iP] * rayDirs[iP];
-        float outDepth = missTerminated ? -1.f : rayDepth[iP];
-        rayDepthOut[outInd] = outDepth;
-        rayPosOut[outInd] = finalPos;
-
-        // iFinished++;
-
-      } else {
-        // Take a step
-        float rayStepSize = -1.;
-        if (mode == ImplicitRenderMode::SphereMarch) {
-          rayStepSize = std::abs(currVals[iP]) * stepFactor;
-        } else if (mode == ImplicitRenderMode::FixedStep) {
-          rayStepSize = stepSize;
-        }
-
-        float newDepth = rayDepth[iP] + rayStepSize;
-        glm::vec3 newPos = rayRoots[iP] + newDepth * rayDirs[iP];
-
-        // Write to the compacted array
-        rayRoots[iPack] = rayRoots[iP];
-        rayDirs[iPack] = rayDirs[iP];
-        rayInds[iPack] = rayInds[iP];
-        rayDepth[iPack] = newDepth;
-        currPos[iPack] = newPos;
-        iPack++;
-      }
-    }
-
-    // "Trim" the working arrays to size
-    rayRoots.resize(iPack);
-    rayDirs.resize(iPack);
-    rayInds.resize(iPack);
-    rayDepth.resize(iPack);
-    currPos.resize(iPack);
-
-    // Evaluate the remaining rays
-    currVals = func(currPos);
+template <class S>
+DepthRenderImageQuantity* addOrUpdateDepthRenderImageQuantity(QuantityStructure<S>* parent, std::string name,
+                                                              size_t dimX, size_t dimY,
+                                                              const std::vector<float>& depthData,
+                                                              const std::vector<glm::vec3>& normalData) {
+  DepthRenderImageQuantity* q = dynamic_cast<DepthRenderImageQuantity*>(parent->getFloatingQuantity(name));
+  if (q && q->getDimX() == dimX && q->getDimY() == dimY && q->getImageOrigin() == ImageOrigin::UpperLeft) {
+    q->updateGeometryBuffers(depthData, normalData);
+    return q;
   }
+  return parent->addDepthRenderImageQuantityImpl(name, dimX, dimY, depthData, normalData, ImageOrigin::UpperLeft);
+}
 
-  // == Compute normals
-  // Uses finite differences on the vertices of a tetrahedron
-  // (see https://iquilezles.org/articles/normalsSDF/)
-
-  std::vector<glm::vec3> normalOut(nPix, glm::vec3{0.f, 0.f, 0.f}); // output values
-  std::array<glm::vec3, 4> tetVerts({
-      glm::vec3{1.f, -1.f, -1.f},
-      glm::vec3{-1.f, -1.f, 1.f},
-      glm::vec3{-1.f, 1.f, -1.f},
-      glm::vec3{1.f, 1.f, 1.f},
-  });
-
-  currPos.resize(nPix);
-  for (size_t iV = 0; iV < 4; iV++) {
-    glm::vec3 vertVec = tetVerts[iV];
-
-    // Set up the evaluation points for each pixel
-    for (size_t iP = 0; iP < nPix; iP++) {
-      float f = rayDepthOut[iP] * normalSampleEps;
-      currPos[iP] = rayPosOut[iP] + f * vertVec;
-    }
-
-    // Evaluate the function at each sample point
-    currVals = func(currPos);
-
-    // Accumulate the result
-    for (size_t iP = 0; iP < nPix; iP++) {
-      normalOut[iP] += vertVec * currVals[iP];
-    }
+template <class S>
+ColorRenderImageQuantity* addOrUpdateColorRenderImageQuantity(QuantityStructure<S>* parent, std::string name,
+                                                              size_t dimX, size_t dimY,
+                                                              const std::vector<float>& depthData,
+                                                              const std::vector<glm::vec3>& normalData,
+                                                              const std::vector<glm::vec3>& colorData) {
+  ColorRenderImageQuantity* q = dynamic_cast<ColorRenderImageQuantity*>(parent->getFloatingQuantity(name));
+  if (q && q->getDimX() == dimX && q->getDimY() == dimY && q->getImageOrigin() == ImageOrigin::UpperLeft) {
+    q->updateBuffers(depthData, normalData, colorData);
+    return q;
   }
+  return parent->addColorRenderImageQuantityImpl(name, dimX, dimY, depthData, normalData, colorData,
+                                                 ImageOrigin::UpperLeft);
+}
 
-  // Normalize the normal vectors and transform to view space
-  glm::mat3x3 viewMat3(viewMat);
-  for (size_t iP = 0; iP < nPix; iP++) {
-    normalOut[iP] = viewMat3 * glm::normalize(normalOut[iP]);
+template <class S>
+ScalarRenderImageQuantity* addOrUpdateScalarRenderImageQuantity(QuantityStructure<S>* parent, std::string name,
+                                                                size_t dimX, size_t dimY,
+                                                                const std::vector<float>& depthData,
+                                                                const std::vector<glm::vec3>& normalData,
+                                                                const std::vector<double>& scalarData,
+                                                                DataType dataType) {
+  ScalarRenderImageQuantity* q = dynamic_cast<ScalarRenderImageQuantity*>(parent->getFloatingQuantity(name));
+  if (q && q->getDimX() == dimX && q->getDimY() == dimY && q->getImageOrigin() == ImageOrigin::UpperLeft &&
+      q->getDataType() == dataType) {
+    q->updateBuffers(depthData, normalData, scalarData);
+    return q;
   }
+  return parent->addScalarRenderImageQuantityImpl(name, dimX, dimY, depthData, normalData, scalarData,
+                                                  ImageOrigin::UpperLeft, dataType);
+}
 
-  // Handle not-converged rays
-  for (size_t iP = 0; iP < nPix; iP++) {
-    bool didConverge = rayDepthOut[iP] >= 0.;
-    if (!didConverge) {
-      rayDepthOut[iP] = std::numeric_limits<float>::infinity();
-      normalOut[iP] = glm::vec3{0.f, 0.f, 0.f};
-    }
-  }
+template <class Func>
+std::tuple<size_t, size_t, std::vector<float>, std::vector<glm::vec3>, std::vector<glm::vec3>>
+renderImplicitSurfaceFromCurrentView(Func&& func, ImplicitRenderOpts opts) {
 
+  ImplicitBatchFunc batchFunc = [&](const std::vector<glm::vec3>& pos, std::vector<float>& vals) { vals = func(pos); };
+  ImplicitRenderResult result = renderImplicitSurfaceFromCurrentViewImpl(batchFunc, opts);
 
   return std::tuple<size_t, size_t, std::vector<float>, std::vector<glm::vec3>, std::vector<glm::vec3>>{
-      dimXsub, dimYsub, rayDepthOut, rayPosOut, normalOut};
+      result.dimX, result.dimY, std::move(result.depth), std::move(result.pos), std::move(result.normal)};
+}
+
+template <class Func>
+ImplicitRenderResult renderImplicitSurfaceFromCamera(Func&& func, const ImplicitRenderCamera& camera,
+                                                     ImplicitRenderOpts opts) {
+  return renderImplicitSurfaceFromCameras(func, std::vector<ImplicitRenderCamera>{camera}, opts)[0];
+}
+
+template <class Func>
+std::vector<ImplicitRenderResult> renderImplicitSurfaceFromCameras(Func&& func,
+                                                                   const std::vector<ImplicitRenderCamera>& cameras,
+                                                                   ImplicitRenderOpts opts) {
+  ImplicitBatchFunc batchFunc = [&](const std::vector<glm::vec3>& pos, std::vector<float>& vals) { vals = func(pos); };
+  return renderImplicitSurfaceFromCamerasImpl(batchFunc, cameras, opts);
 }
 
 // =======================================================
@@ -196,13 +120,9 @@ template <class Func, class S>
 DepthRenderImageQuantity* renderImplicitSurface(QuantityStructure<S>* parent, std::string name, Func&& func,
                                                 ImplicitRenderOpts opts) {
 
-  // Bootstrap on the batch version
-  auto batchFunc = [&](std::vector<glm::vec3> inPos) {
-    std::vector<float> outVals(inPos.size());
-    for (size_t i = 0; i < inPos.size(); i++) {
-      outVals[i] = static_cast<float>(func(inPos[i]));
-    }
-    return outVals;
+  // Bootstrap on the batch version (which is called on one tile of rays at a time, so evaluate serially here)
+  auto batchFunc = [&](const std::vector<glm::vec3>& inPos) {
+    return evaluatePointwise<float>(inPos, func, false);
   };
 
   return renderImplicitSurfaceBatch(parent, name, batchFunc, opts);
@@ -220,12 +140,68 @@ DepthRenderImageQuantity* renderImplicitSurfaceBatch(QuantityStructure<S>* paren
   std::vector<glm::vec3> normalOut;
   std::tie(dimXsub, dimYsub, rayDepthOut, rayPosOut, normalOut) = renderImplicitSurfaceFromCurrentView(func, opts);
 
-  // TODO check if there is an existing quantity of the same type/size to replace, and if so re-fill its buffers rather
-  // than creating a whole new one
+  // reuse an existing quantity of the same name and size if there is one, so repeated renders do not reallocate
+  // textures. here, we bypass the conversion adaptor since we have explicitly filled matching types
+  return addOrUpdateDepthRenderImageQuantity(parent, name, dimXsub, dimYsub, rayDepthOut, normalOut);
+}
 
-  // here, we bypass the conversion adaptor since we have explicitly filled matching types
-  return parent->addDepthRenderImageQuantityImpl(name, dimXsub, dimYsub, rayDepthOut, normalOut,
-                                                 ImageOrigin::UpperLeft);
+template <class Func, class FuncGradient>
+DepthRenderImageQuantity* renderImplicitSurfaceWithGradient(std::string name, Func&& func, FuncGradient&& funcGradient,
+                                                            ImplicitRenderOpts opts) {
+  return renderImplicitSurfaceWithGradient(getGlobalFloatingQuantityStructure(), name, func, funcGradient, opts);
+}
+
+template <class Func, class FuncGradient>
+DepthRenderImageQuantity* renderImplicitSurfaceWithGradientBatch(std::string name, Func&& func,
+                                                                 FuncGradient&& funcGradient, ImplicitRenderOpts opts) {
+  return renderImplicitSurfaceWithGradientBatch(getGlobalFloatingQuantityStructure(), name, func, funcGradient, opts);
+}
+
+template <class Func, class FuncGradient, class S>
+DepthRenderImageQuantity* renderImplicitSurfaceWithGradient(QuantityStructure<S>* parent, std::string name,
+                                                            Func&& func, FuncGradient&& funcGradient,
+                                                            ImplicitRenderOpts opts) {
+
+  // Bootstrap on the batch version (which is called on one tile of rays at a time, so evaluate serially here)
+  auto batchFunc = [&](const std::vector<glm::vec3>& inPos) {
+    return evaluatePointwise<float>(inPos, func, false);
+  };
+  auto batchFuncGradient = [&](const std::vector<glm::vec3>& inPos) {
+    return evaluatePointwise<glm::vec3>(inPos, funcGradient, false);
+  };
+
+  return renderImplicitSurfaceWithGradientBatch(parent, name, batchFunc, batchFuncGradient, opts);
+}
+
+template <class Func, class FuncGradient, class S>
+DepthRenderImageQuantity* renderImplicitSurfaceWithGradientBatch(QuantityStructure<S>* parent, std::string name,
+                                                                 Func&& func, FuncGradient&& funcGradient,
+                                                                 ImplicitRenderOpts opts) {
+
+  ImplicitBatchFunc batchFunc = [&](const std::vector<glm::vec3>& pos, std::vector<float>& vals) { vals = func(pos); };
+  ImplicitGradientBatchFunc batchFuncGradient = [&](const std::vector<glm::vec3>& pos, std::vector<glm::vec3>& grads) {
+    grads = funcGradient(pos);
+  };
+  ImplicitRenderResult result = renderImplicitSurfaceFromCurrentViewImpl(batchFunc, opts, batchFuncGradient);
+
+  return addOrUpdateDepthRenderImageQuantity(parent, name, result.dimX, result.dimY, result.depth, result.normal);
+}
+
+template <class Func>
+DepthRenderImageQuantity* renderImplicitSurfaceBatchSoA(std::string name, Func&& func, ImplicitRenderOpts opts) {
+  return renderImplicitSurfaceBatchSoA(getGlobalFloatingQuantityStructure(), name, func, opts);
+}
+
+template <class Func, class S>
+DepthRenderImageQuantity* renderImplicitSurfaceBatchSoA(QuantityStructure<S>* parent, std::string name, Func&& func,
+                                                        ImplicitRenderOpts opts) {
+
+  ImplicitSoABatchFunc funcSoA = [&](const float* x, const float* y, const float* z, float* vals, size_t n) {
+    func(x, y, z, vals, n);
+  };
+  ImplicitRenderResult result = renderImplicitSurfaceFromCurrentViewImpl(implicitBatchFuncFromSoA(funcSoA), opts);
+
+  return addOrUpdateDepthRenderImageQuantity(parent, name, result.dimX, result.dimY, result.depth, result.normal);
 }
 
 // =======================================================
@@ -250,21 +226,13 @@ template <class Func, class FuncColor, class S>
 ColorRenderImageQuantity* renderImplicitSurfaceColor(QuantityStructure<S>* parent, std::string name, Func&& func,
                                                      FuncColor&& funcColor, ImplicitRenderOpts opts) {
 
-  // Bootstrap on the batch version
-  auto batchFunc = [&](std::vector<glm::vec3> inPos) {
-    std::vector<float> outVals(inPos.size());
-    for (size_t i = 0; i < inPos.size(); i++) {
-      outVals[i] = static_cast<float>(func(inPos[i]));
-    }
-    return outVals;
+  // Bootstrap on the batch version (which is called on one tile of rays at a time, so evaluate serially here)
+  auto batchFunc = [&](const std::vector<glm::vec3>& inPos) {
+    return evaluatePointwise<float>(inPos, func, false);
   };
 
-  auto batchFuncColor = [&](std::vector<glm::vec3> inPos) {
-    std::vector<glm::vec3> outVals(inPos.size());
-    for (size_t i = 0; i < inPos.size(); i++) {
-      outVals[i] = funcColor(inPos[i]);
-    }
-    return outVals;
+  auto batchFuncColor = [&](const std::vector<glm::vec3>& inPos) {
+    return evaluatePointwise<glm::vec3>(inPos, funcColor, opts.parallel);
   };
 
   return renderImplicitSurfaceColorBatch(parent, name, batchFunc, batchFuncColor, opts);
@@ -293,14 +261,99 @@ ColorRenderImageQuantity* renderImplicitSurfaceColorBatch(QuantityStructure<S>*
   }
 
 
-  // TODO check if there is an existing quantity of the same type/size to replace, and if so re-fill its buffers rather
-  // than creating a whole new one
+  // reuse an existing quantity of the same name and size if there is one, so repeated renders do not reallocate
+  // textures. here, we bypass the conversion adaptor since we have explicitly filled matching types
+  return addOrUpdateColorRenderImageQuantity(parent, name, dimXsub, dimYsub, rayDepthOut, normalOut, colorOut);
+}
 
-  // here, we bypass the conversion adaptor since we have explicitly filled matching types
-  return parent->addColorRenderImageQuantityImpl(name, dimXsub, dimYsub, rayDepthOut, normalOut, colorOut,
-                                                 ImageOrigin::UpperLeft);
+
+// =======================================================
+// === Progressive render functions
+// =======================================================
+
+// The progressive renderer outlives this call, so it finds the parent structure by name each time it publishes (in case
+// the structure has been removed in the meantime)
+template <class S>
+std::function<S*()> progressiveRenderParentLookup(QuantityStructure<S>* parent) {
+  std::string typeName = parent->typeName();
+  std::string structureName = parent->name;
+  return [typeName, structureName]() -> S* {
+    if (!hasStructure(typeName, structureName)) return nullptr;
+    return dynamic_cast<S*>(getStructure(typeName, structureName));
+  };
+}
+
+template <class Func>
+ImplicitBatchFunc progressiveRenderBatchFunc(Func&& func) {
+  typename std::decay<Func>::type funcCopy = func;
+  return [funcCopy](const std::vector<glm::vec3>& pos, std::vector<float>& vals) {
+    vals = evaluatePointwise<float>(pos, funcCopy, false);
+  };
 }
 
+template <class Func, class S>
+std::unique_ptr<ImplicitProgressiveRenderer> renderImplicitSurfaceProgressiveImpl(std::function<S*()> getParent,
+                                                                                  std::string name, Func&& func,
+                                                                                  ImplicitRenderOpts opts) {
+  auto publish = [getParent, name](const ImplicitRenderResult& result, const std::vector<glm::vec3>&) {
+    S* parent = getParent();
+    if (parent == nullptr) return;
+    addOrUpdateDepthRenderImageQuantity(parent, name, result.dimX, result.dimY, result.depth, result.normal);
+  };
+
+  return std::unique_ptr<ImplicitProgressiveRenderer>(new ImplicitProgressiveRenderer(
+      progressiveRenderBatchFunc(func), ImplicitColorBatchFunc(), publish, opts));
+}
+
+template <class Func, class FuncColor, class S>
+std::unique_ptr<ImplicitProgressiveRenderer>
+renderImplicitSurfaceColorProgressiveImpl(std::function<S*()> getParent, std::string name, Func&& func,
+                                          FuncColor&& funcColor, ImplicitRenderOpts opts) {
+  auto publish = [getParent, name](const ImplicitRenderResult& result, const std::vector<glm::vec3>& colors) {
+    S* parent = getParent();
+    if (parent == nullptr) return;
+    addOrUpdateColorRenderImageQuantity(parent, name, result.dimX, result.dimY, result.depth, result.normal, colors);
+  };
+
+  typename std::decay<FuncColor>::type funcColorCopy = funcColor;
+  bool parallel = opts.parallel;
+  ImplicitColorBatchFunc batchFuncColor = [funcColorCopy, parallel](const std::vector<glm::vec3>& pos,
+                                                                    std::vector<glm::vec3>& colors) {
+    colors = evaluatePointwise<glm::vec3>(pos, funcColorCopy, parallel);
+  };
+
+  return std::unique_ptr<ImplicitProgressiveRenderer>(
+      new ImplicitProgressiveRenderer(progressiveRenderBatchFunc(func), batchFuncColor, publish, opts));
+}
+
+template <class Func, class S>
+std::unique_ptr<ImplicitProgressiveRenderer> renderImplicitSurfaceProgressive(QuantityStructure<S>* parent,
+                                                                              std::string name, Func&& func,
+                                                                              ImplicitRenderOpts opts) {
+  return renderImplicitSurfaceProgressiveImpl(progressiveRenderParentLookup(parent), name, func, opts);
+}
+
+template <class Func>
+std::unique_ptr<ImplicitProgressiveRenderer> renderImplicitSurfaceProgressive(std::string name, Func&& func,
+                                                                              ImplicitRenderOpts opts) {
+  std::function<FloatingQuantityStructure*()> getParent = []() { return getGlobalFloatingQuantityStructure(); };
+  return renderImplicitSurfaceProgressiveImpl(getParent, name, func, opts);
+}
+
+template <class Func, class FuncColor, class S>
+std::unique_ptr<ImplicitProgressiveRenderer>
+renderImplicitSurfaceColorProgressive(QuantityStructure<S>* parent, std::string name, Func&& func,
+                                      FuncColor&& funcColor, ImplicitRenderOpts opts) {
+  return renderImplicitSurfaceColorProgressiveImpl(progressiveRenderParentLookup(parent), name, func, funcColor, opts);
+}
+
+template <class Func, class FuncColor>
+std::unique_ptr<ImplicitProgressiveRenderer> renderImplicitSurfaceColorProgressive(std::string name, Func&& func,
+                                                                                   FuncColor&& funcColor,
+                                                                                   ImplicitRenderOpts opts) {
+  std::function<FloatingQuantityStructure*()> getParent = []() { return getGlobalFloatingQuantityStructure(); };
+  return renderImplicitSurfaceColorProgressiveImpl(getParent, name, func, funcColor, opts);
+}
 
 // =======================================================
 // === Scalar surface render functions
@@ -324,21 +377,13 @@ ScalarRenderImageQuantity* renderImplicitSurfaceScalar(QuantityStructure<S>* par
                                                        FuncScalar&& funcScalar, ImplicitRenderOpts opts,
                                                        DataType dataType) {
 
-  // Bootstrap on the batch version
-  auto batchFunc = [&](std::vector<glm::vec3> inPos) {
-    std::vector<float> outVals(inPos.size());
-    for (size_t i = 0; i < inPos.size(); i++) {
-      outVals[i] = static_cast<float>(func(inPos[i]));
-    }
-    return outVals;
+  // Bootstrap on the batch version (which is called on one tile of rays at a time, so evaluate serially here)
+  auto batchFunc = [&](const std::vector<glm::vec3>& inPos) {
+    return evaluatePointwise<float>(inPos, func, false);
   };
 
-  auto batchFuncScalar = [&](std::vector<glm::vec3> inPos) {
-    std::vector<double> outVals(inPos.size());
-    for (size_t i = 0; i < inPos.size(); i++) {
-      outVals[i] = static_cast<double>(funcScalar(inPos[i]));
-    }
-    return outVals;
+  auto batchFuncScalar = [&](const std::vector<glm::vec3>& inPos) {
+    return evaluatePointwise<double>(inPos, funcScalar, opts.parallel);
   };
 
   return renderImplicitSurfaceScalarBatch(parent, name, batchFunc, batchFuncScalar, opts, dataType);
@@ -368,12 +413,10 @@ ScalarRenderImageQuantity* renderImplicitSurfaceScalarBatch(QuantityStructure<S>
   }
 
 
-  // TODO check if there is an existing quantity of the same type/size to replace, and if so re-fill its buffers rather
-  // than creating a whole new one
-
-  // here, we bypass the conversion adaptor since we have explicitly filled matching types
-  return parent->addScalarRenderImageQuantityImpl(name, dimXsub, dimYsub, rayDepthOut, normalOut, scalarOut,
-                                                  ImageOrigin::UpperLeft, dataType);
+  // reuse an existing quantity of the same name and size if there is one, so repeated renders do not reallocate
+  // textures. here, we bypass the conversion adaptor since we have explicitly filled matching types
+  return addOrUpdateScalarRenderImageQuantity(parent, name, dimXsub, dimYsub, rayDepthOut, normalOut, scalarOut,
+                                              dataType);
 }
 
 
@@ -9,6 +9,7 @@ namespace polyscope {
 
 // forward declaration
 class FloatingQuantityStructure;
+struct OcclusionDepthMap;
 
 
 namespace internal {
@@ -22,6 +23,17 @@ extern bool pointCloudEfficiencyWarningReported;
 
 extern FloatingQuantityStructure* globalFloatingQuantityStructure;
 
+// Depth of the last frame rendered in to the scene buffer, for occlusion culling (see options::enableOcclusionCulling).
+// currentOcclusionDepthMap() gives it only if culling is enabled, it was rendered from the current camera, and
+// occlusionCullingActive is set. That is only the case while rendering interactive frames, which can be redrawn if the
+// map turns out to be stale, and not for one-off renders like screenshots.
+extern OcclusionDepthMap occlusionDepthMap;
+extern bool occlusionCullingActive;
+extern size_t occlusionCulledCount; // structures and blocks skipped by occlusion culling, since the last render
+const OcclusionDepthMap* currentOcclusionDepthMap();
+
+extern uint64_t drawCount; // number of times the scene has been drawn, so per-frame work can tell frames apart
+
 
 } // namespace internal
 } // namespace polyscope
@@ -0,0 +1,49 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace polyscope {
+
+class SurfaceMesh;
+class VolumeMesh;
+
+// =======================================================
+// === Mesh file loading
+// =======================================================
+
+// Readers for OBJ, PLY (ascii and binary) and Medit .mesh files. The file is memory-mapped and split in to chunks which
+// are parsed on parallel threads (see parallel.h), and faces are written straight in to the flat arrays the structures
+// store, so no per-face allocations are made along the way.
+
+// The contents of a mesh file. Faces are in the same flattened form as SurfaceMesh::faceIndsEntries/faceIndsStart: the
+// vertices of face i are faceIndsEntries[faceIndsStart[i]] to faceIndsEntries[faceIndsStart[i+1]-1].
+struct MeshFileData {
+  std::vector<glm::vec3> vertexPositions;
+  std::vector<uint32_t> faceIndsEntries;
+  std::vector<uint32_t> faceIndsStart{0};
+
+  // Volume cells as in VolumeMesh, tets padded with INVALID_IND_32 (.mesh files only)
+  std::vector<std::array<uint32_t, 8>> cells;
+
+  size_t nFaces() const { return faceIndsStart.size() - 1; }
+};
+
+// Read a mesh file, detecting the format from the extension. Throws if the file cannot be read or is malformed.
+MeshFileData readMeshFile(std::string filename);
+
+MeshFileData readMeshFileOBJ(std::string filename);     // positions and faces, other data is ignored
+MeshFileData readMeshFilePLY(std::string filename);     // the "vertex" element's x,y,z and "face" element's indices
+MeshFileData readMeshFileDotMesh(std::string filename); // vertices, triangles, quads, tets and hexes
+
+// Read a mesh file and register its contents, moving the arrays in to the new structure
+SurfaceMesh* loadSurfaceMesh(std::string name, std::string filename);
+VolumeMesh* loadVolumeMesh(std::string name, std::string filename);
+
+} // namespace polyscope
@@ -47,6 +47,24 @@ extern bool autoscaleStructures;
 // bounding box and length scale manually. (default: true)
 extern bool automaticallyComputeSceneExtents;
 
+// If true, structures do not compute their bounding box and length scale when they are created, only once something
+// (like updateStructureExtents()) asks for them. Position updates always defer this work. Useful for very large
+// structures, particularly with automaticallyComputeSceneExtents = false. (default: false)
+extern bool deferStructureBounds;
+
+// Skip drawing structures, and blocks of large point clouds and meshes, which are outside of the view frustum. Structures
+// whose geometry is being updated every frame are not culled, to avoid recomputing their bounds. (default: true)
+extern bool enableViewCulling;
+
+// Also skip structures and blocks which were hidden behind other geometry in the depth buffer of the last frame, when
+// the camera has not moved since. Reading back the depth costs a GPU sync on each render, so this pays off only for
+// heavily occluded scenes. Requires enableViewCulling, and applies only without transparency. (default: false)
+extern bool enableOcclusionCulling;
+
+// Maximum number of threads used for parallel CPU work, such as computing bounds. 0 means use all hardware threads.
+// (default: 0)
+extern int maxThreads;
+
 // If true, the user callback will be invoked for nested calls to polyscope::show(), otherwise not (default: false)
 extern bool invokeUserCallbackForNestedShow;
 
@@ -66,6 +84,7 @@ extern bool screenshotTransparency;     // controls whether screenshots taken by
                                         // transparent background
 extern std::string screenshotExtension; // sets the extension used for automatically-numbered screenshots (e.g. by
                                         // clicking the GUI button)
+extern int maxPendingScreenshots; // screenshotAsync() blocks while this many images are waiting to be written
 
 // === Rendering parameters
 
@@ -76,6 +95,12 @@ extern int ssaaFactor;
 extern TransparencyMode transparencyMode;
 extern int transparencyRenderPasses;
 
+// If true, structures and quantities created afterward store some render buffers in compact formats: point cloud and
+// surface mesh positions as 16-bit fixed point within their bounding box, surface mesh normals octahedral-encoded in two
+// 16-bit values, and color quantities with 8 bits per channel (clamped to [0,1]). These buffers take 2-3x less GPU
+// memory and upload time, at some cost in precision; host-side data is unaffected. (default: false)
+extern bool compactRenderBuffers;
+
 // === Advanced ImGui configuration
 
 // If false, Polyscope will not create any ImGui UIs at all, but will still set up ImGui and invoke its render steps
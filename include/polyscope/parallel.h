@@ -0,0 +1,23 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace polyscope {
+
+// Number of threads used for parallel work, according to options::maxThreads and the hardware
+size_t parallelThreadCount();
+
+// Number of chunks that parallelForChunks() splits [0, n) in to
+size_t parallelChunkCount(size_t n, size_t chunkSize);
+
+// Split the range [0, n) in to contiguous chunks of chunkSize entries (the last may be shorter), and call
+// func(iChunk, start, end) once for each. Chunks are handed out in order to the calling thread and a persistent pool of
+// worker threads (started on first use), or processed on the calling thread alone if there is only one chunk or one
+// thread. The call returns once all chunks are done; if any call throws, the first exception is rethrown on the calling
+// thread. It may be called from several threads at once, and from inside func.
+void parallelForChunks(size_t n, size_t chunkSize, const std::function<void(size_t, size_t, size_t)>& func);
+
+} // namespace polyscope
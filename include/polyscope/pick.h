@@ -22,6 +22,10 @@ size_t requestPickBufferRange(Structure* requestingStructure, size_t count);
 // that 0 is the first index as returned from requestPickBufferRange())
 std::pair<Structure*, size_t> evaluatePickQuery(int xPos, int yPos);
 
+// Render all structures to render::engine->pickFramebuffer at the current buffer size. Returns false if the buffer
+// could not be bound (e.g. because it has zero size).
+bool renderPickBuffer();
+
 
 // == Stateful picking: track and update a current selection
 
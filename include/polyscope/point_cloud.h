@@ -44,6 +44,9 @@ public:
   // Construct a new point cloud structure
   PointCloud(std::string name, std::vector<glm::vec3> points);
 
+  // Re-create a point cloud written by writeToSceneFile() (see scene_file.h)
+  static PointCloud* createFromSceneFile(const SceneFileReader& reader, const std::string& prefix, std::string name);
+
   // === Overrides
 
   // Build the imgui display
@@ -56,8 +59,11 @@ public:
   virtual void drawDelayed() override;
   virtual void drawPick() override;
   virtual void updateObjectSpaceBounds() override;
+  virtual bool isCullable() override;
+  virtual float cullingMargin() override;
   virtual std::string typeName() override;
   virtual void refresh() override;
+  virtual bool writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) override;
 
   // === Geometry members
   render::ManagedBuffer<glm::vec3> points;
@@ -94,6 +100,32 @@ public:
   template <class V>
   void updatePointPositions2D(const V& newPositions);
 
+  // Update the positions of the points [start, start + newPositions.size()). Only that range is uploaded, and the
+  // bounds are grown to contain the new positions (but do not shrink).
+  template <class V>
+  void updatePointPositionsRange(size_t start, const V& newPositions);
+
+  // === Streaming
+
+  // Append new points to the cloud. Only the new entries are uploaded, in to render buffers which grow geometrically,
+  // and the bounds are grown incrementally. Each quantity is padded with default values for the new points; call its
+  // appendData() right after this to supply the actual values.
+  // If a maximum stream size is set, the cloud acts as a ring buffer: once it is full, new points overwrite the oldest
+  // ones, and point indices refer to slots in the ring rather than to arrival order.
+  template <class V>
+  void appendPoints(const V& newPositions);
+
+  // The maximum number of points kept while streaming. 0 (the default) means no limit. Cannot be set smaller than the
+  // current number of points.
+  PointCloud* setMaxStreamSize(size_t newVal);
+  size_t getMaxStreamSize();
+
+  // Used by quantities: write values for the points added by the last appendPoints() call in to a buffer. `values` must
+  // have nAppendedPoints() entries.
+  template <typename T>
+  void writeAppendedValues(render::ManagedBuffer<T>& buffer, const std::vector<T>& values);
+  size_t nAppendedPoints();
+
   // === Set point size from a scalar quantity
   // effect is multiplicative with pointRadius
   // negative values are always clamped to 0
@@ -157,6 +189,30 @@ private:
   std::shared_ptr<render::ShaderProgram> program;
   std::shared_ptr<render::ShaderProgram> pickProgram;
 
+  // Pick colors live in a buffer so they can grow with appended points. The pick range may have spare capacity
+  // beyond nPoints() for the same reason.
+  std::vector<glm::vec3> pickColorsData;
+  render::ManagedBuffer<glm::vec3> pickColors;
+  size_t pickStart = 0;
+  size_t pickCapacity = 0;
+
+  // View culling of blocks of points. Boxes are kept up to date with the bounds; the visible ranges are recomputed at
+  // each draw and applied to every program which draws the points.
+  std::vector<std::tuple<glm::vec3, glm::vec3>> cullingBlockBoxes;
+  std::vector<std::pair<size_t, size_t>> visibleDrawRanges;
+  bool useVisibleDrawRanges = false;
+  bool pointRadiiAreBounded();
+  void updateVisibleDrawRanges();
+
+  // Streaming state
+  size_t maxStreamSize = 0;
+  size_t streamNextSlot = 0;       // once the ring is full, the slot that the next appended point overwrites
+  size_t streamLastAppendSize = 0; // number of points passed to the last appendPoints() call
+  std::vector<std::tuple<size_t, size_t, size_t>> streamLastAppendRanges; // (source offset, first slot, count)
+  void appendPointsImpl(const std::vector<glm::vec3>& newPositions);
+  void updatePointPositionsRangeImpl(size_t start, const std::vector<glm::vec3>& newPositions);
+  void expandObjectSpaceBounds(const std::vector<glm::vec3>& newPositions);
+
   // === Helpers
   // Do setup work related to drawing, including allocating openGL data
   void ensureRenderProgramPrepared();
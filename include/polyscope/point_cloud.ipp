@@ -38,6 +38,12 @@ void PointCloud::updatePointPositions(const V& newPositions) {
   validateSize(newPositions, nPoints(), "point cloud updated positions " + name);
   points.data = standardizeVectorArray<glm::vec3, 3>(newPositions);
   points.markHostBufferUpdated();
+  markObjectSpaceBoundsStale();
+}
+
+template <class V>
+void PointCloud::updatePointPositionsRange(size_t start, const V& newPositions) {
+  updatePointPositionsRangeImpl(start, standardizeVectorArray<glm::vec3, 3>(newPositions));
 }
 
 template <class V>
@@ -52,6 +58,36 @@ void PointCloud::updatePointPositions2D(const V& newPositions2D) {
   updatePointPositions(positions3D);
 }
 
+template <class V>
+void PointCloud::appendPoints(const V& newPositions) {
+  appendPointsImpl(standardizeVectorArray<glm::vec3, 3>(newPositions));
+}
+
+template <typename T>
+void PointCloud::writeAppendedValues(render::ManagedBuffer<T>& buffer, const std::vector<T>& values) {
+  if (values.size() != streamLastAppendSize) {
+    exception("point cloud " + name + " appended values for " + buffer.name + " have size " +
+              std::to_string(values.size()) + ", but " + std::to_string(streamLastAppendSize) +
+              " points were appended");
+  }
+
+  buffer.ensureHostBufferPopulated();
+
+  // Grow first, then write and upload each range
+  size_t newSize = buffer.data.size();
+  for (const std::tuple<size_t, size_t, size_t>& range : streamLastAppendRanges) {
+    newSize = std::max(newSize, std::get<1>(range) + std::get<2>(range));
+  }
+  buffer.data.resize(newSize);
+
+  for (const std::tuple<size_t, size_t, size_t>& range : streamLastAppendRanges) {
+    size_t srcStart, dstStart, count;
+    std::tie(srcStart, dstStart, count) = range;
+    std::copy(values.begin() + srcStart, values.begin() + srcStart + count, buffer.data.begin() + dstStart);
+    buffer.markHostBufferRangeUpdated(dstStart, count);
+  }
+}
+
 
 // Shorthand to get a point cloud from polyscope
 inline PointCloud* getPointCloud(std::string name) {
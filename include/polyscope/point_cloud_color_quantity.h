@@ -23,6 +23,12 @@ public:
 
   virtual std::string niceName() override;
 
+  // Streaming: colors for the points added by the last PointCloud::appendPoints()
+  template <class V>
+  void appendData(const V& newColors);
+  virtual void appendDefaultData() override;
+  void appendDataImpl(const std::vector<glm::vec3>& newColors);
+
   // === Members
 
 protected:
@@ -32,4 +38,9 @@ protected:
 };
 
 
+template <class V>
+void PointCloudColorQuantity::appendData(const V& newColors) {
+  appendDataImpl(standardizeVectorArray<glm::vec3, 3>(newColors));
+}
+
 } // namespace polyscope
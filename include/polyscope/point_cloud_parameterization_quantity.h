@@ -22,6 +22,12 @@ public:
   virtual void refresh() override;
   virtual std::string niceName() override;
 
+  // Streaming: coordinates for the points added by the last PointCloud::appendPoints()
+  template <class V>
+  void appendData(const V& newCoords);
+  virtual void appendDefaultData() override;
+  void appendDataImpl(const std::vector<glm::vec2>& newCoords);
+
 
 protected:
   std::shared_ptr<render::ShaderProgram> program;
@@ -32,4 +38,9 @@ protected:
 };
 
 
+template <class V>
+void PointCloudParameterizationQuantity::appendData(const V& newCoords) {
+  appendDataImpl(standardizeVectorArray<glm::vec2, 2>(newCoords));
+}
+
 } // namespace polyscope
@@ -18,6 +18,9 @@ public:
 
   // Build GUI info about a point
   virtual void buildInfoGUI(size_t pointInd);
+
+  // Called after the parent appends points, fills this quantity's values for the new points with a default
+  virtual void appendDefaultData();
 };
 
 
@@ -26,6 +26,12 @@ public:
 
   virtual std::string niceName() override;
 
+  // Streaming: values for the points added by the last PointCloud::appendPoints()
+  template <class V>
+  void appendData(const V& newValues);
+  virtual void appendDefaultData() override;
+  void appendDataImpl(const std::vector<double>& newValues);
+
 protected:
   void createProgram();
 
@@ -33,4 +39,9 @@ protected:
 };
 
 
+template <class V>
+void PointCloudScalarQuantity::appendData(const V& newValues) {
+  appendDataImpl(standardizeArray<double, V>(newValues));
+}
+
 } // namespace polyscope
@@ -19,6 +19,18 @@ public:
   virtual void buildPickUI(size_t ind) override;
   virtual std::string niceName() override;
   virtual void refresh() override;
+  virtual bool drawsOutsideStructureBounds() override;
+
+  // Streaming: vectors for the points added by the last PointCloud::appendPoints()
+  template <class V>
+  void appendData(const V& newVectors);
+  virtual void appendDefaultData() override;
+  void appendDataImpl(const std::vector<glm::vec3>& newVectors);
 };
 
+template <class V>
+void PointCloudVectorQuantity::appendData(const V& newVectors) {
+  appendDataImpl(standardizeVectorArray<glm::vec3, 3>(newVectors));
+}
+
 } // namespace polyscope
@@ -48,6 +48,10 @@ public:
   virtual std::string niceName();
   std::string uniquePrefix();
 
+  // Does this quantity draw anything outside of its parent structure's bounds (like vectors sticking out of it)? If so,
+  // the structure cannot be culled while the quantity is enabled.
+  virtual bool drawsOutsideStructureBounds();
+
   // === Member variables ===
   Structure& parent;      // the parent structure with which this quantity is associated
   const std::string name; // a name for this quantity, which must be unique amongst quantities on `parent`
@@ -0,0 +1,208 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include "polyscope/file_helpers.h"
+#include "polyscope/widget.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace polyscope {
+
+class Structure;
+class PointCloud;
+class SurfaceMesh;
+class CurveNetwork;
+
+// =======================================================
+// === Frame sources
+// =======================================================
+
+// A series of frames of float values, all of the same length, e.g. one frame per timestep of a simulation.
+// Vector-valued data (positions, colors, vectors) is stored as 3 consecutive floats per element.
+class FrameSource {
+public:
+  virtual ~FrameSource();
+
+  virtual size_t frameCount() = 0;
+  virtual size_t frameSize() = 0; // number of floats in each frame
+
+  // Copy frame iFrame in to out. This is called from a prefetch thread, so it must be safe to call concurrently with
+  // the other functions.
+  virtual void readFrame(size_t iFrame, std::vector<float>& out) = 0;
+
+  // Hint that frame iFrame will be read soon (does nothing by default)
+  virtual void willReadFrame(size_t iFrame);
+};
+
+// Frames which are already in memory
+class MemoryFrameSource : public FrameSource {
+public:
+  MemoryFrameSource(std::vector<std::vector<float>> frames);
+
+  virtual size_t frameCount() override;
+  virtual size_t frameSize() override;
+  virtual void readFrame(size_t iFrame, std::vector<float>& out) override;
+
+private:
+  const std::vector<std::vector<float>> frames;
+};
+
+// Frames stored back-to-back as raw float32 values (in native byte order) in a file, starting headerBytes in to the
+// file. The file is memory-mapped, so frames are read from disk only as they are needed.
+class MappedFileFrameSource : public FrameSource {
+public:
+  MappedFileFrameSource(std::string filename, size_t frameSize, size_t headerBytes = 0);
+
+  virtual size_t frameCount() override;
+  virtual size_t frameSize() override;
+  virtual void readFrame(size_t iFrame, std::vector<float>& out) override;
+  virtual void willReadFrame(size_t iFrame) override;
+
+private:
+  MemoryMappedFile file;
+  const size_t nValues;
+  const size_t headerBytes;
+  size_t nFrames;
+};
+
+// =======================================================
+// === Sequences and the timeline
+// =======================================================
+
+// One quantity (or structure's positions) following a FrameSource. Frames are held in a small LRU cache, which a
+// prefetch thread fills with the upcoming frames, so showing a frame is usually just the upload of a cached frame.
+// Created through the Timeline below.
+class QuantitySequence {
+public:
+  // Shows a frame in the target quantity. Returns false if the target no longer exists.
+  using ApplyFunc = std::function<bool(const std::vector<float>& frame)>;
+
+  QuantitySequence(std::string name, std::shared_ptr<FrameSource> source, ApplyFunc apply, size_t cacheFrames);
+  ~QuantitySequence();
+
+  // No copy constructor/assignment
+  QuantitySequence(const QuantitySequence&) = delete;
+  QuantitySequence& operator=(const QuantitySequence&) = delete;
+
+  const std::string name;
+  size_t frameCount();
+
+  // Show the frame in the target, reading it right away if it is not cached. Returns false if the target is gone.
+  bool showFrame(size_t iFrame);
+
+  bool isCached(size_t iFrame);
+  size_t cachedFrameCount();
+
+  // Replace the list of frames for the prefetch thread to load, in order
+  void prefetch(const std::vector<size_t>& frames);
+
+private:
+  std::shared_ptr<FrameSource> source;
+  ApplyFunc apply;
+  const size_t cacheFrames;
+
+  struct CachedFrame {
+    size_t iFrame;
+    uint64_t lastUsed;
+    std::shared_ptr<const std::vector<float>> values; // shared with a showFrame() in progress
+  };
+
+  std::mutex mutex;
+  std::condition_variable queueChanged;
+  std::vector<CachedFrame> cache;
+  std::deque<size_t> prefetchQueue;
+  uint64_t useCounter = 0;
+  bool stopping = false;
+  std::thread prefetchThread;
+
+  CachedFrame* findCached(size_t iFrame); // must hold the mutex
+  CachedFrame& insertCached(size_t iFrame, std::vector<float>&& values); // must hold the mutex
+  void prefetchWork();
+};
+
+// A set of sequences played back together, with a small window to play/pause and scrub through the frames. The
+// timeline must be kept alive for as long as the sequences should play. Playback advances once per polyscope frame at
+// up to the requested rate, and waits for a frame to be loaded rather than skipping it, so playing from disk is limited
+// by the speed of the disk.
+class Timeline : public Widget {
+public:
+  Timeline(std::string name = "Timeline", size_t cacheFrames = 16);
+  ~Timeline();
+
+  const std::string name;
+
+  // == Sequences
+  // Each frame must hold one value (scalars) or three floats (positions, colors, vectors) per element of the target.
+  // The targets are looked up by name each time a frame is shown, and are skipped if they have since been removed.
+  // Sequences are named after their target, as "<structure type>/<structure name>" for positions, with
+  // "/<quantity name>" added for quantities (see sequenceTargetName()).
+
+  QuantitySequence* addPositionSequence(PointCloud* cloud, std::shared_ptr<FrameSource> source);
+  QuantitySequence* addPositionSequence(SurfaceMesh* mesh, std::shared_ptr<FrameSource> source);
+  QuantitySequence* addPositionSequence(CurveNetwork* curveNetwork, std::shared_ptr<FrameSource> source);
+  template <class Q>
+  QuantitySequence* addScalarSequence(Q* quantity, std::shared_ptr<FrameSource> source);
+  template <class Q>
+  QuantitySequence* addColorSequence(Q* quantity, std::shared_ptr<FrameSource> source);
+  template <class Q>
+  QuantitySequence* addVectorSequence(Q* quantity, std::shared_ptr<FrameSource> source);
+
+  // General form, for other targets
+  QuantitySequence* addSequence(std::string name, std::shared_ptr<FrameSource> source,
+                                QuantitySequence::ApplyFunc apply);
+  void removeSequence(std::string name, bool errorIfAbsent = false);
+  void removeAllSequences();
+
+  // == Playback
+
+  size_t frameCount(); // of the shortest sequence
+  void setFrame(size_t iFrame); // show the frame in all sequences now
+  size_t getFrame();
+  void setPlaying(bool newPlaying);
+  bool isPlaying();
+  void setFramesPerSecond(double newFPS);
+  double getFramesPerSecond();
+  void setLoop(bool newLoop);
+  bool getLoop();
+
+  virtual void buildGUI() override; // advances playback, and builds the window
+
+private:
+  const size_t cacheFrames;
+  std::vector<std::unique_ptr<QuantitySequence>> sequences;
+  size_t currFrame = 0;
+  bool playing = false;
+  double framesPerSecond = 30.;
+  bool loop = true;
+  std::chrono::steady_clock::time_point lastFrameTime;
+
+  size_t nextFrame(size_t iFrame); // the frame after iFrame, or iFrame if there is none
+  void prefetchFrom(size_t iFrame);
+  void advancePlayback();
+};
+
+// Helpers for the templated functions above: checks that a frame holds valuesPerElement values per element, and the
+// name of a sequence on a structure (including its type, so structures of different types can share a name)
+void checkSequenceFrameSize(FrameSource& source, size_t nElements, size_t valuesPerElement, std::string targetName);
+std::string sequenceTargetName(Structure& structure);
+
+// Bracket-indexed view of a frame of floats as 3-vectors, so frames go straight in to the usual update functions
+struct Vec3FrameView {
+  const std::vector<float>& values;
+  size_t size() const { return values.size() / 3; }
+  const float* operator[](size_t i) const { return &values[3 * i]; }
+};
+
+} // namespace polyscope
+
+#include "polyscope/quantity_sequence.ipp"
@@ -0,0 +1,63 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/polyscope.h"
+
+#include <type_traits>
+
+namespace polyscope {
+
+// Returns a function which finds the quantity again by name, or returns null if it (or its structure) has been removed
+template <class Q>
+std::function<Q*()> sequenceQuantityLookup(Q* quantity) {
+  using S = typename std::remove_reference<decltype(quantity->parent)>::type;
+  std::string typeName = quantity->parent.typeName();
+  std::string structureName = quantity->parent.name;
+  std::string quantityName = quantity->name;
+  return [=]() -> Q* {
+    if (!hasStructure(typeName, structureName)) return nullptr;
+    S* structure = dynamic_cast<S*>(getStructure(typeName, structureName));
+    if (structure == nullptr) return nullptr;
+    return dynamic_cast<Q*>(structure->getQuantity(quantityName));
+  };
+}
+
+template <class Q>
+QuantitySequence* Timeline::addScalarSequence(Q* quantity, std::shared_ptr<FrameSource> source) {
+  std::string targetName = sequenceTargetName(quantity->parent) + "/" + quantity->name;
+  checkSequenceFrameSize(*source, quantity->values.size(), 1, targetName);
+  std::function<Q*()> lookup = sequenceQuantityLookup(quantity);
+  return addSequence(targetName, source, [lookup](const std::vector<float>& frame) {
+    Q* q = lookup();
+    if (q == nullptr) return false;
+    q->updateData(frame);
+    return true;
+  });
+}
+
+template <class Q>
+QuantitySequence* Timeline::addColorSequence(Q* quantity, std::shared_ptr<FrameSource> source) {
+  std::string targetName = sequenceTargetName(quantity->parent) + "/" + quantity->name;
+  checkSequenceFrameSize(*source, quantity->colors.size(), 3, targetName);
+  std::function<Q*()> lookup = sequenceQuantityLookup(quantity);
+  return addSequence(targetName, source, [lookup](const std::vector<float>& frame) {
+    Q* q = lookup();
+    if (q == nullptr) return false;
+    q->updateData(Vec3FrameView{frame});
+    return true;
+  });
+}
+
+template <class Q>
+QuantitySequence* Timeline::addVectorSequence(Q* quantity, std::shared_ptr<FrameSource> source) {
+  std::string targetName = sequenceTargetName(quantity->parent) + "/" + quantity->name;
+  checkSequenceFrameSize(*source, quantity->vectors.size(), 3, targetName);
+  std::function<Q*()> lookup = sequenceQuantityLookup(quantity);
+  return addSequence(targetName, source, [lookup](const std::vector<float>& frame) {
+    Q* q = lookup();
+    if (q == nullptr) return false;
+    q->updateData(Vec3FrameView{frame});
+    return true;
+  });
+}
+
+} // namespace polyscope
@@ -0,0 +1,66 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/type_precision.hpp"
+
+#include "polyscope/render/color_maps.h"
+
+namespace polyscope {
+namespace render {
+
+// Applies colormaps to scalar values on the CPU, the same way the SHADE_COLORMAP_VALUE and ISOLINE_STRIPE_VALUECOLOR
+// shader rules do, e.g. to bake vertex colors or export them. The colormap is resampled once in to a table, and values
+// are mapped in blocks: a branch-free pass computes table indices (which compilers vectorize), then a second pass copies
+// out the colors. Large arrays are split across threads (see parallel.h).
+
+// How values are mapped to colors, as set on a ScalarQuantity
+struct ColorMapParams {
+  std::pair<double, double> range{0., 1.}; // values mapped to the ends of the colormap, others are clamped
+  bool isolinesEnabled = false;
+  double isolineWidth = 0.;    // absolute, in data units
+  double isolineDarkness = 1.; // multiplies the color on every second stripe
+};
+
+class ColorMapLUT {
+public:
+  static const size_t defaultResolution = 4096;
+
+  // Resample a colormap at `resolution` evenly spaced points in [0,1]
+  explicit ColorMapLUT(const ValueColorMap& cmap, size_t resolution = defaultResolution);
+
+  // Color of t in [0,1] (clamped), from the nearest table entry. Non-finite values are black, like
+  // ValueColorMap::getValue().
+  glm::vec3 sample(double t) const;
+
+  // Map n values to colors. 8-bit colors are rounded from the float colors.
+  void mapValues(const double* values, size_t n, const ColorMapParams& params, glm::vec3* out) const;
+  void mapValues(const double* values, size_t n, const ColorMapParams& params, glm::u8vec3* out) const;
+  std::vector<glm::vec3> mapValues(const std::vector<double>& values, const ColorMapParams& params) const;
+  std::vector<glm::u8vec3> mapValuesRGB8(const std::vector<double>& values, const ColorMapParams& params) const;
+
+  std::string name;
+  size_t resolution() const { return table.size() - 1; }
+
+private:
+  std::vector<glm::vec3> table; // resolution() samples, then black for non-finite values
+
+  template <typename C>
+  void mapValuesImpl(const double* values, size_t n, const ColorMapParams& params, C* out) const;
+};
+
+// One-off helpers, resampling the colormap on each call
+std::vector<glm::vec3> applyColorMap(const ValueColorMap& cmap, const std::vector<double>& values,
+                                     const ColorMapParams& params);
+std::vector<glm::u8vec3> applyColorMapRGB8(const ValueColorMap& cmap, const std::vector<double>& values,
+                                           const ColorMapParams& params);
+
+} // namespace render
+} // namespace polyscope
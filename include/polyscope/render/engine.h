@@ -13,6 +13,7 @@
 #include "polyscope/types.h"
 #include "polyscope/view.h"
 
+#include "glm/gtc/type_precision.hpp"
 #include "imgui.h"
 
 namespace polyscope {
@@ -23,6 +24,7 @@ namespace polyscope {
 // The drawing modes available
 enum class DrawMode {
   Points = 0,
+  IndexedPoints,
   LinesAdjacency,
   Triangles,
   TrianglesAdjacency,
@@ -50,13 +52,25 @@ enum class RenderDataType {
   Index,
   Vector2UInt,
   Vector3UInt,
-  Vector4UInt
+  Vector4UInt,
+  Vector3UShortNorm, // compact formats, read by shaders as floats (see BufferQuantization)
+  Vector4UByteNorm,
+  Vector2ShortNorm
+};
+
+// Compact device-side storage for vec3 data, at some loss of precision (see ManagedBuffer::setDeviceQuantization())
+enum class BufferQuantization {
+  None = 0,
+  UNorm16InBounds, // 16-bit fixed point within the data's bounding box, for positions (Vector3UShortNorm)
+  UNorm8,          // 8 bits per channel, for colors in [0,1] (Vector4UByteNorm, the 4th byte is padding)
+  Octahedral16     // octahedral map to two 16-bit values, for unit normals (Vector2ShortNorm)
 };
 
 int dimension(const TextureFormat& x);
 std::string modeName(const TransparencyMode& m);
 std::string renderDataTypeName(const RenderDataType& r);
 int renderDataTypeCountCompatbility(const RenderDataType r1, const RenderDataType r2);
+bool isNormalizedRenderDataType(const RenderDataType r); // integer formats which shaders read as floats
 std::string getImageOriginRule(ImageOrigin imageOrigin);
 
 namespace render {
@@ -78,6 +92,11 @@ public:
   virtual void setData(const std::vector<glm::uvec3>& data) = 0;
   virtual void setData(const std::vector<glm::uvec4>& data) = 0;
 
+  // Compact normalized formats
+  virtual void setData(const std::vector<glm::u16vec3>& data) = 0;
+  virtual void setData(const std::vector<glm::u8vec4>& data) = 0;
+  virtual void setData(const std::vector<glm::i16vec2>& data) = 0;
+
   // Array-valued attributes
   // (adding these lazily as we need them)
   // (sadly we cannot template the virtual function)
@@ -85,6 +104,33 @@ public:
   virtual void setData(const std::vector<std::array<glm::vec3, 3>>& data) = 0;
   virtual void setData(const std::vector<std::array<glm::vec3, 4>>& data) = 0;
 
+  // Partial updates, for data which is appended or overwritten a piece at a time. `data` is the full array, which may
+  // have grown since the last set; only the entries [start, start+count) are uploaded. The device allocation grows
+  // geometrically, so a sequence of appends only occasionally needs to re-upload everything.
+  // (not supported for array-valued attributes)
+  virtual void setDataRange(const std::vector<glm::vec2>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<glm::vec3>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<glm::vec4>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<float>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<double>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<int32_t>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<uint32_t>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<glm::uvec2>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<glm::uvec3>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<glm::uvec4>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<glm::u16vec3>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<glm::u8vec4>& data, size_t start, size_t count) = 0;
+  virtual void setDataRange(const std::vector<glm::i16vec2>& data, size_t start, size_t count) = 0;
+
+  // True if setDataRange() for an array of newSize entries must reallocate, and so needs all of the data
+  virtual bool setDataRangeReallocates(size_t newSize) = 0;
+
+  // Like setDataRange(), but given only the entries [start, start+rangeData.size()) of an array of newSize entries, for
+  // data which is converted before upload. Only valid when setDataRangeReallocates(newSize) is false.
+  virtual void setDataSubrange(const std::vector<glm::u16vec3>& rangeData, size_t start, size_t newSize) = 0;
+  virtual void setDataSubrange(const std::vector<glm::u8vec4>& rangeData, size_t start, size_t newSize) = 0;
+  virtual void setDataSubrange(const std::vector<glm::i16vec2>& rangeData, size_t start, size_t newSize) = 0;
+
   virtual uint32_t getNativeBufferID() = 0; // used to interop with external things, e.g. ImGui
 
   // == Getters
@@ -151,6 +197,12 @@ public:
   virtual std::vector<glm::vec2> getDataVector2() = 0;
   virtual std::vector<glm::vec3> getDataVector3() = 0;
 
+  // Overwrite the texture contents in place (with the same conventions as above). The data must have one entry per
+  // texel; use resize() first to change the size.
+  virtual void setData(const std::vector<float>& data) = 0;
+  virtual void setData(const std::vector<glm::vec2>& data) = 0;
+  virtual void setData(const std::vector<glm::vec3>& data) = 0;
+
   // Set texture data
   // void fillTextureData1D(std::string name, unsigned char* texData, unsigned int length);
   // void fillTextureData2D(std::string name, unsigned char* texData, unsigned int width, unsigned int height,
@@ -228,6 +280,9 @@ public:
   virtual float readDepth(int xPos, int yPos) = 0;
   virtual void blitTo(FrameBuffer* other) = 0;
   virtual std::vector<unsigned char> readBuffer() = 0;
+  virtual void readBuffer(std::vector<unsigned char>& buff) = 0; // resizes buff, reusing its storage when possible
+  virtual void readFloat4Buffer(std::vector<float>& buff) = 0;   // all pixels of a Float4 color buffer, like readBuffer()
+  virtual void readDepthBuffer(std::vector<float>& buff) = 0;    // all pixels of the depth buffer, like readBuffer()
 
   uint64_t getUniqueID() const { return uniqueID; }
 
@@ -372,6 +427,11 @@ public:
   // Draw!
   virtual void draw() = 0;
 
+  // Restrict drawing to some ranges of the data, as (start, count) pairs of vertices (or of indices, for indexed draw
+  // modes). Used for culling. An empty list draws nothing; clearDrawRanges() goes back to drawing everything.
+  void setDrawRanges(const std::vector<std::pair<size_t, size_t>>& ranges);
+  void clearDrawRanges();
+
   virtual void validateData() = 0;
 
   uint64_t getUniqueID() const { return uniqueID; }
@@ -390,6 +450,10 @@ protected:
   bool primitiveRestartIndexSet = false;
   unsigned int restartIndex = -1;
   uint64_t uniqueID;
+
+  // Optional subset of the data to draw
+  bool useDrawRanges = false;
+  std::vector<std::pair<size_t, size_t>> drawRanges;
 };
 
 
@@ -414,6 +478,7 @@ public:
   virtual bool bindSceneBuffer();
   virtual void resizeScreenBuffers(); // applies to all buffers tied to display size
   virtual void setScreenBufferViewports();
+  void ensureScreenBufferSizes(); // resize and set viewports only if the buffers do not match the display size
   virtual void
   applyLightingTransform(std::shared_ptr<TextureBuffer>& texture); // tonemap and gamma correct, render to active buffer
   void updateMinDepthTexture();
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "polyscope/render/engine.h"
+#include "polyscope/render/quantization.h"
 
 namespace polyscope {
 namespace render {
@@ -78,6 +79,10 @@ public:
   // updates to the render buffer.
   void markHostBufferUpdated();
 
+  // Like markHostBufferUpdated(), but only the entries [start, start+count) of `data` have changed. The `data` may also
+  // have grown, e.g. when appending new values. Only that range is uploaded to the render buffer (if there is one).
+  void markHostBufferRangeUpdated(size_t start, size_t count);
+
   // Get the value at index `i`. It may be dynamically fetched from either the cpu-side `data` member or the render
   // buffer, depending on where the data currently lives.
   // If the data lives only on the device-side render buffer, this function is expensive, so don't call it in a loop.
@@ -90,6 +95,10 @@ public:
   bool hasData(); // true if there is valid data on either the host or device
   size_t size();  // size of the data (number of entries)
 
+  // Incremented every time the data is updated (through any of the mark*Updated() functions, or a recompute), so
+  // anything derived from the data can cheaply check whether it is out of date.
+  uint64_t getDataVersion() const;
+
   // == Direct access to the GPU (device-side) render buffer
 
   // NOTE: This class follows the policy that once the render buffer is allocated, it is always immediately kept updated
@@ -120,20 +129,42 @@ public:
   // same view will be returned repeatedly at no additional cost.
   std::shared_ptr<render::AttributeBuffer> getIndexedRenderAttributeBuffer(ManagedBuffer<uint32_t>& indices);
 
+  // == Compact device-side storage
+
+  // Store the render buffer and indexed views in a compact format (see BufferQuantization), re-encoding whenever the
+  // host data is updated. The host-side `data` keeps full precision. Only glm::vec3 buffers can be quantized, and it
+  // must be set before any render buffers are created. Quantized render buffers cannot be written on the device.
+  void setDeviceQuantization(BufferQuantization newQuantization);
+  BufferQuantization getDeviceQuantization() const;
+
+  // Programs which draw this buffer's render data must include these rules and set these uniforms, to decode the
+  // quantized values. Both do nothing if the buffer is not quantized.
+  std::vector<std::string> addDequantizeRules(std::vector<std::string> rules);
+  void setDequantizeUniforms(render::ShaderProgram& p);
+
 protected:
   // == Internal members
 
   bool hostBufferIsPopulated; // true if the host buffer contains currently-valid data
+  uint64_t dataVersion = 0;
 
   // A mirror of the
   std::shared_ptr<render::AttributeBuffer> renderAttributeBuffer;
 
+  // == Internal representation of quantized render data
+  BufferQuantization deviceQuantization = BufferQuantization::None;
+  QuantizationBounds quantizationBounds; // bounds of `data` the render data is stored relative to, for UNorm16InBounds
+  void updateQuantizationBounds();
+  std::shared_ptr<render::AttributeBuffer> generateRenderBuffer();
+  void setRenderBufferData(render::AttributeBuffer& buff, const std::vector<T>& vals);
+
   // == Internal representation of indexed views
   // NOTE: this seems like a problem, we are storing pointers as keys in a cache. Here, it works out because if the key
   // ptr becomes invalid, the value weak_ptr must also be invalid, and we check that before dereferencing the key.
   std::vector<std::tuple<render::ManagedBuffer<uint32_t>*, std::weak_ptr<render::AttributeBuffer>>>
       existingIndexedViews;
   void updateIndexedViews();
+  void updateIndexedViewsRange(size_t start, size_t count); // only the view entries indexing [start, start+count)
   void removeDeletedIndexedViews();
 
   // == Internal helper functions
@@ -31,6 +31,9 @@ public:
   void setData(const std::vector<glm::uvec2>& data) override;
   void setData(const std::vector<glm::uvec3>& data) override;
   void setData(const std::vector<glm::uvec4>& data) override;
+  void setData(const std::vector<glm::u16vec3>& data) override;
+  void setData(const std::vector<glm::u8vec4>& data) override;
+  void setData(const std::vector<glm::i16vec2>& data) override;
 
   // Array-valued attributes
   // (adding these lazily as we need them)
@@ -39,6 +42,26 @@ public:
   void setData(const std::vector<std::array<glm::vec3, 3>>& data) override;
   void setData(const std::vector<std::array<glm::vec3, 4>>& data) override;
 
+  // Partial updates
+  void setDataRange(const std::vector<glm::vec2>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::vec3>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::vec4>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<float>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<double>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<int32_t>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<uint32_t>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::uvec2>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::uvec3>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::uvec4>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::u16vec3>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::u8vec4>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::i16vec2>& data, size_t start, size_t count) override;
+
+  bool setDataRangeReallocates(size_t newSize) override;
+  void setDataSubrange(const std::vector<glm::u16vec3>& rangeData, size_t start, size_t newSize) override;
+  void setDataSubrange(const std::vector<glm::u8vec4>& rangeData, size_t start, size_t newSize) override;
+  void setDataSubrange(const std::vector<glm::i16vec2>& rangeData, size_t start, size_t newSize) override;
+
   // get data at a single index from the buffer
   float getData_float(size_t ind) override;
   double getData_double(size_t ind) override;
@@ -69,6 +92,10 @@ protected:
 private:
   void checkType(RenderDataType targetType);
   void checkArray(int arrayCount);
+
+  template <typename T>
+  void setDataRangeHelper(const std::vector<T>& data, size_t start, size_t count);
+  void setDataSubrangeHelper(size_t count, size_t start, size_t newSize);
 };
 
 class GLTextureBuffer : public TextureBuffer {
@@ -95,9 +122,14 @@ public:
   std::vector<glm::vec2> getDataVector2() override;
   std::vector<glm::vec3> getDataVector3() override;
 
+  void setData(const std::vector<float>& data) override;
+  void setData(const std::vector<glm::vec2>& data) override;
+  void setData(const std::vector<glm::vec3>& data) override;
+
   void bind();
 
 protected:
+  void setDataFloat(const float* data, size_t nEntries, int nComponents);
 };
 
 class GLRenderBuffer : public RenderBuffer {
@@ -138,6 +170,9 @@ public:
 
   // Query pixels
   std::vector<unsigned char> readBuffer() override;
+  void readBuffer(std::vector<unsigned char>& buff) override;
+  void readFloat4Buffer(std::vector<float>& buff) override;
+  void readDepthBuffer(std::vector<float>& buff) override;
   std::array<float, 4> readFloat4(int xPos, int yPos) override;
   float readDepth(int xPos, int yPos) override;
   void blitTo(FrameBuffer* other) override;
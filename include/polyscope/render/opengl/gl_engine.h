@@ -68,6 +68,9 @@ public:
   void setData(const std::vector<glm::uvec2>& data) override;
   void setData(const std::vector<glm::uvec3>& data) override;
   void setData(const std::vector<glm::uvec4>& data) override;
+  void setData(const std::vector<glm::u16vec3>& data) override;
+  void setData(const std::vector<glm::u8vec4>& data) override;
+  void setData(const std::vector<glm::i16vec2>& data) override;
 
   // Array-valued attributes
   // (adding these lazily as we need them)
@@ -76,6 +79,26 @@ public:
   void setData(const std::vector<std::array<glm::vec3, 3>>& data) override;
   void setData(const std::vector<std::array<glm::vec3, 4>>& data) override;
 
+  // Partial updates
+  void setDataRange(const std::vector<glm::vec2>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::vec3>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::vec4>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<float>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<double>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<int32_t>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<uint32_t>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::uvec2>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::uvec3>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::uvec4>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::u16vec3>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::u8vec4>& data, size_t start, size_t count) override;
+  void setDataRange(const std::vector<glm::i16vec2>& data, size_t start, size_t count) override;
+
+  bool setDataRangeReallocates(size_t newSize) override;
+  void setDataSubrange(const std::vector<glm::u16vec3>& rangeData, size_t start, size_t newSize) override;
+  void setDataSubrange(const std::vector<glm::u8vec4>& rangeData, size_t start, size_t newSize) override;
+  void setDataSubrange(const std::vector<glm::i16vec2>& rangeData, size_t start, size_t newSize) override;
+
   // get data at a single index from the buffer
   float getData_float(size_t ind) override;
   double getData_double(size_t ind) override;
@@ -104,11 +127,19 @@ public:
 
 protected:
   VertexBufferHandle VBOLoc;
+  int64_t dataCapacity = -1; // number of entries the device allocation can hold (if larger than dataSize)
 
 private:
   void checkType(RenderDataType targetType);
   void checkArray(int arrayCount);
   GLenum getTarget();
+
+  template <typename T>
+  void setDataRangeHelper(const std::vector<T>& data, size_t start, size_t count);
+
+  // Write `count` entries to [start, start+count) of the existing allocation, which must be large enough
+  template <typename T>
+  void writeDataRange(const T* rangeData, size_t start, size_t count, size_t newSize);
 };
 
 class GLTextureBuffer : public TextureBuffer {
@@ -135,6 +166,10 @@ public:
   std::vector<glm::vec2> getDataVector2() override;
   std::vector<glm::vec3> getDataVector3() override;
 
+  void setData(const std::vector<float>& data) override;
+  void setData(const std::vector<glm::vec2>& data) override;
+  void setData(const std::vector<glm::vec3>& data) override;
+
   void bind();
   GLenum textureType();
   TextureBufferHandle getHandle() const { return handle; }
@@ -142,6 +177,8 @@ public:
 
 protected:
   TextureBufferHandle handle;
+
+  void setDataFloat(const float* data, size_t nEntries, int nComponents);
 };
 
 class GLRenderBuffer : public RenderBuffer {
@@ -183,6 +220,9 @@ public:
 
   // Query pixels
   std::vector<unsigned char> readBuffer() override;
+  void readBuffer(std::vector<unsigned char>& buff) override;
+  void readFloat4Buffer(std::vector<float>& buff) override;
+  void readDepthBuffer(std::vector<float>& buff) override;
   std::array<float, 4> readFloat4(int xPos, int yPos) override;
   float readDepth(int xPos, int yPos) override;
   void blitTo(FrameBuffer* other) override;
@@ -331,11 +371,13 @@ private:
 
   // Drawing related
   void activateTextures();
+  void uploadIndexData(const unsigned int* indices, size_t count);
 
   // GL pointers for various useful things
   std::shared_ptr<GLCompiledProgram> compiledProgram;
   AttributeHandle vaoHandle;
   AttributeHandle indexVBO;
+  GLenum indexType = GL_UNSIGNED_INT; // GL_UNSIGNED_SHORT when every index fits in 16 bits
 };
 
 
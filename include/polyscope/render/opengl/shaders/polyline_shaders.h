@@ -0,0 +1,25 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include "polyscope/render/opengl/gl_shaders.h"
+
+namespace polyscope {
+namespace render {
+namespace backend_openGL3_glfw {
+
+// High level pipeline
+extern const ShaderStageSpecification FLEX_POLYLINE_VERT_SHADER;
+extern const ShaderStageSpecification FLEX_POLYLINE_GEOM_SHADER;
+extern const ShaderStageSpecification FLEX_POLYLINE_FRAG_SHADER;
+
+// Rules specific to polylines
+extern const ShaderReplacementRule POLYLINE_PROPAGATE_VALUE;
+extern const ShaderReplacementRule POLYLINE_PROPAGATE_COLOR;
+extern const ShaderReplacementRule POLYLINE_PROPAGATE_PICK;
+extern const ShaderReplacementRule POLYLINE_CULLPOS_FROM_MID;
+
+
+} // namespace backend_openGL3_glfw
+} // namespace render
+} // namespace polyscope
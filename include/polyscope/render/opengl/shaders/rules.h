@@ -32,6 +32,10 @@ extern const ShaderReplacementRule CHECKER_VALUE2COLOR;         // modulate albe
 extern const ShaderReplacementRule GENERATE_VIEW_POS;          // computes viewPos, position in viewspace for fragment
 extern const ShaderReplacementRule CULL_POS_FROM_VIEW;
 
+// Decoding compact attributes (see BufferQuantization)
+extern const ShaderReplacementRule DEQUANTIZE_POSITION;         // modifies `position` in the vertex shader
+extern const ShaderReplacementRule DECODE_OCTAHEDRAL_NORMAL;    // modifies `normal` in the vertex shader
+
 ShaderReplacementRule generateSlicePlaneRule(std::string uniquePostfix);
 
 // clang-format on
@@ -17,6 +17,8 @@ extern const ShaderStageSpecification FLEX_VECTOR_FRAG_SHADER;
 // Rules specific to cylinders
 extern const ShaderReplacementRule VECTOR_PROPAGATE_COLOR;
 extern const ShaderReplacementRule VECTOR_CULLPOS_FROM_TAIL;
+extern const ShaderReplacementRule VECTOR_CULL_MAGNITUDE;
+extern const ShaderReplacementRule TANGENT_VECTOR_CULL_MAGNITUDE;
 
 } // namespace backend_openGL3_glfw
 } // namespace render
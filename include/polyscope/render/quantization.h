@@ -0,0 +1,77 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "polyscope/messages.h"
+#include "polyscope/render/engine.h"
+
+namespace polyscope {
+namespace render {
+
+// Encoding for the compact render buffer formats of BufferQuantization. Shaders decode the values again; see the
+// DEQUANTIZE_POSITION and DECODE_OCTAHEDRAL_NORMAL rules. Whole buffers are encoded on parallel threads (parallel.h).
+
+// The box that UNorm16InBounds positions are stored relative to. A position is decoded as lower + q * (upper - lower),
+// for q in [0,1]^3. An empty box has lower > upper.
+struct QuantizationBounds {
+  glm::vec3 lower{std::numeric_limits<float>::infinity()};
+  glm::vec3 upper{-std::numeric_limits<float>::infinity()};
+
+  glm::vec3 dequantizeOffset() const;
+  glm::vec3 dequantizeScale() const;
+  bool operator==(const QuantizationBounds& other) const { return lower == other.lower && upper == other.upper; }
+  bool operator!=(const QuantizationBounds& other) const { return !(*this == other); }
+};
+
+// The render data type which holds a given quantization
+RenderDataType quantizedRenderDataType(BufferQuantization q);
+
+// Grow `bounds` to contain data[start, start+count)
+QuantizationBounds expandQuantizationBounds(QuantizationBounds bounds, const std::vector<glm::vec3>& data, size_t start,
+                                            size_t count);
+QuantizationBounds computeQuantizationBounds(const std::vector<glm::vec3>& data);
+
+// Encode/decode single values, matching the GPU's conversions for normalized formats
+glm::u16vec3 quantizeUNorm16(glm::vec3 p, const QuantizationBounds& bounds);
+glm::vec3 dequantizeUNorm16(glm::u16vec3 q, const QuantizationBounds& bounds);
+glm::u8vec4 quantizeUNorm8(glm::vec3 c);
+glm::vec3 dequantizeUNorm8(glm::u8vec4 q);
+glm::i16vec2 encodeOctahedral16(glm::vec3 n);
+glm::vec3 decodeOctahedral16(glm::i16vec2 e);
+
+// Encode whole arrays
+std::vector<glm::u16vec3> quantizeUNorm16(const std::vector<glm::vec3>& data, const QuantizationBounds& bounds);
+std::vector<glm::u8vec4> quantizeUNorm8(const std::vector<glm::vec3>& data);
+std::vector<glm::i16vec2> encodeOctahedral16(const std::vector<glm::vec3>& data);
+
+// Encode `data` and upload it to a buffer of type quantizedRenderDataType(q), either entirely or the range
+// [start, start+count) as in AttributeBuffer::setDataRange(). A range update only encodes that range, unless the buffer
+// must be reallocated. `bounds` is only used for UNorm16InBounds.
+void setQuantizedAttributeBufferData(AttributeBuffer& buff, BufferQuantization q, const std::vector<glm::vec3>& data,
+                                     const QuantizationBounds& bounds);
+void setQuantizedAttributeBufferDataRange(AttributeBuffer& buff, BufferQuantization q,
+                                          const std::vector<glm::vec3>& data, const QuantizationBounds& bounds,
+                                          size_t start, size_t count);
+
+// Fallbacks so that ManagedBuffer<T> compiles for every T; only glm::vec3 data can be quantized
+template <typename T>
+QuantizationBounds expandQuantizationBounds(QuantizationBounds bounds, const std::vector<T>&, size_t, size_t) {
+  return bounds;
+}
+template <typename T>
+void setQuantizedAttributeBufferData(AttributeBuffer&, BufferQuantization, const std::vector<T>&,
+                                     const QuantizationBounds&) {
+  exception("only vec3 render buffers can be quantized");
+}
+template <typename T>
+void setQuantizedAttributeBufferDataRange(AttributeBuffer&, BufferQuantization, const std::vector<T>&,
+                                          const QuantizationBounds&, size_t, size_t) {
+  exception("only vec3 render buffers can be quantized");
+}
+
+} // namespace render
+} // namespace polyscope
@@ -25,5 +25,10 @@ T getAttributeBufferData(AttributeBuffer& buff, size_t ind);
 template <typename T>
 std::vector<T> getAttributeBufferDataRange(AttributeBuffer& buff, size_t ind, size_t count);
 
+// Upload a range of data values to a buffer of a templated type, see AttributeBuffer::setDataRange()
+// (array-valued types are not supported)
+template <typename T>
+void setAttributeBufferDataRange(AttributeBuffer& buff, const std::vector<T>& data, size_t start, size_t count);
+
 } // namespace render
 } // namespace polyscope
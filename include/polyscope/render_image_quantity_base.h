@@ -29,7 +29,11 @@ public:
   virtual void refresh() override;
 
   size_t nPix();
+  size_t getDimX() const { return dimX; }
+  size_t getDimY() const { return dimY; }
+  ImageOrigin getImageOrigin() const { return imageOrigin; }
 
+  // Replace the depth and normal data, which must have the same size as before. Existing textures are updated in place.
   void updateGeometryBuffers(const std::vector<float>& newDepthData, const std::vector<glm::vec3>& newNormalData);
 
   // == Setters and getters
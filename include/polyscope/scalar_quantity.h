@@ -6,11 +6,16 @@
 #include "polyscope/histogram.h"
 #include "polyscope/persistent_value.h"
 #include "polyscope/polyscope.h"
+#include "polyscope/render/colormap_lut.h"
 #include "polyscope/render/engine.h"
 #include "polyscope/render/managed_buffer.h"
+#include "polyscope/scalar_statistics.h"
 #include "polyscope/scaled_value.h"
 #include "polyscope/standardize_data_array.h"
 
+#include <chrono>
+#include <future>
+
 namespace polyscope {
 
 // Encapsulates logic which is common to all scalar quantities
@@ -30,6 +35,8 @@ public:
   // Set uniforms in rendering programs for scalars
   void setScalarUniforms(render::ShaderProgram& p);
 
+  // Replace the values, e.g. once per frame when animating a field. Only the value buffer is re-uploaded; shader
+  // programs and textures are kept, and the ranges follow getRangeUpdate(). The histogram is recomputed lazily.
   template <class V>
   void updateData(const V& newValues);
 
@@ -50,7 +57,12 @@ public:
   QuantityT* setMapRange(std::pair<double, double> val);
   std::pair<double, double> getMapRange();
   QuantityT* resetMapRange(); // reset to full range
+  QuantityT* resetMapRangeToPercentiles(double lower, double upper); // e.g. (1, 99) to ignore outliers
   std::pair<double, double> getDataRange();
+  const ScalarStatistics& getDataStatistics(); // waits for (or computes) the full statistics if needed
+  DataType getDataType() const;
+  QuantityT* setRangeUpdate(ScalarRangeUpdate newMode); // how updateData() and appends treat the ranges
+  ScalarRangeUpdate getRangeUpdate();
 
   // Isolines
   QuantityT* setIsolinesEnabled(bool newEnabled);
@@ -60,17 +72,42 @@ public:
   QuantityT* setIsolineDarkness(double val);
   double getIsolineDarkness();
 
+  // The colors the values are currently shown with (colormap, map range and isolines), computed on the CPU, e.g. to
+  // bake vertex colors or export them
+  render::ColorMapParams getColorMapParams();
+  std::vector<glm::vec3> getMappedColors();
+  std::vector<glm::u8vec3> getMappedColorsRGB8();
+
 protected:
   std::vector<double> valuesData;
   const DataType dataType;
+  ScalarStatistics dataStats; // only the range and counts until ensureDataStatistics() or the histogram needs more
 
   // === Visualization parameters
 
   // Affine data maps and limits
   std::pair<float, float> vizRange; // TODO make these persistent
+  bool vizRangeManuallySet = false;  // if so, running ranges do not move it
   std::pair<double, double> dataRange;
+  ScalarRangeUpdate rangeUpdate = ScalarRangeUpdate::Fixed;
   Histogram hist;
 
+  // The histogram is only built once the UI first needs it. The full statistics it is built from are computed on a
+  // worker thread, and a placeholder is shown until they are ready.
+  bool dataStatsComplete = false; // dataStats includes the chunk histograms
+  bool histogramBuilt = false;    // the histogram reflects the current data
+  bool histogramDrawable = false; // the histogram has been built at least once, possibly from older data
+  std::future<ScalarStatistics> dataStatsFuture; // pending worker, if any; it works on a copy of the values
+  bool dataStatsFutureStale = false;             // the values changed after the pending worker started
+  void ensureDataStatistics();                   // compute the full statistics now, waiting on the worker if needed
+  bool prepareHistogram();                       // returns true if there is a histogram to draw
+  void invalidateDataStatistics();               // mark statistics and histogram stale, without waiting
+  void setMapRangeFromDataRange();               // the default map range for the data type
+
+  // Call after writing new values (all of them, or only appended/changed ones) in to the values buffer. Marks the
+  // statistics stale, and grows the ranges to cover the new values according to the range update mode.
+  void valuesUpdated(const std::vector<double>& newValues);
+
   // Parameters
   PersistentValue<std::string> cMap;
   PersistentValue<bool> isolinesEnabled;
@@ -7,7 +7,7 @@ namespace polyscope {
 template <typename QuantityT>
 ScalarQuantity<QuantityT>::ScalarQuantity(QuantityT& quantity_, const std::vector<double>& values_, DataType dataType_)
     : quantity(quantity_), values(quantity.uniquePrefix() + "#values", valuesData), valuesData(values_),
-      dataType(dataType_), dataRange(robustMinMax(values.data, 1e-5)),
+      dataType(dataType_), dataStats(computeScalarStatistics(values_, false)), dataRange(dataStats.robustRange(1e-5)),
       cMap(quantity.uniquePrefix() + "#cmap", defaultColorMap(dataType)),
       isolinesEnabled(quantity.uniquePrefix() + "#isolinesEnabled", false),
       isolineWidth(quantity.uniquePrefix() + "#isolineWidth",
@@ -16,7 +16,6 @@ ScalarQuantity<QuantityT>::ScalarQuantity(QuantityT& quantity_, const std::vecto
 
 {
   hist.updateColormap(cMap.get());
-  hist.buildHistogram(values.data);
   resetMapRange();
 }
 
@@ -61,11 +60,16 @@ void ScalarQuantity<QuantityT>::buildScalarUI() {
                         .c_str());
 
 
-  // Draw the histogram of values
-  hist.colormapRange = vizRange;
+  // Draw the histogram of values, or a placeholder of the same size while it is computed
   float windowWidth = ImGui::GetWindowWidth();
   float histWidth = 0.75 * windowWidth;
-  hist.buildUI(histWidth);
+  if (prepareHistogram()) {
+    hist.colormapRange = vizRange; // may be from older data for a frame or two while an update is computed
+    hist.buildUI(histWidth);
+  } else {
+    ImGui::TextDisabled("computing histogram...");
+    ImGui::Dummy(ImVec2(histWidth, histWidth / 4. - ImGui::GetTextLineHeightWithSpacing()));
+  }
 
   // Data range
   // Note: %g specifiers are generally nicer than %e, but here we don't acutally have a choice. ImGui (for somewhat
@@ -81,11 +85,15 @@ void ScalarQuantity<QuantityT>::buildScalarUI() {
     switch (dataType) {
     case DataType::STANDARD: {
 
-      ImGui::DragFloat("##min", &vizRange.first, speed, dataRange.first, vizRange.second, "%.5g",
-                       ImGuiSliderFlags_NoRoundToFormat);
+      if (ImGui::DragFloat("##min", &vizRange.first, speed, dataRange.first, vizRange.second, "%.5g",
+                           ImGuiSliderFlags_NoRoundToFormat)) {
+        vizRangeManuallySet = true;
+      }
       ImGui::SameLine();
-      ImGui::DragFloat("##max", &vizRange.second, speed, vizRange.first, dataRange.second, "%.5g",
-                       ImGuiSliderFlags_NoRoundToFormat);
+      if (ImGui::DragFloat("##max", &vizRange.second, speed, vizRange.first, dataRange.second, "%.5g",
+                           ImGuiSliderFlags_NoRoundToFormat)) {
+        vizRangeManuallySet = true;
+      }
 
     } break;
     case DataType::SYMMETRIC: {
@@ -93,16 +101,20 @@ void ScalarQuantity<QuantityT>::buildScalarUI() {
 
       if (ImGui::DragFloat("##min", &vizRange.first, speed, -absRange, 0.f, "%.5g", ImGuiSliderFlags_NoRoundToFormat)) {
         vizRange.second = -vizRange.first;
+        vizRangeManuallySet = true;
       }
       ImGui::SameLine();
       if (ImGui::DragFloat("##max", &vizRange.second, speed, 0.f, absRange, "%.5g", ImGuiSliderFlags_NoRoundToFormat)) {
         vizRange.first = -vizRange.second;
+        vizRangeManuallySet = true;
       }
 
     } break;
     case DataType::MAGNITUDE: {
-      ImGui::DragFloat("##max", &vizRange.second, speed, 0.f, dataRange.second, "%.5g",
-                       ImGuiSliderFlags_NoRoundToFormat);
+      if (ImGui::DragFloat("##max", &vizRange.second, speed, 0.f, dataRange.second, "%.5g",
+                           ImGuiSliderFlags_NoRoundToFormat)) {
+        vizRangeManuallySet = true;
+      }
 
     } break;
     }
@@ -173,6 +185,14 @@ void ScalarQuantity<QuantityT>::setScalarUniforms(render::ShaderProgram& p) {
 
 template <typename QuantityT>
 QuantityT* ScalarQuantity<QuantityT>::resetMapRange() {
+  setMapRangeFromDataRange();
+  vizRangeManuallySet = false;
+  requestRedraw();
+  return &quantity;
+}
+
+template <typename QuantityT>
+void ScalarQuantity<QuantityT>::setMapRangeFromDataRange() {
   switch (dataType) {
   case DataType::STANDARD:
     vizRange = dataRange;
@@ -185,17 +205,82 @@ QuantityT* ScalarQuantity<QuantityT>::resetMapRange() {
     vizRange = std::make_pair(0., dataRange.second);
     break;
   }
-
-  requestRedraw();
-  return &quantity;
 }
 
 template <typename QuantityT>
 template <class V>
 void ScalarQuantity<QuantityT>::updateData(const V& newValues) {
   validateSize(newValues, values.size(), "scalar quantity " + quantity.name);
-  values.data = standardizeArray<double, V>(newValues);
+  adaptorF_convertToStdVector<double>(newValues, values.data); // in place, reusing the allocation
   values.markHostBufferUpdated();
+  valuesUpdated(values.data);
+}
+
+template <typename QuantityT>
+void ScalarQuantity<QuantityT>::valuesUpdated(const std::vector<double>& newValues) {
+  invalidateDataStatistics();
+
+  if (rangeUpdate == ScalarRangeUpdate::Running) {
+    ScalarStatistics newStats = computeScalarStatistics(newValues, false);
+    if (newStats.finiteCount > 0) {
+      dataRange.first = std::min(dataRange.first, newStats.min);
+      dataRange.second = std::max(dataRange.second, newStats.max);
+      if (!vizRangeManuallySet) {
+        setMapRangeFromDataRange();
+        requestRedraw();
+      }
+    }
+  }
+}
+
+template <typename QuantityT>
+void ScalarQuantity<QuantityT>::ensureDataStatistics() {
+  if (dataStatsComplete) return;
+  if (dataStatsFuture.valid() && !dataStatsFutureStale) {
+    dataStats = dataStatsFuture.get();
+  } else {
+    dataStatsFuture = std::future<ScalarStatistics>(); // drop any stale worker
+    dataStatsFutureStale = false;
+    values.ensureHostBufferPopulated();
+    dataStats = computeScalarStatistics(values.data);
+  }
+  dataStatsComplete = true;
+}
+
+template <typename QuantityT>
+bool ScalarQuantity<QuantityT>::prepareHistogram() {
+  if (histogramBuilt) return true;
+  requestRedraw(); // poll again next frame
+
+  if (!dataStatsComplete) {
+    auto isReady = [&]() { return dataStatsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+
+    // Only one worker runs at a time. If the values changed since it started, its result is dropped once it finishes
+    // and a new worker is started for the latest values, so frequent updates do not pile up work.
+    if (dataStatsFuture.valid() && dataStatsFutureStale) {
+      if (!isReady()) return histogramDrawable;
+      dataStatsFuture = std::future<ScalarStatistics>();
+      dataStatsFutureStale = false;
+    }
+    if (!dataStatsFuture.valid()) {
+      values.ensureHostBufferPopulated();
+      dataStatsFuture = computeScalarStatisticsAsync(values.data);
+    }
+    if (!isReady()) return histogramDrawable;
+    ensureDataStatistics();
+  }
+
+  hist.buildHistogram(dataStats);
+  histogramBuilt = true;
+  histogramDrawable = true;
+  return true;
+}
+
+template <typename QuantityT>
+void ScalarQuantity<QuantityT>::invalidateDataStatistics() {
+  if (dataStatsFuture.valid()) dataStatsFutureStale = true;
+  dataStatsComplete = false;
+  histogramBuilt = false;
 }
 
 
@@ -215,6 +300,7 @@ std::string ScalarQuantity<QuantityT>::getColorMap() {
 template <typename QuantityT>
 QuantityT* ScalarQuantity<QuantityT>::setMapRange(std::pair<double, double> val) {
   vizRange = val;
+  vizRangeManuallySet = true;
   requestRedraw();
   return &quantity;
 }
@@ -222,10 +308,52 @@ template <typename QuantityT>
 std::pair<double, double> ScalarQuantity<QuantityT>::getMapRange() {
   return vizRange;
 }
+template <typename QuantityT>
+QuantityT* ScalarQuantity<QuantityT>::resetMapRangeToPercentiles(double lower, double upper) {
+  ensureDataStatistics();
+  double lowerVal = dataStats.percentile(lower / 100.);
+  double upperVal = dataStats.percentile(upper / 100.);
+  switch (dataType) {
+  case DataType::STANDARD:
+    vizRange = std::make_pair(lowerVal, upperVal);
+    break;
+  case DataType::SYMMETRIC: {
+    double absRange = std::max(std::abs(lowerVal), std::abs(upperVal));
+    vizRange = std::make_pair(-absRange, absRange);
+  } break;
+  case DataType::MAGNITUDE:
+    vizRange = std::make_pair(0., upperVal);
+    break;
+  }
+  vizRangeManuallySet = true;
+
+  requestRedraw();
+  return &quantity;
+}
+
+template <typename QuantityT>
+const ScalarStatistics& ScalarQuantity<QuantityT>::getDataStatistics() {
+  ensureDataStatistics();
+  return dataStats;
+}
+
 template <typename QuantityT>
 std::pair<double, double> ScalarQuantity<QuantityT>::getDataRange() {
   return dataRange;
 }
+template <typename QuantityT>
+DataType ScalarQuantity<QuantityT>::getDataType() const {
+  return dataType;
+}
+template <typename QuantityT>
+QuantityT* ScalarQuantity<QuantityT>::setRangeUpdate(ScalarRangeUpdate newMode) {
+  rangeUpdate = newMode;
+  return &quantity;
+}
+template <typename QuantityT>
+ScalarRangeUpdate ScalarQuantity<QuantityT>::getRangeUpdate() {
+  return rangeUpdate;
+}
 
 template <typename QuantityT>
 QuantityT* ScalarQuantity<QuantityT>::setIsolineWidth(double size, bool isRelative) {
@@ -255,6 +383,28 @@ double ScalarQuantity<QuantityT>::getIsolineDarkness() {
   return isolineDarkness.get();
 }
 
+template <typename QuantityT>
+render::ColorMapParams ScalarQuantity<QuantityT>::getColorMapParams() {
+  render::ColorMapParams params;
+  params.range = vizRange;
+  params.isolinesEnabled = isolinesEnabled.get();
+  params.isolineWidth = getIsolineWidth();
+  params.isolineDarkness = getIsolineDarkness();
+  return params;
+}
+template <typename QuantityT>
+std::vector<glm::vec3> ScalarQuantity<QuantityT>::getMappedColors() {
+  values.ensureHostBufferPopulated();
+  render::ColorMapLUT lut(render::engine->getColorMap(cMap.get()));
+  return lut.mapValues(values.data, getColorMapParams());
+}
+template <typename QuantityT>
+std::vector<glm::u8vec3> ScalarQuantity<QuantityT>::getMappedColorsRGB8() {
+  values.ensureHostBufferPopulated();
+  render::ColorMapLUT lut(render::engine->getColorMap(cMap.get()));
+  return lut.mapValuesRGB8(values.data, getColorMapParams());
+}
+
 template <typename QuantityT>
 QuantityT* ScalarQuantity<QuantityT>::setIsolinesEnabled(bool newEnabled) {
   isolinesEnabled = newEnabled;
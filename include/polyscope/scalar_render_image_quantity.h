@@ -28,6 +28,11 @@ public:
 
   virtual std::string niceName() override;
 
+  // Replace the depth, normal and scalar data, which must have the same size as before. Existing textures are updated
+  // in place. The colormap range is not changed.
+  void updateBuffers(const std::vector<float>& newDepthData, const std::vector<glm::vec3>& newNormalData,
+                     const std::vector<double>& newScalarData);
+
   // == Setters and getters
 
 
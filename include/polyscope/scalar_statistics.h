@@ -0,0 +1,67 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <utility>
+#include <vector>
+
+namespace polyscope {
+
+// Summary statistics of an array of scalar values, as used for colormap ranges and histograms
+struct ScalarStatistics {
+  double min = 0.; // range of the finite values (zero if there are none)
+  double max = 0.;
+  size_t finiteCount = 0;
+  size_t nanCount = 0;
+  size_t infCount = 0; // entries which are +-infinity
+
+  // The value below which a fraction p in [0,1] of the finite values lie. This is found from the chunk histograms
+  // below, so it stays accurate when a few outliers stretch the overall range.
+  double percentile(double p) const;
+
+  // The range of the finite values, padded for constant or near-constant data, like robustMinMax()
+  std::pair<double, double> robustRange(double rangeEPS = 1e-12) const;
+
+  // Counts of the finite values in nBins equal-width bins spanning [lower, upper]. For statisticsHistogramBinCount bins
+  // spanning robustRange() (as Histogram uses) this is rangeHistogram, which is exact. Otherwise it is approximate:
+  // each bin of the chunk histograms below is counted in the bin containing the center of its values.
+  std::vector<double> histogram(double lower, double upper, size_t nBins) const;
+
+  // Exact counts of the finite values in statisticsHistogramBinCount equal-width bins spanning robustRange(). Every
+  // chunk uses the same bin edges, so the chunk counts add up exactly.
+  std::vector<double> rangeHistogram;
+
+  // Histogram of each chunk of values over the chunk's own range of finite values. The counts are running totals, and
+  // the range of the values which landed in each bin is kept, so one outlier does not blur the rest of its chunk.
+  struct ChunkHistogram {
+    double min;
+    double max;
+    std::vector<uint32_t> cumulativeCounts;
+    std::vector<double> binMin;
+    std::vector<double> binMax;
+  };
+  std::vector<ChunkHistogram> chunks;
+
+private:
+  size_t countAtMost(double x) const; // approximately, interpolating within bins
+};
+
+// Compute statistics of the values in parallel, in two passes. The first finds the range and counts, and bins each
+// chunk of values over its own range while it is still in cache. Exact counts over the overall range need bin edges
+// which are only known once every chunk is done, so the second pass counts rangeHistogram. The range, counts and
+// rangeHistogram are exact; percentiles and other histograms are accurate to the width of a chunk's bins. If
+// withHistograms is false, only the first pass runs, for the range and counts, and percentile() and histogram() have
+// no data to work from.
+const size_t statisticsChunkSize = 1 << 16;
+const size_t statisticsChunkBinCount = 256;
+const size_t statisticsHistogramBinCount = 51;
+ScalarStatistics computeScalarStatistics(const std::vector<double>& values, bool withHistograms = true);
+
+// Compute the full statistics of the values on a new thread, which works on its own copy of them. Unlike a future from
+// std::async, the returned future does not block when it is destroyed, so an unwanted result can simply be dropped.
+std::future<ScalarStatistics> computeScalarStatisticsAsync(std::vector<double> values);
+
+} // namespace polyscope
@@ -0,0 +1,201 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#pragma once
+
+#include "polyscope/affine_remapper.h"
+#include "polyscope/file_helpers.h"
+#include "polyscope/types.h"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace polyscope {
+
+class Quantity;
+namespace render {
+template <typename T>
+class ManagedBuffer;
+}
+
+// =======================================================
+// === Binary scene files
+// =======================================================
+
+// Polyscope's native binary format. A scene file is a container of named arrays: a fixed-size header, then the array
+// contents, each starting on a 64-byte boundary, then a table of contents giving the name, type and location of every
+// array. Structures store their geometry along with the connectivity and geometry computed from it (triangulations,
+// edge indices, twins, tets, normals...), so loading a scene is just copying each array out of a memory mapping of
+// the file, with no parsing and nothing recomputed.
+//
+// Every array is checked to lie within the file and enum values are range-checked, so corrupt files are rejected rather
+// than read out of bounds. Beyond that files are trusted: array sizes are checked against each other on load, but
+// indices are not checked against the element counts like they are when registering a structure from user data.
+
+const uint32_t sceneFileVersion = 1;
+const size_t sceneFileAlignment = 64;
+
+enum class SceneFileValueType : uint32_t { UInt8 = 0, UInt32, UInt64, Float, Double };
+
+// The storage type of each kind of array element which can be written to a scene file
+template <typename T>
+struct SceneFileElement;
+
+// Write a scene file array-by-array. Arrays are written to disk as they are added; the table of contents is written by
+// finish(), which is also called by the destructor.
+class SceneFileWriter {
+public:
+  SceneFileWriter(std::string filename); // throws if the file cannot be opened
+  ~SceneFileWriter();
+
+  // No copy constructor/assignment
+  SceneFileWriter(const SceneFileWriter&) = delete;
+  SceneFileWriter& operator=(const SceneFileWriter&) = delete;
+
+  const std::string filename;
+
+  template <typename T>
+  void writeArray(const std::string& key, const std::vector<T>& values);
+  template <typename T>
+  void writeValue(const std::string& key, T value);
+  void writeString(const std::string& key, const std::string& value);
+
+  // Arrays of size_t are stored as uint64_t, so files are the same on every platform
+  void writeIndexArray(const std::string& key, const std::vector<size_t>& values);
+
+  void finish();
+
+private:
+  struct Entry {
+    std::string key;
+    SceneFileValueType type;
+    uint32_t components;
+    uint64_t count;
+    uint64_t offset;
+  };
+
+  std::ofstream out;
+  std::vector<Entry> entries;
+  uint64_t currentOffset = 0;
+  bool finished = false;
+
+  void writeRaw(const std::string& key, SceneFileValueType type, uint32_t components, uint64_t count,
+                const void* data, size_t nBytes);
+  void writePadding(size_t nBytes);
+};
+
+// Read from a scene file. The file is memory-mapped, so only the arrays which are read are paged in from disk.
+class SceneFileReader {
+public:
+  SceneFileReader(std::string filename); // throws if the file is missing, corrupt, or from a newer version
+
+  const std::string filename;
+  uint32_t version;
+
+  bool hasArray(const std::string& key) const;
+  std::vector<std::string> arrayKeys() const;
+
+  // Direct access to an array inside the mapped file, valid for the lifetime of the reader. Throws if the key is absent
+  // or the stored type does not match T.
+  template <typename T>
+  const T* arrayData(const std::string& key, size_t& count) const;
+
+  template <typename T>
+  void readArray(const std::string& key, std::vector<T>& out) const;
+  template <typename T>
+  std::vector<T> readArray(const std::string& key) const;
+  template <typename T>
+  T readValue(const std::string& key) const; // a single-entry array
+  std::string readString(const std::string& key) const;
+  std::vector<size_t> readIndexArray(const std::string& key) const;
+
+  // Like readArray() for data which is optional, e.g. lazily-computed buffers. Returns false (and leaves out unchanged)
+  // if the key is absent.
+  template <typename T>
+  bool readArrayIfPresent(const std::string& key, std::vector<T>& out) const;
+
+private:
+  struct Entry {
+    SceneFileValueType type;
+    uint32_t components;
+    uint64_t count;
+    uint64_t offset;
+  };
+
+  MemoryMappedFile file;
+  std::unordered_map<std::string, Entry> entries;
+
+  const Entry& findEntry(const std::string& key, SceneFileValueType type, uint32_t components) const;
+};
+
+// Write all registered structures (which support scene files) to a file, along with their scalar, color and vector
+// quantities. Structures and quantities of other kinds are skipped with a warning.
+void writeSceneFile(std::string filename);
+
+// Register all of the structures in a scene file. Structures with the same name as one in the file are replaced, so
+// this can also be used to reload a scene.
+void loadSceneFile(std::string filename);
+
+// === Helpers used by structures to store their buffers and quantities
+
+template <typename T>
+void writeBufferToSceneFile(SceneFileWriter& writer, const std::string& key, render::ManagedBuffer<T>& buffer);
+template <typename T>
+void readBufferFromSceneFile(const SceneFileReader& reader, const std::string& key, render::ManagedBuffer<T>& buffer);
+
+// For lazily-computed buffers: written only if they have been computed, and read back only if they were written
+template <typename T>
+void writeComputedBufferToSceneFile(SceneFileWriter& writer, const std::string& key,
+                                    render::ManagedBuffer<T>& buffer);
+template <typename T>
+void readComputedBufferFromSceneFile(const SceneFileReader& reader, const std::string& key,
+                                     render::ManagedBuffer<T>& buffer);
+
+// Write a quantity if it is of type Q, returning false otherwise
+template <class Q>
+bool writeScalarQuantityToSceneFile(SceneFileWriter& writer, const std::string& prefix, const std::string& kind,
+                                    Quantity& quantity);
+template <class Q>
+bool writeColorQuantityToSceneFile(SceneFileWriter& writer, const std::string& prefix, const std::string& kind,
+                                   Quantity& quantity);
+template <class Q>
+bool writeVectorQuantityToSceneFile(SceneFileWriter& writer, const std::string& prefix, const std::string& kind,
+                                    Quantity& quantity);
+
+// Write the number of quantities written with the helpers above, after the last one
+void writeSceneFileQuantityCount(SceneFileWriter& writer, const std::string& structurePrefix, size_t count);
+
+// Prefix for the i'th quantity of the structure with the given prefix
+std::string sceneFileQuantityPrefix(const std::string& structurePrefix, size_t iQuantity);
+
+// A quantity stored in a scene file. Structures read the data to re-create the quantity, then pass the new quantity to
+// restore() to apply the stored settings.
+struct SceneFileQuantity {
+  const SceneFileReader& reader;
+  const std::string prefix;
+  const std::string kind;
+  const std::string name;
+
+  std::vector<double> readValues() const;
+  DataType readDataType() const;
+  std::vector<glm::vec3> readColors() const;
+  std::vector<glm::vec3> readVectors() const;
+  VectorType readVectorType() const;
+
+  template <class Q>
+  void restore(Q* quantity) const;
+  template <class Q>
+  void restoreScalar(Q* quantity) const; // also restores the colormap and range
+
+  void warnUnsupported(const std::string& structureName) const;
+};
+std::vector<SceneFileQuantity> sceneFileQuantities(const SceneFileReader& reader, const std::string& structurePrefix);
+
+} // namespace polyscope
+
+#include "polyscope/scene_file.ipp"
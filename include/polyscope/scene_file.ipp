@@ -0,0 +1,147 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/messages.h"
+
+#include <cstring>
+
+namespace polyscope {
+
+// clang-format off
+template <> struct SceneFileElement<uint8_t>  { static SceneFileValueType type() { return SceneFileValueType::UInt8; }  static uint32_t components() { return 1; } };
+template <> struct SceneFileElement<char>     { static SceneFileValueType type() { return SceneFileValueType::UInt8; }  static uint32_t components() { return 1; } };
+template <> struct SceneFileElement<uint32_t> { static SceneFileValueType type() { return SceneFileValueType::UInt32; } static uint32_t components() { return 1; } };
+template <> struct SceneFileElement<uint64_t> { static SceneFileValueType type() { return SceneFileValueType::UInt64; } static uint32_t components() { return 1; } };
+template <> struct SceneFileElement<float>    { static SceneFileValueType type() { return SceneFileValueType::Float; }  static uint32_t components() { return 1; } };
+template <> struct SceneFileElement<double>   { static SceneFileValueType type() { return SceneFileValueType::Double; } static uint32_t components() { return 1; } };
+template <> struct SceneFileElement<glm::vec2> { static SceneFileValueType type() { return SceneFileValueType::Float; } static uint32_t components() { return 2; } };
+template <> struct SceneFileElement<glm::vec3> { static SceneFileValueType type() { return SceneFileValueType::Float; } static uint32_t components() { return 3; } };
+template <> struct SceneFileElement<glm::mat4> { static SceneFileValueType type() { return SceneFileValueType::Float; } static uint32_t components() { return 16; } };
+template <size_t D> struct SceneFileElement<std::array<uint32_t, D>> { static SceneFileValueType type() { return SceneFileValueType::UInt32; } static uint32_t components() { return D; } };
+// clang-format on
+
+template <typename T>
+void SceneFileWriter::writeArray(const std::string& key, const std::vector<T>& values) {
+  writeRaw(key, SceneFileElement<T>::type(), SceneFileElement<T>::components(), values.size(), values.data(),
+           sizeof(T) * values.size());
+}
+
+template <typename T>
+void SceneFileWriter::writeValue(const std::string& key, T value) {
+  writeArray(key, std::vector<T>{value});
+}
+
+template <typename T>
+const T* SceneFileReader::arrayData(const std::string& key, size_t& count) const {
+  const Entry& entry = findEntry(key, SceneFileElement<T>::type(), SceneFileElement<T>::components());
+  count = entry.count;
+  return reinterpret_cast<const T*>(file.data() + entry.offset);
+}
+
+template <typename T>
+void SceneFileReader::readArray(const std::string& key, std::vector<T>& out) const {
+  size_t count;
+  const T* data = arrayData<T>(key, count);
+  out.resize(count);
+  if (count > 0) std::memcpy(&out[0], data, sizeof(T) * count);
+}
+
+template <typename T>
+std::vector<T> SceneFileReader::readArray(const std::string& key) const {
+  std::vector<T> out;
+  readArray(key, out);
+  return out;
+}
+
+template <typename T>
+T SceneFileReader::readValue(const std::string& key) const {
+  size_t count;
+  const T* data = arrayData<T>(key, count);
+  if (count != 1) exception("scene file " + filename + " entry " + key + " should hold a single value");
+  return data[0];
+}
+
+template <typename T>
+bool SceneFileReader::readArrayIfPresent(const std::string& key, std::vector<T>& out) const {
+  if (!hasArray(key)) return false;
+  readArray(key, out);
+  return true;
+}
+
+template <typename T>
+void writeBufferToSceneFile(SceneFileWriter& writer, const std::string& key, render::ManagedBuffer<T>& buffer) {
+  writer.writeArray(key, buffer.getPopulatedHostBufferRef());
+}
+
+template <typename T>
+void readBufferFromSceneFile(const SceneFileReader& reader, const std::string& key, render::ManagedBuffer<T>& buffer) {
+  reader.readArray(key, buffer.data);
+  buffer.markHostBufferUpdated();
+}
+
+template <typename T>
+void writeComputedBufferToSceneFile(SceneFileWriter& writer, const std::string& key,
+                                    render::ManagedBuffer<T>& buffer) {
+  if (buffer.hasData()) writeBufferToSceneFile(writer, key, buffer);
+}
+
+template <typename T>
+void readComputedBufferFromSceneFile(const SceneFileReader& reader, const std::string& key,
+                                     render::ManagedBuffer<T>& buffer) {
+  if (reader.hasArray(key)) readBufferFromSceneFile(reader, key, buffer);
+}
+
+template <class Q>
+bool writeScalarQuantityToSceneFile(SceneFileWriter& writer, const std::string& prefix, const std::string& kind,
+                                    Quantity& quantity) {
+  Q* q = dynamic_cast<Q*>(&quantity);
+  if (q == nullptr) return false;
+  writer.writeString(prefix + "kind", kind);
+  writer.writeString(prefix + "name", q->name);
+  writer.writeValue<uint8_t>(prefix + "enabled", q->isEnabled());
+  writer.writeArray(prefix + "values", q->values.getPopulatedHostBufferRef());
+  writer.writeValue<uint32_t>(prefix + "dataType", static_cast<uint32_t>(q->getDataType()));
+  writer.writeString(prefix + "colorMap", q->getColorMap());
+  std::pair<double, double> mapRange = q->getMapRange();
+  writer.writeArray(prefix + "mapRange", std::vector<double>{mapRange.first, mapRange.second});
+  return true;
+}
+
+template <class Q>
+bool writeColorQuantityToSceneFile(SceneFileWriter& writer, const std::string& prefix, const std::string& kind,
+                                   Quantity& quantity) {
+  Q* q = dynamic_cast<Q*>(&quantity);
+  if (q == nullptr) return false;
+  writer.writeString(prefix + "kind", kind);
+  writer.writeString(prefix + "name", q->name);
+  writer.writeValue<uint8_t>(prefix + "enabled", q->isEnabled());
+  writer.writeArray(prefix + "colors", q->colors.getPopulatedHostBufferRef());
+  return true;
+}
+
+template <class Q>
+bool writeVectorQuantityToSceneFile(SceneFileWriter& writer, const std::string& prefix, const std::string& kind,
+                                    Quantity& quantity) {
+  Q* q = dynamic_cast<Q*>(&quantity);
+  if (q == nullptr) return false;
+  writer.writeString(prefix + "kind", kind);
+  writer.writeString(prefix + "name", q->name);
+  writer.writeValue<uint8_t>(prefix + "enabled", q->isEnabled());
+  writer.writeArray(prefix + "vectors", q->vectors.getPopulatedHostBufferRef());
+  writer.writeValue<uint32_t>(prefix + "vectorType", static_cast<uint32_t>(q->getVectorType()));
+  return true;
+}
+
+template <class Q>
+void SceneFileQuantity::restore(Q* quantity) const {
+  quantity->setEnabled(reader.readValue<uint8_t>(prefix + "enabled"));
+}
+
+template <class Q>
+void SceneFileQuantity::restoreScalar(Q* quantity) const {
+  quantity->setColorMap(reader.readString(prefix + "colorMap"));
+  std::vector<double> mapRange = reader.readArray<double>(prefix + "mapRange");
+  if (mapRange.size() == 2) quantity->setMapRange({mapRange[0], mapRange[1]});
+  restore(quantity);
+}
+
+} // namespace polyscope
@@ -4,6 +4,9 @@
 
 #include "polyscope/polyscope.h"
 
+#include <functional>
+#include <vector>
+
 namespace polyscope {
 
 
@@ -13,6 +16,80 @@ void screenshot(bool transparentBG = true);
 void saveImage(std::string name, unsigned char* buffer, int w, int h, int channels);
 void resetScreenshotIndex();
 
+// Like screenshot(), but only the render and readback happen on the calling thread. Fixing up the alpha channel,
+// encoding and writing the file are done by background threads. At most options::maxPendingScreenshots images are
+// held in memory at once; if that many are pending, this call waits for one to finish.
+void screenshotAsync(std::string filename, bool transparentBG = true);
+void screenshotAsync(bool transparentBG = true);
+
+// Wait until all screenshots from screenshotAsync() have been written. Throws if any of them could not be written.
+void flushScreenshots();
+
+// === Offscreen rendering to memory
+
+// Output of renderToBuffer(). The vectors are resized as needed, so reusing one object for many calls avoids
+// reallocating. All channels are stored row by row, top row first.
+struct RenderBufferData {
+  int width = 0;
+  int height = 0;
+  std::vector<unsigned char> color; // RGBA, 4 entries per pixel
+  std::vector<float> depth;         // depth buffer value in [0,1], 1 where nothing was drawn (if requested)
+  std::vector<size_t> pickInds;     // global pick index, see pick::globalIndexToLocal(), 0 where nothing was drawn (if
+                                    // requested)
+};
+
+// Render the current view at width x height, independent of the window size, and read the result in to memory
+void renderToBuffer(int width, int height, RenderBufferData& data, bool transparentBG = true, bool withDepth = false,
+                    bool withPickInds = false);
+
+// Same as above, but writes in to caller-provided memory: width*height*4 bytes of color, and width*height entries of
+// depth and pick indices. Any of the pointers may be nullptr to skip that channel.
+void renderToBuffer(int width, int height, unsigned char* color, float* depth = nullptr, size_t* pickInds = nullptr,
+                    bool transparentBG = true);
+
+// === Tiled high-resolution rendering
+
+// Render the current view at width x height, which may be far beyond the window size or the GPU's framebuffer limits.
+// The image is rendered in tiles of at most tileSize x tileSize pixels using a restricted projection (see
+// view::setProjectionTile()). It is produced one row of tiles at a time, so only one strip of the image is ever held
+// in memory. The callback receives each strip as RGBA pixels with the top row first, along with the index of its first
+// row and its number of rows. The pixel data is only valid during the call.
+void renderTiled(int width, int height, std::function<void(const unsigned char*, int, int)> stripCallback,
+                 bool transparentBG = true, int tileSize = 1024);
+
+// Render as in renderTiled(), streaming the image to an uncompressed PNG file
+void screenshotTiled(std::string filename, int width, int height, bool transparentBG = true, int tileSize = 1024);
+
+// === Raw frame streams
+
+// Stream successive rendered frames to a consumer such as a video encoder reading from a pipe, without encoding an
+// image file per frame. Frames are written from the calling thread, so a slow consumer applies backpressure. All
+// frames in a stream must have the same size. At most one stream is open at a time.
+//
+// Formats:
+//   - RGBA: raw 8-bit RGBA pixels, top row first, with no header (e.g. `ffmpeg -f rawvideo -pix_fmt rgba -s WxH -i -`)
+//   - Y4M:  YUV4MPEG2 video with 4:4:4 chroma, which ffmpeg and most players read directly
+enum class FrameStreamFormat { RGBA = 0, Y4M };
+
+// Open a stream writing to a file, or to an existing named pipe
+void openFrameStream(std::string filename, FrameStreamFormat format = FrameStreamFormat::RGBA, int fps = 30);
+
+// Open a stream writing to an already-open file descriptor, such as the write end of a pipe. The descriptor is not
+// closed by closeFrameStream().
+void openFrameStreamFD(int fileDescriptor, FrameStreamFormat format = FrameStreamFormat::RGBA, int fps = 30);
+
+// Open a stream which passes the encoded bytes to a callback, for consumers living in the same process. The data
+// pointer is only valid during the call.
+void openFrameStreamCallback(std::function<void(const unsigned char*, size_t)> callback,
+                             FrameStreamFormat format = FrameStreamFormat::RGBA, int fps = 30);
+
+// Render the current view and append it to the open stream. The readback and conversion buffers are reused from frame
+// to frame. transparentBG only affects the RGBA format.
+void writeFrame(bool transparentBG = false);
+
+void closeFrameStream();
+bool frameStreamIsOpen();
+
 
 namespace state {
 
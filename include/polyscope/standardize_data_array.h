@@ -3,8 +3,10 @@
 #pragma once
 
 #include "polyscope/messages.h"
+#include "polyscope/parallel.h"
 #include "polyscope/utilities.h"
 
+#include <algorithm>
 #include <type_traits>
 #include <vector>
 
@@ -145,6 +147,34 @@ struct InnerType {
   typedef typename std::remove_reference<decltype(std::declval<T>()[0])>::type type;
 };
 
+// Get the type pointed to by T.data(), for contiguous containers like std::vector<> or Eigen matrices. (An alias rather
+// than a struct like InnerType, so that a missing .data() is a substitution failure rather than an error.)
+template <typename T>
+using PointeeType =
+    typename std::remove_cv<typename std::remove_pointer<decltype(std::declval<T>().data())>::type>::type;
+
+// Inputs whose memory can be read directly are converted in chunks of this many entries, in parallel for large inputs
+const size_t standardizeArrayChunkSize = 1 << 16;
+
+// The spacing between consecutive entries of an input with a .data() pointer. Eigen blocks and maps (e.g. a column of a
+// row-major matrix) have a .innerStride(), anything else is assumed to be contiguous.
+template <class T,
+  /* condition: has .innerStride() method which returns something that can be cast to size_t */
+  typename C1 = decltype((size_t)(std::declval<T>()).innerStride())>
+size_t adaptorF_innerStrideImpl(PreferenceT<1>, const T& inputData) {
+  return static_cast<size_t>(inputData.innerStride());
+}
+
+template <class T>
+size_t adaptorF_innerStrideImpl(PreferenceT<0>, const T& inputData) {
+  return 1;
+}
+
+template <class T>
+size_t adaptorF_innerStride(const T& inputData) {
+  return adaptorF_innerStrideImpl(PreferenceT<1>{}, inputData);
+}
+
 
 // =================================================
 // ============ array size adapator
@@ -263,12 +293,45 @@ void adaptorF_convertToStdVectorImpl(PreferenceT<4>, const T& inputData, std::ve
 }
 
 
+// Fast path for bracket-accessible inputs which also expose their memory via .data() (std::vector<>, Eigen vectors,
+// etc). The values are copied (or converted) in bulk, rather than one operator[] call at a time. Returns false if the
+// input turns out not to be contiguous, in which case the caller falls back on operator[].
+template <class T, class S,
+  /* helper type: the type pointed to by .data() */
+  typename C_DATA = PointeeType<T>,
+  /* condition: .data() points to arithmetic values, and the output is an arithmetic type with addressable storage */
+  typename C1 = typename std::enable_if<std::is_arithmetic<C_DATA>::value && std::is_arithmetic<S>::value &&
+                                        !std::is_same<S, bool>::value>::type>
+
+bool adaptorF_convertContiguousToStdVector(PreferenceT<1>, const T& inputData, std::vector<S>& dataOut) {
+  if (adaptorF_innerStride(inputData) != 1) return false;
+
+  size_t dataSize = adaptorF_size(inputData);
+  dataOut.resize(dataSize);
+  if (dataSize == 0) return true;
+
+  const C_DATA* src = inputData.data();
+  S* dst = &dataOut.front();
+  parallelForChunks(dataSize, standardizeArrayChunkSize, [&](size_t iChunk, size_t start, size_t end) {
+    std::copy(src + start, src + end, dst + start); // a memmove if the types match, a vectorizable loop otherwise
+  });
+  return true;
+}
+
+template <class T, class S>
+bool adaptorF_convertContiguousToStdVector(PreferenceT<0>, const T& inputData, std::vector<S>& dataOut) {
+  return false;
+}
+
+
 // Next: any bracket access operator
 template <class T, class S,
   /* condition: input can be bracket-indexed to get an S */
   typename C1 = typename std::enable_if<std::is_same<decltype((S)(std::declval<T>())[(size_t)0]), S>::value>::type>
 
 void adaptorF_convertToStdVectorImpl(PreferenceT<3>, const T& inputData, std::vector<S>& dataOut) {
+  if (adaptorF_convertContiguousToStdVector(PreferenceT<1>{}, inputData, dataOut)) return;
+
   size_t dataSize = adaptorF_size(inputData);
   dataOut.resize(dataSize);
   for (size_t i = 0; i < dataSize; i++) {
@@ -615,6 +678,48 @@ std::vector<O> adaptorF_convertArrayOfVectorToStdVectorImpl(PreferenceT<8>, cons
 }
 
 
+// Fast path for dense matrices which expose their memory, like Eigen matrices and maps with any storage order. Entries
+// are read straight from memory with the matrix's strides, rather than through operator(). Returns false if the matrix
+// does not have exactly D columns, in which case the caller falls back on operator().
+template <class O, unsigned int D, class T,
+    /* helper type: the type pointed to by .data() */
+    typename C_DATA = PointeeType<T>,
+    /* condition: .data() points to arithmetic values */
+    typename C1 = typename std::enable_if<std::is_arithmetic<C_DATA>::value>::type,
+    /* condition: has .cols(), .innerStride(), .outerStride() and a compile-time IsRowMajor flag, like Eigen types */
+    typename C2 = decltype((size_t)(std::declval<T>()).cols()),
+    typename C3 = decltype((size_t)(std::declval<T>()).innerStride()),
+    typename C4 = decltype((size_t)(std::declval<T>()).outerStride()),
+    typename C5 = decltype((bool)T::IsRowMajor)>
+
+bool adaptorF_convertStridedMatrixToStdVector(PreferenceT<1>, const T& inputData, std::vector<O>& dataOut) {
+  if (static_cast<size_t>(inputData.cols()) != D) return false;
+
+  size_t dataSize = adaptorF_size(inputData);
+  dataOut.resize(dataSize);
+  if (dataSize == 0) return true;
+
+  size_t innerStride = static_cast<size_t>(inputData.innerStride());
+  size_t outerStride = static_cast<size_t>(inputData.outerStride());
+  size_t rowStride = T::IsRowMajor ? outerStride : innerStride;
+  size_t colStride = T::IsRowMajor ? innerStride : outerStride;
+  const C_DATA* src = inputData.data();
+  parallelForChunks(dataSize, standardizeArrayChunkSize, [&](size_t iChunk, size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      for (size_t j = 0; j < D; j++) {
+        dataOut[i][j] = src[i * rowStride + j * colStride];
+      }
+    }
+  });
+  return true;
+}
+
+template <class O, unsigned int D, class T>
+bool adaptorF_convertStridedMatrixToStdVector(PreferenceT<0>, const T& inputData, std::vector<O>& dataOut) {
+  return false;
+}
+
+
 // Next: any dense callable (parenthesis) access operator
 template <class O, unsigned int D, class T,
     /* condition: input can be called with two integer arguments to get something that can be cast to the inner type of O */
@@ -623,8 +728,11 @@ template <class O, unsigned int D, class T,
                                           typename InnerType<O>::type>::value>::type>
 
 std::vector<O> adaptorF_convertArrayOfVectorToStdVectorImpl(PreferenceT<7>, const T& inputData) {
+  std::vector<O> dataOut;
+  if (adaptorF_convertStridedMatrixToStdVector<O, D, T>(PreferenceT<1>{}, inputData, dataOut)) return dataOut;
+
   size_t dataSize = adaptorF_size(inputData);
-  std::vector<O> dataOut(dataSize);
+  dataOut.resize(dataSize);
   for (size_t i = 0; i < dataSize; i++) {
     for (size_t j = 0; j < D; j++) {
       dataOut[i][j] = inputData(i, j);
@@ -634,6 +742,46 @@ std::vector<O> adaptorF_convertArrayOfVectorToStdVectorImpl(PreferenceT<7>, cons
 }
 
 
+// Fast path for contiguous arrays of packed fixed-size vectors, like std::vector<glm::vec3> or
+// std::vector<std::array<double,3>>, which are read as one flat array of scalars. Identical types are copied in bulk.
+template <class O, unsigned int D, class T,
+    /* helper type: the element type pointed to by .data() */
+    typename C_ELEM = PointeeType<T>,
+    /* helper type: the scalar type inside of each element */
+    typename C_SCALAR = typename std::remove_cv<typename std::remove_reference<decltype(std::declval<C_ELEM>()[0])>::type>::type,
+    /* condition: each element is exactly D packed arithmetic values, with no padding or indirection */
+    typename C1 = typename std::enable_if<std::is_arithmetic<C_SCALAR>::value &&
+                                          std::is_trivially_copyable<C_ELEM>::value &&
+                                          std::is_standard_layout<C_ELEM>::value &&
+                                          sizeof(C_ELEM) == D * sizeof(C_SCALAR)>::type>
+
+bool adaptorF_convertContiguousArrayOfVectorToStdVector(PreferenceT<1>, const T& inputData, std::vector<O>& dataOut) {
+  size_t dataSize = adaptorF_size(inputData);
+  dataOut.resize(dataSize);
+  if (dataSize == 0) return true;
+
+  const C_ELEM* srcElems = inputData.data();
+  const C_SCALAR* src = reinterpret_cast<const C_SCALAR*>(srcElems);
+  parallelForChunks(dataSize, standardizeArrayChunkSize, [&](size_t iChunk, size_t start, size_t end) {
+    if (std::is_same<C_ELEM, O>::value) {
+      std::copy(srcElems + start, srcElems + end, reinterpret_cast<C_ELEM*>(&dataOut[start]));
+      return;
+    }
+    for (size_t i = start; i < end; i++) {
+      for (size_t j = 0; j < D; j++) {
+        dataOut[i][j] = src[D * i + j];
+      }
+    }
+  });
+  return true;
+}
+
+template <class O, unsigned int D, class T>
+bool adaptorF_convertContiguousArrayOfVectorToStdVector(PreferenceT<0>, const T& inputData, std::vector<O>& dataOut) {
+  return false;
+}
+
+
 // Next: any dense bracket access operator
 template <class O, unsigned int D, class T,
     /* condition: input can be bracket-indexed twice to get something that can be cast to the inner type of O */
@@ -642,8 +790,13 @@ template <class O, unsigned int D, class T,
                                           typename InnerType<O>::type>::value>::type>
 
 std::vector<O> adaptorF_convertArrayOfVectorToStdVectorImpl(PreferenceT<6>, const T& inputData) {
+  std::vector<O> dataOut;
+  if (adaptorF_convertContiguousArrayOfVectorToStdVector<O, D, T>(PreferenceT<1>{}, inputData, dataOut)) {
+    return dataOut;
+  }
+
   size_t dataSize = adaptorF_size(inputData);
-  std::vector<O> dataOut(dataSize);
+  dataOut.resize(dataSize);
   for (size_t i = 0; i < dataSize; i++) {
     for (size_t j = 0; j < D; j++) {
       dataOut[i][j] = inputData[i][j];
@@ -16,6 +16,8 @@
 
 namespace polyscope {
 
+class SceneFileReader;
+class SceneFileWriter;
 
 // A 'structure' in Polyscope terms, is an object with which we can associate data in the UI, such as a point cloud,
 // or a mesh. This in contrast to 'quantities', which we associate with the structures. For instance, a surface mesh
@@ -62,6 +64,11 @@ public:
   float lengthScale();                            // get characteristic length
   virtual bool hasExtents();                      // bounding box and length scale are only meaningful if true
 
+  // = View culling
+  // Conservative test for whether any of the structure might be inside the current view frustum. Structures for which
+  // this is false are not drawn (if options::enableViewCulling is set).
+  bool mayBeInView();
+
   // = Basic state
   virtual std::string typeName() = 0;
 
@@ -85,6 +92,10 @@ public:
   // Get rid of it (invalidates the object and all pointers, etc!)
   void remove();
 
+  // Write the structure's data to a scene file (see scene_file.h), under keys starting with prefix. Returns false if
+  // scene files cannot hold this type of structure.
+  virtual bool writeToSceneFile(SceneFileWriter& writer, const std::string& prefix);
+
   // Selection tools
   virtual Structure* setEnabled(bool newEnabled);
   bool isEnabled();
@@ -123,6 +134,24 @@ protected:
   std::tuple<glm::vec3, glm::vec3> objectSpaceBoundingBox;
   float objectSpaceLengthScale;
   virtual void updateObjectSpaceBounds() = 0;
+
+  // Bounds may be left stale and recomputed on demand. boundingBox() and lengthScale() always ensure they are current;
+  // anything reading the objectSpace members directly should call ensureObjectSpaceBoundsUpdated() first.
+  bool objectSpaceBoundsStale = false;
+  uint64_t objectSpaceBoundsStaleDraw = 0; // internal::drawCount when the bounds were last marked stale
+  void objectSpaceBoundsChanged(); // recompute now, or mark stale if options::deferStructureBounds
+  void markObjectSpaceBoundsStale();
+  void ensureObjectSpaceBoundsUpdated();
+
+  // Culling needs current bounds, but recomputing them after every position update would undo the point of deferring
+  // them. So while the geometry keeps changing the structure is not culled; once it has been drawn a frame without
+  // changes, this recomputes the bounds (once) and returns true.
+  bool objectSpaceBoundsReadyForCulling();
+
+  // Structures opt in to view culling by overriding these, since only they know whether everything they draw stays
+  // within their bounds. By default structures are never culled.
+  virtual bool isCullable();
+  virtual float cullingMargin(); // world-space padding around the bounds, e.g. for point radii
 };
 
 
@@ -187,6 +216,9 @@ public:
 
   void setAllQuantitiesEnabled(bool newEnabled);
 
+  // True if no enabled quantity draws outside of the structure's bounds, so the structure may be culled
+  bool quantitiesStayWithinBounds();
+
   // = Quantities
   std::map<std::string, std::unique_ptr<QuantityType>> quantities;
   QuantityS<S>* dominantQuantity = nullptr; // If non-null, a special quantity of which only one can be drawn for
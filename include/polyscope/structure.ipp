@@ -108,6 +108,17 @@ void QuantityStructure<S>::refresh() {
   requestRedraw();
 }
 
+template <typename S>
+bool QuantityStructure<S>::quantitiesStayWithinBounds() {
+  for (auto& qp : quantities) {
+    if (qp.second->isEnabled() && qp.second->drawsOutsideStructureBounds()) return false;
+  }
+  for (auto& qp : floatingQuantities) {
+    if (qp.second->isEnabled()) return false; // e.g. images drawn in screen space
+  }
+  return true;
+}
+
 template <typename S>
 void QuantityStructure<S>::removeQuantity(std::string name, bool errorIfAbsent) {
 
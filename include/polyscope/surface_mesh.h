@@ -63,10 +63,17 @@ public:
   SurfaceMesh(std::string name, const std::vector<glm::vec3>& vertexPositions,
               const std::vector<uint32_t>& faceIndsEntries, const std::vector<uint32_t>& faceIndsStart);
 
+  // From flattened list, taking ownership of the arrays rather than copying them
+  SurfaceMesh(std::string name, std::vector<glm::vec3>&& vertexPositions, std::vector<uint32_t>&& faceIndsEntries,
+              std::vector<uint32_t>&& faceIndsStart);
+
   // Construct from a nested face list
   SurfaceMesh(std::string name, const std::vector<glm::vec3>& vertexPositions,
               const std::vector<std::vector<size_t>>& faceIndices);
 
+  // Re-create a mesh written by writeToSceneFile() (see scene_file.h), including its computed connectivity
+  static SurfaceMesh* createFromSceneFile(const SceneFileReader& reader, const std::string& prefix, std::string name);
+
 
   // Build the imgui display
   virtual void buildCustomUI() override;
@@ -78,8 +85,10 @@ public:
   virtual void drawDelayed() override;
   virtual void drawPick() override;
   virtual void updateObjectSpaceBounds() override;
+  virtual bool isCullable() override;
   virtual std::string typeName() override;
   virtual void refresh() override;
+  virtual bool writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) override;
 
   // Mesh connectivity
   // (end users probably should not mess with theses)
@@ -339,6 +348,16 @@ private:
   void prepare();
   void preparePick();
 
+  // View culling of blocks of triangles ("meshlets", in the triangulated face order). Boxes are recomputed lazily after
+  // the bounds change; the visible ranges are recomputed at each draw and applied to every program which draws the
+  // surface.
+  std::vector<std::tuple<glm::vec3, glm::vec3>> cullingBlockBoxes;
+  bool cullingBlockBoxesStale = true;
+  std::vector<std::pair<size_t, size_t>> visibleDrawRanges;
+  bool useVisibleDrawRanges = false;
+  void updateVisibleDrawRanges();
+  void setVisibleDrawRanges(render::ShaderProgram& p);
+
 
   /// == Compute indices & geometry data
   void computeTriangleCornerInds();
@@ -416,6 +435,33 @@ template <class V, class F, class P>
 SurfaceMesh* registerSurfaceMesh(std::string name, const V& vertexPositions, const F& faceIndices,
                                  const std::array<std::pair<P, size_t>, 5>& perms);
 
+// Register a mesh from faces in flat form, the way SurfaceMesh stores them: the vertices of face i are
+// faceIndsEntries[faceIndsStart[i]] to faceIndsEntries[faceIndsStart[i+1]-1], and faceIndsStart has nFaces+1 entries.
+// Unlike the face lists above, this never makes a list per face. Any arrays the adaptors accept can be used.
+template <class V, class E, class S>
+SurfaceMesh* registerSurfaceMeshFlat(std::string name, const V& vertexPositions, const E& faceIndsEntries,
+                                     const S& faceIndsStart);
+// As above, moving the arrays in to the mesh rather than copying them
+SurfaceMesh* registerSurfaceMeshFlat(std::string name, std::vector<glm::vec3>&& vertexPositions,
+                                     std::vector<uint32_t>&& faceIndsEntries, std::vector<uint32_t>&& faceIndsStart);
+
+// Register a mesh whose faces all have D vertices (3 for triangles, 4 for quads), from an FxD array in any form the
+// adaptors accept, like an Eigen matrix in either storage order or a std::vector<std::array<int, 3>>. Unlike
+// registerSurfaceMesh(), this never makes a list per face. For example, registerSurfaceMeshFixedDegree<3>(name, V, F).
+template <size_t D, class V, class F>
+SurfaceMesh* registerSurfaceMeshFixedDegree(std::string name, const V& vertexPositions, const F& faceIndices);
+
+// As above, reading nFaces * faceDegree indices from memory. Vertex j of face i is faceInds[i * faceStride + j *
+// cornerStride]. Without strides, the indices must be in row-major order (faceStride = faceDegree, cornerStride = 1),
+// like the data of a std::vector<std::array<int, 3>> or a row-major matrix. For a column-major FxD matrix, like the
+// default Eigen::MatrixXi, pass faceStride = 1 and cornerStride = F.rows(), or use the form above.
+template <class V, class I>
+SurfaceMesh* registerSurfaceMeshFixedDegree(std::string name, const V& vertexPositions, const I* faceInds,
+                                            size_t nFaces, size_t faceDegree);
+template <class V, class I>
+SurfaceMesh* registerSurfaceMeshFixedDegree(std::string name, const V& vertexPositions, const I* faceInds,
+                                            size_t nFaces, size_t faceDegree, size_t faceStride, size_t cornerStride);
+
 
 // Shorthand to get a mesh from polyscope
 inline SurfaceMesh* getSurfaceMesh(std::string name = "");
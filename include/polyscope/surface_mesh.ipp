@@ -16,8 +16,8 @@ SurfaceMesh* registerSurfaceMesh(std::string name, const V& vertexPositions, con
   std::vector<uint32_t>& faceIndsEntries = std::get<0>(nestedListTup);
   std::vector<uint32_t>& faceIndsStart = std::get<1>(nestedListTup);
 
-  SurfaceMesh* s =
-      new SurfaceMesh(name, standardizeVectorArray<glm::vec3, 3>(vertexPositions), faceIndsEntries, faceIndsStart);
+  SurfaceMesh* s = new SurfaceMesh(name, standardizeVectorArray<glm::vec3, 3>(vertexPositions),
+                                   std::move(faceIndsEntries), std::move(faceIndsStart));
 
   bool success = registerStructure(s);
   if (!success) {
@@ -38,11 +38,60 @@ SurfaceMesh* registerSurfaceMesh2D(std::string name, const V& vertexPositions, c
   return registerSurfaceMesh(name, positions3D, faceIndices);
 }
 
+template <class V, class E, class S>
+SurfaceMesh* registerSurfaceMeshFlat(std::string name, const V& vertexPositions, const E& faceIndsEntries,
+                                     const S& faceIndsStart) {
+  return registerSurfaceMeshFlat(name, standardizeVectorArray<glm::vec3, 3>(vertexPositions),
+                                 standardizeArray<uint32_t, E>(faceIndsEntries),
+                                 standardizeArray<uint32_t, S>(faceIndsStart));
+}
+
+template <size_t D, class V, class F>
+SurfaceMesh* registerSurfaceMeshFixedDegree(std::string name, const V& vertexPositions, const F& faceIndices) {
+  static_assert(D >= 3, "faces must have at least 3 vertices");
+  std::vector<std::array<uint32_t, D>> faces = standardizeVectorArray<std::array<uint32_t, D>, D>(faceIndices);
+  const uint32_t* faceInds = faces.empty() ? nullptr : &faces[0][0];
+  return registerSurfaceMeshFixedDegree(name, vertexPositions, faceInds, faces.size(), D);
+}
+
+template <class V, class I>
+SurfaceMesh* registerSurfaceMeshFixedDegree(std::string name, const V& vertexPositions, const I* faceInds,
+                                            size_t nFaces, size_t faceDegree) {
+  return registerSurfaceMeshFixedDegree(name, vertexPositions, faceInds, nFaces, faceDegree, faceDegree, 1);
+}
+
+template <class V, class I>
+SurfaceMesh* registerSurfaceMeshFixedDegree(std::string name, const V& vertexPositions, const I* faceInds,
+                                            size_t nFaces, size_t faceDegree, size_t faceStride, size_t cornerStride) {
+  if (faceDegree < 3) {
+    exception("SurfaceMesh " + name + " faces must have at least 3 vertices, not " + std::to_string(faceDegree));
+  }
+
+  std::vector<uint32_t> faceIndsEntries(nFaces * faceDegree);
+  if (faceStride == faceDegree && cornerStride == 1) {
+    std::copy(faceInds, faceInds + nFaces * faceDegree, faceIndsEntries.begin());
+  } else {
+    for (size_t iF = 0; iF < nFaces; iF++) {
+      for (size_t j = 0; j < faceDegree; j++) {
+        faceIndsEntries[iF * faceDegree + j] = static_cast<uint32_t>(faceInds[iF * faceStride + j * cornerStride]);
+      }
+    }
+  }
+  std::vector<uint32_t> faceIndsStart(nFaces + 1);
+  for (size_t iF = 0; iF <= nFaces; iF++) {
+    faceIndsStart[iF] = static_cast<uint32_t>(iF * faceDegree);
+  }
+
+  return registerSurfaceMeshFlat(name, standardizeVectorArray<glm::vec3, 3>(vertexPositions),
+                                 std::move(faceIndsEntries), std::move(faceIndsStart));
+}
+
 template <class V>
 void SurfaceMesh::updateVertexPositions(const V& newPositions) {
   validateSize(newPositions, vertexDataSize, "newPositions");
   vertexPositions.data = standardizeVectorArray<glm::vec3, 3>(newPositions);
   vertexPositions.markHostBufferUpdated();
+  markObjectSpaceBoundsStale();
   recomputeGeometryIfPopulated();
 }
 
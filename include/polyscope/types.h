@@ -16,6 +16,7 @@ enum class GroundPlaneMode { None, Tile, TileReflection, ShadowOnly };
 enum class BackFacePolicy { Identical, Different, Custom, Cull };
 
 enum class PointRenderMode { Sphere = 0, Quad };
+enum class CurveNetworkRenderMode { Tube = 0, Line };
 enum class MeshElement { VERTEX = 0, FACE, EDGE, HALFEDGE, CORNER };
 enum class MeshShadeStyle { Smooth = 0, Flat, TriFlat };
 enum class VolumeMeshElement { VERTEX = 0, EDGE, FACE, CELL };
@@ -34,5 +35,11 @@ enum class ParamVizStyle { CHECKER = 0, GRID, LOCAL_CHECK, LOCAL_RAD }; // TODO
 // MAGNITUDE: [0, inf], zero is special (ie, length of a vector)
 enum class DataType { STANDARD = 0, SYMMETRIC, MAGNITUDE };
 
+// How the range of a scalar quantity follows new values passed to updateData() or appended, e.g. when animating a field
+// Fixed: keep the data range and colormap range as they are
+// Running: grow the data range to a running min/max of all values seen. The colormap range follows it, unless it was
+//          set by hand (setMapRange(), the UI or resetMapRangeToPercentiles()); resetMapRange() makes it follow again.
+enum class ScalarRangeUpdate { Fixed = 0, Running };
+
 
 }; // namespace polyscope
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "polyscope/affine_remapper.h"
+#include "polyscope/parallel.h"
 #include "polyscope/persistent_value.h"
 #include "polyscope/polyscope.h"
 #include "polyscope/render/engine.h"
@@ -10,11 +11,16 @@
 #include "polyscope/scaled_value.h"
 #include "polyscope/types.h"
 
+#include <atomic>
+
 
 namespace polyscope {
 
 // These classes encapsulate logic which is common to all vector quantities
 
+// Smallest screen cell used for vector decimation, which bounds the size of the cell grid
+const float minVectorDecimationPixels = 2.;
+
 // ================================================
 // === Base Vector Quantity
 // ================================================
@@ -59,6 +65,18 @@ public:
   QuantityT* setMaterial(std::string name);
   std::string getMaterial();
 
+  // Screen-space decimation. When positive, at most one vector (the longest one) is drawn in each square cell of this
+  // many pixels, at least minVectorDecimationPixels. The selection is recomputed only when the view, the data or these
+  // settings change. 0 disables decimation.
+  QuantityT* setVectorDecimationPixels(float pixels);
+  float getVectorDecimationPixels();
+
+  // Vectors whose magnitude (in the units of the input data) is less than this threshold are not drawn
+  QuantityT* setVectorMagnitudeThreshold(double val);
+  double getVectorMagnitudeThreshold();
+
+  VectorType getVectorType() const;
+
 
 protected:
   const VectorType vectorType;
@@ -68,11 +86,33 @@ protected:
   PersistentValue<ScaledValue<float>> vectorRadius;
   PersistentValue<glm::vec3> vectorColor;
   PersistentValue<std::string> material;
+  PersistentValue<float> vectorDecimationPixels;
+  PersistentValue<float> vectorMagnitudeThreshold;
 
   float vectorLengthRange = -1.;
   bool vectorLengthRangeManuallySet = false;
 
   std::shared_ptr<render::ShaderProgram> vectorProgram;
+
+  // Decimated drawing. The program reads the same attribute buffers as vectorProgram, but only draws the indices in
+  // decimatedInds, which are updated when the view or data changes.
+  std::shared_ptr<render::ShaderProgram> decimatedVectorProgram;
+  std::vector<uint32_t> decimatedInds;
+  glm::mat4 decimatedViewProjection;
+  glm::vec4 decimatedViewport;
+  float decimatedCellSize = -1.;
+  float decimatedMagnitudeThreshold = -1.;
+  uint64_t decimatedRootsVersion = 0; // the roots' ManagedBuffer::getDataVersion(), since the parent may move them
+  bool decimatedIndsDirty = true;
+
+  // Helpers
+  bool useDecimation();
+  void setVectorUniforms(render::ShaderProgram& p);
+  std::vector<std::string> addVectorRules(std::vector<std::string> initRules, std::string cullMagnitudeRule);
+
+  // Select one vector per screen cell, recomputing only if the view changed. Returns true if the selection changed.
+  template <typename MagnitudeFunc>
+  bool updateDecimatedInds(render::ManagedBuffer<glm::vec3>& vectorRoots, MagnitudeFunc vectorMagnitude);
 };
 
 // ================================================
@@ -113,6 +153,8 @@ public:
 protected:
   // helpers
   void createProgram();
+  void createDecimatedProgram();
+  void fillProgramBuffers(render::ShaderProgram& p);
   void updateMaxLength();
 
   std::vector<glm::vec3> vectorsData;
@@ -156,6 +198,8 @@ public:
 protected:
   // helpers
   void createProgram();
+  void createDecimatedProgram();
+  void fillProgramBuffers(render::ShaderProgram& p);
   void updateMaxLength();
 
   std::vector<glm::vec2> tangentVectorsData;
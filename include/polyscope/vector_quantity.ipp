@@ -3,6 +3,8 @@
 
 #include "polyscope/standardize_data_array.h"
 
+#include <cstring>
+
 namespace polyscope {
 
 // ================================================
@@ -16,7 +18,9 @@ VectorQuantityBase<QuantityT>::VectorQuantityBase(QuantityT& quantity_, VectorTy
                        vectorType == VectorType::AMBIENT ? absoluteValue(1.0) : relativeValue(0.02)),
       vectorRadius(quantity.uniquePrefix() + "#vectorRadius", relativeValue(0.0025)),
       vectorColor(quantity.uniquePrefix() + "#vectorColor", getNextUniqueColor()),
-      material(quantity.uniquePrefix() + "#material", "clay") {}
+      material(quantity.uniquePrefix() + "#material", "clay"),
+      vectorDecimationPixels(quantity.uniquePrefix() + "#vectorDecimationPixels", 0.),
+      vectorMagnitudeThreshold(quantity.uniquePrefix() + "#vectorMagnitudeThreshold", 0.) {}
 
 template <typename QuantityT>
 void VectorQuantityBase<QuantityT>::buildVectorUI() {
@@ -34,6 +38,18 @@ void VectorQuantityBase<QuantityT>::buildVectorUI() {
       material.manuallyChanged();
       setMaterial(material.get()); // trigger the other updates that happen on set()
     }
+
+    ImGui::PushItemWidth(100);
+    float decimationPixels = getVectorDecimationPixels();
+    if (ImGui::SliderFloat("Decimation (px)", &decimationPixels, 0., 64., "%.0f")) {
+      setVectorDecimationPixels(decimationPixels);
+    }
+    float threshold = getVectorMagnitudeThreshold();
+    if (ImGui::InputFloat("Min magnitude", &threshold)) {
+      setVectorMagnitudeThreshold(threshold);
+    }
+    ImGui::PopItemWidth();
+
     ImGui::EndPopup();
   }
 
@@ -107,6 +123,7 @@ template <typename QuantityT>
 QuantityT* VectorQuantityBase<QuantityT>::setMaterial(std::string m) {
   material = m;
   if (vectorProgram) render::engine->setMaterial(*vectorProgram, getMaterial());
+  if (decimatedVectorProgram) render::engine->setMaterial(*decimatedVectorProgram, getMaterial());
   requestRedraw();
   return &quantity;
 }
@@ -115,6 +132,146 @@ std::string VectorQuantityBase<QuantityT>::getMaterial() {
   return material.get();
 }
 
+template <typename QuantityT>
+QuantityT* VectorQuantityBase<QuantityT>::setVectorDecimationPixels(float pixels) {
+  if (pixels > 0.) pixels = std::max(pixels, minVectorDecimationPixels);
+  vectorDecimationPixels = std::max(pixels, 0.f);
+  requestRedraw();
+  return &quantity;
+}
+template <typename QuantityT>
+float VectorQuantityBase<QuantityT>::getVectorDecimationPixels() {
+  return vectorDecimationPixels.get();
+}
+
+template <typename QuantityT>
+QuantityT* VectorQuantityBase<QuantityT>::setVectorMagnitudeThreshold(double val) {
+  vectorMagnitudeThreshold = val;
+  // the culling rule is only added to the programs when the threshold is positive
+  vectorProgram.reset();
+  decimatedVectorProgram.reset();
+  requestRedraw();
+  return &quantity;
+}
+template <typename QuantityT>
+double VectorQuantityBase<QuantityT>::getVectorMagnitudeThreshold() {
+  return vectorMagnitudeThreshold.get();
+}
+
+template <typename QuantityT>
+VectorType VectorQuantityBase<QuantityT>::getVectorType() const {
+  return vectorType;
+}
+
+template <typename QuantityT>
+bool VectorQuantityBase<QuantityT>::useDecimation() {
+  return vectorDecimationPixels.get() > 0.;
+}
+
+template <typename QuantityT>
+void VectorQuantityBase<QuantityT>::setVectorUniforms(render::ShaderProgram& p) {
+  quantity.parent.setStructureUniforms(p);
+  p.setUniform("u_radius", vectorRadius.get().asAbsolute());
+  p.setUniform("u_baseColor", vectorColor.get());
+
+  if (vectorType == VectorType::AMBIENT) {
+    p.setUniform("u_lengthMult", 1.0);
+  } else {
+    p.setUniform("u_lengthMult", vectorLengthMult.get().asAbsolute() / vectorLengthRange);
+  }
+
+  glm::mat4 P = view::getCameraPerspectiveMatrix();
+  glm::mat4 Pinv = glm::inverse(P);
+  p.setUniform("u_invProjMatrix", glm::value_ptr(Pinv));
+  p.setUniform("u_viewport", render::engine->getCurrentViewport());
+
+  if (p.hasUniform("u_vectorMagnitudeThreshold")) {
+    p.setUniform("u_vectorMagnitudeThreshold", vectorMagnitudeThreshold.get());
+  }
+}
+
+template <typename QuantityT>
+std::vector<std::string> VectorQuantityBase<QuantityT>::addVectorRules(std::vector<std::string> initRules,
+                                                                       std::string cullMagnitudeRule) {
+  initRules = quantity.parent.addStructureRules(initRules);
+  if (quantity.parent.wantsCullPosition()) {
+    initRules.push_back("VECTOR_CULLPOS_FROM_TAIL");
+  }
+  if (vectorMagnitudeThreshold.get() > 0.) {
+    initRules.push_back(cullMagnitudeRule);
+  }
+  return initRules;
+}
+
+template <typename QuantityT>
+template <typename MagnitudeFunc>
+bool VectorQuantityBase<QuantityT>::updateDecimatedInds(render::ManagedBuffer<glm::vec3>& vectorRoots,
+                                                        MagnitudeFunc vectorMagnitude) {
+
+  glm::mat4 viewProjection = view::getCameraPerspectiveMatrix() * quantity.parent.getModelView();
+  glm::vec4 viewport = render::engine->getCurrentViewport();
+  float cellSize = std::max(getVectorDecimationPixels(), minVectorDecimationPixels);
+  float threshold = vectorMagnitudeThreshold.get();
+  uint64_t rootsVersion = vectorRoots.getDataVersion();
+  if (!decimatedIndsDirty && viewProjection == decimatedViewProjection && viewport == decimatedViewport &&
+      cellSize == decimatedCellSize && threshold == decimatedMagnitudeThreshold &&
+      rootsVersion == decimatedRootsVersion) {
+    return false;
+  }
+  decimatedIndsDirty = false;
+  decimatedRootsVersion = rootsVersion;
+  decimatedViewProjection = viewProjection;
+  decimatedViewport = viewport;
+  decimatedCellSize = cellSize;
+  decimatedMagnitudeThreshold = threshold;
+
+  size_t nCellX = static_cast<size_t>(std::ceil(viewport[2] / cellSize));
+  size_t nCellY = static_cast<size_t>(std::ceil(viewport[3] / cellSize));
+  decimatedInds.clear();
+  if (nCellX == 0 || nCellY == 0) {
+    return true;
+  }
+
+  // Bin the roots in to screen cells in parallel, keeping the longest vector in each. Each cell holds the best
+  // (magnitude, index) pair packed in to one integer, with the magnitude's bits on top (they order like the value, for
+  // non-negative floats) and the inverted index below (so ties go to the lowest index). 0 marks an empty cell.
+  std::vector<std::atomic<uint64_t>> cellBest(nCellX * nCellY);
+  for (std::atomic<uint64_t>& c : cellBest) c.store(0, std::memory_order_relaxed);
+
+  vectorRoots.ensureHostBufferPopulated();
+  const size_t decimationChunkSize = 1 << 14;
+  parallelForChunks(vectorRoots.size(), decimationChunkSize, [&](size_t, size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      float magnitude = vectorMagnitude(i);
+      if (!(magnitude >= threshold) || !(magnitude >= 0.)) continue; // (also skips NaN)
+
+      glm::vec4 clipPos = viewProjection * glm::vec4(vectorRoots.data[i], 1.);
+      if (clipPos.w <= 0.) continue;
+      float ndcX = clipPos.x / clipPos.w;
+      float ndcY = clipPos.y / clipPos.w;
+      if (ndcX < -1. || ndcX > 1. || ndcY < -1. || ndcY > 1.) continue;
+
+      size_t cellX = std::min(nCellX - 1, static_cast<size_t>((0.5f * ndcX + 0.5f) * viewport[2] / cellSize));
+      size_t cellY = std::min(nCellY - 1, static_cast<size_t>((0.5f * ndcY + 0.5f) * viewport[3] / cellSize));
+      std::atomic<uint64_t>& cell = cellBest[cellY * nCellX + cellX];
+
+      uint32_t magnitudeBits;
+      std::memcpy(&magnitudeBits, &magnitude, sizeof(float));
+      uint64_t key = (static_cast<uint64_t>(magnitudeBits) << 32) | (INVALID_IND_32 - static_cast<uint32_t>(i));
+      uint64_t current = cell.load(std::memory_order_relaxed);
+      while (key > current && !cell.compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+      }
+    }
+  });
+
+  for (const std::atomic<uint64_t>& c : cellBest) {
+    uint64_t key = c.load(std::memory_order_relaxed);
+    if (key != 0) decimatedInds.push_back(INVALID_IND_32 - static_cast<uint32_t>(key & 0xFFFFFFFF));
+  }
+
+  return true;
+}
+
 // ================================================
 // === (3D) Vector Quantity
 // ================================================
@@ -129,26 +286,32 @@ VectorQuantity<QuantityT>::VectorQuantity(QuantityT& quantity_, const std::vecto
 
 template <typename QuantityT>
 void VectorQuantity<QuantityT>::drawVectors() {
+
+  if (this->useDecimation()) {
+    if (!this->decimatedVectorProgram) {
+      createDecimatedProgram();
+    }
+
+    vectors.ensureHostBufferPopulated();
+    if (this->updateDecimatedInds(vectorRoots, [&](size_t i) { return glm::length(vectors.data[i]); })) {
+      if (this->decimatedInds.empty()) return;
+      this->decimatedVectorProgram->setIndex(this->decimatedInds);
+    }
+    if (this->decimatedInds.empty()) return;
+
+    this->setVectorUniforms(*(this->decimatedVectorProgram));
+    vectorRoots.setDequantizeUniforms(*(this->decimatedVectorProgram));
+    this->decimatedVectorProgram->draw();
+    return;
+  }
+
   if (!this->vectorProgram) {
     createProgram();
   }
 
   // Set uniforms
-  this->quantity.parent.setStructureUniforms(*(this->vectorProgram));
-  this->vectorProgram->setUniform("u_radius", this->vectorRadius.get().asAbsolute());
-  this->vectorProgram->setUniform("u_baseColor", this->vectorColor.get());
-
-  if (this->vectorType == VectorType::AMBIENT) {
-    this->vectorProgram->setUniform("u_lengthMult", 1.0);
-  } else {
-    this->vectorProgram->setUniform("u_lengthMult",
-                                    this->vectorLengthMult.get().asAbsolute() / this->vectorLengthRange);
-  }
-
-  glm::mat4 P = view::getCameraPerspectiveMatrix();
-  glm::mat4 Pinv = glm::inverse(P);
-  this->vectorProgram->setUniform("u_invProjMatrix", glm::value_ptr(Pinv));
-  this->vectorProgram->setUniform("u_viewport", render::engine->getCurrentViewport());
+  this->setVectorUniforms(*(this->vectorProgram));
+  vectorRoots.setDequantizeUniforms(*(this->vectorProgram));
 
   this->vectorProgram->draw();
 }
@@ -156,26 +319,43 @@ void VectorQuantity<QuantityT>::drawVectors() {
 template <typename QuantityT>
 void VectorQuantity<QuantityT>::createProgram() {
 
-  std::vector<std::string> rules = this->quantity.parent.addStructureRules({"SHADE_BASECOLOR"});
-  if (this->quantity.parent.wantsCullPosition()) {
-    rules.push_back("VECTOR_CULLPOS_FROM_TAIL");
-  }
-
-
   // Create the vectorProgram to draw this quantity
   // clang-format off
   this->vectorProgram = render::engine->requestShader(
       "RAYCAST_VECTOR",
-      rules
+      this->addVectorRules(vectorRoots.addDequantizeRules({"SHADE_BASECOLOR"}), "VECTOR_CULL_MAGNITUDE")
   );
   // clang-format on
 
-  this->vectorProgram->setAttribute("a_vector", vectors.getRenderAttributeBuffer());
-  this->vectorProgram->setAttribute("a_position", vectorRoots.getRenderAttributeBuffer());
+  fillProgramBuffers(*(this->vectorProgram));
 
   render::engine->setMaterial(*(this->vectorProgram), this->material.get());
 }
 
+template <typename QuantityT>
+void VectorQuantity<QuantityT>::createDecimatedProgram() {
+
+  // Same as the program above, but draws only the vectors listed in an index buffer
+  // clang-format off
+  this->decimatedVectorProgram = render::engine->requestShader(
+      "RAYCAST_VECTOR_INDEXED",
+      this->addVectorRules(vectorRoots.addDequantizeRules({"SHADE_BASECOLOR"}), "VECTOR_CULL_MAGNITUDE")
+  );
+  // clang-format on
+
+  fillProgramBuffers(*(this->decimatedVectorProgram));
+  this->decimatedIndsDirty = true;
+
+  render::engine->setMaterial(*(this->decimatedVectorProgram), this->material.get());
+}
+
+template <typename QuantityT>
+void VectorQuantity<QuantityT>::fillProgramBuffers(render::ShaderProgram& p) {
+  // (the roots are the parent's buffer, which is shared rather than uploaded again)
+  p.setAttribute("a_vector", vectors.getRenderAttributeBuffer());
+  p.setAttribute("a_position", vectorRoots.getRenderAttributeBuffer());
+}
+
 template <typename QuantityT>
 void VectorQuantity<QuantityT>::updateMaxLength() {
   if (this->vectorLengthRangeManuallySet) return; // do nothing if it has already been set manually
@@ -191,6 +371,8 @@ void VectorQuantity<QuantityT>::updateMaxLength() {
 template <typename QuantityT>
 void VectorQuantity<QuantityT>::refreshVectors() {
   this->vectorProgram.reset();
+  this->decimatedVectorProgram.reset();
+  this->decimatedIndsDirty = true;
 }
 
 template <typename QuantityT>
@@ -199,6 +381,7 @@ void VectorQuantity<QuantityT>::updateData(const T& newVectors) {
   validateSize(newVectors, this->vectors.size(), "vector quantity " + this->quantity.name);
   this->vectors.data = standardizeVectorArray<glm::vec3, 3>(newVectors);
   this->vectors.markHostBufferUpdated();
+  this->decimatedIndsDirty = true;
   this->updateMaxLength();
 }
 
@@ -211,6 +394,7 @@ void VectorQuantity<QuantityT>::updateData2D(const T& newVectors) {
     v.z = 0.;
   }
   this->vectors.markHostBufferUpdated();
+  this->decimatedIndsDirty = true;
   this->updateMaxLength();
 }
 
@@ -237,60 +421,82 @@ TangentVectorQuantity<QuantityT>::TangentVectorQuantity(QuantityT& quantity_,
 
 template <typename QuantityT>
 void TangentVectorQuantity<QuantityT>::drawVectors() {
-  if (!this->vectorProgram) {
-    createProgram();
+
+  std::shared_ptr<render::ShaderProgram> program;
+  if (this->useDecimation()) {
+    if (!this->decimatedVectorProgram) {
+      createDecimatedProgram();
+    }
+
+    tangentVectors.ensureHostBufferPopulated();
+    if (this->updateDecimatedInds(vectorRoots, [&](size_t i) { return glm::length(tangentVectors.data[i]); })) {
+      if (this->decimatedInds.empty()) return;
+      this->decimatedVectorProgram->setIndex(this->decimatedInds);
+    }
+    if (this->decimatedInds.empty()) return;
+
+    program = this->decimatedVectorProgram;
+  } else {
+    if (!this->vectorProgram) {
+      createProgram();
+    }
+    program = this->vectorProgram;
   }
 
   for (int iSym = 0; iSym < nSym; iSym++) { // for drawing symmetric vectors, does nothing in the common case nSym == 1
 
     float symRotRad = (iSym * 2. * PI) / nSym;
-    this->vectorProgram->setUniform("u_vectorRotRad", symRotRad);
+    program->setUniform("u_vectorRotRad", symRotRad);
 
     // Set uniforms
-    this->quantity.parent.setStructureUniforms(*(this->vectorProgram));
-    this->vectorProgram->setUniform("u_radius", this->vectorRadius.get().asAbsolute());
-    this->vectorProgram->setUniform("u_baseColor", this->vectorColor.get());
-
-    if (this->vectorType == VectorType::AMBIENT) {
-      this->vectorProgram->setUniform("u_lengthMult", 1.0);
-    } else {
-      this->vectorProgram->setUniform("u_lengthMult",
-                                      this->vectorLengthMult.get().asAbsolute() / this->vectorLengthRange);
-    }
-
-    glm::mat4 P = view::getCameraPerspectiveMatrix();
-    glm::mat4 Pinv = glm::inverse(P);
-    this->vectorProgram->setUniform("u_invProjMatrix", glm::value_ptr(Pinv));
-    this->vectorProgram->setUniform("u_viewport", render::engine->getCurrentViewport());
+    this->setVectorUniforms(*program);
+    vectorRoots.setDequantizeUniforms(*program);
 
-    this->vectorProgram->draw();
+    program->draw();
   }
 }
 
 template <typename QuantityT>
 void TangentVectorQuantity<QuantityT>::createProgram() {
 
-  std::vector<std::string> rules = this->quantity.parent.addStructureRules({"SHADE_BASECOLOR"});
-  if (this->quantity.parent.wantsCullPosition()) {
-    rules.push_back("VECTOR_CULLPOS_FROM_TAIL");
-  }
-
   // Create the vectorProgram to draw this quantity
   // clang-format off
   this->vectorProgram = render::engine->requestShader(
       "RAYCAST_TANGENT_VECTOR",
-      rules
+      this->addVectorRules(vectorRoots.addDequantizeRules({"SHADE_BASECOLOR"}), "TANGENT_VECTOR_CULL_MAGNITUDE")
   );
   // clang-format on
 
-  this->vectorProgram->setAttribute("a_tangentVector", tangentVectors.getRenderAttributeBuffer());
-  this->vectorProgram->setAttribute("a_basisVectorX", tangentBasisX.getRenderAttributeBuffer());
-  this->vectorProgram->setAttribute("a_basisVectorY", tangentBasisY.getRenderAttributeBuffer());
-  this->vectorProgram->setAttribute("a_position", vectorRoots.getRenderAttributeBuffer());
+  fillProgramBuffers(*(this->vectorProgram));
 
   render::engine->setMaterial(*(this->vectorProgram), this->material.get());
 }
 
+template <typename QuantityT>
+void TangentVectorQuantity<QuantityT>::createDecimatedProgram() {
+
+  // Same as the program above, but draws only the vectors listed in an index buffer
+  // clang-format off
+  this->decimatedVectorProgram = render::engine->requestShader(
+      "RAYCAST_TANGENT_VECTOR_INDEXED",
+      this->addVectorRules(vectorRoots.addDequantizeRules({"SHADE_BASECOLOR"}), "TANGENT_VECTOR_CULL_MAGNITUDE")
+  );
+  // clang-format on
+
+  fillProgramBuffers(*(this->decimatedVectorProgram));
+  this->decimatedIndsDirty = true;
+
+  render::engine->setMaterial(*(this->decimatedVectorProgram), this->material.get());
+}
+
+template <typename QuantityT>
+void TangentVectorQuantity<QuantityT>::fillProgramBuffers(render::ShaderProgram& p) {
+  p.setAttribute("a_tangentVector", tangentVectors.getRenderAttributeBuffer());
+  p.setAttribute("a_basisVectorX", tangentBasisX.getRenderAttributeBuffer());
+  p.setAttribute("a_basisVectorY", tangentBasisY.getRenderAttributeBuffer());
+  p.setAttribute("a_position", vectorRoots.getRenderAttributeBuffer());
+}
+
 template <typename QuantityT>
 void TangentVectorQuantity<QuantityT>::updateMaxLength() {
   if (this->vectorLengthRangeManuallySet) return; // do nothing if it has already been set manually
@@ -306,6 +512,8 @@ void TangentVectorQuantity<QuantityT>::updateMaxLength() {
 template <typename QuantityT>
 void TangentVectorQuantity<QuantityT>::refreshVectors() {
   this->vectorProgram.reset();
+  this->decimatedVectorProgram.reset();
+  this->decimatedIndsDirty = true;
 }
 
 template <typename QuantityT>
@@ -314,6 +522,7 @@ void TangentVectorQuantity<QuantityT>::updateData(const T& newVectors) {
   validateSize(newVectors, this->tangentVectors.size(), "tangent vector quantity " + this->quantity.name);
   this->tangentVectors.data = standardizeVectorArray<glm::vec2, 2>(newVectors);
   this->tangentVectors.markHostBufferUpdated();
+  this->decimatedIndsDirty = true;
   this->updateMaxLength();
 }
 
@@ -98,6 +98,13 @@ void lookAt(glm::vec3 cameraLocation, glm::vec3 target, glm::vec3 upDir, bool fl
 glm::mat4 getCameraViewMatrix();
 void setCameraViewMatrix(glm::mat4 newMat);
 glm::mat4 getCameraPerspectiveMatrix();
+
+// Restrict the projection to a tile of a larger virtual image of fullWidth x fullHeight pixels, so the tile can be
+// rendered in a buffer of just its own size. Tile coordinates are pixels from the top-left of the full image, and a
+// tile may extend past its right or bottom edge. Used by renderTiled(); clearProjectionTile() returns to the usual
+// full-buffer projection.
+void setProjectionTile(int fullWidth, int fullHeight, int tileX, int tileY, int tileWidth, int tileHeight);
+void clearProjectionTile();
 glm::vec3 getCameraWorldPosition();
 void getCameraFrame(glm::vec3& lookDir, glm::vec3& upDir, glm::vec3& rightDir);
 
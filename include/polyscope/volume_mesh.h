@@ -42,10 +42,20 @@ public:
 
   // === Member functions ===
 
+  // initializes members
+  VolumeMesh(std::string name);
+
   // Construct a new volume mesh structure
   VolumeMesh(std::string name, const std::vector<glm::vec3>& vertexPositions,
              const std::vector<std::array<uint32_t, 8>>& cellIndices);
 
+  // As above, taking ownership of the arrays rather than copying them
+  VolumeMesh(std::string name, std::vector<glm::vec3>&& vertexPositions,
+             std::vector<std::array<uint32_t, 8>>&& cellIndices);
+
+  // Re-create a mesh written by writeToSceneFile() (see scene_file.h), including its computed connectivity
+  static VolumeMesh* createFromSceneFile(const SceneFileReader& reader, const std::string& prefix, std::string name);
+
   // TODO add constructors & adaptors without intermediate nested list
 
   // Build the imgui display
@@ -58,8 +68,10 @@ public:
   virtual void drawDelayed() override;
   virtual void drawPick() override;
   virtual void updateObjectSpaceBounds() override;
+  virtual bool isCullable() override;
   virtual std::string typeName() override;
   virtual void refresh() override;
+  virtual bool writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) override;
 
   // == Geometric quantities
   // (actually, these are wrappers around the private raw data members, but external users should interact with these
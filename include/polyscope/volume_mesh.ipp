@@ -89,6 +89,7 @@ void VolumeMesh::updateVertexPositions(const V& newPositions) {
   validateSize(newPositions, nVertices(), "newPositions");
   vertexPositions.data = standardizeVectorArray<glm::vec3, 3>(newPositions);
   vertexPositions.markHostBufferUpdated();
+  markObjectSpaceBoundsStale();
   geometryChanged();
 }
 
@@ -22,6 +22,8 @@ class VolumeMeshVectorQuantity : public VolumeMeshQuantity {
 public:
   VolumeMeshVectorQuantity(std::string name, VolumeMesh& mesh_, VolumeMeshElement definedOn_);
 
+  virtual bool drawsOutsideStructureBounds() override;
+
 protected:
   VolumeMeshElement definedOn;
 };
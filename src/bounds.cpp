@@ -0,0 +1,318 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/bounds.h"
+
+#include "polyscope/parallel.h"
+#include "polyscope/utilities.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace polyscope {
+
+namespace {
+
+// Plain min/max loops over separate components, which compilers vectorize
+void blockMinMax(const glm::vec3* points, size_t start, size_t end, glm::vec3& min, glm::vec3& max) {
+  float minX = std::numeric_limits<float>::infinity();
+  float minY = minX;
+  float minZ = minX;
+  float maxX = -minX;
+  float maxY = -minX;
+  float maxZ = -minX;
+  for (size_t i = start; i < end; i++) {
+    minX = std::min(minX, points[i].x);
+    minY = std::min(minY, points[i].y);
+    minZ = std::min(minZ, points[i].z);
+    maxX = std::max(maxX, points[i].x);
+    maxY = std::max(maxY, points[i].y);
+    maxZ = std::max(maxZ, points[i].z);
+  }
+  min = glm::vec3{minX, minY, minZ};
+  max = glm::vec3{maxX, maxY, maxZ};
+}
+
+float blockMaxDist2(const glm::vec3* points, size_t start, size_t end, glm::vec3 center) {
+  float maxDist2 = 0.;
+  for (size_t i = start; i < end; i++) {
+    glm::vec3 d = points[i] - center;
+    maxDist2 = std::max(maxDist2, d.x * d.x + d.y * d.y + d.z * d.z);
+  }
+  return maxDist2;
+}
+
+// Squared distance from a point to the farthest corner of a box
+float farthestCornerDist2(glm::vec3 min, glm::vec3 max, glm::vec3 p) {
+  glm::vec3 d = componentwiseMax(glm::abs(min - p), glm::abs(max - p));
+  return glm::dot(d, d);
+}
+
+} // namespace
+
+void computePointBounds(const glm::vec3* points, size_t n, std::tuple<glm::vec3, glm::vec3>& bbox, float& lengthScale,
+                        std::vector<std::tuple<glm::vec3, glm::vec3>>* blockBoxes) {
+
+  size_t nBlocks = parallelChunkCount(n, pointBoundsBlockSize);
+  std::vector<glm::vec3> blockMin(nBlocks);
+  std::vector<glm::vec3> blockMax(nBlocks);
+
+  // Pass 1: per-block bounding boxes
+  parallelForChunks(n, pointBoundsBlockSize, [&](size_t iBlock, size_t start, size_t end) {
+    blockMinMax(points, start, end, blockMin[iBlock], blockMax[iBlock]);
+  });
+
+  glm::vec3 min = glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
+  glm::vec3 max = -glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
+  for (size_t iBlock = 0; iBlock < nBlocks; iBlock++) {
+    min = componentwiseMin(min, blockMin[iBlock]);
+    max = componentwiseMax(max, blockMax[iBlock]);
+  }
+  bbox = std::make_tuple(min, max);
+
+  if (blockBoxes != nullptr) {
+    blockBoxes->resize(nBlocks);
+    for (size_t iBlock = 0; iBlock < nBlocks; iBlock++) {
+      (*blockBoxes)[iBlock] = std::make_tuple(blockMin[iBlock], blockMax[iBlock]);
+    }
+  }
+
+  if (n == 0) {
+    lengthScale = 0.;
+    return;
+  }
+
+  // Pass 2: length scale, as twice the radius from the center of the bounding box. Visit blocks in order of how far
+  // away their boxes reach, and skip any block which cannot beat the current best. For spatially coherent data (which
+  // is typical) most blocks are skipped.
+  glm::vec3 center = 0.5f * (min + max);
+  std::vector<float> blockBound(nBlocks);
+  for (size_t iBlock = 0; iBlock < nBlocks; iBlock++) {
+    blockBound[iBlock] = farthestCornerDist2(blockMin[iBlock], blockMax[iBlock], center);
+  }
+  std::vector<size_t> blockOrder(nBlocks);
+  std::iota(blockOrder.begin(), blockOrder.end(), 0);
+  std::sort(blockOrder.begin(), blockOrder.end(),
+            [&](size_t a, size_t b) { return blockBound[a] > blockBound[b]; });
+
+  std::atomic<float> maxDist2(0.);
+  parallelForChunks(nBlocks, 1, [&](size_t iOrder, size_t, size_t) {
+    size_t iBlock = blockOrder[iOrder];
+    if (blockBound[iBlock] <= maxDist2.load()) return;
+
+    size_t start = iBlock * pointBoundsBlockSize;
+    size_t end = std::min(n, start + pointBoundsBlockSize);
+    float blockDist2 = blockMaxDist2(points, start, end, center);
+
+    float prev = maxDist2.load();
+    while (blockDist2 > prev && !maxDist2.compare_exchange_weak(prev, blockDist2)) {
+    }
+  });
+
+  lengthScale = 2 * std::sqrt(maxDist2.load());
+}
+
+void computePointBounds(const std::vector<glm::vec3>& points, std::tuple<glm::vec3, glm::vec3>& bbox,
+                        float& lengthScale, std::vector<std::tuple<glm::vec3, glm::vec3>>* blockBoxes) {
+  computePointBounds(points.data(), points.size(), bbox, lengthScale, blockBoxes);
+}
+
+void expandPointBounds(const glm::vec3* points, size_t n, std::tuple<glm::vec3, glm::vec3>& bbox, float& lengthScale) {
+  if (n == 0) return;
+
+  std::tuple<glm::vec3, glm::vec3> newBbox;
+  float newLengthScale;
+  computePointBounds(points, n, newBbox, newLengthScale);
+
+  glm::vec3 oldMin, oldMax, newMin, newMax;
+  std::tie(oldMin, oldMax) = bbox;
+  std::tie(newMin, newMax) = newBbox;
+
+  // Old bounds were empty
+  if (!isFinite(oldMin) || !isFinite(oldMax)) {
+    bbox = newBbox;
+    lengthScale = newLengthScale;
+    return;
+  }
+
+  glm::vec3 min = componentwiseMin(oldMin, newMin);
+  glm::vec3 max = componentwiseMax(oldMax, newMax);
+  bbox = std::make_tuple(min, max);
+
+  // A sphere about the new center which contains the spheres of both the old and the new points
+  glm::vec3 center = 0.5f * (min + max);
+  float oldRadius = 0.5f * lengthScale + glm::length(center - 0.5f * (oldMin + oldMax));
+  float newRadius = 0.5f * newLengthScale + glm::length(center - 0.5f * (newMin + newMax));
+  lengthScale = 2 * std::max(oldRadius, newRadius);
+}
+
+void updateBlockBounds(const glm::vec3* points, size_t n, size_t blockSize, size_t start, size_t end,
+                       std::vector<std::tuple<glm::vec3, glm::vec3>>& blockBoxes) {
+  size_t nBlocks = parallelChunkCount(n, blockSize);
+  blockBoxes.resize(nBlocks);
+  if (start >= end) return;
+
+  size_t firstBlock = start / blockSize;
+  size_t lastBlock = std::min(nBlocks, parallelChunkCount(end, blockSize));
+  parallelForChunks(lastBlock - firstBlock, 1, [&](size_t iChunk, size_t, size_t) {
+    size_t iBlock = firstBlock + iChunk;
+    glm::vec3 min, max;
+    blockMinMax(points, iBlock * blockSize, std::min(n, (iBlock + 1) * blockSize), min, max);
+    blockBoxes[iBlock] = std::make_tuple(min, max);
+  });
+}
+
+void computeIndexedBlockBounds(const std::vector<glm::vec3>& points, const std::vector<uint32_t>& inds,
+                               size_t blockSize, std::vector<std::tuple<glm::vec3, glm::vec3>>& blockBoxes) {
+  blockBoxes.resize(parallelChunkCount(inds.size(), blockSize));
+  parallelForChunks(inds.size(), blockSize, [&](size_t iBlock, size_t start, size_t end) {
+    glm::vec3 min = glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
+    glm::vec3 max = -glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
+    for (size_t i = start; i < end; i++) {
+      min = componentwiseMin(min, points[inds[i]]);
+      max = componentwiseMax(max, points[inds[i]]);
+    }
+    blockBoxes[iBlock] = std::make_tuple(min, max);
+  });
+}
+
+std::array<glm::vec4, 6> frustumPlanes(const glm::mat4& viewProjection) {
+  // Rows of the matrix (glm is column-major); planes are row3 +- row{0,1,2}
+  glm::mat4 T = glm::transpose(viewProjection);
+  std::array<glm::vec4, 6> planes{{T[3] + T[0], T[3] - T[0], T[3] + T[1], T[3] - T[1], T[3] + T[2], T[3] - T[2]}};
+  for (glm::vec4& plane : planes) {
+    float len = glm::length(glm::vec3(plane));
+    if (len > 0.) {
+      plane /= len;
+    }
+  }
+  return planes;
+}
+
+bool boxMayIntersectFrustum(const std::array<glm::vec4, 6>& planes, const glm::mat4& transform, glm::vec3 boxMin,
+                            glm::vec3 boxMax, float margin) {
+  if (!isFinite(boxMin) || !isFinite(boxMax)) return false; // empty box
+
+  // Transform as a center and half-extent
+  glm::vec3 center = glm::vec3(transform * glm::vec4(0.5f * (boxMin + boxMax), 1.));
+  glm::vec3 halfExtent = 0.5f * (boxMax - boxMin);
+  glm::mat3 absLinear = glm::mat3(transform);
+  for (int i = 0; i < 3; i++) {
+    absLinear[i] = glm::abs(absLinear[i]);
+  }
+  glm::vec3 extent = absLinear * halfExtent;
+
+  for (const glm::vec4& plane : planes) {
+    glm::vec3 normal(plane);
+    float dist = glm::dot(normal, center) + plane.w;
+    float radius = glm::dot(glm::abs(normal), extent);
+    if (dist + radius + margin < 0.) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void buildOcclusionDepthMap(const std::vector<float>& depth, size_t width, size_t height,
+                            const glm::mat4& viewProjection, OcclusionDepthMap& map) {
+  map.viewProjection = viewProjection;
+  map.levels.clear();
+  map.levelSizes.clear();
+  if (width == 0 || height == 0 || depth.size() != width * height) return;
+
+  map.levels.push_back(depth);
+  map.levelSizes.push_back(glm::uvec2(width, height));
+  while (map.levelSizes.back().x > 1 || map.levelSizes.back().y > 1) {
+    const std::vector<float>& fine = map.levels.back();
+    glm::uvec2 fineSize = map.levelSizes.back();
+    glm::uvec2 size = (fineSize + 1u) / 2u;
+    std::vector<float> coarse(static_cast<size_t>(size.x) * size.y);
+    parallelForChunks(size.y, 64, [&](size_t, size_t start, size_t end) {
+      for (size_t y = start; y < end; y++) {
+        size_t y0 = 2 * y;
+        size_t y1 = std::min<size_t>(y0 + 1, fineSize.y - 1);
+        for (size_t x = 0; x < size.x; x++) {
+          size_t x0 = 2 * x;
+          size_t x1 = std::min<size_t>(x0 + 1, fineSize.x - 1);
+          coarse[y * size.x + x] = std::max(std::max(fine[y0 * fineSize.x + x0], fine[y0 * fineSize.x + x1]),
+                                            std::max(fine[y1 * fineSize.x + x0], fine[y1 * fineSize.x + x1]));
+        }
+      }
+    });
+    map.levels.push_back(std::move(coarse));
+    map.levelSizes.push_back(size);
+  }
+}
+
+bool boxMayBeUnoccluded(const OcclusionDepthMap& map, const glm::mat4& transform, glm::vec3 boxMin, glm::vec3 boxMax,
+                        float margin) {
+  if (!map.isValid()) return true;
+  if (!isFinite(boxMin) || !isFinite(boxMax)) return false; // empty box
+
+  // Transformed, padded box, as in boxMayIntersectFrustum()
+  glm::vec3 center = glm::vec3(transform * glm::vec4(0.5f * (boxMin + boxMax), 1.));
+  glm::vec3 halfExtent = 0.5f * (boxMax - boxMin);
+  glm::mat3 absLinear = glm::mat3(transform);
+  for (int i = 0; i < 3; i++) {
+    absLinear[i] = glm::abs(absLinear[i]);
+  }
+  glm::vec3 extent = absLinear * halfExtent + glm::vec3{margin, margin, margin};
+
+  // Screen rectangle and nearest depth of the corners
+  glm::vec2 ndcMin{std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+  glm::vec2 ndcMax = -ndcMin;
+  float ndcNearZ = std::numeric_limits<float>::infinity();
+  for (int iCorner = 0; iCorner < 8; iCorner++) {
+    glm::vec3 sign{(iCorner & 1) ? 1.f : -1.f, (iCorner & 2) ? 1.f : -1.f, (iCorner & 4) ? 1.f : -1.f};
+    glm::vec4 clip = map.viewProjection * glm::vec4(center + sign * extent, 1.);
+    if (!(clip.w > 0.f)) return true; // behind the camera
+    glm::vec3 ndc = glm::vec3(clip) / clip.w;
+    ndcMin = glm::min(ndcMin, glm::vec2(ndc));
+    ndcMax = glm::max(ndcMax, glm::vec2(ndc));
+    ndcNearZ = std::min(ndcNearZ, ndc.z);
+  }
+  float nearDepth = 0.5f * ndcNearZ + 0.5f;
+  if (!(nearDepth > 0.f)) return true; // crosses the near plane
+
+  // Covered pixels, clamped to the buffer (anything outside of it is left to frustum culling)
+  glm::uvec2 size = map.levelSizes.front();
+  glm::vec2 pixMin = (0.5f * glm::clamp(ndcMin, -1.f, 1.f) + 0.5f) * glm::vec2(size);
+  glm::vec2 pixMax = (0.5f * glm::clamp(ndcMax, -1.f, 1.f) + 0.5f) * glm::vec2(size);
+  glm::uvec2 lo = glm::min(glm::uvec2(pixMin), size - 1u);
+  glm::uvec2 hi = glm::min(glm::uvec2(pixMax), size - 1u);
+
+  // Coarsest level needed to cover the rectangle with at most 4x4 cells
+  size_t level = 0;
+  while (level + 1 < map.levels.size() &&
+         (((hi.x >> level) - (lo.x >> level)) >= 4 || ((hi.y >> level) - (lo.y >> level)) >= 4)) {
+    level++;
+  }
+
+  const std::vector<float>& depth = map.levels[level];
+  size_t levelWidth = map.levelSizes[level].x;
+  for (size_t y = lo.y >> level; y <= (hi.y >> level); y++) {
+    for (size_t x = lo.x >> level; x <= (hi.x >> level); x++) {
+      if (nearDepth <= depth[y * levelWidth + x]) return true;
+    }
+  }
+  return false;
+}
+
+std::vector<std::pair<size_t, size_t>> blockIndicesToRanges(const std::vector<size_t>& blockInds, size_t blockSize,
+                                                           size_t n) {
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t iBlock : blockInds) {
+    size_t start = iBlock * blockSize;
+    size_t end = std::min(n, start + blockSize);
+    if (!ranges.empty() && ranges.back().first + ranges.back().second == start) {
+      ranges.back().second += end - start;
+    } else {
+      ranges.emplace_back(start, end - start);
+    }
+  }
+  return ranges;
+}
+
+} // namespace polyscope
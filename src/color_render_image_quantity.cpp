@@ -87,6 +87,21 @@ void ColorRenderImageQuantity::prepare() {
 }
 
 
+void ColorRenderImageQuantity::updateBuffers(const std::vector<float>& newDepthData,
+                                             const std::vector<glm::vec3>& newNormalData,
+                                             const std::vector<glm::vec3>& newColorData) {
+  if (newDepthData.size() != nPix() || newNormalData.size() != nPix() || newColorData.size() != nPix()) {
+    exception("render image quantity " + name + " updated with data of the wrong size");
+  }
+
+  colorData = newColorData;
+  if (textureColor) {
+    textureColor->setData(colorData);
+  }
+
+  updateGeometryBuffers(newDepthData, newNormalData);
+}
+
 std::string ColorRenderImageQuantity::niceName() { return name + " (color render image)"; }
 
 ColorRenderImageQuantity* ColorRenderImageQuantity::setEnabled(bool newEnabled) {
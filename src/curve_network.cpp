@@ -2,9 +2,12 @@
 
 #include "polyscope/curve_network.h"
 
+#include "polyscope/bounds.h"
+#include "polyscope/parallel.h"
 #include "polyscope/pick.h"
 #include "polyscope/polyscope.h"
 #include "polyscope/render/engine.h"
+#include "polyscope/scene_file.h"
 
 #include "imgui.h"
 
@@ -27,7 +30,10 @@ CurveNetwork::CurveNetwork(std::string name, std::vector<glm::vec3> nodes_, std:
       nodePositionsData(std::move(nodes_)), 
       color(uniquePrefix() + "#color", getNextUniqueColor()), 
       radius(uniquePrefix() + "#radius", relativeValue(0.005)),
-      material(uniquePrefix() + "#material", "clay")
+      material(uniquePrefix() + "#material", "clay"),
+      renderMode(uniquePrefix() + "#renderMode", "tube"),
+      lineWidth(uniquePrefix() + "#lineWidth", 1.5),
+      lineSimplificationTolerance(uniquePrefix() + "#lineSimplificationTolerance", 2.)
 // clang-format on
 {
 
@@ -59,7 +65,7 @@ CurveNetwork::CurveNetwork(std::string name, std::vector<glm::vec3> nodes_, std:
     nodeDegrees[nB]++;
   }
 
-  updateObjectSpaceBounds();
+  objectSpaceBoundsChanged();
 }
 
 float CurveNetwork::computeRadiusMultiplierUniform() {
@@ -96,13 +102,34 @@ void CurveNetwork::setCurveNetworkEdgeUniforms(render::ShaderProgram& p) {
   p.setUniform("u_radius", computeRadiusMultiplierUniform());
 }
 
+void CurveNetwork::setCurveNetworkLineUniforms(render::ShaderProgram& p) {
+  p.setUniform("u_viewport", render::engine->getCurrentViewport());
+  p.setUniform("u_lineWidth", getLineWidth() * render::engine->getCurrentPixelScaling());
+}
+
 void CurveNetwork::draw() {
   if (!isEnabled()) {
     return;
   }
 
+  if (getRenderMode() == CurveNetworkRenderMode::Line) {
+    updateLineLOD();
+  }
+
   // If there is no dominant quantity, then this class is responsible for drawing points
-  if (dominantQuantity == nullptr) {
+  if (dominantQuantity == nullptr && getRenderMode() == CurveNetworkRenderMode::Line) {
+
+    if (lineProgram == nullptr) {
+      prepareLine();
+    }
+
+    setStructureUniforms(*lineProgram);
+    setCurveNetworkLineUniforms(*lineProgram);
+    lineProgram->setUniform("u_baseColor", getColor());
+
+    lineProgram->draw();
+
+  } else if (dominantQuantity == nullptr) {
 
     // Ensure we have prepared buffers
     if (edgeProgram == nullptr || nodeProgram == nullptr) {
@@ -151,6 +178,20 @@ void CurveNetwork::drawPick() {
     return;
   }
 
+  if (getRenderMode() == CurveNetworkRenderMode::Line) {
+    updateLineLOD();
+
+    if (linePickProgram == nullptr) {
+      prepareLinePick();
+    }
+
+    setStructureUniforms(*linePickProgram);
+    setCurveNetworkLineUniforms(*linePickProgram);
+
+    linePickProgram->draw();
+    return;
+  }
+
   // Ensure we have prepared buffers
   if (edgePickProgram == nullptr || nodePickProgram == nullptr) {
     preparePick();
@@ -191,6 +232,14 @@ std::vector<std::string> CurveNetwork::addCurveNetworkEdgeRules(std::vector<std:
   }
   return initRules;
 }
+std::vector<std::string> CurveNetwork::addCurveNetworkLineRules(std::vector<std::string> initRules) {
+  initRules = addStructureRules(initRules);
+
+  if (wantsCullPosition()) {
+    initRules.push_back("POLYLINE_CULLPOS_FROM_MID");
+  }
+  return initRules;
+}
 
 void CurveNetwork::prepare() {
   if (dominantQuantity != nullptr) {
@@ -276,6 +325,253 @@ void CurveNetwork::preparePick() {
   }
 }
 
+void CurveNetwork::prepareLine() {
+  if (dominantQuantity != nullptr) {
+    return;
+  }
+
+  lineProgram = render::engine->requestShader("POLYLINE", addCurveNetworkLineRules({"SHADE_BASECOLOR"}));
+  render::engine->setMaterial(*lineProgram, getMaterial());
+
+  fillLineGeometryBuffers(*lineProgram);
+}
+
+void CurveNetwork::prepareLinePick() {
+
+  // Use the same pick index layout as the tube mode, but only nodes are picked, each segment is split between its two
+  // nearest nodes. The edge range is still requested so the layout is consistent if the render mode changes.
+  size_t totalPickElements = nNodes() + nEdges();
+  size_t pickStart = pick::requestPickBufferRange(this, totalPickElements);
+
+  linePickProgram = render::engine->requestShader("POLYLINE", addCurveNetworkLineRules({"POLYLINE_PROPAGATE_PICK"}),
+                                                  render::ShaderReplacementDefaults::Pick);
+
+  std::vector<glm::vec3> pickColors;
+  pickColors.reserve(nNodes());
+  for (size_t i = pickStart; i < pickStart + nNodes(); i++) {
+    pickColors.push_back(pick::indToVec(i));
+  }
+  linePickProgram->setAttribute("a_color", pickColors);
+
+  fillLineGeometryBuffers(*linePickProgram);
+}
+
+void CurveNetwork::fillLineGeometryBuffers(render::ShaderProgram& program) {
+  program.setAttribute("a_position", nodePositions.getRenderAttributeBuffer());
+  program.setPrimitiveRestartIndex(INVALID_IND_32);
+  setLineIndex(program);
+}
+
+void CurveNetwork::setLineIndex(render::ShaderProgram& program) {
+  if (!lineBlocksComputed) {
+    updateLineLOD();
+  }
+  program.setIndex(lineStripInds);
+}
+
+void CurveNetwork::computeLineStrips() {
+  nodePositions.ensureHostBufferPopulated();
+  edgeTailInds.ensureHostBufferPopulated();
+  edgeTipInds.ensureHostBufferPopulated();
+
+  // Node-to-edge adjacency, in compressed row form
+  std::vector<size_t> adjStart(nNodes() + 1, 0);
+  for (size_t iE = 0; iE < nEdges(); iE++) {
+    adjStart[edgeTailInds.data[iE] + 1]++;
+    adjStart[edgeTipInds.data[iE] + 1]++;
+  }
+  for (size_t iN = 0; iN < nNodes(); iN++) {
+    adjStart[iN + 1] += adjStart[iN];
+  }
+  std::vector<uint32_t> adjEdges(adjStart.back());
+  std::vector<size_t> adjFill(adjStart.begin(), adjStart.end() - 1);
+  for (size_t iE = 0; iE < nEdges(); iE++) {
+    adjEdges[adjFill[edgeTailInds.data[iE]]++] = iE;
+    adjEdges[adjFill[edgeTipInds.data[iE]]++] = iE;
+  }
+
+  // Walk chains of degree-2 nodes, first starting from all nodes where chains end, then any remaining pure cycles
+  std::vector<char> edgeVisited(nEdges(), false);
+  std::vector<std::vector<uint32_t>> chains;
+  auto walkChain = [&](uint32_t startNode, uint32_t startEdge) {
+    std::vector<uint32_t> chain{startNode};
+    uint32_t currNode = startNode;
+    uint32_t currEdge = startEdge;
+    while (true) {
+      edgeVisited[currEdge] = true;
+      uint32_t tail = edgeTailInds.data[currEdge];
+      currNode = (tail == currNode) ? edgeTipInds.data[currEdge] : tail;
+      chain.push_back(currNode);
+      if (currNode == startNode || nodeDegrees[currNode] != 2) break;
+
+      // continue along the other edge of this node
+      uint32_t nextEdge = INVALID_IND_32;
+      for (size_t i = adjStart[currNode]; i < adjStart[currNode + 1]; i++) {
+        if (!edgeVisited[adjEdges[i]]) {
+          nextEdge = adjEdges[i];
+          break;
+        }
+      }
+      if (nextEdge == INVALID_IND_32) break;
+      currEdge = nextEdge;
+    }
+    chains.push_back(chain);
+  };
+  for (size_t iN = 0; iN < nNodes(); iN++) {
+    if (nodeDegrees[iN] == 2) continue;
+    for (size_t i = adjStart[iN]; i < adjStart[iN + 1]; i++) {
+      if (!edgeVisited[adjEdges[i]]) walkChain(iN, adjEdges[i]);
+    }
+  }
+  for (size_t iE = 0; iE < nEdges(); iE++) {
+    if (!edgeVisited[iE]) walkChain(edgeTailInds.data[iE], iE);
+  }
+
+  // Split the chains in to blocks, which share their end nodes so the strips stay connected
+  lineBlocks.clear();
+  for (const std::vector<uint32_t>& chain : chains) {
+    for (size_t start = 0; start + 1 < chain.size(); start += lineLODBlockEdges) {
+      size_t end = std::min(start + lineLODBlockEdges, chain.size() - 1);
+      LineBlock block;
+      block.nodes.assign(chain.begin() + start, chain.begin() + end + 1);
+      lineBlocks.push_back(block);
+    }
+  }
+}
+
+void CurveNetwork::ensureLineBlocksComputed() {
+  bool rebuilt = !lineBlocksComputed;
+  if (rebuilt) {
+    computeLineStrips();
+    lineBlocksComputed = true;
+    lineBlockLevels.clear();
+  }
+
+  // The bounds and edge lengths of each block, refreshed whenever the nodes move
+  uint64_t positionsVersion = nodePositions.getDataVersion();
+  if (!rebuilt && positionsVersion == lineBlockPositionsVersion) return;
+  lineBlockPositionsVersion = positionsVersion;
+  nodePositions.ensureHostBufferPopulated();
+  const std::vector<glm::vec3>& positions = nodePositions.data;
+  parallelForChunks(lineBlocks.size(), 64, [&](size_t, size_t start, size_t end) {
+    for (size_t iBlock = start; iBlock < end; iBlock++) {
+      LineBlock& block = lineBlocks[iBlock];
+      glm::vec3 bboxMin = positions[block.nodes[0]];
+      glm::vec3 bboxMax = bboxMin;
+      float maxEdgeLength = 0.;
+      for (size_t i = 1; i < block.nodes.size(); i++) {
+        const glm::vec3& p = positions[block.nodes[i]];
+        bboxMin = componentwiseMin(bboxMin, p);
+        bboxMax = componentwiseMax(bboxMax, p);
+        maxEdgeLength = std::max(maxEdgeLength, glm::length(p - positions[block.nodes[i - 1]]));
+      }
+      block.bounds = std::make_tuple(bboxMin, bboxMax);
+      block.maxEdgeLength = maxEdgeLength;
+    }
+  });
+}
+
+namespace {
+
+// Upper bound on how much a linear map stretches any vector: the square root of a bound (the largest row sum) on the
+// largest eigenvalue of A^T A. It is exact for rotations and uniform scales.
+float maxStretch(const glm::mat3& A) {
+  glm::mat3 AtA = glm::transpose(A) * A;
+  float maxRowSum = 0.;
+  for (int i = 0; i < 3; i++) {
+    maxRowSum = std::max(maxRowSum, std::abs(AtA[0][i]) + std::abs(AtA[1][i]) + std::abs(AtA[2][i]));
+  }
+  return std::sqrt(maxRowSum);
+}
+
+} // namespace
+
+std::vector<size_t> CurveNetwork::computeLineLODLevels() {
+  ensureLineBlocksComputed();
+  std::vector<size_t> levels(lineBlocks.size(), 0);
+
+  glm::mat4 P = view::getCameraPerspectiveMatrix();
+  glm::mat4 modelView = getModelView();
+  const glm::mat4& T = objectTransform.get();
+  std::array<glm::vec4, 6> planes = frustumPlanes(P * view::getCameraViewMatrix());
+  glm::vec4 viewport = render::engine->getCurrentViewport();
+  bool perspective = view::projectionMode == ProjectionMode::Perspective;
+  float pixelSizePerDepth = 2.f / (P[1][1] * viewport[3]); // world-space size of a pixel at unit depth
+  float halfLineWidth = 0.5f * getLineWidth() * render::engine->getCurrentPixelScaling();
+  float tolerance = getLineSimplificationTolerance();
+  float stretch = maxStretch(glm::mat3(T));
+
+  for (size_t iBlock = 0; iBlock < lineBlocks.size(); iBlock++) {
+    const LineBlock& block = lineBlocks[iBlock];
+    glm::vec3 bboxMin, bboxMax;
+    std::tie(bboxMin, bboxMax) = block.bounds;
+
+    // Size of a pixel where the block is nearest to and farthest from the camera
+    float pixelSizeNear = pixelSizePerDepth;
+    float pixelSizeFar = pixelSizePerDepth;
+    if (perspective) {
+      float nearDepth = std::numeric_limits<float>::infinity();
+      float farDepth = 0.;
+      for (int iCorner = 0; iCorner < 8; iCorner++) {
+        glm::vec3 corner{(iCorner & 1) ? bboxMax.x : bboxMin.x, (iCorner & 2) ? bboxMax.y : bboxMin.y,
+                         (iCorner & 4) ? bboxMax.z : bboxMin.z};
+        float depth = -(modelView * glm::vec4(corner, 1.)).z;
+        nearDepth = std::min(nearDepth, depth);
+        farDepth = std::max(farDepth, depth);
+      }
+      pixelSizeNear *= nearDepth; // (not positive if the block reaches behind the camera)
+      pixelSizeFar *= farDepth;
+    }
+
+    // Leave out blocks outside the view, padded by the width of the lines
+    if (options::enableViewCulling &&
+        !boxMayIntersectFrustum(planes, T, bboxMin, bboxMax, halfLineWidth * pixelSizeFar)) {
+      levels[iBlock] = INVALID_IND;
+      continue;
+    }
+
+    // Segments at level k span at most 2^k edges. Use the coarsest level whose segments stay under the tolerance even
+    // at the block's nearest point, up to the level where the block is a single segment.
+    float ratio = tolerance * pixelSizeNear / (block.maxEdgeLength * stretch);
+    if (!(ratio >= 2.)) continue; // (also catches NaN)
+    int maxLevel = static_cast<int>(std::ceil(std::log2(static_cast<float>(block.nodes.size() - 1))));
+    ratio = std::min(ratio, std::ldexp(1.f, maxLevel));
+    levels[iBlock] = static_cast<size_t>(std::floor(std::log2(ratio)));
+  }
+
+  return levels;
+}
+
+void CurveNetwork::updateLineLOD() {
+  std::vector<size_t> levels = computeLineLODLevels();
+  if (levels == lineBlockLevels && !lineStripInds.empty()) {
+    return;
+  }
+  lineBlockLevels = levels;
+
+  lineStripInds.clear();
+  for (size_t iBlock = 0; iBlock < lineBlocks.size(); iBlock++) {
+    if (levels[iBlock] == INVALID_IND) continue;
+    const std::vector<uint32_t>& nodes = lineBlocks[iBlock].nodes;
+    size_t stride = static_cast<size_t>(1) << levels[iBlock];
+    for (size_t i = 0; i + 1 < nodes.size(); i += stride) {
+      lineStripInds.push_back(nodes[i]);
+    }
+    lineStripInds.push_back(nodes.back());
+    lineStripInds.push_back(INVALID_IND_32);
+  }
+  if (lineStripInds.empty()) {
+    lineStripInds.push_back(INVALID_IND_32); // nothing in view, but index buffers cannot be empty
+  }
+
+  // Update the index buffers of any existing line programs
+  if (lineProgram) setLineIndex(*lineProgram);
+  if (linePickProgram) setLineIndex(*linePickProgram);
+  for (auto& x : quantities) {
+    x.second->updateLineIndex();
+  }
+}
+
 void CurveNetwork::fillNodeGeometryBuffers(render::ShaderProgram& program) {
   program.setAttribute("a_position", nodePositions.getRenderAttributeBuffer());
 
@@ -320,10 +616,85 @@ void CurveNetwork::refresh() {
   edgeProgram.reset();
   nodePickProgram.reset();
   edgePickProgram.reset();
+  lineProgram.reset();
+  linePickProgram.reset();
+  lineBlocksComputed = false;
+  lineStripInds.clear();
   requestRedraw();
   QuantityStructure<CurveNetwork>::refresh(); // call base class version, which refreshes quantities
 }
 
+bool CurveNetwork::writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) {
+  writeBufferToSceneFile(writer, prefix + "nodePositions", nodePositions);
+  writeBufferToSceneFile(writer, prefix + "edgeTailInds", edgeTailInds);
+  writeBufferToSceneFile(writer, prefix + "edgeTipInds", edgeTipInds);
+  writer.writeIndexArray(prefix + "nodeDegrees", nodeDegrees);
+  writeComputedBufferToSceneFile(writer, prefix + "edgeCenters", edgeCenters);
+  writer.writeString(prefix + "nodeRadiusQuantityName", nodeRadiusQuantityName);
+  writer.writeValue<uint8_t>(prefix + "nodeRadiusQuantityAutoscale", nodeRadiusQuantityAutoscale);
+
+  size_t iQ = 0;
+  for (auto& entry : quantities) {
+    std::string qPrefix = sceneFileQuantityPrefix(prefix, iQ);
+    Quantity& q = *entry.second;
+    if (writeScalarQuantityToSceneFile<CurveNetworkNodeScalarQuantity>(writer, qPrefix, "nodeScalar", q) ||
+        writeScalarQuantityToSceneFile<CurveNetworkEdgeScalarQuantity>(writer, qPrefix, "edgeScalar", q) ||
+        writeColorQuantityToSceneFile<CurveNetworkNodeColorQuantity>(writer, qPrefix, "nodeColor", q) ||
+        writeColorQuantityToSceneFile<CurveNetworkEdgeColorQuantity>(writer, qPrefix, "edgeColor", q) ||
+        writeVectorQuantityToSceneFile<CurveNetworkNodeVectorQuantity>(writer, qPrefix, "nodeVector", q) ||
+        writeVectorQuantityToSceneFile<CurveNetworkEdgeVectorQuantity>(writer, qPrefix, "edgeVector", q)) {
+      iQ++;
+    } else {
+      warning("scene files cannot hold this kind of quantity", "skipped " + q.name + " on curve network " + name);
+    }
+  }
+  writeSceneFileQuantityCount(writer, prefix, iQ);
+
+  return true;
+}
+
+CurveNetwork* CurveNetwork::createFromSceneFile(const SceneFileReader& reader, const std::string& prefix,
+                                                std::string name) {
+  // construct without edges, they are filled in directly below
+  std::vector<glm::vec3> nodes = reader.readArray<glm::vec3>(prefix + "nodePositions");
+  std::unique_ptr<CurveNetwork> curveNetwork(
+      new CurveNetwork(name, std::move(nodes), std::vector<std::array<size_t, 2>>()));
+  readBufferFromSceneFile(reader, prefix + "edgeTailInds", curveNetwork->edgeTailInds);
+  readBufferFromSceneFile(reader, prefix + "edgeTipInds", curveNetwork->edgeTipInds);
+  curveNetwork->nodeDegrees = reader.readIndexArray(prefix + "nodeDegrees");
+  readComputedBufferFromSceneFile(reader, prefix + "edgeCenters", curveNetwork->edgeCenters);
+  if (curveNetwork->edgeTailInds.data.size() != curveNetwork->edgeTipInds.data.size() ||
+      curveNetwork->nodeDegrees.size() != curveNetwork->nNodes()) {
+    exception("scene file " + reader.filename + " has inconsistent edges for curve network " + name);
+  }
+
+  for (const SceneFileQuantity& q : sceneFileQuantities(reader, prefix)) {
+    if (q.kind == "nodeScalar") {
+      q.restoreScalar(curveNetwork->addNodeScalarQuantityImpl(q.name, q.readValues(), q.readDataType()));
+    } else if (q.kind == "edgeScalar") {
+      q.restoreScalar(curveNetwork->addEdgeScalarQuantityImpl(q.name, q.readValues(), q.readDataType()));
+    } else if (q.kind == "nodeColor") {
+      q.restore(curveNetwork->addNodeColorQuantityImpl(q.name, q.readColors()));
+    } else if (q.kind == "edgeColor") {
+      q.restore(curveNetwork->addEdgeColorQuantityImpl(q.name, q.readColors()));
+    } else if (q.kind == "nodeVector") {
+      q.restore(curveNetwork->addNodeVectorQuantityImpl(q.name, q.readVectors(), q.readVectorType()));
+    } else if (q.kind == "edgeVector") {
+      q.restore(curveNetwork->addEdgeVectorQuantityImpl(q.name, q.readVectors(), q.readVectorType()));
+    } else {
+      q.warnUnsupported(name);
+    }
+  }
+
+  std::string radiusQuantityName = reader.readString(prefix + "nodeRadiusQuantityName");
+  if (radiusQuantityName != "") {
+    curveNetwork->setNodeRadiusQuantity(radiusQuantityName,
+                                        reader.readValue<uint8_t>(prefix + "nodeRadiusQuantityAutoscale"));
+  }
+
+  return curveNetwork.release();
+}
+
 void CurveNetwork::recomputeGeometryIfPopulated() { edgeCenters.recomputeIfPopulated(); }
 
 void CurveNetwork::buildPickUI(size_t localPickID) {
@@ -387,16 +758,54 @@ void CurveNetwork::buildCustomUI() {
   }
   ImGui::SameLine();
   ImGui::PushItemWidth(100);
-  if (ImGui::SliderFloat("Radius", radius.get().getValuePtr(), 0.0, .1, "%.5f",
-                         ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_NoRoundToFormat)) {
-    radius.manuallyChanged();
-    requestRedraw();
+  if (getRenderMode() == CurveNetworkRenderMode::Line) {
+    if (ImGui::SliderFloat("Width", &lineWidth.get(), 0.5, 10., "%.1f px")) {
+      lineWidth.manuallyChanged();
+      requestRedraw();
+    }
+  } else {
+    if (ImGui::SliderFloat("Radius", radius.get().getValuePtr(), 0.0, .1, "%.5f",
+                           ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_NoRoundToFormat)) {
+      radius.manuallyChanged();
+      requestRedraw();
+    }
   }
   ImGui::PopItemWidth();
 }
 
 void CurveNetwork::buildCustomOptionsUI() {
 
+  if (ImGui::BeginMenu("Render Mode")) {
+
+    for (const CurveNetworkRenderMode& m : {CurveNetworkRenderMode::Tube, CurveNetworkRenderMode::Line}) {
+      bool selected = (m == getRenderMode());
+      std::string fancyName;
+      switch (m) {
+      case CurveNetworkRenderMode::Tube:
+        fancyName = "tube (pretty)";
+        break;
+      case CurveNetworkRenderMode::Line:
+        fancyName = "line (fast)";
+        break;
+      }
+      if (ImGui::MenuItem(fancyName.c_str(), NULL, selected)) {
+        setRenderMode(m);
+      }
+    }
+
+    if (getRenderMode() == CurveNetworkRenderMode::Line) {
+      ImGui::Separator();
+      ImGui::PushItemWidth(100);
+      if (ImGui::SliderFloat("Simplification (px)", &lineSimplificationTolerance.get(), 0., 10., "%.1f")) {
+        lineSimplificationTolerance.manuallyChanged();
+        requestRedraw();
+      }
+      ImGui::PopItemWidth();
+    }
+
+    ImGui::EndMenu();
+  }
+
   if (ImGui::BeginMenu("Variable Radius")) {
 
     if (ImGui::MenuItem("none", nullptr, nodeRadiusQuantityName == "")) clearNodeRadiusQuantity();
@@ -422,25 +831,17 @@ void CurveNetwork::buildCustomOptionsUI() {
 
 void CurveNetwork::updateObjectSpaceBounds() {
   nodePositions.ensureHostBufferPopulated();
+  computePointBounds(nodePositions.data, objectSpaceBoundingBox, objectSpaceLengthScale);
+}
 
-  // bounding box
-  glm::vec3 min = glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
-  glm::vec3 max = -glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
-  for (const glm::vec3& p : nodePositions.data) {
-    min = componentwiseMin(min, p);
-    max = componentwiseMax(max, p);
-  }
-  objectSpaceBoundingBox = std::make_tuple(min, max);
-
-  // length scale, as twice the radius from the center of the bounding box
-  glm::vec3 center = 0.5f * (min + max);
-  float lengthScale = 0.0;
-  for (const glm::vec3& p : nodePositions.data) {
-    lengthScale = std::max(lengthScale, glm::length2(p - center));
-  }
-  objectSpaceLengthScale = 2 * std::sqrt(lengthScale);
+bool CurveNetwork::isCullable() {
+  // with a non-autoscaled radius quantity, the radii can be anything
+  bool radiiAreBounded = nodeRadiusQuantityName == "" || nodeRadiusQuantityAutoscale;
+  return radiiAreBounded && quantitiesStayWithinBounds();
 }
 
+float CurveNetwork::cullingMargin() { return getRadius(); }
+
 CurveNetwork* CurveNetwork::setColor(glm::vec3 newVal) {
   color = newVal;
   polyscope::requestRedraw();
@@ -481,6 +882,43 @@ CurveNetwork* CurveNetwork::setMaterial(std::string m) {
 }
 std::string CurveNetwork::getMaterial() { return material.get(); }
 
+CurveNetwork* CurveNetwork::setRenderMode(CurveNetworkRenderMode newVal) {
+  switch (newVal) {
+  case CurveNetworkRenderMode::Tube:
+    renderMode = "tube";
+    break;
+  case CurveNetworkRenderMode::Line:
+    renderMode = "line";
+    break;
+  }
+  refresh();
+  polyscope::requestRedraw();
+  return this;
+}
+CurveNetworkRenderMode CurveNetwork::getRenderMode() {
+  // The render mode is stored as string internally to simplify persistent value handling
+  if (renderMode.get() == "tube")
+    return CurveNetworkRenderMode::Tube;
+  else if (renderMode.get() == "line")
+    return CurveNetworkRenderMode::Line;
+  return CurveNetworkRenderMode::Tube; // should never happen
+}
+
+CurveNetwork* CurveNetwork::setLineWidth(float newVal) {
+  lineWidth = newVal;
+  polyscope::requestRedraw();
+  return this;
+}
+float CurveNetwork::getLineWidth() { return lineWidth.get(); }
+
+CurveNetwork* CurveNetwork::setLineSimplificationTolerance(float newVal) {
+  lineSimplificationTolerance = newVal;
+  polyscope::requestRedraw();
+  return this;
+}
+float CurveNetwork::getLineSimplificationTolerance() { return lineSimplificationTolerance.get(); }
+std::vector<size_t> CurveNetwork::getLineLODLevels() { return computeLineLODLevels(); }
+
 std::string CurveNetwork::typeName() { return structureTypeName; }
 
 // === Quantities
@@ -491,6 +929,7 @@ CurveNetworkQuantity::CurveNetworkQuantity(std::string name_, CurveNetwork& curv
 
 void CurveNetworkQuantity::buildNodeInfoGUI(size_t nodeInd) {}
 void CurveNetworkQuantity::buildEdgeInfoGUI(size_t edgeInd) {}
+void CurveNetworkQuantity::updateLineIndex() {}
 
 // === Quantity adders
 
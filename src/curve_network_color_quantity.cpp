@@ -15,6 +15,18 @@ CurveNetworkColorQuantity::CurveNetworkColorQuantity(std::string name, CurveNetw
 void CurveNetworkColorQuantity::draw() {
   if (!isEnabled()) return;
 
+  if (parent.getRenderMode() == CurveNetworkRenderMode::Line) {
+    if (lineProgram == nullptr) {
+      createLineProgram();
+    }
+
+    parent.setStructureUniforms(*lineProgram);
+    parent.setCurveNetworkLineUniforms(*lineProgram);
+
+    lineProgram->draw();
+    return;
+  }
+
   if (edgeProgram == nullptr || nodeProgram == nullptr) {
     createProgram();
   }
@@ -63,6 +75,16 @@ void CurveNetworkNodeColorQuantity::createProgram() {
   render::engine->setMaterial(*edgeProgram, parent.getMaterial());
 }
 
+void CurveNetworkNodeColorQuantity::createLineProgram() {
+  lineProgram = render::engine->requestShader(
+      "POLYLINE", parent.addCurveNetworkLineRules({"POLYLINE_PROPAGATE_COLOR", "SHADE_COLOR"}));
+
+  parent.fillLineGeometryBuffers(*lineProgram);
+  lineProgram->setAttribute("a_color", colors.getRenderAttributeBuffer());
+
+  render::engine->setMaterial(*lineProgram, parent.getMaterial());
+}
+
 
 void CurveNetworkNodeColorQuantity::buildNodeInfoGUI(size_t vInd) {
   ImGui::TextUnformatted(name.c_str());
@@ -81,9 +103,14 @@ std::string CurveNetworkColorQuantity::niceName() { return name + " (" + defined
 void CurveNetworkColorQuantity::refresh() {
   nodeProgram.reset();
   edgeProgram.reset();
+  lineProgram.reset();
   Quantity::refresh();
 }
 
+void CurveNetworkColorQuantity::updateLineIndex() {
+  if (lineProgram) parent.setLineIndex(*lineProgram);
+}
+
 // ========================================================
 // ==========            Edge Color              ==========
 // ========================================================
@@ -118,11 +145,23 @@ void CurveNetworkEdgeColorQuantity::createProgram() {
   render::engine->setMaterial(*edgeProgram, parent.getMaterial());
 }
 
+void CurveNetworkEdgeColorQuantity::createLineProgram() {
+  // Lines are drawn through nodes, so edge colors are shown via their average at each node
+  lineProgram = render::engine->requestShader(
+      "POLYLINE", parent.addCurveNetworkLineRules({"POLYLINE_PROPAGATE_COLOR", "SHADE_COLOR"}));
+
+  parent.fillLineGeometryBuffers(*lineProgram);
+  updateNodeAverageColors();
+  lineProgram->setAttribute("a_color", nodeAverageColors.getRenderAttributeBuffer());
+
+  render::engine->setMaterial(*lineProgram, parent.getMaterial());
+}
+
 void CurveNetworkEdgeColorQuantity::updateNodeAverageColors() {
   parent.edgeTailInds.ensureHostBufferPopulated();
   parent.edgeTipInds.ensureHostBufferPopulated();
   colors.ensureHostBufferPopulated();
-  nodeAverageColors.data.resize(parent.nNodes());
+  nodeAverageColors.data.assign(parent.nNodes(), glm::vec3{0., 0., 0.});
 
   for (size_t iE = 0; iE < parent.nEdges(); iE++) {
     size_t eTail = parent.edgeTailInds.data[iE];
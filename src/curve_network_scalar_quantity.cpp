@@ -19,6 +19,19 @@ CurveNetworkScalarQuantity::CurveNetworkScalarQuantity(std::string name, CurveNe
 void CurveNetworkScalarQuantity::draw() {
   if (!isEnabled()) return;
 
+  if (parent.getRenderMode() == CurveNetworkRenderMode::Line) {
+    if (lineProgram == nullptr) {
+      createLineProgram();
+    }
+
+    parent.setStructureUniforms(*lineProgram);
+    parent.setCurveNetworkLineUniforms(*lineProgram);
+    setScalarUniforms(*lineProgram);
+
+    lineProgram->draw();
+    return;
+  }
+
   if (edgeProgram == nullptr || nodeProgram == nullptr) {
     createProgram();
   }
@@ -57,9 +70,14 @@ void CurveNetworkScalarQuantity::buildCustomUI() {
 void CurveNetworkScalarQuantity::refresh() {
   nodeProgram.reset();
   edgeProgram.reset();
+  lineProgram.reset();
   Quantity::refresh();
 }
 
+void CurveNetworkScalarQuantity::updateLineIndex() {
+  if (lineProgram) parent.setLineIndex(*lineProgram);
+}
+
 std::string CurveNetworkScalarQuantity::niceName() { return name + " (" + definedOn + " scalar)"; }
 
 // ========================================================
@@ -98,6 +116,17 @@ void CurveNetworkNodeScalarQuantity::createProgram() {
   render::engine->setMaterial(*edgeProgram, parent.getMaterial());
 }
 
+void CurveNetworkNodeScalarQuantity::createLineProgram() {
+  lineProgram = render::engine->requestShader(
+      "POLYLINE", addScalarRules(parent.addCurveNetworkLineRules({"POLYLINE_PROPAGATE_VALUE"})));
+
+  parent.fillLineGeometryBuffers(*lineProgram);
+  lineProgram->setAttribute("a_value", values.getRenderAttributeBuffer());
+
+  lineProgram->setTextureFromColormap("t_colormap", cMap.get());
+  render::engine->setMaterial(*lineProgram, parent.getMaterial());
+}
+
 
 void CurveNetworkNodeScalarQuantity::buildNodeInfoGUI(size_t nInd) {
   ImGui::TextUnformatted(name.c_str());
@@ -142,11 +171,24 @@ void CurveNetworkEdgeScalarQuantity::createProgram() {
   render::engine->setMaterial(*edgeProgram, parent.getMaterial());
 }
 
+void CurveNetworkEdgeScalarQuantity::createLineProgram() {
+  // Lines are drawn through nodes, so edge values are shown via their average at each node
+  lineProgram = render::engine->requestShader(
+      "POLYLINE", addScalarRules(parent.addCurveNetworkLineRules({"POLYLINE_PROPAGATE_VALUE"})));
+
+  parent.fillLineGeometryBuffers(*lineProgram);
+  updateNodeAverageValues();
+  lineProgram->setAttribute("a_value", nodeAverageValues.getRenderAttributeBuffer());
+
+  lineProgram->setTextureFromColormap("t_colormap", cMap.get());
+  render::engine->setMaterial(*lineProgram, parent.getMaterial());
+}
+
 void CurveNetworkEdgeScalarQuantity::updateNodeAverageValues() {
   parent.edgeTailInds.ensureHostBufferPopulated();
   parent.edgeTipInds.ensureHostBufferPopulated();
   values.ensureHostBufferPopulated();
-  nodeAverageValues.data.resize(parent.nNodes());
+  nodeAverageValues.data.assign(parent.nNodes(), 0.);
 
   for (size_t iE = 0; iE < parent.nEdges(); iE++) {
     size_t eTail = parent.edgeTailInds.data[iE];
@@ -3,8 +3,23 @@
 #include "polyscope/file_helpers.h"
 
 #include "imgui.h"
+#include "polyscope/messages.h"
 #include "polyscope/polyscope.h"
 
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace polyscope {
 
 namespace {
@@ -50,4 +65,92 @@ std::string promptForFilename(std::string initName) {
 
   return stringOut;
 }
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(std::string filename_) : filename(filename_) {
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    exception("could not open file " + filename);
+  }
+  fileHandle = file;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize)) {
+    CloseHandle(file);
+    exception("could not get size of file " + filename);
+  }
+  mappedSize = static_cast<size_t>(fileSize.QuadPart);
+  if (mappedSize == 0) return; // empty files cannot be mapped
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) {
+    CloseHandle(file);
+    exception("could not map file " + filename);
+  }
+  mappingHandle = mapping;
+  mappedData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (mappedData == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    exception("could not map file " + filename);
+  }
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  if (mappedData) UnmapViewOfFile(mappedData);
+  if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+  if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+}
+
+void MemoryMappedFile::prefetch(size_t offset, size_t length) const {
+  // no portable equivalent of madvise() on older versions of Windows, the sequential scan hint above has to do
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(std::string filename_) : filename(filename_) {
+  fileDescriptor = open(filename.c_str(), O_RDONLY);
+  if (fileDescriptor < 0) {
+    exception("could not open file " + filename);
+  }
+
+  struct stat fileStat;
+  if (fstat(fileDescriptor, &fileStat) != 0) {
+    close(fileDescriptor);
+    exception("could not get size of file " + filename);
+  }
+  mappedSize = static_cast<size_t>(fileStat.st_size);
+  if (mappedSize == 0) return; // empty files cannot be mapped
+
+  void* ptr = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  if (ptr == MAP_FAILED) {
+    close(fileDescriptor);
+    exception("could not map file " + filename);
+  }
+  mappedData = static_cast<const char*>(ptr);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  if (mappedData) munmap(const_cast<char*>(mappedData), mappedSize);
+  if (fileDescriptor >= 0) close(fileDescriptor);
+}
+
+void MemoryMappedFile::prefetch(size_t offset, size_t length) const {
+  if (mappedData == nullptr || offset >= mappedSize) return;
+  length = std::min(length, mappedSize - offset);
+
+  // madvise() wants a page-aligned start
+  size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t alignedOffset = offset - offset % pageSize;
+  posix_madvise(const_cast<char*>(mappedData + alignedOffset), length + (offset - alignedOffset),
+                POSIX_MADV_WILLNEED);
+}
+
+#endif
+
+const char* MemoryMappedFile::data() const { return mappedData; }
+size_t MemoryMappedFile::size() const { return mappedSize; }
+
 } // namespace polyscope
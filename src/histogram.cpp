@@ -19,13 +19,12 @@ Histogram::Histogram(std::vector<double>& values) { buildHistogram(values); }
 
 Histogram::~Histogram() {}
 
-void Histogram::buildHistogram(const std::vector<double>& values) {
+void Histogram::buildHistogram(const std::vector<double>& values) { buildHistogram(computeScalarStatistics(values)); }
 
-  // Build arrays of values
-  size_t N = values.size();
+void Histogram::buildHistogram(const ScalarStatistics& stats) {
 
   // == Build histogram
-  dataRange = robustMinMax(values);
+  dataRange = stats.robustRange();
   colormapRange = dataRange;
 
   // Helper to build the four histogram variants
@@ -33,27 +32,13 @@ void Histogram::buildHistogram(const std::vector<double>& values) {
     // linspace coords
     double range = dataRange.second - dataRange.first;
     double inc = range / binCount;
-    std::vector<double> sumBin(binCount, 0.0);
-
-    // count values in buckets
-    for (size_t iData = 0; iData < N; iData++) {
-
-      double iBinf = binCount * (values[iData] - dataRange.first) / range;
-      size_t iBin = std::floor(glm::clamp(iBinf, 0.0, (double)binCount - 1));
-
-      // NaN values and finite values near the bottom of float range lead to craziness, so only increment bins if we got
-      // something reasonable
-      if (iBin < binCount) {
-        sumBin[iBin] += 1.0;
-      }
-    }
 
+    // count values in buckets (NaN and infinite values are not counted)
+    std::vector<double> sumBin = stats.histogram(dataRange.first, dataRange.second, binCount);
 
     // build histogram coords
     curveX = std::vector<std::array<float, 2>>(binCount);
     curveY = std::vector<float>(binCount);
-    double prevSumU = 0.0;
-    double prevSumW = 0.0;
     double prevXEnd = dataRange.first;
     for (size_t iBin = 0; iBin < binCount; iBin++) {
       // y value
@@ -67,6 +52,7 @@ void Histogram::buildHistogram(const std::vector<double>& values) {
 
     { // Rescale curves to [0,1] in both dimensions
       double maxHeight = *std::max_element(curveY.begin(), curveY.end());
+      if (maxHeight == 0.) maxHeight = 1.;
       for (size_t i = 0; i < binCount; i++) {
         curveX[i][0] = (curveX[i][0] - dataRange.first) / range;
         curveX[i][1] = (curveX[i][1] - dataRange.first) / range;
@@ -76,6 +62,11 @@ void Histogram::buildHistogram(const std::vector<double>& values) {
   };
 
   buildCurve(rawHistBinCount, rawHistCurveX, rawHistCurveY);
+
+  // If we have already been drawn, the buffers need to reflect the new curves
+  if (program) {
+    fillBuffers();
+  }
 }
 
 
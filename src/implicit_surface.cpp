@@ -0,0 +1,806 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/implicit_surface.h"
+
+#include "polyscope/parallel.h"
+#include "polyscope/view.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace polyscope {
+
+namespace {
+
+// Width and height of the square tiles of pixels which are marched together
+const size_t implicitTileSize = 32;
+
+struct ImplicitMarchParams {
+  float missDist;
+  float hitDist;
+  float stepFactor; // used for sphere march only
+  float stepSize;   // used for fixed step only
+  size_t nMaxSteps;
+  float normalSampleEps;
+  ImplicitRenderMode mode;
+  glm::mat3 viewMat3;
+};
+
+ImplicitMarchParams getMarchParams(const ImplicitRenderOpts& opts, const glm::mat4& viewMat) {
+  ImplicitMarchParams params;
+  params.missDist = opts.missDist.asAbsolute();
+  params.hitDist = opts.hitDist.asAbsolute();
+  params.stepFactor = opts.stepFactor;
+  params.stepSize = opts.stepSize.asAbsolute();
+  params.nMaxSteps = opts.nMaxSteps;
+  params.normalSampleEps = opts.normalSampleEps;
+  params.mode = opts.mode;
+  params.viewMat3 = glm::mat3(viewMat);
+  return params;
+}
+
+// Camera rays through the (subsampled) pixels of an image.
+// Perspective rays start at the camera position. Orthographic rays are parallel to the look direction, and start on the
+// plane through the camera position; the render image shaders reconstruct depth with the same convention.
+struct ImplicitViewRays {
+  size_t dimX, dimY; // subsampled image size
+  size_t subsampleFactor;
+  size_t bufferWidth, bufferHeight;
+  bool orthographic;
+  glm::mat4 viewMat;
+  glm::mat4 invViewMat;
+  glm::mat4 invProjMat;
+
+  // Rays through pixels are found by unprojecting the pixel, as in view::bufferCoordsToWorldRay()
+  void ray(size_t iX, size_t iY, glm::vec3& root, glm::vec3& dir) const {
+    glm::vec2 bufferCoords{iX * subsampleFactor, iY * subsampleFactor};
+    float ndcX = 2.f * bufferCoords.x / bufferWidth - 1.f;
+    float ndcY = 2.f * (bufferHeight - bufferCoords.y) / bufferHeight - 1.f;
+    glm::vec4 viewPos = invProjMat * glm::vec4{ndcX, ndcY, -1.f, 1.f};
+    viewPos /= viewPos.w;
+    if (orthographic) {
+      root = glm::vec3(invViewMat * glm::vec4{viewPos.x, viewPos.y, 0.f, 1.f});
+      dir = glm::normalize(glm::vec3(invViewMat * glm::vec4{0.f, 0.f, -1.f, 0.f}));
+    } else {
+      root = glm::vec3(invViewMat * glm::vec4{0.f, 0.f, 0.f, 1.f});
+      dir = glm::normalize(glm::vec3(invViewMat * glm::vec4{viewPos.x, viewPos.y, viewPos.z, 0.f}));
+    }
+  }
+};
+
+ImplicitViewRays getCameraRays(const glm::mat4& viewMat, const glm::mat4& projMat, ProjectionMode projectionMode,
+                               size_t bufferWidth, size_t bufferHeight, size_t subsampleFactor) {
+  ImplicitViewRays rays;
+  rays.subsampleFactor = subsampleFactor;
+  rays.bufferWidth = bufferWidth;
+  rays.bufferHeight = bufferHeight;
+  rays.dimX = rays.bufferWidth / rays.subsampleFactor;
+  rays.dimY = rays.bufferHeight / rays.subsampleFactor;
+  rays.orthographic = projectionMode == ProjectionMode::Orthographic;
+  rays.viewMat = viewMat;
+  rays.invViewMat = glm::inverse(viewMat);
+  rays.invProjMat = glm::inverse(projMat);
+  return rays;
+}
+
+// Rays through the (subsampled) pixels of the current view
+ImplicitViewRays getViewRays(const ImplicitRenderOpts& opts) {
+  return getCameraRays(view::getCameraViewMatrix(), view::getCameraPerspectiveMatrix(), view::projectionMode,
+                       view::bufferWidth, view::bufferHeight, opts.subsampleFactor);
+}
+
+void initRenderResult(ImplicitRenderResult& result, size_t dimX, size_t dimY) {
+  size_t nPix = dimX * dimY;
+  result.dimX = dimX;
+  result.dimY = dimY;
+  result.depth.assign(nPix, -1.);
+  result.pos.assign(nPix, glm::vec3{0.f, 0.f, 0.f});
+  result.normal.assign(nPix, glm::vec3{0.f, 0.f, 0.f});
+}
+
+// March the rays of one tile, writing to the corresponding entries of the output. Normals come from gradFunc if it is
+// given, or from finite differences of func otherwise.
+void marchImplicitTile(const ImplicitBatchFunc& func, const ImplicitGradientBatchFunc& gradFunc,
+                       const ImplicitMarchParams& params, const std::vector<size_t>& tilePixels,
+                       const std::vector<glm::vec3>& tileRoots, const std::vector<glm::vec3>& tileDirs,
+                       const ImplicitRayBounds& bounds, ImplicitRenderResult& result) {
+
+  size_t nTilePix = tilePixels.size();
+
+  // Working set for the tile, which will be shrunk as computation proceeds. Rays with an empty marching interval (e.g.
+  // which miss the bounding box) are left out from the start.
+  std::vector<glm::vec3> rayRoots;
+  std::vector<glm::vec3> rayDirs;
+  std::vector<size_t> rayInds; // index of the ray in the output image
+  std::vector<float> rayDepth;
+  std::vector<float> rayEnd;
+  for (size_t iP = 0; iP < nTilePix; iP++) {
+    size_t outInd = tilePixels[iP];
+    result.depth[outInd] = -1.f; // stays negative if the ray does not terminate
+    float start = bounds.start.empty() ? 0.f : bounds.start[outInd];
+    float end = bounds.end.empty() ? params.missDist : bounds.end[outInd];
+    if (!(start <= end)) continue;
+    rayRoots.push_back(tileRoots[iP]);
+    rayDirs.push_back(tileDirs[iP]);
+    rayInds.push_back(outInd);
+    rayDepth.push_back(start);
+    rayEnd.push_back(end);
+  }
+  size_t nRays = rayInds.size();
+
+  // Sample the first value at each ray (to check for sign changes)
+  std::vector<glm::vec3> currPos(nRays);
+  std::vector<float> currVals;
+  for (size_t iP = 0; iP < nRays; iP++) {
+    currPos[iP] = rayRoots[iP] + rayDepth[iP] * rayDirs[iP];
+  }
+  if (nRays > 0) func(currPos, currVals);
+  std::vector<char> initSigns(nRays);
+  for (size_t iP = 0; iP < nRays; iP++) {
+    initSigns[iP] = std::signbit(currVals[iP]);
+  }
+
+  // Jump ahead to the warm start depths, unless the function has changed sign by then (so the surface was passed)
+  if (!bounds.warm.empty()) {
+    std::vector<size_t> warmRays;
+    std::vector<glm::vec3> warmPos;
+    std::vector<float> warmVals;
+    for (size_t iP = 0; iP < nRays; iP++) {
+      float warm = bounds.warm[rayInds[iP]];
+      if (warm > rayDepth[iP] && warm < rayEnd[iP]) {
+        warmRays.push_back(iP);
+        warmPos.push_back(rayRoots[iP] + warm * rayDirs[iP]);
+      }
+    }
+    if (!warmRays.empty()) func(warmPos, warmVals);
+    for (size_t i = 0; i < warmRays.size(); i++) {
+      size_t iP = warmRays[i];
+      if (std::signbit(warmVals[i]) == static_cast<bool>(initSigns[iP])) {
+        rayDepth[iP] = bounds.warm[rayInds[iP]];
+        currVals[iP] = warmVals[i];
+      }
+    }
+  }
+
+  // March along the ray to compute depth
+  for (size_t iStep = 0; iStep < params.nMaxSteps && !rayDepth.empty(); iStep++) {
+
+    // Check for convergence & write/compact
+    size_t iPack = 0;
+    for (size_t iP = 0; iP < rayDepth.size(); iP++) {
+
+      // Check for termination
+      bool missTerminated = rayDepth[iP] > rayEnd[iP];
+      bool terminated = missTerminated || (std::abs(currVals[iP]) < params.hitDist) ||
+                        (std::signbit(currVals[iP]) != static_cast<bool>(initSigns[iP]));
+
+      if (terminated) {
+        // Write to the output buffer
+        size_t outInd = rayInds[iP];
+        result.depth[outInd] = missTerminated ? -1.f : rayDepth[iP];
+        result.pos[outInd] = rayRoots[iP] + rayDepth[iP] * rayDirs[iP];
+
+      } else {
+        // Take a step
+        float rayStepSize = -1.;
+        if (params.mode == ImplicitRenderMode::SphereMarch) {
+          rayStepSize = std::abs(currVals[iP]) * params.stepFactor;
+        } else if (params.mode == ImplicitRenderMode::FixedStep) {
+          rayStepSize = params.stepSize;
+        }
+
+        float newDepth = rayDepth[iP] + rayStepSize;
+
+        // Write to the compacted array
+        rayRoots[iPack] = rayRoots[iP];
+        rayDirs[iPack] = rayDirs[iP];
+        rayInds[iPack] = rayInds[iP];
+        initSigns[iPack] = initSigns[iP];
+        rayDepth[iPack] = newDepth;
+        rayEnd[iPack] = rayEnd[iP];
+        currPos[iPack] = rayRoots[iP] + newDepth * rayDirs[iP];
+        iPack++;
+      }
+    }
+
+    // "Trim" the working arrays to size
+    rayRoots.resize(iPack);
+    rayDirs.resize(iPack);
+    rayInds.resize(iPack);
+    initSigns.resize(iPack);
+    rayDepth.resize(iPack);
+    rayEnd.resize(iPack);
+    currPos.resize(iPack);
+
+    // Evaluate the remaining rays
+    if (iPack > 0) func(currPos, currVals);
+  }
+
+  // == Compute normals, at the hit points only
+
+  std::vector<size_t> hitInds;
+  for (size_t outInd : tilePixels) {
+    if (result.depth[outInd] >= 0.) {
+      hitInds.push_back(outInd);
+    } else {
+      // Handle not-converged rays
+      result.depth[outInd] = std::numeric_limits<float>::infinity();
+      result.normal[outInd] = glm::vec3{0.f, 0.f, 0.f};
+    }
+  }
+  size_t nHit = hitInds.size();
+  if (nHit == 0) return;
+
+  std::vector<glm::vec3> normalSum(nHit, glm::vec3{0.f, 0.f, 0.f});
+  currPos.resize(nHit);
+  if (gradFunc) {
+    for (size_t i = 0; i < nHit; i++) {
+      currPos[i] = result.pos[hitInds[i]];
+    }
+    gradFunc(currPos, normalSum);
+  } else {
+    // Uses finite differences on the vertices of a tetrahedron
+    // (see https://iquilezles.org/articles/normalsSDF/)
+    const std::array<glm::vec3, 4> tetVerts{{
+        glm::vec3{1.f, -1.f, -1.f},
+        glm::vec3{-1.f, -1.f, 1.f},
+        glm::vec3{-1.f, 1.f, -1.f},
+        glm::vec3{1.f, 1.f, 1.f},
+    }};
+
+    for (size_t iV = 0; iV < 4; iV++) {
+      glm::vec3 vertVec = tetVerts[iV];
+
+      // Set up the evaluation points for each pixel
+      for (size_t i = 0; i < nHit; i++) {
+        size_t outInd = hitInds[i];
+        float f = result.depth[outInd] * params.normalSampleEps;
+        currPos[i] = result.pos[outInd] + f * vertVec;
+      }
+
+      // Evaluate the function at each sample point, and accumulate the result
+      func(currPos, currVals);
+      for (size_t i = 0; i < nHit; i++) {
+        normalSum[i] += vertVec * currVals[i];
+      }
+    }
+  }
+
+  // Normalize the normal vectors and transform to view space
+  for (size_t i = 0; i < nHit; i++) {
+    result.normal[hitInds[i]] = params.viewMat3 * glm::normalize(normalSum[i]);
+  }
+}
+
+// March the rays through a list of pixels. In parallel, this works in chunks of one tile's worth of pixels (so pass
+// pixels in tile order to keep each chunk spatially coherent); otherwise all pixels go to the function in one batch.
+void marchImplicitPixels(const ImplicitBatchFunc& func, const ImplicitGradientBatchFunc& gradFunc,
+                         const ImplicitMarchParams& params, const ImplicitViewRays& rays,
+                         const ImplicitRayBounds& bounds, const std::vector<size_t>& pixels,
+                         ImplicitRenderResult& result, bool parallel) {
+
+  auto marchChunks = [&](size_t, size_t start, size_t end) {
+    std::vector<size_t> tilePixels(pixels.begin() + start, pixels.begin() + end);
+    std::vector<glm::vec3> tileRoots(tilePixels.size());
+    std::vector<glm::vec3> tileDirs(tilePixels.size());
+    for (size_t i = 0; i < tilePixels.size(); i++) {
+      rays.ray(tilePixels[i] % rays.dimX, tilePixels[i] / rays.dimX, tileRoots[i], tileDirs[i]);
+    }
+    marchImplicitTile(func, gradFunc, params, tilePixels, tileRoots, tileDirs, bounds, result);
+  };
+
+  if (parallel) {
+    parallelForChunks(pixels.size(), implicitTileSize * implicitTileSize, marchChunks);
+  } else {
+    marchChunks(0, 0, pixels.size());
+  }
+}
+
+// Run a loop over the rows of an image, in parallel if requested
+template <class Func>
+void forImageRows(size_t dimY, bool parallel, Func&& func) {
+  auto rowChunk = [&](size_t, size_t start, size_t end) {
+    for (size_t iY = start; iY < end; iY++) {
+      func(iY);
+    }
+  };
+  if (parallel) {
+    parallelForChunks(dimY, 16, rowChunk);
+  } else {
+    rowChunk(0, 0, dimY);
+  }
+}
+
+// Clip each ray to the bounding box
+void clipRaysToBox(const ImplicitMarchParams& params, const ImplicitRenderOpts& opts, const ImplicitViewRays& rays,
+                   ImplicitRayBounds& bounds, bool parallel) {
+  forImageRows(rays.dimY, parallel, [&](size_t iY) {
+    for (size_t iX = 0; iX < rays.dimX; iX++) {
+      glm::vec3 root, dir;
+      rays.ray(iX, iY, root, dir);
+
+      // slab test, narrowing the interval one axis at a time
+      float tMin = 0.;
+      float tMax = params.missDist;
+      for (int k = 0; k < 3; k++) {
+        if (dir[k] == 0.) {
+          if (root[k] < opts.boundingBoxMin[k] || root[k] > opts.boundingBoxMax[k]) tMin = tMax + 1.f;
+          continue;
+        }
+        float t0 = (opts.boundingBoxMin[k] - root[k]) / dir[k];
+        float t1 = (opts.boundingBoxMax[k] - root[k]) / dir[k];
+        tMin = std::max(tMin, std::min(t0, t1));
+        tMax = std::min(tMax, std::max(t0, t1));
+      }
+
+      size_t ind = iY * rays.dimX + iX;
+      bounds.start[ind] = tMin;
+      bounds.end[ind] = tMax;
+    }
+  });
+}
+
+// Sphere march one cone through each block of blockSize x blockSize pixels, and start every ray in the block at the
+// depth where the cone stopped. If every ray in the block lies within distance r(t) of the cone's axis at depth t, then
+// a step from axis point p of f(p) - r(t) cannot cross the surface along any of the rays.
+void coneMarchPrepass(const ImplicitBatchFunc& func, const ImplicitMarchParams& params, const ImplicitViewRays& rays,
+                      size_t blockSize, ImplicitRayBounds& bounds, bool parallel) {
+
+  size_t nBlockX = (rays.dimX + blockSize - 1) / blockSize;
+  size_t nBlockY = (rays.dimY + blockSize - 1) / blockSize;
+  size_t nBlock = nBlockX * nBlockY;
+
+  auto marchCones = [&](size_t, size_t start, size_t end) {
+    size_t n = end - start;
+
+    // The cone of each block has its axis through the middle of the corner rays, with radius r0 + k * t
+    std::vector<glm::vec3> axisRoots(n), axisDirs(n);
+    std::vector<float> r0(n, 0.), k(n, 0.), depth(n, 0.);
+    for (size_t i = 0; i < n; i++) {
+      size_t iBlock = start + i;
+      size_t x0 = (iBlock % nBlockX) * blockSize;
+      size_t y0 = (iBlock / nBlockX) * blockSize;
+      size_t x1 = std::min(x0 + blockSize, rays.dimX) - 1;
+      size_t y1 = std::min(y0 + blockSize, rays.dimY) - 1;
+      std::array<glm::vec3, 4> roots, dirs;
+      rays.ray(x0, y0, roots[0], dirs[0]);
+      rays.ray(x1, y0, roots[1], dirs[1]);
+      rays.ray(x0, y1, roots[2], dirs[2]);
+      rays.ray(x1, y1, roots[3], dirs[3]);
+      axisRoots[i] = 0.25f * (roots[0] + roots[1] + roots[2] + roots[3]);
+      axisDirs[i] = glm::normalize(dirs[0] + dirs[1] + dirs[2] + dirs[3]);
+      for (size_t c = 0; c < 4; c++) {
+        r0[i] = std::max(r0[i], glm::length(roots[c] - axisRoots[i]));
+        k[i] = std::max(k[i], glm::length(dirs[c] - axisDirs[i]));
+      }
+      // pad, since rays inside the block are only approximately blends of the corner rays
+      r0[i] *= 1.1f;
+      k[i] *= 1.1f;
+    }
+
+    // March all of the cones in the chunk together, compacting as they finish
+    std::vector<size_t> active(n);
+    for (size_t i = 0; i < n; i++) active[i] = i;
+    std::vector<glm::vec3> pos;
+    std::vector<float> vals;
+    for (size_t iStep = 0; iStep < params.nMaxSteps && !active.empty(); iStep++) {
+      pos.resize(active.size());
+      for (size_t j = 0; j < active.size(); j++) {
+        size_t i = active[j];
+        pos[j] = axisRoots[i] + depth[i] * axisDirs[i];
+      }
+      func(pos, vals);
+
+      size_t iPack = 0;
+      for (size_t j = 0; j < active.size(); j++) {
+        size_t i = active[j];
+        float freeDist = vals[j] - (r0[i] + k[i] * depth[i]);
+        if (freeDist < params.hitDist || depth[i] > params.missDist) continue;
+        depth[i] += freeDist * params.stepFactor;
+        active[iPack++] = i;
+      }
+      active.resize(iPack);
+    }
+
+    // Start each ray in the block at least as far as its cone got
+    for (size_t i = 0; i < n; i++) {
+      size_t iBlock = start + i;
+      size_t x0 = (iBlock % nBlockX) * blockSize;
+      size_t y0 = (iBlock / nBlockX) * blockSize;
+      for (size_t iY = y0; iY < std::min(y0 + blockSize, rays.dimY); iY++) {
+        for (size_t iX = x0; iX < std::min(x0 + blockSize, rays.dimX); iX++) {
+          size_t ind = iY * rays.dimX + iX;
+          bounds.start[ind] = std::max(bounds.start[ind], depth[i]);
+        }
+      }
+    }
+  };
+
+  if (parallel) {
+    parallelForChunks(nBlock, 256, marchCones);
+  } else {
+    marchCones(0, 0, nBlock); // one batch, like the rays
+  }
+}
+
+// Project the previous render's hit points in to the image, and warm start each ray just in front of the nearest one
+// in the surrounding 3x3 pixels
+void warmStartFromPrevious(const ImplicitWarmStart& warmStart, const ImplicitViewRays& rays, ImplicitRayBounds& bounds,
+                           bool parallel) {
+
+  const float inf = std::numeric_limits<float>::infinity();
+  size_t dimX = rays.dimX;
+  size_t dimY = rays.dimY;
+  std::vector<float> splat(dimX * dimY, inf);
+  glm::mat4 viewProj = glm::inverse(rays.invProjMat) * rays.viewMat;
+  for (const glm::vec3& p : warmStart.hitPos) {
+    glm::vec4 clip = viewProj * glm::vec4(p, 1.f);
+    if (clip.w <= 0.) continue;
+    float bufferX = (clip.x / clip.w + 1.f) / 2.f * rays.bufferWidth;
+    float bufferY = rays.bufferHeight - (clip.y / clip.w + 1.f) / 2.f * rays.bufferHeight;
+    float fX = std::round(bufferX / rays.subsampleFactor);
+    float fY = std::round(bufferY / rays.subsampleFactor);
+    if (!(fX >= 0. && fY >= 0. && fX < dimX && fY < dimY)) continue;
+    size_t iX = static_cast<size_t>(fX);
+    size_t iY = static_cast<size_t>(fY);
+    glm::vec3 root, dir;
+    rays.ray(iX, iY, root, dir);
+    float& s = splat[iY * dimX + iX];
+    s = std::min(s, glm::dot(p - root, dir));
+  }
+
+  bounds.warm.assign(dimX * dimY, -1.);
+  forImageRows(dimY, parallel, [&](size_t iY) {
+    for (size_t iX = 0; iX < dimX; iX++) {
+      float nearest = inf;
+      for (size_t jY = iY > 0 ? iY - 1 : 0; jY < std::min(iY + 2, dimY); jY++) {
+        for (size_t jX = iX > 0 ? iX - 1 : 0; jX < std::min(iX + 2, dimX); jX++) {
+          nearest = std::min(nearest, splat[jY * dimX + jX]);
+        }
+      }
+      if (nearest != inf) {
+        bounds.warm[iY * dimX + iX] = nearest * (1.f - warmStart.backoff);
+      }
+    }
+  });
+}
+
+// Compute the marching intervals for an image from the acceleration options
+ImplicitRayBounds computeRayBounds(const ImplicitBatchFunc& func, const ImplicitMarchParams& params,
+                                   const ImplicitRenderOpts& opts, const ImplicitViewRays& rays,
+                                   const ImplicitWarmStart* warmStart, bool parallel) {
+  ImplicitRayBounds bounds;
+  size_t nPix = rays.dimX * rays.dimY;
+
+  bool useCones = params.mode == ImplicitRenderMode::SphereMarch && opts.conePrepassFactor > 1;
+  if (opts.useBoundingBox || useCones) {
+    bounds.start.assign(nPix, 0.);
+    bounds.end.assign(nPix, params.missDist);
+  }
+  if (opts.useBoundingBox) {
+    clipRaysToBox(params, opts, rays, bounds, parallel);
+  }
+  if (useCones) {
+    coneMarchPrepass(func, params, rays, opts.conePrepassFactor, bounds, parallel);
+  }
+
+  if (warmStart && warmStart->valid) {
+    glm::vec3 cameraPos(rays.invViewMat[3]);
+    if (glm::length(cameraPos - warmStart->cameraPos) <= warmStart->maxCameraMove.asAbsolute()) {
+      warmStartFromPrevious(*warmStart, rays, bounds, parallel);
+    }
+  }
+
+  return bounds;
+}
+
+// March every pixel of an image
+ImplicitRenderResult marchImplicitImage(const ImplicitBatchFunc& func, const ImplicitGradientBatchFunc& gradFunc,
+                                        const ImplicitRenderOpts& opts, const ImplicitViewRays& rays,
+                                        ImplicitWarmStart* warmStart, bool parallel) {
+
+  ImplicitRenderResult result;
+  ImplicitMarchParams params = getMarchParams(opts, rays.viewMat);
+  initRenderResult(result, rays.dimX, rays.dimY);
+  ImplicitRayBounds bounds = computeRayBounds(func, params, opts, rays, warmStart, parallel);
+
+  // == March each tile of pixels
+  std::vector<size_t> pixels;
+  pixels.reserve(rays.dimX * rays.dimY);
+  for (size_t tileY = 0; tileY < rays.dimY; tileY += implicitTileSize) {
+    for (size_t tileX = 0; tileX < rays.dimX; tileX += implicitTileSize) {
+      for (size_t iY = tileY; iY < std::min(tileY + implicitTileSize, rays.dimY); iY++) {
+        for (size_t iX = tileX; iX < std::min(tileX + implicitTileSize, rays.dimX); iX++) {
+          pixels.push_back(iY * rays.dimX + iX);
+        }
+      }
+    }
+  }
+  marchImplicitPixels(func, gradFunc, params, rays, bounds, pixels, result, parallel);
+
+  // Remember the hits for the next render
+  if (warmStart) {
+    warmStart->valid = true;
+    warmStart->cameraPos = glm::vec3(rays.invViewMat[3]);
+    warmStart->hitPos.clear();
+    for (size_t i = 0; i < result.depth.size(); i++) {
+      if (result.depth[i] != std::numeric_limits<float>::infinity()) {
+        warmStart->hitPos.push_back(result.pos[i]);
+      }
+    }
+  }
+
+  return result;
+}
+
+} // namespace
+
+ImplicitRenderCamera ImplicitRenderCamera::perspective(const CameraParameters& params, size_t dimX, size_t dimY) {
+  // (the clip planes do not matter for ray generation)
+  ImplicitRenderCamera camera;
+  camera.viewMat = params.getViewMat();
+  camera.projMat =
+      glm::perspective(glm::radians(params.getFoVVerticalDegrees()), params.getAspectRatioWidthOverHeight(), 1.f, 2.f);
+  camera.projectionMode = ProjectionMode::Perspective;
+  camera.dimX = dimX;
+  camera.dimY = dimY;
+  return camera;
+}
+
+ImplicitRenderCamera ImplicitRenderCamera::orthographic(const CameraExtrinsics& extrinsics, float viewHeight,
+                                                        size_t dimX, size_t dimY) {
+  ImplicitRenderCamera camera;
+  float vert = viewHeight / 2.f;
+  float horiz = dimY == 0 ? vert : vert * dimX / dimY;
+  camera.viewMat = extrinsics.getViewMat();
+  camera.projMat = glm::ortho(-horiz, horiz, -vert, vert, 1.f, 2.f);
+  camera.projectionMode = ProjectionMode::Orthographic;
+  camera.dimX = dimX;
+  camera.dimY = dimY;
+  return camera;
+}
+
+ImplicitRenderResult renderImplicitSurfaceFromCurrentViewImpl(const ImplicitBatchFunc& func,
+                                                              const ImplicitRenderOpts& opts,
+                                                              const ImplicitGradientBatchFunc& gradFunc) {
+  return marchImplicitImage(func, gradFunc, opts, getViewRays(opts), opts.warmStart.get(), opts.parallel);
+}
+
+std::vector<ImplicitRenderResult> renderImplicitSurfaceFromCamerasImpl(const ImplicitBatchFunc& func,
+                                                                       const std::vector<ImplicitRenderCamera>& cameras,
+                                                                       const ImplicitRenderOpts& opts,
+                                                                       const ImplicitGradientBatchFunc& gradFunc) {
+
+  std::vector<ImplicitRenderResult> results(cameras.size());
+  auto renderCamera = [&](size_t iCam, bool parallel) {
+    const ImplicitRenderCamera& camera = cameras[iCam];
+    ImplicitViewRays rays =
+        getCameraRays(camera.viewMat, camera.projMat, camera.projectionMode, camera.dimX, camera.dimY, 1);
+    results[iCam] = marchImplicitImage(func, gradFunc, opts, rays, nullptr, parallel);
+  };
+
+  if (opts.parallel && cameras.size() >= parallelThreadCount()) {
+    // enough views to keep every thread busy, give each thread whole images
+    parallelForChunks(cameras.size(), 1, [&](size_t, size_t start, size_t end) {
+      for (size_t iCam = start; iCam < end; iCam++) {
+        renderCamera(iCam, false);
+      }
+    });
+  } else {
+    // otherwise, march the tiles of each image in parallel
+    for (size_t iCam = 0; iCam < cameras.size(); iCam++) {
+      renderCamera(iCam, opts.parallel);
+    }
+  }
+
+  return results;
+}
+
+ImplicitBatchFunc implicitBatchFuncFromSoA(ImplicitSoABatchFunc funcSoA) {
+  return [funcSoA](const std::vector<glm::vec3>& pos, std::vector<float>& vals) {
+    // per-thread scratch space, so the coordinate arrays are not reallocated for each batch
+    static thread_local std::vector<float> x, y, z;
+    size_t n = pos.size();
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      x[i] = pos[i].x;
+      y[i] = pos[i].y;
+      z[i] = pos[i].z;
+    }
+    vals.resize(n);
+    funcSoA(x.data(), y.data(), z.data(), vals.data(), n);
+  };
+}
+
+// =======================================================
+// === Progressive rendering
+// =======================================================
+
+ImplicitProgressiveRenderer::ImplicitProgressiveRenderer(ImplicitBatchFunc func_, ImplicitColorBatchFunc colorFunc_,
+                                                         PublishFunc publish_, ImplicitRenderOpts opts_)
+    : func(func_), colorFunc(colorFunc_), publish(publish_), opts(opts_) {
+  restart();
+}
+
+bool ImplicitProgressiveRenderer::refine() {
+  if (!started || viewChanged()) {
+    restart();
+  } else if (!isComplete()) {
+    refinePass();
+  }
+  return isComplete();
+}
+
+bool ImplicitProgressiveRenderer::isComplete() const { return started && stride <= 1; }
+
+size_t ImplicitProgressiveRenderer::getCurrentStride() const { return stride; }
+
+void ImplicitProgressiveRenderer::draw() { refine(); }
+
+bool ImplicitProgressiveRenderer::viewChanged() const {
+  return view::getCameraViewMatrix() != startViewMat || view::getCameraPerspectiveMatrix() != startProjMat ||
+         view::bufferWidth != startBufferWidth || view::bufferHeight != startBufferHeight;
+}
+
+void ImplicitProgressiveRenderer::restart() {
+  started = true;
+  startViewMat = view::getCameraViewMatrix();
+  startProjMat = view::getCameraPerspectiveMatrix();
+  startBufferWidth = view::bufferWidth;
+  startBufferHeight = view::bufferHeight;
+
+  ImplicitViewRays rays = getViewRays(opts);
+  initRenderResult(result, rays.dimX, rays.dimY);
+  colors.assign(rays.dimX * rays.dimY, glm::vec3{0.f, 0.f, 0.f});
+
+  // the largest power of two which is no more than the requested stride
+  stride = 1;
+  while (2 * stride <= static_cast<size_t>(std::max(opts.progressiveInitialStride, 1))) {
+    stride *= 2;
+  }
+
+  // march the coarse grid of pixels
+  std::vector<size_t> pixels;
+  for (size_t iY = 0; iY < rays.dimY; iY += stride) {
+    for (size_t iX = 0; iX < rays.dimX; iX += stride) {
+      pixels.push_back(iY * rays.dimX + iX);
+    }
+  }
+  ImplicitMarchParams params = getMarchParams(opts, rays.viewMat);
+  rayBounds = computeRayBounds(func, params, opts, rays, nullptr, opts.parallel);
+  marchImplicitPixels(func, ImplicitGradientBatchFunc(), params, rays, rayBounds, pixels, result, opts.parallel);
+
+  finishPass(pixels);
+}
+
+void ImplicitProgressiveRenderer::refinePass() {
+
+  size_t prevStride = stride;
+  stride /= 2;
+  size_t dimX = result.dimX;
+  size_t dimY = result.dimY;
+  const float inf = std::numeric_limits<float>::infinity();
+
+  // Fill a new sample from the corners of the previous pass's grid cell around it. Returns false if the corners are too
+  // different, and a ray needs to be marched instead.
+  auto interpolateSample = [&](size_t ind, const std::array<size_t, 4>& corners, const std::array<float, 4>& weights) {
+    size_t nHit = 0;
+    float depthMin = inf;
+    float depthMax = 0.;
+    for (size_t c : corners) {
+      if (result.depth[c] != inf) {
+        nHit++;
+        depthMin = std::min(depthMin, result.depth[c]);
+        depthMax = std::max(depthMax, result.depth[c]);
+      }
+    }
+    if (nHit != 0 && nHit != corners.size()) return false; // silhouette
+    if (nHit > 0) {
+      if (depthMax - depthMin > opts.progressiveDepthThreshold * depthMin) return false;
+      for (size_t i = 0; i < corners.size(); i++) {
+        for (size_t j = i + 1; j < corners.size(); j++) {
+          if (glm::dot(result.normal[corners[i]], result.normal[corners[j]]) < opts.progressiveNormalThreshold) {
+            return false;
+          }
+        }
+      }
+    }
+
+    float depth = 0.;
+    glm::vec3 normal{0.f, 0.f, 0.f};
+    glm::vec3 pos{0.f, 0.f, 0.f};
+    for (size_t i = 0; i < corners.size(); i++) {
+      depth += weights[i] * result.depth[corners[i]];
+      normal += weights[i] * result.normal[corners[i]];
+      pos += weights[i] * result.pos[corners[i]];
+    }
+    result.depth[ind] = nHit > 0 ? depth : inf;
+    result.normal[ind] = nHit > 0 ? glm::normalize(normal) : glm::vec3{0.f, 0.f, 0.f};
+    result.pos[ind] = pos;
+    return true;
+  };
+
+  // Visit each pixel which is on the new grid but not the previous one
+  std::vector<size_t> newPixels;
+  std::vector<size_t> marchPixels;
+  for (size_t iY = 0; iY < dimY; iY += stride) {
+    for (size_t iX = 0; iX < dimX; iX += stride) {
+      if (iX % prevStride == 0 && iY % prevStride == 0) continue;
+      size_t ind = iY * dimX + iX;
+      newPixels.push_back(ind);
+
+      size_t x0 = iX - iX % prevStride;
+      size_t y0 = iY - iY % prevStride;
+      size_t x1 = x0 + prevStride < dimX ? x0 + prevStride : x0;
+      size_t y1 = y0 + prevStride < dimY ? y0 + prevStride : y0;
+      float tX = x1 == x0 ? 0.f : static_cast<float>(iX - x0) / (x1 - x0);
+      float tY = y1 == y0 ? 0.f : static_cast<float>(iY - y0) / (y1 - y0);
+      std::array<size_t, 4> corners{{y0 * dimX + x0, y0 * dimX + x1, y1 * dimX + x0, y1 * dimX + x1}};
+      std::array<float, 4> weights{{(1.f - tX) * (1.f - tY), tX * (1.f - tY), (1.f - tX) * tY, tX * tY}};
+
+      if (!interpolateSample(ind, corners, weights)) {
+        marchPixels.push_back(ind);
+      }
+    }
+  }
+
+  if (!marchPixels.empty()) {
+    ImplicitViewRays rays = getViewRays(opts);
+    marchImplicitPixels(func, ImplicitGradientBatchFunc(), getMarchParams(opts, rays.viewMat), rays, rayBounds,
+                        marchPixels, result, opts.parallel);
+  }
+
+  finishPass(newPixels);
+}
+
+void ImplicitProgressiveRenderer::finishPass(const std::vector<size_t>& newPixels) {
+  size_t dimX = result.dimX;
+  size_t dimY = result.dimY;
+
+  // Colors for the new samples
+  if (colorFunc) {
+    std::vector<glm::vec3> newPos(newPixels.size());
+    for (size_t i = 0; i < newPixels.size(); i++) {
+      newPos[i] = result.pos[newPixels[i]];
+    }
+    std::vector<glm::vec3> newColors;
+    colorFunc(newPos, newColors);
+    for (size_t i = 0; i < newPixels.size(); i++) {
+      bool didHit = result.depth[newPixels[i]] != std::numeric_limits<float>::infinity();
+      colors[newPixels[i]] = didHit ? newColors[i] : glm::vec3{0.f, 0.f, 0.f};
+    }
+  }
+
+  // Pixels between the samples copy the sample at the top-left corner of their cell
+  if (stride > 1) {
+    auto fillRows = [&](size_t, size_t start, size_t end) {
+      for (size_t iY = start; iY < end; iY++) {
+        for (size_t iX = 0; iX < dimX; iX++) {
+          if (iX % stride == 0 && iY % stride == 0) continue;
+          size_t ind = iY * dimX + iX;
+          size_t srcInd = (iY - iY % stride) * dimX + (iX - iX % stride);
+          result.depth[ind] = result.depth[srcInd];
+          result.normal[ind] = result.normal[srcInd];
+          result.pos[ind] = result.pos[srcInd];
+          colors[ind] = colors[srcInd];
+        }
+      }
+    };
+    if (opts.parallel) {
+      parallelForChunks(dimY, 16, fillRows);
+    } else {
+      fillRows(0, 0, dimY);
+    }
+  }
+
+  if (!result.depth.empty()) {
+    publish(result, colors);
+  }
+  requestRedraw();
+}
+
+} // namespace polyscope
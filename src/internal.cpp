@@ -2,6 +2,10 @@
 
 #include "polyscope/internal.h"
 
+#include "polyscope/bounds.h"
+#include "polyscope/options.h"
+#include "polyscope/view.h"
+
 namespace polyscope {
 namespace internal {
 
@@ -12,5 +16,17 @@ uint64_t getNextUniqueID() { return uniqueID++; }
 bool pointCloudEfficiencyWarningReported = false;
 FloatingQuantityStructure* globalFloatingQuantityStructure = nullptr;
 
+OcclusionDepthMap occlusionDepthMap;
+bool occlusionCullingActive = false;
+size_t occlusionCulledCount = 0;
+uint64_t drawCount = 0;
+
+const OcclusionDepthMap* currentOcclusionDepthMap() {
+  if (!occlusionCullingActive || !options::enableOcclusionCulling || !occlusionDepthMap.isValid()) return nullptr;
+  glm::mat4 viewProjection = view::getCameraPerspectiveMatrix() * view::getCameraViewMatrix();
+  if (viewProjection != occlusionDepthMap.viewProjection) return nullptr;
+  return &occlusionDepthMap;
+}
+
 } // namespace internal
 } // namespace polyscope
@@ -0,0 +1,898 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/mesh_io.h"
+
+#include "polyscope/file_helpers.h"
+#include "polyscope/messages.h"
+#include "polyscope/parallel.h"
+#include "polyscope/polyscope.h"
+#include "polyscope/surface_mesh.h"
+#include "polyscope/utilities.h"
+#include "polyscope/volume_mesh.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <sstream>
+
+namespace polyscope {
+
+namespace {
+
+// Text files are split in to chunks of about this many bytes, which are parsed in parallel
+const size_t textChunkBytes = 1 << 22;
+
+// Binary PLY elements are parsed in parallel blocks of this many records
+const size_t binaryBlockRecords = 1 << 16;
+
+// === Text parsing
+
+bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Skip spaces, tabs, and line continuations (a backslash at the end of a line, used in OBJ files)
+void skipBlanks(const char*& p, const char* end) {
+  while (p < end) {
+    if (isBlank(*p)) {
+      p++;
+    } else if (*p == '\\' && p + 1 < end && p[1] == '\n') {
+      p += 2;
+    } else if (*p == '\\' && p + 2 < end && p[1] == '\r' && p[2] == '\n') {
+      p += 3;
+    } else {
+      break;
+    }
+  }
+}
+
+void skipToken(const char*& p, const char* end) {
+  while (p < end && !isBlank(*p) && *p != '\n') p++;
+}
+
+// The end of the line starting at p: the next newline which does not follow a line continuation, or the end of the text
+const char* findLineEnd(const char* p, const char* end) {
+  const char* searchStart = p;
+  while (true) {
+    const char* newline = static_cast<const char*>(std::memchr(searchStart, '\n', end - searchStart));
+    if (newline == nullptr) return end;
+    const char* lineLast = newline;
+    if (lineLast > p && lineLast[-1] == '\r') lineLast--;
+    if (lineLast > p && lineLast[-1] == '\\') {
+      searchStart = newline + 1;
+      continue;
+    }
+    return newline;
+  }
+}
+
+// The start of the line nLines lines after p
+const char* skipLines(const char* p, const char* end, size_t nLines) {
+  for (size_t i = 0; i < nLines && p < end; i++) {
+    p = findLineEnd(p, end) + 1;
+  }
+  return std::min(p, end);
+}
+
+double powerOfTen(int exponent) {
+  static const double exact[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  if (exponent >= 0 && exponent <= 22) return exact[exponent];
+  return std::pow(10., exponent);
+}
+
+// Parse a decimal number like "-1.5e-3". This is much faster than the locale-aware standard library functions, and
+// unlike them it stops at the end of the buffer, which is not null-terminated. The result may differ from a correctly
+// rounded parse in the last bit of a double, which is well below float precision.
+bool parseDouble(const char*& p, const char* end, double& out) {
+  const char* s = p;
+  bool negative = false;
+  if (s < end && (*s == '-' || *s == '+')) {
+    negative = (*s == '-');
+    s++;
+  }
+
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  int nDigits = 0; // significant digits in the mantissa, up to the 19 which fit in a uint64
+  bool anyDigits = false;
+  while (s < end && *s >= '0' && *s <= '9') {
+    if (nDigits < 19) {
+      mantissa = 10 * mantissa + (*s - '0');
+      if (mantissa > 0) nDigits++;
+    } else {
+      exponent++;
+    }
+    anyDigits = true;
+    s++;
+  }
+  if (s < end && *s == '.') {
+    s++;
+    while (s < end && *s >= '0' && *s <= '9') {
+      if (nDigits < 19) {
+        mantissa = 10 * mantissa + (*s - '0');
+        exponent--;
+        if (mantissa > 0) nDigits++;
+      }
+      anyDigits = true;
+      s++;
+    }
+  }
+  if (!anyDigits) return false;
+
+  if (s < end && (*s == 'e' || *s == 'E')) {
+    const char* e = s + 1;
+    bool negativeExponent = false;
+    if (e < end && (*e == '-' || *e == '+')) {
+      negativeExponent = (*e == '-');
+      e++;
+    }
+    if (e < end && *e >= '0' && *e <= '9') {
+      int explicitExponent = 0;
+      while (e < end && *e >= '0' && *e <= '9') {
+        if (explicitExponent < 10000) explicitExponent = 10 * explicitExponent + (*e - '0');
+        e++;
+      }
+      exponent += negativeExponent ? -explicitExponent : explicitExponent;
+      s = e;
+    }
+  }
+
+  double value = static_cast<double>(mantissa);
+  if (exponent < 0) {
+    value /= powerOfTen(-exponent);
+  } else if (exponent > 0) {
+    value *= powerOfTen(exponent);
+  }
+  out = negative ? -value : value;
+  p = s;
+  return true;
+}
+
+bool parseInt(const char*& p, const char* end, int64_t& out) {
+  const char* s = p;
+  bool negative = false;
+  if (s < end && (*s == '-' || *s == '+')) {
+    negative = (*s == '-');
+    s++;
+  }
+  if (s >= end || *s < '0' || *s > '9') return false;
+  int64_t value = 0;
+  while (s < end && *s >= '0' && *s <= '9') {
+    if (value < (int64_t(1) << 56)) value = 10 * value + (*s - '0');
+    s++;
+  }
+  out = negative ? -value : value;
+  p = s;
+  return true;
+}
+
+// Convert a 0-based index read from a file, throwing if it cannot be stored
+uint32_t checkedIndex(int64_t ind, const std::string& filename) {
+  if (ind < 0 || ind >= static_cast<int64_t>(INVALID_IND_32)) {
+    exception("mesh file " + filename + " has an out-of-range index " + std::to_string(ind));
+  }
+  return static_cast<uint32_t>(ind);
+}
+
+// What one chunk of text lines contributes to the mesh
+struct TextChunk {
+  std::vector<glm::vec3> positions;
+  std::vector<int64_t> faceEntries;
+  std::vector<uint32_t> faceDegrees;
+  std::vector<size_t> relativeEntries; // faceEntries which count from this chunk's first vertex (negative OBJ indices)
+  std::vector<std::array<uint32_t, 8>> cells;
+};
+
+using LineParser = std::function<void(const char* line, const char* lineEnd, TextChunk& chunk)>;
+
+// Append the chunks to the mesh data, copying each chunk in to place on a parallel thread
+void appendTextChunks(std::vector<TextChunk>& chunks, MeshFileData& data, const std::string& filename) {
+
+  // Where each chunk's contents go
+  size_t nChunks = chunks.size();
+  std::vector<size_t> vertexStart(nChunks + 1), entryStart(nChunks + 1), faceStart(nChunks + 1),
+      cellStart(nChunks + 1);
+  vertexStart[0] = data.vertexPositions.size();
+  entryStart[0] = data.faceIndsEntries.size();
+  faceStart[0] = data.nFaces();
+  cellStart[0] = data.cells.size();
+  for (size_t iChunk = 0; iChunk < nChunks; iChunk++) {
+    vertexStart[iChunk + 1] = vertexStart[iChunk] + chunks[iChunk].positions.size();
+    entryStart[iChunk + 1] = entryStart[iChunk] + chunks[iChunk].faceEntries.size();
+    faceStart[iChunk + 1] = faceStart[iChunk] + chunks[iChunk].faceDegrees.size();
+    cellStart[iChunk + 1] = cellStart[iChunk] + chunks[iChunk].cells.size();
+  }
+  if (entryStart[nChunks] >= INVALID_IND_32) {
+    exception("mesh file " + filename + " has too many face entries to index with 32 bits");
+  }
+
+  data.vertexPositions.resize(vertexStart[nChunks]);
+  data.faceIndsEntries.resize(entryStart[nChunks]);
+  data.faceIndsStart.resize(faceStart[nChunks] + 1);
+  data.cells.resize(cellStart[nChunks]);
+
+  parallelForChunks(nChunks, 1, [&](size_t iChunk, size_t, size_t) {
+    TextChunk& chunk = chunks[iChunk];
+
+    std::copy(chunk.positions.begin(), chunk.positions.end(), data.vertexPositions.begin() + vertexStart[iChunk]);
+
+    for (size_t iEntry : chunk.relativeEntries) {
+      chunk.faceEntries[iEntry] += vertexStart[iChunk];
+    }
+    for (size_t i = 0; i < chunk.faceEntries.size(); i++) {
+      data.faceIndsEntries[entryStart[iChunk] + i] = checkedIndex(chunk.faceEntries[i], filename);
+    }
+
+    uint32_t faceEntryStart = static_cast<uint32_t>(entryStart[iChunk]);
+    for (size_t i = 0; i < chunk.faceDegrees.size(); i++) {
+      data.faceIndsStart[faceStart[iChunk] + i] = faceEntryStart;
+      faceEntryStart += chunk.faceDegrees[i];
+    }
+
+    std::copy(chunk.cells.begin(), chunk.cells.end(), data.cells.begin() + cellStart[iChunk]);
+
+    chunk = TextChunk(); // release the memory as we go
+  });
+  data.faceIndsStart.back() = static_cast<uint32_t>(entryStart[nChunks]);
+}
+
+// Parse the lines in [begin, end) in parallel chunks, and append the results to the mesh data
+void parseTextLines(const char* begin, const char* end, const LineParser& parseLine, MeshFileData& data,
+                    const std::string& filename) {
+
+  // Split in to chunks at line ends
+  std::vector<const char*> chunkStarts{begin};
+  while (static_cast<size_t>(end - chunkStarts.back()) > textChunkBytes) {
+    const char* lineEnd = findLineEnd(chunkStarts.back() + textChunkBytes, end);
+    if (lineEnd >= end) break;
+    chunkStarts.push_back(lineEnd + 1);
+  }
+  size_t nChunks = chunkStarts.size();
+
+  std::vector<TextChunk> chunks(nChunks);
+  parallelForChunks(nChunks, 1, [&](size_t iChunk, size_t, size_t) {
+    const char* chunkEnd = (iChunk + 1 < nChunks) ? chunkStarts[iChunk + 1] : end;
+    const char* p = chunkStarts[iChunk];
+    while (p < chunkEnd) {
+      const char* lineEnd = findLineEnd(p, chunkEnd);
+      parseLine(p, lineEnd, chunks[iChunk]);
+      p = lineEnd + 1;
+    }
+  });
+
+  appendTextChunks(chunks, data, filename);
+}
+
+// Check that all indices refer to a vertex
+void checkMeshFileIndices(const MeshFileData& data, const std::string& filename) {
+  size_t nVertices = data.vertexPositions.size();
+  parallelForChunks(data.faceIndsEntries.size(), binaryBlockRecords, [&](size_t, size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      if (data.faceIndsEntries[i] >= nVertices) {
+        exception("mesh file " + filename + " has a face index " + std::to_string(data.faceIndsEntries[i]) +
+                  " but only " + std::to_string(nVertices) + " vertices");
+      }
+    }
+  });
+  parallelForChunks(data.cells.size(), binaryBlockRecords, [&](size_t, size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      for (uint32_t ind : data.cells[i]) {
+        if (ind != INVALID_IND_32 && ind >= nVertices) {
+          exception("mesh file " + filename + " has a cell index " + std::to_string(ind) + " but only " +
+                    std::to_string(nVertices) + " vertices");
+        }
+      }
+    }
+  });
+}
+
+// === OBJ
+
+void parseLineOBJ(const char* p, const char* end, TextChunk& chunk, const std::string& filename) {
+  skipBlanks(p, end);
+
+  // Only vertex positions and faces are read
+  if (end - p < 2 || !isBlank(p[1])) return;
+  char lineType = p[0];
+  p++;
+
+  if (lineType == 'v') {
+    glm::vec3 pos;
+    for (int j = 0; j < 3; j++) {
+      skipBlanks(p, end);
+      double val;
+      if (!parseDouble(p, end, val)) exception("could not parse vertex position in mesh file " + filename);
+      pos[j] = static_cast<float>(val);
+    }
+    chunk.positions.push_back(pos);
+
+  } else if (lineType == 'f') {
+    uint32_t degree = 0;
+    while (true) {
+      skipBlanks(p, end);
+      if (p >= end) break;
+      int64_t ind;
+      if (!parseInt(p, end, ind) || ind == 0) exception("could not parse face in mesh file " + filename);
+      if (ind > 0) {
+        chunk.faceEntries.push_back(ind - 1); // 1-based
+      } else {
+        // negative indices count back from the most recent vertex
+        chunk.relativeEntries.push_back(chunk.faceEntries.size());
+        chunk.faceEntries.push_back(static_cast<int64_t>(chunk.positions.size()) + ind);
+      }
+      degree++;
+      skipToken(p, end); // texture coordinate and normal indices, like "/2/3"
+    }
+    chunk.faceDegrees.push_back(degree);
+  }
+}
+
+// === PLY
+
+enum class PLYType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+struct PLYProperty {
+  std::string name;
+  PLYType type;
+  bool isList = false;
+  PLYType countType; // lists only
+};
+
+struct PLYElement {
+  std::string name;
+  size_t count;
+  std::vector<PLYProperty> properties;
+};
+
+enum class PLYFormat { ASCII, BinaryLittleEndian, BinaryBigEndian };
+
+PLYType plyTypeFromName(const std::string& name, const std::string& filename) {
+  if (name == "char" || name == "int8") return PLYType::Int8;
+  if (name == "uchar" || name == "uint8") return PLYType::UInt8;
+  if (name == "short" || name == "int16") return PLYType::Int16;
+  if (name == "ushort" || name == "uint16") return PLYType::UInt16;
+  if (name == "int" || name == "int32") return PLYType::Int32;
+  if (name == "uint" || name == "uint32") return PLYType::UInt32;
+  if (name == "float" || name == "float32") return PLYType::Float32;
+  if (name == "double" || name == "float64") return PLYType::Float64;
+  exception("unrecognized property type " + name + " in PLY file " + filename);
+  return PLYType::Float64;
+}
+
+size_t plyTypeSize(PLYType type) {
+  switch (type) {
+  case PLYType::Int8:
+  case PLYType::UInt8:
+    return 1;
+  case PLYType::Int16:
+  case PLYType::UInt16:
+    return 2;
+  case PLYType::Int32:
+  case PLYType::UInt32:
+  case PLYType::Float32:
+    return 4;
+  case PLYType::Float64:
+    return 8;
+  }
+  return 0;
+}
+
+template <typename T>
+double plyValueFromBytes(const char* bytes) {
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return static_cast<double>(value);
+}
+
+double readPLYBinaryValue(const char* p, PLYType type, bool swapBytes) {
+  char bytes[8];
+  size_t size = plyTypeSize(type);
+  std::memcpy(bytes, p, size);
+  if (swapBytes) std::reverse(bytes, bytes + size);
+  switch (type) {
+  case PLYType::Int8:
+    return plyValueFromBytes<int8_t>(bytes);
+  case PLYType::UInt8:
+    return plyValueFromBytes<uint8_t>(bytes);
+  case PLYType::Int16:
+    return plyValueFromBytes<int16_t>(bytes);
+  case PLYType::UInt16:
+    return plyValueFromBytes<uint16_t>(bytes);
+  case PLYType::Int32:
+    return plyValueFromBytes<int32_t>(bytes);
+  case PLYType::UInt32:
+    return plyValueFromBytes<uint32_t>(bytes);
+  case PLYType::Float32:
+    return plyValueFromBytes<float>(bytes);
+  case PLYType::Float64:
+    return plyValueFromBytes<double>(bytes);
+  }
+  return 0.;
+}
+
+// Parse the header, returning the offset of the first byte after it
+size_t parsePLYHeader(const MemoryMappedFile& file, PLYFormat& format, std::vector<PLYElement>& elements) {
+  const std::string& filename = file.filename;
+  const char* begin = file.data();
+  const char* end = begin + file.size();
+
+  const char endMarker[] = "end_header";
+  const char* markerPos = std::search(begin, end, endMarker, endMarker + sizeof(endMarker) - 1);
+  if (markerPos == end) exception("could not find the header in PLY file " + filename);
+  const char* bodyStart = std::min(findLineEnd(markerPos, end) + 1, end);
+
+  std::istringstream header(std::string(begin, markerPos));
+  std::string line;
+  bool haveFormat = false;
+  bool firstLine = true;
+  while (std::getline(header, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (firstLine) {
+      if (line != "ply") exception("file " + filename + " is not a PLY file");
+      firstLine = false;
+      continue;
+    }
+
+    std::istringstream lineStream(line);
+    std::string keyword;
+    lineStream >> keyword;
+    if (keyword == "format") {
+      std::string formatName;
+      lineStream >> formatName;
+      if (formatName == "ascii") {
+        format = PLYFormat::ASCII;
+      } else if (formatName == "binary_little_endian") {
+        format = PLYFormat::BinaryLittleEndian;
+      } else if (formatName == "binary_big_endian") {
+        format = PLYFormat::BinaryBigEndian;
+      } else {
+        exception("unrecognized format " + formatName + " in PLY file " + filename);
+      }
+      haveFormat = true;
+    } else if (keyword == "element") {
+      PLYElement element;
+      if (!(lineStream >> element.name >> element.count)) exception("malformed element in PLY file " + filename);
+      elements.push_back(element);
+    } else if (keyword == "property") {
+      if (elements.empty()) exception("property before any element in PLY file " + filename);
+      PLYProperty property;
+      std::string typeName;
+      lineStream >> typeName;
+      if (typeName == "list") {
+        std::string countTypeName;
+        lineStream >> countTypeName >> typeName;
+        property.isList = true;
+        property.countType = plyTypeFromName(countTypeName, filename);
+      }
+      property.type = plyTypeFromName(typeName, filename);
+      lineStream >> property.name;
+      elements.back().properties.push_back(property);
+    }
+    // comments and obj_info lines are ignored
+  }
+  if (firstLine) exception("file " + filename + " is not a PLY file");
+  if (!haveFormat) exception("PLY file " + filename + " does not give its format");
+
+  return bodyStart - begin;
+}
+
+// The index of the property with one of the given names, or -1
+int findPLYProperty(const PLYElement& element, std::vector<std::string> names, bool isList) {
+  for (size_t i = 0; i < element.properties.size(); i++) {
+    const PLYProperty& property = element.properties[i];
+    if (property.isList == isList && std::find(names.begin(), names.end(), property.name) != names.end()) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+// Find where each property of a binary record starts, and return the end of the record. Lists start with their count.
+const char* walkPLYBinaryRecord(const PLYElement& element, const char* p, const char* end, bool swapBytes,
+                                std::vector<const char*>& propertyStarts, const std::string& filename) {
+  propertyStarts.resize(element.properties.size());
+  for (size_t i = 0; i < element.properties.size(); i++) {
+    const PLYProperty& property = element.properties[i];
+    propertyStarts[i] = p;
+    size_t size = plyTypeSize(property.type);
+    if (property.isList) {
+      size_t countSize = plyTypeSize(property.countType);
+      if (static_cast<size_t>(end - p) < countSize) exception("PLY file " + filename + " is truncated");
+      double count = readPLYBinaryValue(p, property.countType, swapBytes);
+      if (count < 0) exception("PLY file " + filename + " has a list with negative length");
+      p += countSize;
+      size *= static_cast<size_t>(count);
+    }
+    if (static_cast<size_t>(end - p) < size) exception("PLY file " + filename + " is truncated");
+    p += size;
+  }
+  return p;
+}
+
+// Find the start of each block of binaryBlockRecords records of an element, followed by the end of the element. This
+// is the only sequential pass over the data, and only needs to touch each record if the element has lists.
+std::vector<const char*> findPLYBinaryBlocks(const PLYElement& element, const char* p, const char* end,
+                                             bool swapBytes, const std::string& filename) {
+  size_t recordSize = 0;
+  bool fixedSize = true;
+  for (const PLYProperty& property : element.properties) {
+    if (property.isList) fixedSize = false;
+    recordSize += plyTypeSize(property.type);
+  }
+
+  std::vector<const char*> blocks;
+  size_t nBlocks = parallelChunkCount(element.count, binaryBlockRecords);
+  if (fixedSize) {
+    if (recordSize > 0 && static_cast<size_t>(end - p) / recordSize < element.count) {
+      exception("PLY file " + filename + " is truncated");
+    }
+    for (size_t iBlock = 0; iBlock < nBlocks; iBlock++) {
+      blocks.push_back(p + iBlock * binaryBlockRecords * recordSize);
+    }
+    blocks.push_back(p + element.count * recordSize);
+  } else {
+    std::vector<const char*> propertyStarts;
+    for (size_t iRecord = 0; iRecord < element.count; iRecord++) {
+      if (iRecord % binaryBlockRecords == 0) blocks.push_back(p);
+      p = walkPLYBinaryRecord(element, p, end, swapBytes, propertyStarts, filename);
+    }
+    blocks.push_back(p);
+  }
+  return blocks;
+}
+
+void readPLYBinaryVertices(const PLYElement& element, const std::vector<const char*>& blocks, bool swapBytes,
+                           MeshFileData& data, const std::string& filename) {
+  int iX = findPLYProperty(element, {"x"}, false);
+  int iY = findPLYProperty(element, {"y"}, false);
+  int iZ = findPLYProperty(element, {"z"}, false);
+  if (iX < 0 || iY < 0 || iZ < 0) exception("PLY file " + filename + " does not have vertex positions");
+  const PLYType typeX = element.properties[iX].type;
+  const PLYType typeY = element.properties[iY].type;
+  const PLYType typeZ = element.properties[iZ].type;
+
+  data.vertexPositions.resize(element.count);
+  parallelForChunks(element.count, binaryBlockRecords, [&](size_t iBlock, size_t start, size_t end) {
+    const char* p = blocks[iBlock];
+    std::vector<const char*> propertyStarts;
+    for (size_t iV = start; iV < end; iV++) {
+      p = walkPLYBinaryRecord(element, p, blocks.back(), swapBytes, propertyStarts, filename);
+      data.vertexPositions[iV] = glm::vec3{readPLYBinaryValue(propertyStarts[iX], typeX, swapBytes),
+                                           readPLYBinaryValue(propertyStarts[iY], typeY, swapBytes),
+                                           readPLYBinaryValue(propertyStarts[iZ], typeZ, swapBytes)};
+    }
+  });
+}
+
+void readPLYBinaryFaces(const PLYElement& element, const std::vector<const char*>& blocks, bool swapBytes,
+                        MeshFileData& data, const std::string& filename) {
+  int iInds = findPLYProperty(element, {"vertex_indices", "vertex_index"}, true);
+  if (iInds < 0) exception("PLY file " + filename + " does not have face indices");
+  const PLYProperty& indsProperty = element.properties[iInds];
+  const size_t countSize = plyTypeSize(indsProperty.countType);
+  const size_t indSize = plyTypeSize(indsProperty.type);
+
+  // Face degrees, then their running sum for the face starts
+  data.faceIndsStart.resize(element.count + 1);
+  data.faceIndsStart[0] = 0;
+  parallelForChunks(element.count, binaryBlockRecords, [&](size_t iBlock, size_t start, size_t end) {
+    const char* p = blocks[iBlock];
+    std::vector<const char*> propertyStarts;
+    for (size_t iF = start; iF < end; iF++) {
+      p = walkPLYBinaryRecord(element, p, blocks.back(), swapBytes, propertyStarts, filename);
+      data.faceIndsStart[iF + 1] =
+          static_cast<uint32_t>(readPLYBinaryValue(propertyStarts[iInds], indsProperty.countType, swapBytes));
+    }
+  });
+  uint64_t nEntries = 0;
+  for (size_t iF = 0; iF < element.count; iF++) {
+    nEntries += data.faceIndsStart[iF + 1];
+    if (nEntries >= INVALID_IND_32) {
+      exception("mesh file " + filename + " has too many face entries to index with 32 bits");
+    }
+    data.faceIndsStart[iF + 1] = static_cast<uint32_t>(nEntries);
+  }
+
+  data.faceIndsEntries.resize(nEntries);
+  parallelForChunks(element.count, binaryBlockRecords, [&](size_t iBlock, size_t start, size_t end) {
+    const char* p = blocks[iBlock];
+    std::vector<const char*> propertyStarts;
+    for (size_t iF = start; iF < end; iF++) {
+      p = walkPLYBinaryRecord(element, p, blocks.back(), swapBytes, propertyStarts, filename);
+      const char* inds = propertyStarts[iInds] + countSize;
+      for (uint32_t i = data.faceIndsStart[iF]; i < data.faceIndsStart[iF + 1]; i++) {
+        double ind = readPLYBinaryValue(inds, indsProperty.type, swapBytes);
+        data.faceIndsEntries[i] = checkedIndex(static_cast<int64_t>(ind), filename);
+        inds += indSize;
+      }
+    }
+  });
+}
+
+void parseLinePLYVertex(const PLYElement& element, int iX, int iY, int iZ, const char* p, const char* end,
+                        TextChunk& chunk, const std::string& filename) {
+  glm::vec3 pos{0., 0., 0.};
+  for (size_t i = 0; i < element.properties.size(); i++) {
+    skipBlanks(p, end);
+    if (element.properties[i].isList) {
+      int64_t count;
+      if (!parseInt(p, end, count)) exception("could not parse vertex in PLY file " + filename);
+      for (int64_t j = 0; j < count; j++) {
+        skipBlanks(p, end);
+        skipToken(p, end);
+      }
+      continue;
+    }
+    double val;
+    if (!parseDouble(p, end, val)) exception("could not parse vertex in PLY file " + filename);
+    int iProp = static_cast<int>(i);
+    if (iProp == iX) pos.x = static_cast<float>(val);
+    if (iProp == iY) pos.y = static_cast<float>(val);
+    if (iProp == iZ) pos.z = static_cast<float>(val);
+  }
+  chunk.positions.push_back(pos);
+}
+
+void parseLinePLYFace(const PLYElement& element, int iInds, const char* p, const char* end, TextChunk& chunk,
+                      const std::string& filename) {
+  for (size_t i = 0; i < element.properties.size(); i++) {
+    skipBlanks(p, end);
+    if (!element.properties[i].isList) {
+      skipToken(p, end);
+      continue;
+    }
+    int64_t count;
+    if (!parseInt(p, end, count) || count < 0) exception("could not parse face in PLY file " + filename);
+    for (int64_t j = 0; j < count; j++) {
+      skipBlanks(p, end);
+      if (static_cast<int>(i) == iInds) {
+        int64_t ind;
+        if (!parseInt(p, end, ind)) exception("could not parse face in PLY file " + filename);
+        chunk.faceEntries.push_back(ind);
+      } else {
+        skipToken(p, end);
+      }
+    }
+    if (static_cast<int>(i) == iInds) chunk.faceDegrees.push_back(static_cast<uint32_t>(count));
+  }
+}
+
+// === Medit .mesh
+
+// Section keywords and the number of indices in each of their records
+struct DotMeshSection {
+  const char* keyword;
+  int nIndices;
+};
+const DotMeshSection dotMeshSections[] = {{"Triangles", 3}, {"Quadrilaterals", 4}, {"Tetrahedra", 4}, {"Hexahedra", 8}};
+
+void parseLineDotMeshVertex(int dimension, const char* p, const char* end, TextChunk& chunk,
+                            const std::string& filename) {
+  glm::vec3 pos{0., 0., 0.};
+  for (int j = 0; j < dimension; j++) {
+    skipBlanks(p, end);
+    double val;
+    if (!parseDouble(p, end, val)) exception("could not parse vertex in mesh file " + filename);
+    pos[j] = static_cast<float>(val);
+  }
+  chunk.positions.push_back(pos); // the reference number after the position is ignored
+}
+
+void parseLineDotMeshElement(int nIndices, bool isCell, const char* p, const char* end, TextChunk& chunk,
+                             const std::string& filename) {
+  std::array<uint32_t, 8> cell;
+  cell.fill(INVALID_IND_32);
+  for (int j = 0; j < nIndices; j++) {
+    skipBlanks(p, end);
+    int64_t ind;
+    if (!parseInt(p, end, ind)) exception("could not parse element in mesh file " + filename);
+    cell[j] = checkedIndex(ind - 1, filename); // 1-based
+  }
+  if (isCell) {
+    chunk.cells.push_back(cell);
+  } else {
+    chunk.faceEntries.insert(chunk.faceEntries.end(), cell.begin(), cell.begin() + nIndices);
+    chunk.faceDegrees.push_back(static_cast<uint32_t>(nIndices));
+  }
+}
+
+// Read the next whitespace-separated word, across lines, skipping comments
+std::string nextDotMeshWord(const char*& p, const char* end) {
+  while (p < end) {
+    if (std::isspace(static_cast<unsigned char>(*p))) {
+      p++;
+    } else if (*p == '#') {
+      p = findLineEnd(p, end);
+    } else {
+      break;
+    }
+  }
+  const char* wordStart = p;
+  while (p < end && !std::isspace(static_cast<unsigned char>(*p))) p++;
+  return std::string(wordStart, p);
+}
+
+std::string lowercaseExtension(const std::string& filename) {
+  std::string::size_type sepInd = filename.rfind('.');
+  if (sepInd == std::string::npos) return "";
+  std::string extension = filename.substr(sepInd + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+  return extension;
+}
+
+} // namespace
+
+MeshFileData readMeshFile(std::string filename) {
+  std::string extension = lowercaseExtension(filename);
+  if (extension == "obj") return readMeshFileOBJ(filename);
+  if (extension == "ply") return readMeshFilePLY(filename);
+  if (extension == "mesh") return readMeshFileDotMesh(filename);
+  exception("could not detect the mesh file type of " + filename + " (expected .obj, .ply, or .mesh)");
+  return MeshFileData();
+}
+
+MeshFileData readMeshFileOBJ(std::string filename) {
+  MemoryMappedFile file(filename);
+  MeshFileData data;
+
+  LineParser parseLine = [&](const char* p, const char* end, TextChunk& chunk) {
+    parseLineOBJ(p, end, chunk, filename);
+  };
+  parseTextLines(file.data(), file.data() + file.size(), parseLine, data, filename);
+
+  checkMeshFileIndices(data, filename);
+  return data;
+}
+
+MeshFileData readMeshFilePLY(std::string filename) {
+  MemoryMappedFile file(filename);
+  MeshFileData data;
+
+  PLYFormat format = PLYFormat::ASCII;
+  std::vector<PLYElement> elements;
+  size_t bodyOffset = parsePLYHeader(file, format, elements);
+  const char* p = file.data() + bodyOffset;
+  const char* end = file.data() + file.size();
+
+  const uint16_t endianTest = 1;
+  bool hostIsLittleEndian = *reinterpret_cast<const uint8_t*>(&endianTest) == 1;
+  bool swapBytes = (format == PLYFormat::BinaryLittleEndian && !hostIsLittleEndian) ||
+                   (format == PLYFormat::BinaryBigEndian && hostIsLittleEndian);
+
+  bool haveVertices = false;
+  for (const PLYElement& element : elements) {
+    bool isVertices = element.name == "vertex";
+    bool isFaces = element.name == "face";
+
+    if (format == PLYFormat::ASCII) {
+      // One line per record
+      const char* elementEnd = skipLines(p, end, element.count);
+      if (isVertices) {
+        int iX = findPLYProperty(element, {"x"}, false);
+        int iY = findPLYProperty(element, {"y"}, false);
+        int iZ = findPLYProperty(element, {"z"}, false);
+        if (iX < 0 || iY < 0 || iZ < 0) exception("PLY file " + filename + " does not have vertex positions");
+        LineParser parseLine = [&](const char* line, const char* lineEnd, TextChunk& chunk) {
+          parseLinePLYVertex(element, iX, iY, iZ, line, lineEnd, chunk, filename);
+        };
+        parseTextLines(p, elementEnd, parseLine, data, filename);
+      } else if (isFaces) {
+        int iInds = findPLYProperty(element, {"vertex_indices", "vertex_index"}, true);
+        if (iInds < 0) exception("PLY file " + filename + " does not have face indices");
+        LineParser parseLine = [&](const char* line, const char* lineEnd, TextChunk& chunk) {
+          parseLinePLYFace(element, iInds, line, lineEnd, chunk, filename);
+        };
+        parseTextLines(p, elementEnd, parseLine, data, filename);
+      }
+      p = elementEnd;
+
+    } else {
+      std::vector<const char*> blocks = findPLYBinaryBlocks(element, p, end, swapBytes, filename);
+      if (isVertices) {
+        readPLYBinaryVertices(element, blocks, swapBytes, data, filename);
+      } else if (isFaces) {
+        readPLYBinaryFaces(element, blocks, swapBytes, data, filename);
+      }
+      p = blocks.back();
+    }
+
+    if (isVertices) haveVertices = true;
+  }
+  if (!haveVertices) exception("PLY file " + filename + " does not have vertices");
+
+  checkMeshFileIndices(data, filename);
+  return data;
+}
+
+MeshFileData readMeshFileDotMesh(std::string filename) {
+  MemoryMappedFile file(filename);
+  MeshFileData data;
+
+  const char* p = file.data();
+  const char* end = file.data() + file.size();
+  int dimension = 3;
+
+  // Find each section, then parse its records (one per line) in parallel
+  while (p < end) {
+    std::string keyword = nextDotMeshWord(p, end);
+    if (keyword.empty() || keyword == "End") break;
+
+    if (keyword == "MeshVersionFormatted") {
+      nextDotMeshWord(p, end);
+      continue;
+    }
+    if (keyword == "Dimension") {
+      dimension = std::atoi(nextDotMeshWord(p, end).c_str());
+      if (dimension != 2 && dimension != 3) exception("unsupported dimension in mesh file " + filename);
+      continue;
+    }
+
+    // Other keywords start a section: a count, then one record per line
+    const char* countStart = p;
+    std::string countWord = nextDotMeshWord(p, end);
+    const char* countPtr = countWord.c_str();
+    int64_t count;
+    if (!parseInt(countPtr, countPtr + countWord.size(), count) || count < 0) {
+      p = countStart; // not a section we can skip, move on to the next word
+      continue;
+    }
+    const char* sectionStart = std::min(findLineEnd(p, end) + 1, end);
+    const char* sectionEnd = skipLines(sectionStart, end, count);
+
+    LineParser parseLine;
+    if (keyword == "Vertices") {
+      parseLine = [&](const char* line, const char* lineEnd, TextChunk& chunk) {
+        parseLineDotMeshVertex(dimension, line, lineEnd, chunk, filename);
+      };
+    }
+    for (const DotMeshSection& section : dotMeshSections) {
+      if (keyword != section.keyword) continue;
+      int nIndices = section.nIndices;
+      bool isCell = (keyword == "Tetrahedra" || keyword == "Hexahedra");
+      parseLine = [&filename, nIndices, isCell](const char* line, const char* lineEnd, TextChunk& chunk) {
+        parseLineDotMeshElement(nIndices, isCell, line, lineEnd, chunk, filename);
+      };
+    }
+    if (parseLine) {
+      parseTextLines(sectionStart, sectionEnd, parseLine, data, filename);
+    }
+
+    p = sectionEnd;
+  }
+
+  checkMeshFileIndices(data, filename);
+  return data;
+}
+
+SurfaceMesh* loadSurfaceMesh(std::string name, std::string filename) {
+  checkInitialized();
+
+  MeshFileData data = readMeshFile(filename);
+  if (data.nFaces() == 0 && !data.cells.empty()) {
+    exception("mesh file " + filename + " holds volume cells, use loadVolumeMesh() to load it");
+  }
+
+  return registerSurfaceMeshFlat(name, std::move(data.vertexPositions), std::move(data.faceIndsEntries),
+                                 std::move(data.faceIndsStart));
+}
+
+VolumeMesh* loadVolumeMesh(std::string name, std::string filename) {
+  checkInitialized();
+
+  MeshFileData data = readMeshFile(filename);
+  if (data.cells.empty()) {
+    exception("mesh file " + filename + " has no volume cells, use loadSurfaceMesh() to load it");
+  }
+
+  VolumeMesh* s = new VolumeMesh(name, std::move(data.vertexPositions), std::move(data.cells));
+  bool success = registerStructure(s);
+  if (!success) {
+    safeDelete(s);
+  }
+
+  return s;
+}
+
+} // namespace polyscope
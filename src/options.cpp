@@ -18,11 +18,16 @@ bool alwaysRedraw = false;
 bool autocenterStructures = false;
 bool autoscaleStructures = false;
 bool automaticallyComputeSceneExtents = true;
+bool deferStructureBounds = false;
+bool enableViewCulling = true;
+bool enableOcclusionCulling = false;
+int maxThreads = 0;
 bool invokeUserCallbackForNestedShow = false;
 bool giveFocusOnShow = false;
 
 bool screenshotTransparency = true;
 std::string screenshotExtension = ".png";
+int maxPendingScreenshots = 4;
 
 // == Scene options
 
@@ -41,6 +46,9 @@ int ssaaFactor = 1;
 TransparencyMode transparencyMode = TransparencyMode::None;
 int transparencyRenderPasses = 8;
 
+// Compact render buffers
+bool compactRenderBuffers = false;
+
 // === Advanced ImGui configuration
 
 bool buildGui = true;
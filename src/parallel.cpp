@@ -0,0 +1,150 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/parallel.h"
+
+#include "polyscope/options.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace polyscope {
+
+size_t parallelThreadCount() {
+  size_t nThreads = std::max(1u, std::thread::hardware_concurrency());
+  if (options::maxThreads > 0) {
+    nThreads = std::min(nThreads, static_cast<size_t>(options::maxThreads));
+  }
+  return nThreads;
+}
+
+size_t parallelChunkCount(size_t n, size_t chunkSize) {
+  chunkSize = std::max(chunkSize, static_cast<size_t>(1));
+  return (n + chunkSize - 1) / chunkSize;
+}
+
+namespace {
+
+// The state of one parallelForChunks() call. Helper threads hold it by shared_ptr, so one which picks up the call late
+// finds no chunks left and never touches func, which is only valid until the caller returns.
+struct ChunkJob {
+  const std::function<void(size_t, size_t, size_t)>* func;
+  size_t n;
+  size_t chunkSize;
+  size_t nChunks;
+  size_t helpersWanted; // guarded by the pool mutex
+  std::atomic<size_t> nextChunk{0};
+  std::atomic<size_t> finishedChunks{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr firstException;
+  std::mutex mutex; // guards firstException and waiting on allFinished
+  std::condition_variable allFinished;
+
+  // Claim and run chunks until none are left
+  void work() {
+    while (true) {
+      size_t iChunk = nextChunk++;
+      if (iChunk >= nChunks) return;
+      if (!failed) {
+        try {
+          (*func)(iChunk, iChunk * chunkSize, std::min(n, (iChunk + 1) * chunkSize));
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!firstException) firstException = std::current_exception();
+          failed = true; // the remaining chunks are claimed but skipped
+        }
+      }
+      if (++finishedChunks == nChunks) {
+        std::lock_guard<std::mutex> lock(mutex);
+        allFinished.notify_all();
+      }
+    }
+  }
+};
+
+// Worker threads are started the first time they are needed, and more are added if options::maxThreads goes up. The
+// pool is never destroyed: joining threads from static destructors can deadlock (e.g. when loaded as a DLL), and idle
+// workers just wait on a condition variable.
+class ChunkThreadPool {
+public:
+  void run(const std::shared_ptr<ChunkJob>& job, size_t nHelpers) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (; nWorkers < nHelpers; nWorkers++) {
+        std::thread(&ChunkThreadPool::workerLoop, this).detach();
+      }
+      job->helpersWanted = nHelpers;
+      jobs.push_back(job);
+    }
+    newJob.notify_all();
+
+    // The calling thread works too. Since it can finish every chunk on its own, calls from inside a chunk (or from
+    // several threads at once) cannot deadlock waiting for busy workers.
+    job->work();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::deque<std::shared_ptr<ChunkJob>>::iterator it = std::find(jobs.begin(), jobs.end(), job);
+      if (it != jobs.end()) jobs.erase(it);
+    }
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->allFinished.wait(lock, [&]() { return job->finishedChunks == job->nChunks; });
+  }
+
+private:
+  std::mutex mutex; // guards the members below, and ChunkJob::helpersWanted
+  std::condition_variable newJob;
+  std::deque<std::shared_ptr<ChunkJob>> jobs; // calls which still want helpers
+  size_t nWorkers = 0;
+
+  void workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      newJob.wait(lock, [&]() { return !jobs.empty(); });
+      std::shared_ptr<ChunkJob> job = jobs.front();
+      if (--job->helpersWanted == 0) jobs.pop_front();
+      lock.unlock();
+      job->work();
+      lock.lock();
+    }
+  }
+};
+
+ChunkThreadPool& chunkThreadPool() {
+  static ChunkThreadPool* pool = new ChunkThreadPool(); // deliberately leaked, see above
+  return *pool;
+}
+
+} // namespace
+
+void parallelForChunks(size_t n, size_t chunkSize, const std::function<void(size_t, size_t, size_t)>& func) {
+  chunkSize = std::max(chunkSize, static_cast<size_t>(1));
+  size_t nChunks = parallelChunkCount(n, chunkSize);
+  size_t nThreads = std::min(parallelThreadCount(), nChunks);
+
+  // Small inputs: no threads
+  if (nThreads <= 1) {
+    for (size_t iChunk = 0; iChunk < nChunks; iChunk++) {
+      func(iChunk, iChunk * chunkSize, std::min(n, (iChunk + 1) * chunkSize));
+    }
+    return;
+  }
+
+  std::shared_ptr<ChunkJob> job = std::make_shared<ChunkJob>();
+  job->func = &func;
+  job->n = n;
+  job->chunkSize = chunkSize;
+  job->nChunks = nChunks;
+  chunkThreadPool().run(job, nThreads - 1);
+
+  if (job->firstException) {
+    std::rethrow_exception(job->firstException);
+  }
+}
+
+} // namespace polyscope
@@ -119,14 +119,7 @@ size_t localIndexToGlobal(std::pair<Structure*, size_t> localPick) {
 }
 
 
-std::pair<Structure*, size_t> evaluatePickQuery(int xPos, int yPos) {
-
-  // NOTE: hack used for debugging: if xPos == yPos == -1 we do a pick render but do not query the value.
-
-  // Be sure not to pick outside of buffer
-  if (xPos < -1 || xPos >= view::bufferWidth || yPos < -1 || yPos >= view::bufferHeight) {
-    return {nullptr, 0};
-  }
+bool renderPickBuffer() {
 
   render::FrameBuffer* pickFramebuffer = render::engine->pickFramebuffer.get();
 
@@ -136,16 +129,32 @@ std::pair<Structure*, size_t> evaluatePickQuery(int xPos, int yPos) {
   pickFramebuffer->resize(view::bufferWidth, view::bufferHeight);
   pickFramebuffer->setViewport(0, 0, view::bufferWidth, view::bufferHeight);
   pickFramebuffer->clearColor = glm::vec3{0., 0., 0.};
-  if (!pickFramebuffer->bindForRendering()) return {nullptr, 0};
+  if (!pickFramebuffer->bindForRendering()) return false;
   pickFramebuffer->clear();
 
   // Render pick buffer
   for (auto cat : state::structures) {
     for (auto x : cat.second) {
+      if (options::enableViewCulling && !x.second->mayBeInView()) continue;
       x.second->drawPick();
     }
   }
 
+  return true;
+}
+
+std::pair<Structure*, size_t> evaluatePickQuery(int xPos, int yPos) {
+
+  // NOTE: hack used for debugging: if xPos == yPos == -1 we do a pick render but do not query the value.
+
+  // Be sure not to pick outside of buffer
+  if (xPos < -1 || xPos >= view::bufferWidth || yPos < -1 || yPos >= view::bufferHeight) {
+    return {nullptr, 0};
+  }
+
+  render::FrameBuffer* pickFramebuffer = render::engine->pickFramebuffer.get();
+  if (!renderPickBuffer()) return {nullptr, 0};
+
   if (xPos == -1 || yPos == -1) {
     return {nullptr, 0};
   }
@@ -2,10 +2,12 @@
 
 #include "polyscope/point_cloud.h"
 
+#include "polyscope/bounds.h"
 #include "polyscope/file_helpers.h"
 #include "polyscope/pick.h"
 #include "polyscope/polyscope.h"
 #include "polyscope/render/engine.h"
+#include "polyscope/scene_file.h"
 
 #include "polyscope/point_cloud_color_quantity.h"
 #include "polyscope/point_cloud_scalar_quantity.h"
@@ -30,15 +32,25 @@ PointCloud::PointCloud(std::string name, std::vector<glm::vec3> points_)
       pointRenderMode(uniquePrefix() + "#pointRenderMode", "sphere"),
       pointColor(uniquePrefix() + "#pointColor", getNextUniqueColor()),
       pointRadius(uniquePrefix() + "#pointRadius", relativeValue(0.005)),
-      material(uniquePrefix() + "#material", "clay")
+      material(uniquePrefix() + "#material", "clay"),
+      pickColors(uniquePrefix() + "#pickColors", pickColorsData)
 // clang-format on
 {
   cullWholeElements.setPassive(true);
-  updateObjectSpaceBounds();
+  if (options::compactRenderBuffers) {
+    points.setDeviceQuantization(BufferQuantization::UNorm16InBounds);
+  }
+  objectSpaceBoundsChanged();
 }
 
 // Helper to set uniforms
 void PointCloud::setPointCloudUniforms(render::ShaderProgram& p) {
+  if (useVisibleDrawRanges) {
+    p.setDrawRanges(visibleDrawRanges);
+  } else {
+    p.clearDrawRanges();
+  }
+
   glm::mat4 P = view::getCameraPerspectiveMatrix();
   glm::mat4 Pinv = glm::inverse(P);
 
@@ -61,6 +73,8 @@ void PointCloud::setPointCloudUniforms(render::ShaderProgram& p) {
 
     p.setUniform("u_pointRadius", pointRadius.get().asAbsolute() / scalarQScale);
   }
+
+  points.setDequantizeUniforms(p);
 }
 
 void PointCloud::draw() {
@@ -78,6 +92,8 @@ void PointCloud::draw() {
   }
 
 
+  updateVisibleDrawRanges();
+
   // If there is no dominant quantity, then this class is responsible for drawing points
   if (dominantQuantity == nullptr) {
 
@@ -122,6 +138,7 @@ void PointCloud::drawPick() {
 
   // Ensure we have prepared buffers
   ensurePickProgramPrepared();
+  updateVisibleDrawRanges();
 
   // Set uniforms
   setStructureUniforms(*pickProgram);
@@ -147,11 +164,20 @@ void PointCloud::ensureRenderProgramPrepared() {
 }
 
 void PointCloud::ensurePickProgramPrepared() {
+  // If already prepared, do nothing
+  if (pickProgram) return;
+
   ensureRenderProgramPrepared();
 
-  // Request pick indices
-  size_t pickCount = nPoints();
-  size_t pickStart = pick::requestPickBufferRange(this, pickCount);
+  // Request pick indices. Streamed clouds reserve spare indices, so appended points can be picked without requesting
+  // a new range.
+  pickCapacity = nPoints();
+  if (maxStreamSize > 0) {
+    pickCapacity = std::max(pickCapacity, maxStreamSize);
+  } else if (streamLastAppendSize > 0) {
+    pickCapacity = 2 * pickCapacity;
+  }
+  pickStart = pick::requestPickBufferRange(this, pickCapacity);
 
   // Create a new pick program
   // clang-format off
@@ -165,14 +191,14 @@ void PointCloud::ensurePickProgramPrepared() {
   setPointProgramGeometryAttributes(*pickProgram);
 
   // Fill color buffer with packed point indices
-  std::vector<glm::vec3> pickColors;
-  for (size_t i = pickStart; i < pickStart + pickCount; i++) {
-    glm::vec3 val = pick::indToVec(i);
-    pickColors.push_back(pick::indToVec(i));
+  pickColors.data.resize(nPoints());
+  for (size_t i = 0; i < nPoints(); i++) {
+    pickColors.data[i] = pick::indToVec(pickStart + i);
   }
+  pickColors.markHostBufferRangeUpdated(0, nPoints());
 
   // Store data in buffers
-  pickProgram->setAttribute("a_color", pickColors);
+  pickProgram->setAttribute("a_color", pickColors.getRenderAttributeBuffer());
 }
 
 void PointCloud::setPointProgramGeometryAttributes(render::ShaderProgram& p) {
@@ -199,6 +225,7 @@ glm::vec3 PointCloud::getPointPosition(size_t iPt) { return points.getValue(iPt)
 std::vector<std::string> PointCloud::addPointCloudRules(std::vector<std::string> initRules, bool withPointCloud) {
   initRules = addStructureRules(initRules);
   if (withPointCloud) {
+    initRules = points.addDequantizeRules(initRules);
     if (pointRadiusQuantityName != "") {
       initRules.push_back("SPHERE_VARIABLE_SIZE");
     }
@@ -309,25 +336,152 @@ void PointCloud::buildCustomOptionsUI() {
 
 void PointCloud::updateObjectSpaceBounds() {
   points.ensureHostBufferPopulated();
+  computePointBounds(points.data, objectSpaceBoundingBox, objectSpaceLengthScale, &cullingBlockBoxes);
+}
+
+bool PointCloud::pointRadiiAreBounded() {
+  // with a non-autoscaled radius quantity, the point radii can be anything
+  return pointRadiusQuantityName == "" || pointRadiusQuantityAutoscale;
+}
 
-  // bounding box
-  glm::vec3 min = glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
-  glm::vec3 max = -glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
-  for (const glm::vec3& p : points.data) {
-    min = componentwiseMin(min, p);
-    max = componentwiseMax(max, p);
+bool PointCloud::isCullable() { return pointRadiiAreBounded() && quantitiesStayWithinBounds(); }
+
+float PointCloud::cullingMargin() { return pointRadius.get().asAbsolute(); }
+
+void PointCloud::updateVisibleDrawRanges() {
+  useVisibleDrawRanges = false;
+
+  // Block culling only touches the programs which draw the points themselves, so other quantities don't matter here
+  if (!options::enableViewCulling || !pointRadiiAreBounded() || nPoints() <= pointBoundsBlockSize) return;
+  if (!objectSpaceBoundsReadyForCulling()) return; // the block boxes are computed with the bounds
+  std::array<glm::vec4, 6> planes =
+      frustumPlanes(view::getCameraPerspectiveMatrix() * view::getCameraViewMatrix());
+  const glm::mat4& T = objectTransform.get();
+  const OcclusionDepthMap* occlusion = internal::currentOcclusionDepthMap();
+  float margin = cullingMargin();
+
+  std::vector<size_t> visibleBlocks;
+  for (size_t iBlock = 0; iBlock < cullingBlockBoxes.size(); iBlock++) {
+    if (boxMayIntersectFrustum(planes, T, std::get<0>(cullingBlockBoxes[iBlock]),
+                               std::get<1>(cullingBlockBoxes[iBlock]), margin)) {
+      if (occlusion && !boxMayBeUnoccluded(*occlusion, T, std::get<0>(cullingBlockBoxes[iBlock]),
+                                           std::get<1>(cullingBlockBoxes[iBlock]), margin)) {
+        internal::occlusionCulledCount++;
+        continue;
+      }
+      visibleBlocks.push_back(iBlock);
+    }
   }
-  objectSpaceBoundingBox = std::make_tuple(min, max);
+  if (visibleBlocks.size() == cullingBlockBoxes.size()) return;
+
+  visibleDrawRanges = blockIndicesToRanges(visibleBlocks, pointBoundsBlockSize, nPoints());
+  useVisibleDrawRanges = true;
+}
 
-  // length scale, as twice the radius from the center of the bounding box
-  glm::vec3 center = 0.5f * (min + max);
-  float lengthScale = 0.0;
-  for (const glm::vec3& p : points.data) {
-    lengthScale = std::max(lengthScale, glm::length2(p - center));
+
+void PointCloud::appendPointsImpl(const std::vector<glm::vec3>& newPositions) {
+
+  size_t oldSize = nPoints();
+  size_t nNew = newPositions.size();
+
+  // Work out which slots the new points land in. If more points arrive than the ring can hold, only the newest ones
+  // are kept.
+  streamLastAppendSize = nNew;
+  streamLastAppendRanges.clear();
+  size_t srcStart = 0;
+  if (maxStreamSize > 0 && nNew > maxStreamSize) {
+    srcStart = nNew - maxStreamSize;
+  }
+  size_t toGrow = nNew - srcStart;
+  if (maxStreamSize > 0) {
+    toGrow = std::min(toGrow, maxStreamSize - oldSize);
+  }
+  if (toGrow > 0) {
+    streamLastAppendRanges.emplace_back(srcStart, oldSize, toGrow);
+    srcStart += toGrow;
+  }
+  while (srcStart < nNew) {
+    size_t count = std::min(nNew - srcStart, maxStreamSize - streamNextSlot);
+    streamLastAppendRanges.emplace_back(srcStart, streamNextSlot, count);
+    srcStart += count;
+    streamNextSlot = (streamNextSlot + count) % maxStreamSize;
+  }
+
+  // Write the positions
+  writeAppendedValues(points, newPositions);
+  for (const std::tuple<size_t, size_t, size_t>& range : streamLastAppendRanges) {
+    updateBlockBounds(points.data.data(), nPoints(), pointBoundsBlockSize, std::get<1>(range),
+                      std::get<1>(range) + std::get<2>(range), cullingBlockBoxes);
   }
-  objectSpaceLengthScale = 2 * std::sqrt(lengthScale);
+
+  // Pick colors for the newly-grown slots; overwritten slots keep their index
+  if (pickProgram) {
+    if (nPoints() <= pickCapacity) {
+      pickColors.ensureHostBufferPopulated();
+      pickColors.data.resize(nPoints());
+      for (size_t i = oldSize; i < nPoints(); i++) {
+        pickColors.data[i] = pick::indToVec(pickStart + i);
+      }
+      pickColors.markHostBufferRangeUpdated(oldSize, nPoints() - oldSize);
+    } else {
+      pickProgram.reset(); // rebuilt with a larger range on the next pick
+    }
+  }
+
+  // Pad quantities with default values
+  for (auto& q : quantities) {
+    q.second->appendDefaultData();
+  }
+
+  expandObjectSpaceBounds(newPositions);
+  requestRedraw();
+}
+
+void PointCloud::updatePointPositionsRangeImpl(size_t start, const std::vector<glm::vec3>& newPositions) {
+  if (start + newPositions.size() > nPoints()) {
+    exception("point cloud " + name + " position range update [" + std::to_string(start) + ", " +
+              std::to_string(start + newPositions.size()) + ") is out of bounds, cloud has " +
+              std::to_string(nPoints()) + " points");
+  }
+
+  points.ensureHostBufferPopulated();
+  std::copy(newPositions.begin(), newPositions.end(), points.data.begin() + start);
+  points.markHostBufferRangeUpdated(start, newPositions.size());
+  updateBlockBounds(points.data.data(), nPoints(), pointBoundsBlockSize, start, start + newPositions.size(),
+                    cullingBlockBoxes);
+
+  // The old positions are not removed from the bounds, so they may become conservative
+  expandObjectSpaceBounds(newPositions);
+  requestRedraw();
+}
+
+void PointCloud::expandObjectSpaceBounds(const std::vector<glm::vec3>& newPositions) {
+  // If the bounds are stale they will be fully recomputed when needed anyway
+  if (objectSpaceBoundsStale) return;
+
+  std::tuple<glm::vec3, glm::vec3> oldBoundingBox = objectSpaceBoundingBox;
+  float oldLengthScale = objectSpaceLengthScale;
+  expandPointBounds(newPositions.data(), newPositions.size(), objectSpaceBoundingBox, objectSpaceLengthScale);
+
+  // Only the scene extents depend on the bounds; skip recomputing them unless the bounds actually changed
+  if (objectSpaceBoundingBox != oldBoundingBox || objectSpaceLengthScale != oldLengthScale) {
+    updateStructureExtents();
+  }
+}
+
+PointCloud* PointCloud::setMaxStreamSize(size_t newVal) {
+  if (newVal > 0 && newVal < nPoints()) {
+    exception("point cloud " + name + " has " + std::to_string(nPoints()) +
+              " points, cannot set a max stream size of " + std::to_string(newVal));
+  }
+  maxStreamSize = newVal;
+  streamNextSlot = 0;
+  return this;
 }
 
+size_t PointCloud::getMaxStreamSize() { return maxStreamSize; }
+
+size_t PointCloud::nAppendedPoints() { return streamLastAppendSize; }
 
 std::string PointCloud::typeName() { return structureTypeName; }
 
@@ -338,6 +492,53 @@ void PointCloud::refresh() {
   QuantityStructure<PointCloud>::refresh(); // call base class version, which refreshes quantities
 }
 
+bool PointCloud::writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) {
+  writer.writeArray(prefix + "points", points.getPopulatedHostBufferRef());
+  writer.writeString(prefix + "pointRadiusQuantityName", pointRadiusQuantityName);
+  writer.writeValue<uint8_t>(prefix + "pointRadiusQuantityAutoscale", pointRadiusQuantityAutoscale);
+
+  size_t iQ = 0;
+  for (auto& entry : quantities) {
+    std::string qPrefix = sceneFileQuantityPrefix(prefix, iQ);
+    Quantity& q = *entry.second;
+    if (writeScalarQuantityToSceneFile<PointCloudScalarQuantity>(writer, qPrefix, "scalar", q) ||
+        writeColorQuantityToSceneFile<PointCloudColorQuantity>(writer, qPrefix, "color", q) ||
+        writeVectorQuantityToSceneFile<PointCloudVectorQuantity>(writer, qPrefix, "vector", q)) {
+      iQ++;
+    } else {
+      warning("scene files cannot hold this kind of quantity", "skipped " + q.name + " on point cloud " + name);
+    }
+  }
+  writeSceneFileQuantityCount(writer, prefix, iQ);
+
+  return true;
+}
+
+PointCloud* PointCloud::createFromSceneFile(const SceneFileReader& reader, const std::string& prefix,
+                                            std::string name) {
+  std::unique_ptr<PointCloud> cloud(new PointCloud(name, reader.readArray<glm::vec3>(prefix + "points")));
+
+  for (const SceneFileQuantity& q : sceneFileQuantities(reader, prefix)) {
+    if (q.kind == "scalar") {
+      q.restoreScalar(cloud->addScalarQuantityImpl(q.name, q.readValues(), q.readDataType()));
+    } else if (q.kind == "color") {
+      q.restore(cloud->addColorQuantityImpl(q.name, q.readColors()));
+    } else if (q.kind == "vector") {
+      q.restore(cloud->addVectorQuantityImpl(q.name, q.readVectors(), q.readVectorType()));
+    } else {
+      q.warnUnsupported(name);
+    }
+  }
+
+  std::string radiusQuantityName = reader.readString(prefix + "pointRadiusQuantityName");
+  if (radiusQuantityName != "") {
+    cloud->setPointRadiusQuantity(radiusQuantityName,
+                                  reader.readValue<uint8_t>(prefix + "pointRadiusQuantityAutoscale"));
+  }
+
+  return cloud.release();
+}
+
 
 // === Set point size from a scalar quantity
 void PointCloud::setPointRadiusQuantity(PointCloudScalarQuantity* quantity, bool autoScale) {
@@ -366,6 +567,7 @@ PointCloudQuantity::PointCloudQuantity(std::string name_, PointCloud& pointCloud
 
 
 void PointCloudQuantity::buildInfoGUI(size_t pointInd) {}
+void PointCloudQuantity::appendDefaultData() {}
 
 // === Quantity adders
 
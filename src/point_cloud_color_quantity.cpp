@@ -30,6 +30,15 @@ void PointCloudColorQuantity::draw() {
 
 std::string PointCloudColorQuantity::niceName() { return name + " (color)"; }
 
+void PointCloudColorQuantity::appendDataImpl(const std::vector<glm::vec3>& newColors) {
+  validateSize(newColors, parent.nAppendedPoints(), "point cloud color quantity " + name);
+  parent.writeAppendedValues(colors, newColors);
+}
+
+void PointCloudColorQuantity::appendDefaultData() {
+  parent.writeAppendedValues(colors, std::vector<glm::vec3>(parent.nAppendedPoints(), glm::vec3{0., 0., 0.}));
+}
+
 void PointCloudColorQuantity::createPointProgram() {
 
   // Create the program to draw this quantity
@@ -74,6 +74,15 @@ void PointCloudParameterizationQuantity::refresh() {
 
 std::string PointCloudParameterizationQuantity::niceName() { return name + " (parameterization)"; }
 
+void PointCloudParameterizationQuantity::appendDataImpl(const std::vector<glm::vec2>& newCoords) {
+  validateSize(newCoords, parent.nAppendedPoints(), "point cloud parameterization quantity " + name);
+  parent.writeAppendedValues(coords, newCoords);
+}
+
+void PointCloudParameterizationQuantity::appendDefaultData() {
+  parent.writeAppendedValues(coords, std::vector<glm::vec2>(parent.nAppendedPoints(), glm::vec2{0., 0.}));
+}
+
 void PointCloudParameterizationQuantity::buildPickUI(size_t ind) {
 
   glm::vec2 coord = coords.getValue(ind);
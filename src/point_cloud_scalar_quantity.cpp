@@ -82,4 +82,16 @@ void PointCloudScalarQuantity::buildPickUI(size_t ind) {
 
 std::string PointCloudScalarQuantity::niceName() { return name + " (scalar)"; }
 
+void PointCloudScalarQuantity::appendDataImpl(const std::vector<double>& newValues) {
+  validateSize(newValues, parent.nAppendedPoints(), "point cloud scalar quantity " + name);
+  parent.writeAppendedValues(values, newValues);
+  valuesUpdated(newValues);
+}
+
+void PointCloudScalarQuantity::appendDefaultData() {
+  // (placeholder values do not grow the ranges, but the histogram changes)
+  parent.writeAppendedValues(values, std::vector<double>(parent.nAppendedPoints(), 0.));
+  invalidateDataStatistics();
+}
+
 } // namespace polyscope
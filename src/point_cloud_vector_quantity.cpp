@@ -48,4 +48,17 @@ void PointCloudVectorQuantity::buildPickUI(size_t ind) {
 
 std::string PointCloudVectorQuantity::niceName() { return name + " (vector)"; }
 
+bool PointCloudVectorQuantity::drawsOutsideStructureBounds() { return true; }
+
+void PointCloudVectorQuantity::appendDataImpl(const std::vector<glm::vec3>& newVectors) {
+  validateSize(newVectors, parent.nAppendedPoints(), "point cloud vector quantity " + name);
+  parent.writeAppendedValues(vectors, newVectors);
+  decimatedIndsDirty = true;
+}
+
+void PointCloudVectorQuantity::appendDefaultData() {
+  parent.writeAppendedValues(vectors, std::vector<glm::vec3>(parent.nAppendedPoints(), glm::vec3{0., 0., 0.}));
+  decimatedIndsDirty = true;
+}
+
 } // namespace polyscope
@@ -9,6 +9,7 @@
 
 #include "imgui.h"
 
+#include "polyscope/bounds.h"
 #include "polyscope/pick.h"
 #include "polyscope/render/engine.h"
 #include "polyscope/view.h"
@@ -39,6 +40,7 @@ struct ContextEntry {
 std::vector<ContextEntry> contextStack;
 
 bool redrawNextFrame = true;
+bool occlusionRedrawNeeded = false; // occlusion culling used a depth map which was then found to be stale
 
 // Some state about imgui windows to stack them
 float imguiStackMargin = 10;
@@ -256,6 +258,7 @@ void drawStructures() {
 
   for (auto catMap : state::structures) {
     for (auto s : catMap.second) {
+      if (options::enableViewCulling && !s.second->mayBeInView()) continue;
       s.second->draw();
     }
   }
@@ -271,6 +274,7 @@ void drawStructuresDelayed() {
   // drawn
   for (auto catMap : state::structures) {
     for (auto s : catMap.second) {
+      if (options::enableViewCulling && !s.second->mayBeInView()) continue;
       s.second->drawDelayed();
     }
   }
@@ -407,8 +411,29 @@ void renderSlicePlanes() {
   }
 }
 
+// Keep the depth of the frame just rendered for occlusion culling in the next one. If anything was culled against an
+// older map and the depth has changed since, that geometry might have been uncovered, so the frame is redrawn. Once
+// the depth stops changing, everything culled is hidden behind what was drawn.
+void updateOcclusionDepthMap(bool depthIsOpaque) {
+  OcclusionDepthMap& map = internal::occlusionDepthMap;
+  if (!options::enableViewCulling || !options::enableOcclusionCulling || !depthIsOpaque) {
+    map = OcclusionDepthMap();
+    return;
+  }
+
+  render::FrameBuffer* sceneBuffer = render::engine->sceneBuffer.get();
+  std::vector<float> depth;
+  sceneBuffer->readDepthBuffer(depth);
+  if (internal::occlusionCulledCount > 0 && (!map.isValid() || depth != map.levels.front())) {
+    occlusionRedrawNeeded = true;
+  }
+  buildOcclusionDepthMap(depth, sceneBuffer->getSizeX(), sceneBuffer->getSizeY(),
+                         view::getCameraPerspectiveMatrix() * view::getCameraViewMatrix(), map);
+}
+
 void renderScene() {
   processLazyProperties();
+  internal::occlusionCulledCount = 0;
 
   render::engine->applyTransparencySettings();
 
@@ -480,6 +505,9 @@ void renderScene() {
 
     render::engine->sceneBuffer->blitTo(render::engine->sceneBufferFinal.get());
   }
+
+  // (with transparency, the depth buffer does not hide what is behind it)
+  updateOcclusionDepthMap(render::engine->getTransparencyMode() == TransparencyMode::None);
 } // namespace
 
 void renderSceneToScreen() {
@@ -702,10 +730,12 @@ void buildUserGuiAndInvokeCallback() {
 }
 
 void draw(bool withUI, bool withContextCallback) {
+  internal::drawCount++;
   processLazyProperties();
 
   // Update buffer and context
   render::engine->makeContextCurrent();
+  render::engine->ensureScreenBufferSizes(); // e.g. back from an offscreen size, see renderToBuffer()
   render::engine->bindDisplay();
   render::engine->setBackgroundColor({view::bgColor[0], view::bgColor[1], view::bgColor[2]});
   render::engine->setBackgroundAlpha(view::bgColor[3]);
@@ -746,8 +776,12 @@ void draw(bool withUI, bool withContextCallback) {
 
   // Draw structures in the scene
   if (redrawNextFrame || options::alwaysRedraw) {
+    // occlusion culling only in interactive frames, other renders (like screenshots) would not get redrawn
+    occlusionRedrawNeeded = false;
+    internal::occlusionCullingActive = withUI;
     renderScene();
-    redrawNextFrame = false;
+    internal::occlusionCullingActive = false;
+    redrawNextFrame = occlusionRedrawNeeded;
   }
   renderSceneToScreen();
 
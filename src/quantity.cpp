@@ -35,6 +35,8 @@ void Quantity::refresh() { requestRedraw(); }
 
 std::string Quantity::niceName() { return name; }
 
+bool Quantity::drawsOutsideStructureBounds() { return false; }
+
 std::string Quantity::uniquePrefix() { return parent.uniquePrefix() + name + "#"; }
 
 } // namespace polyscope
@@ -0,0 +1,402 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/quantity_sequence.h"
+
+#include "polyscope/curve_network.h"
+#include "polyscope/point_cloud.h"
+#include "polyscope/polyscope.h"
+#include "polyscope/surface_mesh.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace polyscope {
+
+// =======================================================
+// === Frame sources
+// =======================================================
+
+FrameSource::~FrameSource() {}
+
+void FrameSource::willReadFrame(size_t iFrame) {}
+
+MemoryFrameSource::MemoryFrameSource(std::vector<std::vector<float>> frames_) : frames(std::move(frames_)) {
+  for (const std::vector<float>& frame : frames) {
+    if (frame.size() != frames.front().size()) {
+      exception("MemoryFrameSource: all frames must have the same size");
+    }
+  }
+}
+
+size_t MemoryFrameSource::frameCount() { return frames.size(); }
+
+size_t MemoryFrameSource::frameSize() { return frames.empty() ? 0 : frames.front().size(); }
+
+void MemoryFrameSource::readFrame(size_t iFrame, std::vector<float>& out) {
+  if (iFrame >= frames.size()) {
+    exception("MemoryFrameSource: frame " + std::to_string(iFrame) + " out of range");
+  }
+  out = frames[iFrame];
+}
+
+MappedFileFrameSource::MappedFileFrameSource(std::string filename, size_t frameSize_, size_t headerBytes_)
+    : file(filename), nValues(frameSize_), headerBytes(headerBytes_) {
+  if (nValues == 0) {
+    exception("MappedFileFrameSource: frame size must be nonzero");
+  }
+  size_t frameBytes = nValues * sizeof(float);
+  size_t dataBytes = file.size() > headerBytes ? file.size() - headerBytes : 0;
+  if (dataBytes % frameBytes != 0) {
+    exception("MappedFileFrameSource: " + filename + " does not hold a whole number of frames of " +
+              std::to_string(nValues) + " floats");
+  }
+  nFrames = dataBytes / frameBytes;
+}
+
+size_t MappedFileFrameSource::frameCount() { return nFrames; }
+
+size_t MappedFileFrameSource::frameSize() { return nValues; }
+
+void MappedFileFrameSource::readFrame(size_t iFrame, std::vector<float>& out) {
+  if (iFrame >= nFrames) {
+    exception("MappedFileFrameSource: frame " + std::to_string(iFrame) + " out of range");
+  }
+  out.resize(nValues);
+  std::memcpy(&out.front(), file.data() + headerBytes + iFrame * nValues * sizeof(float), nValues * sizeof(float));
+}
+
+void MappedFileFrameSource::willReadFrame(size_t iFrame) {
+  if (iFrame >= nFrames) return;
+  file.prefetch(headerBytes + iFrame * nValues * sizeof(float), nValues * sizeof(float));
+}
+
+// =======================================================
+// === Sequences
+// =======================================================
+
+QuantitySequence::QuantitySequence(std::string name_, std::shared_ptr<FrameSource> source_, ApplyFunc apply_,
+                                   size_t cacheFrames_)
+    : name(name_), source(source_), apply(apply_), cacheFrames(std::max(cacheFrames_, static_cast<size_t>(2))) {
+  cache.reserve(cacheFrames); // entries are never reallocated, so pointers to them stay valid
+  prefetchThread = std::thread([this]() { prefetchWork(); });
+}
+
+QuantitySequence::~QuantitySequence() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  queueChanged.notify_all();
+  prefetchThread.join();
+}
+
+size_t QuantitySequence::frameCount() { return source->frameCount(); }
+
+bool QuantitySequence::showFrame(size_t iFrame) {
+  if (iFrame >= frameCount()) {
+    exception("sequence " + name + ": frame " + std::to_string(iFrame) + " out of range");
+  }
+
+  std::shared_ptr<const std::vector<float>> values;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    CachedFrame* frame = findCached(iFrame);
+    if (frame == nullptr) {
+      // not prefetched, read it now
+      lock.unlock();
+      std::vector<float> readValues;
+      source->readFrame(iFrame, readValues);
+      lock.lock();
+      frame = &insertCached(iFrame, std::move(readValues));
+    }
+    frame->lastUsed = ++useCounter;
+    values = frame->values;
+  }
+
+  // without the lock, so the prefetch thread keeps going during the upload (the values outlive an eviction)
+  return apply(*values);
+}
+
+bool QuantitySequence::isCached(size_t iFrame) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return findCached(iFrame) != nullptr;
+}
+
+size_t QuantitySequence::cachedFrameCount() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return cache.size();
+}
+
+void QuantitySequence::prefetch(const std::vector<size_t>& frames) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    prefetchQueue.clear();
+    for (size_t iFrame : frames) {
+      if (iFrame < source->frameCount() && findCached(iFrame) == nullptr) {
+        prefetchQueue.push_back(iFrame);
+      }
+    }
+  }
+  queueChanged.notify_all();
+
+  // let the OS start reading the frames from disk while the prefetch thread works through them
+  for (size_t iFrame : frames) {
+    source->willReadFrame(iFrame);
+  }
+}
+
+QuantitySequence::CachedFrame* QuantitySequence::findCached(size_t iFrame) {
+  for (CachedFrame& frame : cache) {
+    if (frame.iFrame == iFrame) return &frame;
+  }
+  return nullptr;
+}
+
+QuantitySequence::CachedFrame& QuantitySequence::insertCached(size_t iFrame, std::vector<float>&& values) {
+  CachedFrame* existing = findCached(iFrame);
+  if (existing != nullptr) return *existing;
+
+  if (cache.size() < cacheFrames) {
+    cache.push_back(CachedFrame{iFrame, ++useCounter, std::make_shared<const std::vector<float>>(std::move(values))});
+    return cache.back();
+  }
+
+  // evict the least recently used frame
+  CachedFrame& oldest = *std::min_element(cache.begin(), cache.end(), [](const CachedFrame& a, const CachedFrame& b) {
+    return a.lastUsed < b.lastUsed;
+  });
+  oldest.iFrame = iFrame;
+  oldest.lastUsed = ++useCounter;
+  oldest.values = std::make_shared<const std::vector<float>>(std::move(values));
+  return oldest;
+}
+
+void QuantitySequence::prefetchWork() {
+  std::vector<float> values;
+  while (true) {
+    size_t iFrame;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      queueChanged.wait(lock, [&]() { return stopping || !prefetchQueue.empty(); });
+      if (stopping) return;
+      iFrame = prefetchQueue.front();
+      prefetchQueue.pop_front();
+      if (findCached(iFrame) != nullptr) continue;
+    }
+
+    try {
+      source->readFrame(iFrame, values);
+    } catch (...) {
+      // skip it; if the frame is shown it will be read again on the main thread, which reports the error
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      insertCached(iFrame, std::move(values));
+    }
+  }
+}
+
+// =======================================================
+// === Timeline
+// =======================================================
+
+void checkSequenceFrameSize(FrameSource& source, size_t nElements, size_t valuesPerElement, std::string targetName) {
+  if (source.frameSize() != nElements * valuesPerElement) {
+    exception("sequence for " + targetName + ": frames have " + std::to_string(source.frameSize()) +
+              " values, expected " + std::to_string(nElements * valuesPerElement));
+  }
+}
+
+std::string sequenceTargetName(Structure& structure) { return structure.typeName() + "/" + structure.name; }
+
+Timeline::Timeline(std::string name_, size_t cacheFrames_)
+    : name(name_), cacheFrames(std::max(cacheFrames_, static_cast<size_t>(2))),
+      lastFrameTime(std::chrono::steady_clock::now()) {}
+
+Timeline::~Timeline() {}
+
+QuantitySequence* Timeline::addPositionSequence(PointCloud* cloud, std::shared_ptr<FrameSource> source) {
+  std::string cloudName = cloud->name;
+  checkSequenceFrameSize(*source, cloud->nPoints(), 3, sequenceTargetName(*cloud));
+  return addSequence(sequenceTargetName(*cloud), source, [cloudName](const std::vector<float>& frame) {
+    if (!hasPointCloud(cloudName)) return false;
+    getPointCloud(cloudName)->updatePointPositions(Vec3FrameView{frame});
+    return true;
+  });
+}
+
+QuantitySequence* Timeline::addPositionSequence(SurfaceMesh* mesh, std::shared_ptr<FrameSource> source) {
+  std::string meshName = mesh->name;
+  checkSequenceFrameSize(*source, mesh->nVertices(), 3, sequenceTargetName(*mesh));
+  return addSequence(sequenceTargetName(*mesh), source, [meshName](const std::vector<float>& frame) {
+    if (!hasSurfaceMesh(meshName)) return false;
+    getSurfaceMesh(meshName)->updateVertexPositions(Vec3FrameView{frame});
+    return true;
+  });
+}
+
+QuantitySequence* Timeline::addPositionSequence(CurveNetwork* curveNetwork, std::shared_ptr<FrameSource> source) {
+  std::string curveName = curveNetwork->name;
+  checkSequenceFrameSize(*source, curveNetwork->nNodes(), 3, sequenceTargetName(*curveNetwork));
+  return addSequence(sequenceTargetName(*curveNetwork), source, [curveName](const std::vector<float>& frame) {
+    if (!hasCurveNetwork(curveName)) return false;
+    getCurveNetwork(curveName)->updateNodePositions(Vec3FrameView{frame});
+    return true;
+  });
+}
+
+QuantitySequence* Timeline::addSequence(std::string sequenceName, std::shared_ptr<FrameSource> source,
+                                        QuantitySequence::ApplyFunc apply) {
+  for (const std::unique_ptr<QuantitySequence>& seq : sequences) {
+    if (seq->name == sequenceName) {
+      exception("timeline " + name + " already has a sequence named " + sequenceName);
+    }
+  }
+
+  sequences.emplace_back(new QuantitySequence(sequenceName, source, apply, cacheFrames));
+  QuantitySequence* seq = sequences.back().get();
+
+  // bring it in line with the others
+  if (currFrame < seq->frameCount()) {
+    seq->showFrame(currFrame);
+  }
+  prefetchFrom(currFrame);
+  return seq;
+}
+
+void Timeline::removeSequence(std::string sequenceName, bool errorIfAbsent) {
+  for (size_t i = 0; i < sequences.size(); i++) {
+    if (sequences[i]->name == sequenceName) {
+      sequences.erase(sequences.begin() + i);
+      return;
+    }
+  }
+  if (errorIfAbsent) {
+    exception("timeline " + name + " has no sequence named " + sequenceName);
+  }
+}
+
+void Timeline::removeAllSequences() { sequences.clear(); }
+
+size_t Timeline::frameCount() {
+  if (sequences.empty()) return 0;
+  size_t n = sequences.front()->frameCount();
+  for (const std::unique_ptr<QuantitySequence>& seq : sequences) {
+    n = std::min(n, seq->frameCount());
+  }
+  return n;
+}
+
+void Timeline::setFrame(size_t iFrame) {
+  if (iFrame >= frameCount()) {
+    exception("timeline " + name + ": frame " + std::to_string(iFrame) + " out of range");
+  }
+  currFrame = iFrame;
+  for (const std::unique_ptr<QuantitySequence>& seq : sequences) {
+    seq->showFrame(iFrame);
+  }
+  prefetchFrom(iFrame);
+  requestRedraw();
+}
+
+size_t Timeline::getFrame() { return currFrame; }
+
+void Timeline::setPlaying(bool newPlaying) {
+  playing = newPlaying;
+  lastFrameTime = std::chrono::steady_clock::now();
+  requestRedraw();
+}
+bool Timeline::isPlaying() { return playing; }
+
+void Timeline::setFramesPerSecond(double newFPS) { framesPerSecond = std::max(newFPS, 1e-3); }
+double Timeline::getFramesPerSecond() { return framesPerSecond; }
+
+void Timeline::setLoop(bool newLoop) {
+  loop = newLoop;
+  prefetchFrom(currFrame);
+}
+bool Timeline::getLoop() { return loop; }
+
+size_t Timeline::nextFrame(size_t iFrame) {
+  size_t n = frameCount();
+  if (iFrame + 1 < n) return iFrame + 1;
+  return loop ? 0 : iFrame;
+}
+
+void Timeline::prefetchFrom(size_t iFrame) {
+  // the frames which will be shown next, leaving room in the cache for the current one
+  std::vector<size_t> upcoming;
+  size_t f = iFrame;
+  for (size_t i = 0; i + 1 < cacheFrames; i++) {
+    size_t next = nextFrame(f);
+    if (next == f || next == iFrame) break;
+    upcoming.push_back(next);
+    f = next;
+  }
+  for (const std::unique_ptr<QuantitySequence>& seq : sequences) {
+    seq->prefetch(upcoming);
+  }
+}
+
+void Timeline::advancePlayback() {
+  if (!playing || frameCount() == 0) return;
+  requestRedraw(); // keep frames coming while playing
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  double elapsed = std::chrono::duration<double>(now - lastFrameTime).count();
+  if (elapsed < 1. / framesPerSecond) return;
+
+  size_t next = nextFrame(currFrame);
+  if (next == currFrame) {
+    playing = false; // reached the end
+    return;
+  }
+
+  // Wait for the prefetch threads rather than stalling the UI on a read, unless they seem to be stuck
+  bool allCached = true;
+  for (const std::unique_ptr<QuantitySequence>& seq : sequences) {
+    allCached = allCached && seq->isCached(next);
+  }
+  if (!allCached && elapsed < 1.) return;
+
+  setFrame(next);
+  lastFrameTime = now;
+}
+
+void Timeline::buildGUI() {
+  advancePlayback();
+
+  size_t n = frameCount();
+  ImGui::Begin(name.c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+
+  if (ImGui::Button(playing ? "Pause" : "Play")) {
+    setPlaying(!playing);
+  }
+  ImGui::SameLine();
+  ImGui::PushItemWidth(300);
+  int frameInt = static_cast<int>(currFrame);
+  if (ImGui::SliderInt("frame", &frameInt, 0, n == 0 ? 0 : static_cast<int>(n - 1)) && n > 0) {
+    setFrame(static_cast<size_t>(std::max(frameInt, 0)));
+  }
+  ImGui::PopItemWidth();
+
+  ImGui::PushItemWidth(100);
+  float fps = static_cast<float>(framesPerSecond);
+  if (ImGui::InputFloat("fps", &fps)) {
+    setFramesPerSecond(fps);
+  }
+  ImGui::PopItemWidth();
+  ImGui::SameLine();
+  bool loopVal = loop;
+  if (ImGui::Checkbox("loop", &loopVal)) {
+    setLoop(loopVal);
+  }
+
+  ImGui::End();
+}
+
+} // namespace polyscope
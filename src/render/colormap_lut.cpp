@@ -0,0 +1,136 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/render/colormap_lut.h"
+
+#include "polyscope/messages.h"
+#include "polyscope/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace polyscope {
+namespace render {
+
+namespace {
+
+// Values per parallel work item, and per block of table indices within it (kept on the stack)
+const size_t colorMapChunkSize = 1 << 16;
+const size_t colorMapBlockSize = 1024;
+
+void convertColor(glm::vec3 c, glm::vec3& out) { out = c; }
+void convertColor(glm::vec3 c, glm::u8vec3& out) {
+  for (int j = 0; j < 3; j++) {
+    out[j] = static_cast<uint8_t>(std::round(glm::clamp(c[j], 0.f, 1.f) * 255.f));
+  }
+}
+
+} // namespace
+
+ColorMapLUT::ColorMapLUT(const ValueColorMap& cmap, size_t resolution) : name(cmap.name) {
+  if (resolution < 2) exception("colormap table resolution must be at least 2");
+  if (cmap.values.empty()) exception("colormap " + cmap.name + " has no values");
+  if (resolution > std::numeric_limits<uint32_t>::max() / 2 - 1) exception("colormap table resolution is too large");
+
+  table.resize(resolution + 1);
+  for (size_t i = 0; i < resolution; i++) {
+    double t = static_cast<double>(i) / (resolution - 1);
+    // (the last sample is taken directly, getValue() would blend with the entry past the end)
+    table[i] = (cmap.values.size() == 1 || i + 1 == resolution) ? cmap.values.back() : cmap.getValue(t);
+  }
+  table[resolution] = glm::vec3{0., 0., 0.};
+}
+
+glm::vec3 ColorMapLUT::sample(double t) const {
+  if (!std::isfinite(t)) return table.back();
+  t = glm::clamp(t, 0.0, 1.0);
+  return table[static_cast<size_t>(t * (resolution() - 1) + 0.5)];
+}
+
+template <typename C>
+void ColorMapLUT::mapValuesImpl(const double* values, size_t n, const ColorMapParams& params, C* out) const {
+
+  // The output colors, followed by the same colors darkened for isoline stripes. Non-finite values index the final
+  // black entry of either half.
+  const uint32_t res = static_cast<uint32_t>(resolution());
+  const uint32_t blackInd = res;
+  const uint32_t darkOffset = res + 1;
+  std::vector<C> outTable(2 * table.size());
+  for (size_t i = 0; i < table.size(); i++) {
+    convertColor(table[i], outTable[i]);
+    convertColor(table[i] * static_cast<float>(params.isolineDarkness), outTable[darkOffset + i]);
+  }
+
+  // Affine map from values to (fractional) table indices. A zero-width range maps everything to the start, rather
+  // than dividing by zero.
+  const double low = params.range.first;
+  const double span = params.range.second - params.range.first;
+  const double toIndex = span != 0. ? (res - 1) / span : 0.;
+  const double maxIndex = res - 1;
+
+  // Isolines darken every second band of width isolineWidth, as mod(value, 2 * width) > width does in the shader
+  const bool isolines = params.isolinesEnabled && params.isolineWidth > 0.;
+  const double invPeriod = isolines ? 1. / (2. * params.isolineWidth) : 0.;
+
+  parallelForChunks(n, colorMapChunkSize, [&](size_t, size_t chunkStart, size_t chunkEnd) {
+    uint32_t inds[colorMapBlockSize];
+    for (size_t blockStart = chunkStart; blockStart < chunkEnd; blockStart += colorMapBlockSize) {
+      size_t blockCount = std::min(colorMapBlockSize, chunkEnd - blockStart);
+      const double* blockValues = values + blockStart;
+
+      // Table indices, without branches so that the loop vectorizes
+      for (size_t j = 0; j < blockCount; j++) {
+        double v = blockValues[j];
+        bool finite = std::abs(v) <= std::numeric_limits<double>::max(); // false for nan and inf
+        double x = finite ? v : low;
+        double s = (x - low) * toIndex;
+        s = s < 0. ? 0. : s;
+        s = s > maxIndex ? maxIndex : s;
+        uint32_t ind = finite ? static_cast<uint32_t>(s + 0.5) : blackInd;
+        double p = x * invPeriod;
+        bool stripe = (p - std::floor(p)) > 0.5;
+        inds[j] = ind + (stripe ? darkOffset : 0);
+      }
+
+      // Gather the colors
+      C* blockOut = out + blockStart;
+      for (size_t j = 0; j < blockCount; j++) {
+        blockOut[j] = outTable[inds[j]];
+      }
+    }
+  });
+}
+
+void ColorMapLUT::mapValues(const double* values, size_t n, const ColorMapParams& params, glm::vec3* out) const {
+  mapValuesImpl(values, n, params, out);
+}
+
+void ColorMapLUT::mapValues(const double* values, size_t n, const ColorMapParams& params, glm::u8vec3* out) const {
+  mapValuesImpl(values, n, params, out);
+}
+
+std::vector<glm::vec3> ColorMapLUT::mapValues(const std::vector<double>& values, const ColorMapParams& params) const {
+  std::vector<glm::vec3> out(values.size());
+  mapValues(values.data(), values.size(), params, out.data());
+  return out;
+}
+
+std::vector<glm::u8vec3> ColorMapLUT::mapValuesRGB8(const std::vector<double>& values,
+                                                    const ColorMapParams& params) const {
+  std::vector<glm::u8vec3> out(values.size());
+  mapValues(values.data(), values.size(), params, out.data());
+  return out;
+}
+
+std::vector<glm::vec3> applyColorMap(const ValueColorMap& cmap, const std::vector<double>& values,
+                                     const ColorMapParams& params) {
+  return ColorMapLUT(cmap).mapValues(values, params);
+}
+
+std::vector<glm::u8vec3> applyColorMapRGB8(const ValueColorMap& cmap, const std::vector<double>& values,
+                                           const ColorMapParams& params) {
+  return ColorMapLUT(cmap).mapValuesRGB8(values, params);
+}
+
+} // namespace render
+} // namespace polyscope
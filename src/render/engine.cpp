@@ -55,6 +55,12 @@ std::string renderDataTypeName(const RenderDataType& r) {
     return "Vector3UInt";
   case RenderDataType::Vector4UInt:
     return "Vector4UInt";
+  case RenderDataType::Vector3UShortNorm:
+    return "Vector3UShortNorm";
+  case RenderDataType::Vector4UByteNorm:
+    return "Vector4UByteNorm";
+  case RenderDataType::Vector2ShortNorm:
+    return "Vector2ShortNorm";
   }
   return "";
 }
@@ -71,11 +77,19 @@ int renderDataTypeCountCompatbility(const RenderDataType r1, const RenderDataTyp
   if (r1 == RenderDataType::Vector3UInt && r2 == RenderDataType::UInt) return 3;
   if (r1 == RenderDataType::Vector4UInt && r2 == RenderDataType::UInt) return 4;
 
+  // compact formats feed vec3 attributes; missing components are filled in and extra ones dropped
+  if (r1 == RenderDataType::Vector3Float && isNormalizedRenderDataType(r2)) return 1;
+
   // there are other combinations of types which could be compatible, we don't handle them yet
   //
   return 0;
 }
 
+bool isNormalizedRenderDataType(const RenderDataType r) {
+  return r == RenderDataType::Vector3UShortNorm || r == RenderDataType::Vector4UByteNorm ||
+         r == RenderDataType::Vector2ShortNorm;
+}
+
 std::string modeName(const TransparencyMode& m) {
   switch (m) {
   case TransparencyMode::None:
@@ -157,6 +171,15 @@ void FrameBuffer::setViewport(int startX, int startY, unsigned int sizeX, unsign
 }
 
 void FrameBuffer::resize(unsigned int newXSize, unsigned int newYSize) {
+  // Nothing to reallocate if every attachment already has this size
+  auto hasNewSize = [&](unsigned int x, unsigned int y) { return x == newXSize && y == newYSize; };
+  bool sameSize = hasNewSize(sizeX, sizeY);
+  for (auto& b : renderBuffersColor) sameSize = sameSize && hasNewSize(b->getSizeX(), b->getSizeY());
+  for (auto& b : renderBuffersDepth) sameSize = sameSize && hasNewSize(b->getSizeX(), b->getSizeY());
+  for (auto& b : textureBuffersColor) sameSize = sameSize && hasNewSize(b->getSizeX(), b->getSizeY());
+  for (auto& b : textureBuffersDepth) sameSize = sameSize && hasNewSize(b->getSizeX(), b->getSizeY());
+  if (sameSize) return;
+
   bind();
   for (auto& b : renderBuffersColor) {
     b->resize(newXSize, newYSize);
@@ -198,16 +221,26 @@ ShaderReplacementRule::ShaderReplacementRule(std::string ruleName_,
 ShaderProgram::ShaderProgram(DrawMode dm) : drawMode(dm), uniqueID(render::engine->getNextUniqueID()) {
 
   drawMode = dm;
-  if (dm == DrawMode::IndexedLines || dm == DrawMode::IndexedLineStrip || dm == DrawMode::IndexedLineStripAdjacency ||
-      dm == DrawMode::IndexedTriangles) {
+  if (dm == DrawMode::IndexedPoints || dm == DrawMode::IndexedLines || dm == DrawMode::IndexedLineStrip ||
+      dm == DrawMode::IndexedLineStripAdjacency || dm == DrawMode::IndexedTriangles) {
     useIndex = true;
   }
 
-  if (dm == DrawMode::IndexedLineStripAdjacency) {
+  if (dm == DrawMode::IndexedLineStrip || dm == DrawMode::IndexedLineStripAdjacency) {
     usePrimitiveRestart = true;
   }
 }
 
+void ShaderProgram::setDrawRanges(const std::vector<std::pair<size_t, size_t>>& ranges) {
+  useDrawRanges = true;
+  drawRanges = ranges;
+}
+
+void ShaderProgram::clearDrawRanges() {
+  useDrawRanges = false;
+  drawRanges.clear();
+}
+
 void Engine::buildEngineGui() {
 
   ImGui::SetNextTreeNodeOpen(false, ImGuiCond_FirstUseEver);
@@ -393,6 +426,17 @@ void Engine::resizeScreenBuffers() {
   sceneDepthMinFrame->resize(ssaaFactor * width, ssaaFactor * height);
 }
 
+void Engine::ensureScreenBufferSizes() {
+  unsigned int width = view::bufferWidth;
+  unsigned int height = view::bufferHeight;
+  if (displayBufferAlt->getSizeX() == width && displayBufferAlt->getSizeY() == height &&
+      sceneBuffer->getSizeX() == ssaaFactor * width && sceneBuffer->getSizeY() == ssaaFactor * height) {
+    return;
+  }
+  resizeScreenBuffers();
+  setScreenBufferViewports();
+}
+
 void Engine::setScreenBufferViewports() {
   unsigned int xStart = 0;
   unsigned int yStart = 0;
@@ -1,6 +1,8 @@
 // Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
 
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 #include "polyscope/render/managed_buffer.h"
@@ -61,10 +63,66 @@ std::vector<T>& ManagedBuffer<T>::getPopulatedHostBufferRef() {
 template <typename T>
 void ManagedBuffer<T>::markHostBufferUpdated() {
   hostBufferIsPopulated = true;
+  dataVersion++;
+
+  updateQuantizationBounds();
 
   // If the data is stored in the device-side buffers, update it as needed
   if (renderAttributeBuffer) {
-    renderAttributeBuffer->setData(data);
+    setRenderBufferData(*renderAttributeBuffer, data);
+    requestRedraw();
+  }
+
+  // Indexed views (e.g. mesh vertex values expanded to corners) are drawn from directly, and must follow too
+  if (!existingIndexedViews.empty()) {
+    updateIndexedViews();
+    requestRedraw();
+  }
+}
+
+template <typename T>
+void ManagedBuffer<T>::markHostBufferRangeUpdated(size_t start, size_t count) {
+  hostBufferIsPopulated = true;
+  dataVersion++;
+
+  if (deviceQuantization != BufferQuantization::None) {
+    // The bounds only ever grow here, like other conservative bounds. If they do, everything stored relative to them
+    // must be encoded again.
+    bool boundsChanged = false;
+    if (deviceQuantization == BufferQuantization::UNorm16InBounds) {
+      QuantizationBounds newBounds = expandQuantizationBounds(quantizationBounds, data, start, count);
+      boundsChanged = newBounds != quantizationBounds;
+      quantizationBounds = newBounds;
+    }
+
+    if (renderAttributeBuffer) {
+      if (boundsChanged) {
+        start = 0;
+        count = data.size();
+      }
+      setQuantizedAttributeBufferDataRange(*renderAttributeBuffer, deviceQuantization, data, quantizationBounds, start,
+                                           count);
+      requestRedraw();
+    }
+    if (!existingIndexedViews.empty()) {
+      if (boundsChanged) {
+        updateIndexedViews();
+      } else {
+        updateIndexedViewsRange(start, count);
+      }
+      requestRedraw();
+    }
+    return;
+  }
+
+  if (renderAttributeBuffer) {
+    setAttributeBufferDataRange<T>(*renderAttributeBuffer, data, start, count);
+    requestRedraw();
+  }
+
+  // Indexed views must follow, as in markHostBufferUpdated()
+  if (!existingIndexedViews.empty()) {
+    updateIndexedViewsRange(start, count);
     requestRedraw();
   }
 }
@@ -117,6 +175,11 @@ size_t ManagedBuffer<T>::size() {
   return INVALID_IND;
 }
 
+template <typename T>
+uint64_t ManagedBuffer<T>::getDataVersion() const {
+  return dataVersion;
+}
+
 template <typename T>
 bool ManagedBuffer<T>::hasData() {
   if (hostBufferIsPopulated || renderAttributeBuffer) {
@@ -145,15 +208,20 @@ template <typename T>
 std::shared_ptr<render::AttributeBuffer> ManagedBuffer<T>::getRenderAttributeBuffer() {
   if (!renderAttributeBuffer) {
     ensureHostBufferPopulated(); // warning: the order of these matters because of how hostBufferPopulated works
-    renderAttributeBuffer = generateAttributeBuffer<T>(render::engine);
-    renderAttributeBuffer->setData(data);
+    if (existingIndexedViews.empty()) updateQuantizationBounds();
+    renderAttributeBuffer = generateRenderBuffer();
+    setRenderBufferData(*renderAttributeBuffer, data);
   }
   return renderAttributeBuffer;
 }
 
 template <typename T>
 void ManagedBuffer<T>::markRenderAttributeBufferUpdated() {
+  if (deviceQuantization != BufferQuantization::None) {
+    exception("ManagedBuffer " + name + " has quantized render data, which cannot be written on the device");
+  }
   invalidateHostBuffer();
+  dataVersion++;
   updateIndexedViews();
   requestRedraw();
 }
@@ -181,10 +249,11 @@ ManagedBuffer<T>::getIndexedRenderAttributeBuffer(ManagedBuffer<uint32_t>& indic
 
   // We don't have it. Create a new one and return that.
   ensureHostBufferPopulated();
-  std::shared_ptr<render::AttributeBuffer> newBuffer = generateAttributeBuffer<T>(render::engine);
+  if (!renderAttributeBuffer && existingIndexedViews.empty()) updateQuantizationBounds();
+  std::shared_ptr<render::AttributeBuffer> newBuffer = generateRenderBuffer();
   indices.ensureHostBufferPopulated();
   std::vector<T> expandData = gather(data, indices.data);
-  newBuffer->setData(expandData); // initially populate
+  setRenderBufferData(*newBuffer, expandData); // initially populate
   existingIndexedViews.emplace_back(&indices, newBuffer);
 
   return newBuffer;
@@ -208,13 +277,122 @@ void ManagedBuffer<T>::updateIndexedViews() {
     // apply the indexing and set the data
     indices.ensureHostBufferPopulated();
     std::vector<T> expandData = gather(data, indices.data);
-    viewBuffer.setData(expandData);
+    setRenderBufferData(viewBuffer, expandData);
 
     // TODO fornow, only CPU-side updating is supported. Add direct GPU-side support using the bufferIndexCopyProgram
     // below.
   }
 }
 
+template <typename T>
+void ManagedBuffer<T>::updateIndexedViewsRange(size_t start, size_t count) {
+  removeDeletedIndexedViews(); // periodic filtering
+
+  for (std::tuple<render::ManagedBuffer<uint32_t>*, std::weak_ptr<render::AttributeBuffer>>& existingViewTup :
+       existingIndexedViews) {
+
+    std::shared_ptr<render::AttributeBuffer> viewBufferPtr = std::get<1>(existingViewTup).lock();
+    if (!viewBufferPtr) continue; // skip if it has been deleted (will be removed eventually)
+
+    render::ManagedBuffer<uint32_t>& indices = *std::get<0>(existingViewTup);
+    render::AttributeBuffer& viewBuffer = *viewBufferPtr;
+    indices.ensureHostBufferPopulated();
+    const std::vector<uint32_t>& inds = indices.data;
+
+    if (inds.empty() || viewBuffer.setDataRangeReallocates(inds.size())) {
+      setRenderBufferData(viewBuffer, gather(data, inds));
+      continue;
+    }
+
+    // Only the span of view entries which read from the updated range is gathered and uploaded
+    size_t viewStart = inds.size();
+    size_t viewEnd = 0;
+    for (size_t i = 0; i < inds.size(); i++) {
+      if (inds[i] >= start && inds[i] - start < count) {
+        viewStart = std::min(viewStart, i);
+        viewEnd = i + 1;
+      }
+    }
+    if (viewStart >= viewEnd) continue;
+
+    std::vector<T> expandData(inds.size());
+    for (size_t i = viewStart; i < viewEnd; i++) {
+      expandData[i] = data[inds[i]];
+    }
+    if (deviceQuantization == BufferQuantization::None) {
+      setAttributeBufferDataRange<T>(viewBuffer, expandData, viewStart, viewEnd - viewStart);
+    } else {
+      setQuantizedAttributeBufferDataRange(viewBuffer, deviceQuantization, expandData, quantizationBounds, viewStart,
+                                           viewEnd - viewStart);
+    }
+  }
+}
+
+template <typename T>
+void ManagedBuffer<T>::setDeviceQuantization(BufferQuantization newQuantization) {
+  if (newQuantization == deviceQuantization) return;
+  if (!std::is_same<T, glm::vec3>::value) {
+    exception("ManagedBuffer " + name + " cannot be quantized, only vec3 buffers can");
+  }
+  if (renderAttributeBuffer || !existingIndexedViews.empty()) {
+    exception("ManagedBuffer " + name + " quantization must be set before its render buffers are created");
+  }
+
+  deviceQuantization = newQuantization;
+}
+
+template <typename T>
+BufferQuantization ManagedBuffer<T>::getDeviceQuantization() const {
+  return deviceQuantization;
+}
+
+template <typename T>
+std::vector<std::string> ManagedBuffer<T>::addDequantizeRules(std::vector<std::string> rules) {
+  switch (deviceQuantization) {
+  case BufferQuantization::None:
+  case BufferQuantization::UNorm8: // read as floats in [0,1] by the vertex fetch, nothing to do
+    break;
+  case BufferQuantization::UNorm16InBounds:
+    rules.push_back("DEQUANTIZE_POSITION");
+    break;
+  case BufferQuantization::Octahedral16:
+    rules.push_back("DECODE_OCTAHEDRAL_NORMAL");
+    break;
+  }
+  return rules;
+}
+
+template <typename T>
+void ManagedBuffer<T>::setDequantizeUniforms(render::ShaderProgram& p) {
+  if (deviceQuantization != BufferQuantization::UNorm16InBounds) return;
+  p.setUniform("u_positionDequantizeOffset", quantizationBounds.dequantizeOffset());
+  p.setUniform("u_positionDequantizeScale", quantizationBounds.dequantizeScale());
+}
+
+template <typename T>
+void ManagedBuffer<T>::updateQuantizationBounds() {
+  // (call only when all of the render data is about to be encoded again, since it is stored relative to the bounds)
+  if (deviceQuantization != BufferQuantization::UNorm16InBounds) return;
+  quantizationBounds = expandQuantizationBounds(QuantizationBounds(), data, 0, data.size());
+}
+
+template <typename T>
+std::shared_ptr<render::AttributeBuffer> ManagedBuffer<T>::generateRenderBuffer() {
+  if (deviceQuantization == BufferQuantization::None) {
+    return generateAttributeBuffer<T>(render::engine);
+  }
+  return render::engine->generateAttributeBuffer(quantizedRenderDataType(deviceQuantization));
+}
+
+template <typename T>
+void ManagedBuffer<T>::setRenderBufferData(render::AttributeBuffer& buff, const std::vector<T>& vals) {
+  if (deviceQuantization == BufferQuantization::None) {
+    buff.setData(vals);
+  } else {
+    setQuantizedAttributeBufferData(buff, deviceQuantization, vals, quantizationBounds);
+  }
+}
+
 template <typename T>
 void ManagedBuffer<T>::removeDeletedIndexedViews() {
   // "erase-remove idiom"
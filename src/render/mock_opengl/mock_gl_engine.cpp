@@ -17,6 +17,7 @@
 #include "polyscope/render/opengl/shaders/ground_plane_shaders.h"
 #include "polyscope/render/opengl/shaders/histogram_shaders.h"
 #include "polyscope/render/opengl/shaders/lighting_shaders.h"
+#include "polyscope/render/opengl/shaders/polyline_shaders.h"
 #include "polyscope/render/opengl/shaders/ribbon_shaders.h"
 #include "polyscope/render/opengl/shaders/rules.h"
 #include "polyscope/render/opengl/shaders/sphere_shaders.h"
@@ -273,6 +274,131 @@ void GLAttributeBuffer::setData(const std::vector<glm::uvec4>& data) {
   }
 }
 
+void GLAttributeBuffer::setData(const std::vector<glm::u16vec3>& data) {
+  checkType(RenderDataType::Vector3UShortNorm);
+
+  bind();
+
+  if (isSet()) {
+    if (static_cast<int64_t>(data.size()) != dataSize) exception("updated data must have same size");
+  } else {
+    dataSize = data.size();
+  }
+}
+
+void GLAttributeBuffer::setData(const std::vector<glm::u8vec4>& data) {
+  checkType(RenderDataType::Vector4UByteNorm);
+
+  bind();
+
+  if (isSet()) {
+    if (static_cast<int64_t>(data.size()) != dataSize) exception("updated data must have same size");
+  } else {
+    dataSize = data.size();
+  }
+}
+
+void GLAttributeBuffer::setData(const std::vector<glm::i16vec2>& data) {
+  checkType(RenderDataType::Vector2ShortNorm);
+
+  bind();
+
+  if (isSet()) {
+    if (static_cast<int64_t>(data.size()) != dataSize) exception("updated data must have same size");
+  } else {
+    dataSize = data.size();
+  }
+}
+
+
+// == Partial updates
+
+template <typename T>
+void GLAttributeBuffer::setDataRangeHelper(const std::vector<T>& data, size_t start, size_t count) {
+  if (start + count > data.size()) exception("setDataRange() range is out of bounds");
+  bind();
+  dataSize = data.size();
+}
+
+void GLAttributeBuffer::setDataRange(const std::vector<glm::vec2>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector2Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::vec3>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector3Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::vec4>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector4Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<float>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<double>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<int32_t>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Int);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<uint32_t>& data, size_t start, size_t count) {
+  checkType(RenderDataType::UInt);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::uvec2>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector2UInt);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::uvec3>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector3UInt);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::uvec4>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector4UInt);
+  setDataRangeHelper(data, start, count);
+}
+
+void GLAttributeBuffer::setDataRange(const std::vector<glm::u16vec3>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector3UShortNorm);
+  setDataRangeHelper(data, start, count);
+}
+
+void GLAttributeBuffer::setDataRange(const std::vector<glm::u8vec4>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector4UByteNorm);
+  setDataRangeHelper(data, start, count);
+}
+
+void GLAttributeBuffer::setDataRange(const std::vector<glm::i16vec2>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector2ShortNorm);
+  setDataRangeHelper(data, start, count);
+}
+
+bool GLAttributeBuffer::setDataRangeReallocates(size_t newSize) {
+  return !isSet() || static_cast<int64_t>(newSize) > dataSize;
+}
+
+void GLAttributeBuffer::setDataSubrange(const std::vector<glm::u16vec3>& rangeData, size_t start, size_t newSize) {
+  checkType(RenderDataType::Vector3UShortNorm);
+  setDataSubrangeHelper(rangeData.size(), start, newSize);
+}
+void GLAttributeBuffer::setDataSubrange(const std::vector<glm::u8vec4>& rangeData, size_t start, size_t newSize) {
+  checkType(RenderDataType::Vector4UByteNorm);
+  setDataSubrangeHelper(rangeData.size(), start, newSize);
+}
+void GLAttributeBuffer::setDataSubrange(const std::vector<glm::i16vec2>& rangeData, size_t start, size_t newSize) {
+  checkType(RenderDataType::Vector2ShortNorm);
+  setDataSubrangeHelper(rangeData.size(), start, newSize);
+}
+
+void GLAttributeBuffer::setDataSubrangeHelper(size_t count, size_t start, size_t newSize) {
+  if (setDataRangeReallocates(newSize) || start + count > newSize) exception("bad data range write");
+  bind();
+  dataSize = newSize;
+}
+
 // get single data values
 
 float GLAttributeBuffer::getData_float(size_t ind) {
@@ -543,6 +669,27 @@ std::vector<glm::vec3> GLTextureBuffer::getDataVector3() {
 
   return outData;
 }
+void GLTextureBuffer::setData(const std::vector<float>& data) { setDataFloat(data.data(), data.size(), 1); }
+
+void GLTextureBuffer::setData(const std::vector<glm::vec2>& data) {
+  setDataFloat(reinterpret_cast<const float*>(data.data()), data.size(), 2);
+}
+
+void GLTextureBuffer::setData(const std::vector<glm::vec3>& data) {
+  setDataFloat(reinterpret_cast<const float*>(data.data()), data.size(), 3);
+}
+
+void GLTextureBuffer::setDataFloat(const float* data, size_t nEntries, int nComponents) {
+  if (dimension(format) != nComponents) {
+    exception("called setData on texture with data which does not match the dimension of its format");
+  }
+  if (nEntries != getTotalSize()) {
+    exception("called setData on texture with " + std::to_string(nEntries) + " entries, but it has " +
+              std::to_string(getTotalSize()) + " texels");
+  }
+  bind();
+}
+
 void GLTextureBuffer::bind() {
   if (dim == 1) {
   }
@@ -688,16 +835,44 @@ float GLFrameBuffer::readDepth(int xPos, int yPos) {
 }
 
 std::vector<unsigned char> GLFrameBuffer::readBuffer() {
+  std::vector<unsigned char> buff;
+  readBuffer(buff);
+  return buff;
+}
+
+void GLFrameBuffer::readBuffer(std::vector<unsigned char>& buff) {
   bind();
 
   int w = getSizeX();
   int h = getSizeY();
 
   // Read from openGL
-  size_t buffSize = w * h * 4;
-  std::vector<unsigned char> buff(buffSize);
+  size_t buffSize = static_cast<size_t>(w) * h * 4;
+  buff.resize(buffSize);
+}
 
-  return buff;
+void GLFrameBuffer::readFloat4Buffer(std::vector<float>& buff) {
+  bind();
+
+  int w = getSizeX();
+  int h = getSizeY();
+
+  size_t buffSize = static_cast<size_t>(w) * h * 4;
+  buff.resize(buffSize);
+}
+
+void GLFrameBuffer::readDepthBuffer(std::vector<float>& buff) {
+  if (renderBuffersDepth.empty() && textureBuffersDepth.empty()) {
+    exception("tried to read depth from a framebuffer with no depth buffer attached");
+  }
+
+  bind();
+
+  int w = getSizeX();
+  int h = getSizeY();
+
+  size_t buffSize = static_cast<size_t>(w) * h;
+  buff.assign(buffSize, 1.);
 }
 
 void GLFrameBuffer::blitTo(FrameBuffer* targetIn) {
@@ -867,10 +1042,13 @@ void GLShaderProgram::assignBufferToVAO(GLShaderAttribute& a) {
   a.buff->bind();
   checkGLError();
 
+  // Compact buffers feed float attributes through normalized integer formats, so their layout comes from the buffer
+  RenderDataType layoutType = isNormalizedRenderDataType(a.buff->getType()) ? a.buff->getType() : a.type;
+
   // Choose the correct type for the buffer
   for (int iArrInd = 0; iArrInd < a.arrayCount; iArrInd++) {
 
-    switch (a.type) {
+    switch (layoutType) {
     case RenderDataType::Float:
       break;
     case RenderDataType::Int:
@@ -889,6 +1067,12 @@ void GLShaderProgram::assignBufferToVAO(GLShaderAttribute& a) {
       break;
     case RenderDataType::Vector4UInt:
       break;
+    case RenderDataType::Vector3UShortNorm:
+      break;
+    case RenderDataType::Vector4UByteNorm:
+      break;
+    case RenderDataType::Vector2ShortNorm:
+      break;
     default:
       throw std::invalid_argument("Unrecognized GLShaderAttribute type");
       break;
@@ -1539,11 +1723,22 @@ void GLShaderProgram::draw() {
   if (usePrimitiveRestart) {
   }
 
+  if (useDrawRanges) {
+    for (const std::pair<size_t, size_t>& range : drawRanges) {
+      if (range.first + range.second > drawDataLength) {
+        exception("draw range [" + std::to_string(range.first) + ", " + std::to_string(range.first + range.second) +
+                  ") exceeds the " + std::to_string(drawDataLength) + " entries of data");
+      }
+    }
+  }
+
   activateTextures();
 
   switch (drawMode) {
   case DrawMode::Points:
     break;
+  case DrawMode::IndexedPoints:
+    break;
   case DrawMode::Triangles:
     break;
   case DrawMode::Lines:
@@ -1878,7 +2073,10 @@ void MockGLEngine::populateDefaultShadersAndRules() {
   registerShaderProgram("POINT_QUAD", {FLEX_POINTQUAD_VERT_SHADER, FLEX_POINTQUAD_GEOM_SHADER, FLEX_POINTQUAD_FRAG_SHADER}, DrawMode::Points);
   registerShaderProgram("RAYCAST_VECTOR", {FLEX_VECTOR_VERT_SHADER, FLEX_VECTOR_GEOM_SHADER, FLEX_VECTOR_FRAG_SHADER}, DrawMode::Points);
   registerShaderProgram("RAYCAST_TANGENT_VECTOR", {FLEX_TANGENT_VECTOR_VERT_SHADER, FLEX_VECTOR_GEOM_SHADER, FLEX_VECTOR_FRAG_SHADER}, DrawMode::Points);
+  registerShaderProgram("RAYCAST_VECTOR_INDEXED", {FLEX_VECTOR_VERT_SHADER, FLEX_VECTOR_GEOM_SHADER, FLEX_VECTOR_FRAG_SHADER}, DrawMode::IndexedPoints);
+  registerShaderProgram("RAYCAST_TANGENT_VECTOR_INDEXED", {FLEX_TANGENT_VECTOR_VERT_SHADER, FLEX_VECTOR_GEOM_SHADER, FLEX_VECTOR_FRAG_SHADER}, DrawMode::IndexedPoints);
   registerShaderProgram("RAYCAST_CYLINDER", {FLEX_CYLINDER_VERT_SHADER, FLEX_CYLINDER_GEOM_SHADER, FLEX_CYLINDER_FRAG_SHADER}, DrawMode::Points);
+  registerShaderProgram("POLYLINE", {FLEX_POLYLINE_VERT_SHADER, FLEX_POLYLINE_GEOM_SHADER, FLEX_POLYLINE_FRAG_SHADER}, DrawMode::IndexedLineStrip);
   registerShaderProgram("HISTOGRAM", {HISTOGRAM_VERT_SHADER, HISTOGRAM_FRAG_SHADER}, DrawMode::Triangles);
   registerShaderProgram("GROUND_PLANE_TILE", {GROUND_PLANE_VERT_SHADER, GROUND_PLANE_TILE_FRAG_SHADER}, DrawMode::Triangles);
   registerShaderProgram("GROUND_PLANE_TILE_REFLECT", {GROUND_PLANE_VERT_SHADER, GROUND_PLANE_TILE_REFLECT_FRAG_SHADER}, DrawMode::Triangles);
@@ -1916,6 +2114,8 @@ void MockGLEngine::populateDefaultShadersAndRules() {
   
   registerShaderRule("GENERATE_VIEW_POS", GENERATE_VIEW_POS);
   registerShaderRule("CULL_POS_FROM_VIEW", CULL_POS_FROM_VIEW);
+  registerShaderRule("DEQUANTIZE_POSITION", DEQUANTIZE_POSITION);
+  registerShaderRule("DECODE_OCTAHEDRAL_NORMAL", DECODE_OCTAHEDRAL_NORMAL);
 
   // Lighting and shading things
   registerShaderRule("LIGHT_MATCAP", LIGHT_MATCAP);
@@ -1965,6 +2165,8 @@ void MockGLEngine::populateDefaultShadersAndRules() {
   // vector things
   registerShaderRule("VECTOR_PROPAGATE_COLOR", VECTOR_PROPAGATE_COLOR);
   registerShaderRule("VECTOR_CULLPOS_FROM_TAIL", VECTOR_CULLPOS_FROM_TAIL);
+  registerShaderRule("VECTOR_CULL_MAGNITUDE", VECTOR_CULL_MAGNITUDE);
+  registerShaderRule("TANGENT_VECTOR_CULL_MAGNITUDE", TANGENT_VECTOR_CULL_MAGNITUDE);
   registerShaderRule("TRANSFORMATION_GIZMO_VEC", TRANSFORMATION_GIZMO_VEC);
 
   // cylinder things
@@ -1976,6 +2178,12 @@ void MockGLEngine::populateDefaultShadersAndRules() {
   registerShaderRule("CYLINDER_CULLPOS_FROM_MID", CYLINDER_CULLPOS_FROM_MID);
   registerShaderRule("CYLINDER_VARIABLE_SIZE", CYLINDER_VARIABLE_SIZE);
 
+  // polyline things
+  registerShaderRule("POLYLINE_PROPAGATE_VALUE", POLYLINE_PROPAGATE_VALUE);
+  registerShaderRule("POLYLINE_PROPAGATE_COLOR", POLYLINE_PROPAGATE_COLOR);
+  registerShaderRule("POLYLINE_PROPAGATE_PICK", POLYLINE_PROPAGATE_PICK);
+  registerShaderRule("POLYLINE_CULLPOS_FROM_MID", POLYLINE_CULLPOS_FROM_MID);
+
   // marching tets things
   registerShaderRule("SLICE_TETS_BASECOLOR_SHADE", SLICE_TETS_BASECOLOR_SHADE);
   registerShaderRule("SLICE_TETS_PROPAGATE_VALUE", SLICE_TETS_PROPAGATE_VALUE);
@@ -20,6 +20,7 @@
 #include "polyscope/render/opengl/shaders/ground_plane_shaders.h"
 #include "polyscope/render/opengl/shaders/histogram_shaders.h"
 #include "polyscope/render/opengl/shaders/lighting_shaders.h"
+#include "polyscope/render/opengl/shaders/polyline_shaders.h"
 #include "polyscope/render/opengl/shaders/ribbon_shaders.h"
 #include "polyscope/render/opengl/shaders/rules.h"
 #include "polyscope/render/opengl/shaders/sphere_shaders.h"
@@ -30,6 +31,7 @@
 
 #include "stb_image.h"
 
+#include <limits>
 #include <set>
 
 namespace polyscope {
@@ -502,6 +504,178 @@ void GLAttributeBuffer::setData(const std::vector<glm::uvec4>& data) {
   }
 }
 
+void GLAttributeBuffer::setData(const std::vector<glm::u16vec3>& data) {
+  checkType(RenderDataType::Vector3UShortNorm);
+
+  // sanity check that the data array has the expected layout for the memcopy below
+  static_assert(sizeof(glm::u16vec3) == 3 * sizeof(GLushort), "glm::u16vec3 has unexpected size/layout on this platform");
+
+  bind();
+
+  if (isSet()) {
+    if (static_cast<int64_t>(data.size()) != dataSize) exception("updated data must have same size");
+    glBufferSubData(getTarget(), 0, 3 * dataSize * sizeof(GLushort), &data[0]);
+  } else {
+    glBufferData(getTarget(), 3 * data.size() * sizeof(GLushort), &data[0], GL_STATIC_DRAW);
+    dataSize = data.size();
+  }
+}
+
+void GLAttributeBuffer::setData(const std::vector<glm::u8vec4>& data) {
+  checkType(RenderDataType::Vector4UByteNorm);
+
+  // sanity check that the data array has the expected layout for the memcopy below
+  static_assert(sizeof(glm::u8vec4) == 4 * sizeof(GLubyte), "glm::u8vec4 has unexpected size/layout on this platform");
+
+  bind();
+
+  if (isSet()) {
+    if (static_cast<int64_t>(data.size()) != dataSize) exception("updated data must have same size");
+    glBufferSubData(getTarget(), 0, 4 * dataSize * sizeof(GLubyte), &data[0]);
+  } else {
+    glBufferData(getTarget(), 4 * data.size() * sizeof(GLubyte), &data[0], GL_STATIC_DRAW);
+    dataSize = data.size();
+  }
+}
+
+void GLAttributeBuffer::setData(const std::vector<glm::i16vec2>& data) {
+  checkType(RenderDataType::Vector2ShortNorm);
+
+  // sanity check that the data array has the expected layout for the memcopy below
+  static_assert(sizeof(glm::i16vec2) == 2 * sizeof(GLshort), "glm::i16vec2 has unexpected size/layout on this platform");
+
+  bind();
+
+  if (isSet()) {
+    if (static_cast<int64_t>(data.size()) != dataSize) exception("updated data must have same size");
+    glBufferSubData(getTarget(), 0, 2 * dataSize * sizeof(GLshort), &data[0]);
+  } else {
+    glBufferData(getTarget(), 2 * data.size() * sizeof(GLshort), &data[0], GL_STATIC_DRAW);
+    dataSize = data.size();
+  }
+}
+
+
+// == Partial updates
+
+bool GLAttributeBuffer::setDataRangeReallocates(size_t newSize) {
+  return !isSet() || static_cast<int64_t>(newSize) > std::max(dataCapacity, dataSize);
+}
+
+template <typename T>
+void GLAttributeBuffer::setDataRangeHelper(const std::vector<T>& data, size_t start, size_t count) {
+  if (start + count > data.size()) exception("setDataRange() range is out of bounds");
+
+  if (setDataRangeReallocates(data.size())) {
+    // (re)allocate with room to grow, and upload everything
+    bind();
+    int64_t capacity = std::max(dataCapacity, dataSize);
+    dataCapacity = std::max(static_cast<int64_t>(data.size()), 2 * capacity);
+    glBufferData(getTarget(), dataCapacity * sizeof(T), nullptr, GL_DYNAMIC_DRAW);
+    if (!data.empty()) {
+      glBufferSubData(getTarget(), 0, data.size() * sizeof(T), &data[0]);
+    }
+    dataSize = data.size();
+  } else {
+    writeDataRange(count > 0 ? &data[start] : nullptr, start, count, data.size());
+  }
+}
+
+template <typename T>
+void GLAttributeBuffer::writeDataRange(const T* rangeData, size_t start, size_t count, size_t newSize) {
+  if (setDataRangeReallocates(newSize) || start + count > newSize) exception("bad data range write");
+
+  bind();
+  if (count > 0) {
+    glBufferSubData(getTarget(), start * sizeof(T), count * sizeof(T), rangeData);
+  }
+  dataSize = newSize;
+}
+
+void GLAttributeBuffer::setDataRange(const std::vector<glm::vec2>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector2Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::vec3>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector3Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::vec4>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector4Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<float>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Float);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<double>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Float);
+  if (start + count > data.size()) exception("setDataRange() range is out of bounds");
+
+  // Convert input data to floats; only the updated range, unless the whole array gets uploaded
+  if (setDataRangeReallocates(data.size())) {
+    std::vector<float> floatData(data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+      floatData[i] = static_cast<float>(data[i]);
+    }
+    setDataRangeHelper(floatData, start, count);
+  } else {
+    std::vector<float> floatData(count);
+    for (size_t i = 0; i < count; i++) {
+      floatData[i] = static_cast<float>(data[start + i]);
+    }
+    writeDataRange(floatData.data(), start, count, data.size());
+  }
+}
+void GLAttributeBuffer::setDataRange(const std::vector<int32_t>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Int);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<uint32_t>& data, size_t start, size_t count) {
+  checkType(RenderDataType::UInt);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::uvec2>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector2UInt);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::uvec3>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector3UInt);
+  setDataRangeHelper(data, start, count);
+}
+void GLAttributeBuffer::setDataRange(const std::vector<glm::uvec4>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector4UInt);
+  setDataRangeHelper(data, start, count);
+}
+
+void GLAttributeBuffer::setDataRange(const std::vector<glm::u16vec3>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector3UShortNorm);
+  setDataRangeHelper(data, start, count);
+}
+
+void GLAttributeBuffer::setDataRange(const std::vector<glm::u8vec4>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector4UByteNorm);
+  setDataRangeHelper(data, start, count);
+}
+
+void GLAttributeBuffer::setDataRange(const std::vector<glm::i16vec2>& data, size_t start, size_t count) {
+  checkType(RenderDataType::Vector2ShortNorm);
+  setDataRangeHelper(data, start, count);
+}
+
+void GLAttributeBuffer::setDataSubrange(const std::vector<glm::u16vec3>& rangeData, size_t start, size_t newSize) {
+  checkType(RenderDataType::Vector3UShortNorm);
+  writeDataRange(rangeData.data(), start, rangeData.size(), newSize);
+}
+void GLAttributeBuffer::setDataSubrange(const std::vector<glm::u8vec4>& rangeData, size_t start, size_t newSize) {
+  checkType(RenderDataType::Vector4UByteNorm);
+  writeDataRange(rangeData.data(), start, rangeData.size(), newSize);
+}
+void GLAttributeBuffer::setDataSubrange(const std::vector<glm::i16vec2>& rangeData, size_t start, size_t newSize) {
+  checkType(RenderDataType::Vector2ShortNorm);
+  writeDataRange(rangeData.data(), start, rangeData.size(), newSize);
+}
+
 // get single data values
 
 float GLAttributeBuffer::getData_float(size_t ind) {
@@ -818,6 +992,37 @@ std::vector<glm::vec3> GLTextureBuffer::getDataVector3() {
   return outData;
 }
 
+void GLTextureBuffer::setData(const std::vector<float>& data) { setDataFloat(data.data(), data.size(), 1); }
+
+void GLTextureBuffer::setData(const std::vector<glm::vec2>& data) {
+  static_assert(sizeof(glm::vec2) == sizeof(float) * 2, "glm vec padding breaks direct copy");
+  setDataFloat(reinterpret_cast<const float*>(data.data()), data.size(), 2);
+}
+
+void GLTextureBuffer::setData(const std::vector<glm::vec3>& data) {
+  static_assert(sizeof(glm::vec3) == sizeof(float) * 3, "glm vec padding breaks direct copy");
+  setDataFloat(reinterpret_cast<const float*>(data.data()), data.size(), 3);
+}
+
+void GLTextureBuffer::setDataFloat(const float* data, size_t nEntries, int nComponents) {
+  if (dimension(format) != nComponents) {
+    exception("called setData on texture with data which does not match the dimension of its format");
+  }
+  if (nEntries != getTotalSize()) {
+    exception("called setData on texture with " + std::to_string(nEntries) + " entries, but it has " +
+              std::to_string(getTotalSize()) + " texels");
+  }
+
+  bind();
+  if (dim == 1) {
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, sizeX, formatF(format), GL_FLOAT, data);
+  }
+  if (dim == 2) {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, sizeX, sizeY, formatF(format), GL_FLOAT, data);
+  }
+  checkGLError();
+}
+
 GLenum GLTextureBuffer::textureType() {
   if (dim == 1) {
     return GL_TEXTURE_1D;
@@ -1047,6 +1252,12 @@ float GLFrameBuffer::readDepth(int xPos, int yPos) {
 }
 
 std::vector<unsigned char> GLFrameBuffer::readBuffer() {
+  std::vector<unsigned char> buff;
+  readBuffer(buff);
+  return buff;
+}
+
+void GLFrameBuffer::readBuffer(std::vector<unsigned char>& buff) {
 
   glFlush();
   glFinish();
@@ -1057,11 +1268,46 @@ std::vector<unsigned char> GLFrameBuffer::readBuffer() {
   int h = getSizeY();
 
   // Read from openGL
-  size_t buffSize = w * h * 4;
-  std::vector<unsigned char> buff(buffSize);
+  size_t buffSize = static_cast<size_t>(w) * h * 4;
+  buff.resize(buffSize);
+  if (buffSize == 0) return;
   glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, &(buff.front()));
+}
 
-  return buff;
+void GLFrameBuffer::readFloat4Buffer(std::vector<float>& buff) {
+
+  glFlush();
+  glFinish();
+
+  bind();
+
+  int w = getSizeX();
+  int h = getSizeY();
+
+  size_t buffSize = static_cast<size_t>(w) * h * 4;
+  buff.resize(buffSize);
+  if (buffSize == 0) return;
+  glReadPixels(0, 0, w, h, GL_RGBA, GL_FLOAT, &(buff.front()));
+}
+
+void GLFrameBuffer::readDepthBuffer(std::vector<float>& buff) {
+
+  if (renderBuffersDepth.empty() && textureBuffersDepth.empty()) {
+    exception("tried to read depth from a framebuffer with no depth buffer attached");
+  }
+
+  glFlush();
+  glFinish();
+
+  bind();
+
+  int w = getSizeX();
+  int h = getSizeY();
+
+  size_t buffSize = static_cast<size_t>(w) * h;
+  buff.resize(buffSize);
+  if (buffSize == 0) return;
+  glReadPixels(0, 0, w, h, GL_DEPTH_COMPONENT, GL_FLOAT, &(buff.front()));
 }
 
 void GLFrameBuffer::blitTo(FrameBuffer* targetIn) {
@@ -1344,12 +1590,15 @@ void GLShaderProgram::assignBufferToVAO(GLShaderAttribute& a) {
   a.buff->bind();
   checkGLError();
 
+  // Compact buffers feed float attributes through normalized integer formats, so their layout comes from the buffer
+  RenderDataType layoutType = isNormalizedRenderDataType(a.buff->getType()) ? a.buff->getType() : a.type;
+
   // Choose the correct type for the buffer
   for (int iArrInd = 0; iArrInd < a.arrayCount; iArrInd++) {
 
     glEnableVertexAttribArray(a.location + iArrInd);
 
-    switch (a.type) {
+    switch (layoutType) {
     case RenderDataType::Float:
       glVertexAttribPointer(a.location + iArrInd, 1, GL_FLOAT, GL_FALSE, sizeof(float) * 1 * a.arrayCount,
                             reinterpret_cast<void*>(sizeof(float) * 1 * iArrInd));
@@ -1386,6 +1635,18 @@ void GLShaderProgram::assignBufferToVAO(GLShaderAttribute& a) {
       glVertexAttribPointer(a.location + iArrInd, 4, GL_UNSIGNED_INT, GL_FALSE, sizeof(uint32_t) * 4 * a.arrayCount,
                             reinterpret_cast<void*>(sizeof(uint32_t) * 4 * iArrInd));
       break;
+    case RenderDataType::Vector3UShortNorm:
+      glVertexAttribPointer(a.location + iArrInd, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(uint16_t) * 3 * a.arrayCount,
+                            reinterpret_cast<void*>(sizeof(uint16_t) * 3 * iArrInd));
+      break;
+    case RenderDataType::Vector4UByteNorm:
+      glVertexAttribPointer(a.location + iArrInd, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(uint8_t) * 4 * a.arrayCount,
+                            reinterpret_cast<void*>(sizeof(uint8_t) * 4 * iArrInd));
+      break;
+    case RenderDataType::Vector2ShortNorm:
+      glVertexAttribPointer(a.location + iArrInd, 2, GL_SHORT, GL_TRUE, sizeof(int16_t) * 2 * a.arrayCount,
+                            reinterpret_cast<void*>(sizeof(int16_t) * 2 * iArrInd));
+      break;
     default:
       throw std::invalid_argument("Unrecognized GLShaderAttribute type");
       break;
@@ -1982,11 +2243,9 @@ void GLShaderProgram::setIndex(std::vector<std::array<unsigned int, 3>>& indices
     rawData[3 * i + 2] = static_cast<unsigned int>(indices[i][2]);
   }
 
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, 3 * indices.size() * sizeof(unsigned int), rawData, GL_STATIC_DRAW);
+  uploadIndexData(rawData, 3 * indices.size());
 
   delete[] rawData;
-  indexSize = 3 * indices.size();
 }
 
 void GLShaderProgram::setIndex(std::vector<glm::uvec3>& indices) {
@@ -1998,10 +2257,7 @@ void GLShaderProgram::setIndex(std::vector<glm::uvec3>& indices) {
   // sanity check that the data array has the expected layout for the memcopy below
   static_assert(sizeof(glm::uvec3) == 3 * sizeof(GLuint), "glm::uvec3 has unexpected size/layout on this platform");
 
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, 3 * indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
-
-  indexSize = 3 * indices.size();
+  uploadIndexData(&indices[0][0], 3 * indices.size());
 }
 
 void GLShaderProgram::setIndex(std::vector<unsigned int>& indices) {
@@ -2024,9 +2280,36 @@ void GLShaderProgram::setIndex(std::vector<unsigned int>& indices) {
     }
   }
 
+  uploadIndexData(&indices[0], indices.size());
+}
+
+void GLShaderProgram::uploadIndexData(const unsigned int* indices, size_t count) {
+
+  // Small meshes use 16-bit indices, which halves the index buffer. The largest 16-bit value is kept free to stand in
+  // for the primitive restart index, so that must be set before the indices are.
+  const GLuint restart16 = std::numeric_limits<GLushort>::max();
+  bool fits16 = true;
+  for (size_t i = 0; i < count; i++) {
+    if (indices[i] >= restart16 && !(primitiveRestartIndexSet && indices[i] == restartIndex)) {
+      fits16 = false;
+      break;
+    }
+  }
+
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
-  indexSize = indices.size();
+  if (fits16) {
+    std::vector<GLushort> indices16(count);
+    for (size_t i = 0; i < count; i++) {
+      bool isRestart = primitiveRestartIndexSet && indices[i] == restartIndex;
+      indices16[i] = isRestart ? restart16 : static_cast<GLushort>(indices[i]);
+    }
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(GLushort), indices16.data(), GL_STATIC_DRAW);
+    indexType = GL_UNSIGNED_SHORT;
+  } else {
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(GLuint), indices, GL_STATIC_DRAW);
+    indexType = GL_UNSIGNED_INT;
+  }
+  indexSize = count;
 }
 
 // Check that uniforms and attributes are all set and of consistent size
@@ -2107,47 +2390,67 @@ void GLShaderProgram::draw() {
 
   if (usePrimitiveRestart) {
     glEnable(GL_PRIMITIVE_RESTART);
-    glPrimitiveRestartIndex(restartIndex);
+    glPrimitiveRestartIndex(indexType == GL_UNSIGNED_SHORT ? std::numeric_limits<GLushort>::max() : restartIndex);
   }
 
   activateTextures();
 
-  switch (drawMode) {
-  case DrawMode::Points:
-    glDrawArrays(GL_POINTS, 0, drawDataLength);
-    break;
-  case DrawMode::Triangles:
-    glDrawArrays(GL_TRIANGLES, 0, drawDataLength);
-    break;
-  case DrawMode::Lines:
-    glDrawArrays(GL_LINES, 0, drawDataLength);
-    break;
-  case DrawMode::TrianglesAdjacency:
-    glDrawArrays(GL_TRIANGLES_ADJACENCY, 0, drawDataLength);
-    break;
-  case DrawMode::LinesAdjacency:
-    glDrawArrays(GL_LINES_ADJACENCY, 0, drawDataLength);
-    break;
-  case DrawMode::IndexedLines:
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-    glDrawElements(GL_LINES, drawDataLength, GL_UNSIGNED_INT, 0);
-    break;
-  case DrawMode::IndexedLineStrip:
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-    glDrawElements(GL_LINE_STRIP, drawDataLength, GL_UNSIGNED_INT, 0);
-    break;
-  case DrawMode::IndexedLinesAdjacency:
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-    glDrawElements(GL_LINES_ADJACENCY, drawDataLength, GL_UNSIGNED_INT, 0);
-    break;
-  case DrawMode::IndexedLineStripAdjacency:
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-    glDrawElements(GL_LINE_STRIP_ADJACENCY, drawDataLength, GL_UNSIGNED_INT, 0);
-    break;
-  case DrawMode::IndexedTriangles:
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-    glDrawElements(GL_TRIANGLES, drawDataLength, GL_UNSIGNED_INT, 0);
-    break;
+  size_t indexBytes = indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+  auto drawRange = [&](GLint start, GLsizei count) {
+    const void* indexOffset = reinterpret_cast<const void*>(start * indexBytes);
+    switch (drawMode) {
+    case DrawMode::Points:
+      glDrawArrays(GL_POINTS, start, count);
+      break;
+    case DrawMode::IndexedPoints:
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
+      glDrawElements(GL_POINTS, count, indexType, indexOffset);
+      break;
+    case DrawMode::Triangles:
+      glDrawArrays(GL_TRIANGLES, start, count);
+      break;
+    case DrawMode::Lines:
+      glDrawArrays(GL_LINES, start, count);
+      break;
+    case DrawMode::TrianglesAdjacency:
+      glDrawArrays(GL_TRIANGLES_ADJACENCY, start, count);
+      break;
+    case DrawMode::LinesAdjacency:
+      glDrawArrays(GL_LINES_ADJACENCY, start, count);
+      break;
+    case DrawMode::IndexedLines:
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
+      glDrawElements(GL_LINES, count, indexType, indexOffset);
+      break;
+    case DrawMode::IndexedLineStrip:
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
+      glDrawElements(GL_LINE_STRIP, count, indexType, indexOffset);
+      break;
+    case DrawMode::IndexedLinesAdjacency:
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
+      glDrawElements(GL_LINES_ADJACENCY, count, indexType, indexOffset);
+      break;
+    case DrawMode::IndexedLineStripAdjacency:
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
+      glDrawElements(GL_LINE_STRIP_ADJACENCY, count, indexType, indexOffset);
+      break;
+    case DrawMode::IndexedTriangles:
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
+      glDrawElements(GL_TRIANGLES, count, indexType, indexOffset);
+      break;
+    }
+  };
+
+  if (useDrawRanges) {
+    for (const std::pair<size_t, size_t>& range : drawRanges) {
+      size_t start = std::min(range.first, static_cast<size_t>(drawDataLength));
+      size_t count = std::min(range.second, drawDataLength - start);
+      if (count > 0) {
+        drawRange(start, count);
+      }
+    }
+  } else {
+    drawRange(0, drawDataLength);
   }
 
   if (usePrimitiveRestart) {
@@ -2654,7 +2957,10 @@ void GLEngine::populateDefaultShadersAndRules() {
   registerShaderProgram("POINT_QUAD", {FLEX_POINTQUAD_VERT_SHADER, FLEX_POINTQUAD_GEOM_SHADER, FLEX_POINTQUAD_FRAG_SHADER}, DrawMode::Points);
   registerShaderProgram("RAYCAST_VECTOR", {FLEX_VECTOR_VERT_SHADER, FLEX_VECTOR_GEOM_SHADER, FLEX_VECTOR_FRAG_SHADER}, DrawMode::Points);
   registerShaderProgram("RAYCAST_TANGENT_VECTOR", {FLEX_TANGENT_VECTOR_VERT_SHADER, FLEX_VECTOR_GEOM_SHADER, FLEX_VECTOR_FRAG_SHADER}, DrawMode::Points);
+  registerShaderProgram("RAYCAST_VECTOR_INDEXED", {FLEX_VECTOR_VERT_SHADER, FLEX_VECTOR_GEOM_SHADER, FLEX_VECTOR_FRAG_SHADER}, DrawMode::IndexedPoints);
+  registerShaderProgram("RAYCAST_TANGENT_VECTOR_INDEXED", {FLEX_TANGENT_VECTOR_VERT_SHADER, FLEX_VECTOR_GEOM_SHADER, FLEX_VECTOR_FRAG_SHADER}, DrawMode::IndexedPoints);
   registerShaderProgram("RAYCAST_CYLINDER", {FLEX_CYLINDER_VERT_SHADER, FLEX_CYLINDER_GEOM_SHADER, FLEX_CYLINDER_FRAG_SHADER}, DrawMode::Points);
+  registerShaderProgram("POLYLINE", {FLEX_POLYLINE_VERT_SHADER, FLEX_POLYLINE_GEOM_SHADER, FLEX_POLYLINE_FRAG_SHADER}, DrawMode::IndexedLineStrip);
   registerShaderProgram("HISTOGRAM", {HISTOGRAM_VERT_SHADER, HISTOGRAM_FRAG_SHADER}, DrawMode::Triangles);
   registerShaderProgram("GROUND_PLANE_TILE", {GROUND_PLANE_VERT_SHADER, GROUND_PLANE_TILE_FRAG_SHADER}, DrawMode::Triangles);
   registerShaderProgram("GROUND_PLANE_TILE_REFLECT", {GROUND_PLANE_VERT_SHADER, GROUND_PLANE_TILE_REFLECT_FRAG_SHADER}, DrawMode::Triangles);
@@ -2692,6 +2998,8 @@ void GLEngine::populateDefaultShadersAndRules() {
   
   registerShaderRule("GENERATE_VIEW_POS", GENERATE_VIEW_POS);
   registerShaderRule("CULL_POS_FROM_VIEW", CULL_POS_FROM_VIEW);
+  registerShaderRule("DEQUANTIZE_POSITION", DEQUANTIZE_POSITION);
+  registerShaderRule("DECODE_OCTAHEDRAL_NORMAL", DECODE_OCTAHEDRAL_NORMAL);
 
   // Lighting and shading things
   registerShaderRule("LIGHT_MATCAP", LIGHT_MATCAP);
@@ -2741,6 +3049,8 @@ void GLEngine::populateDefaultShadersAndRules() {
   // vector things
   registerShaderRule("VECTOR_PROPAGATE_COLOR", VECTOR_PROPAGATE_COLOR);
   registerShaderRule("VECTOR_CULLPOS_FROM_TAIL", VECTOR_CULLPOS_FROM_TAIL);
+  registerShaderRule("VECTOR_CULL_MAGNITUDE", VECTOR_CULL_MAGNITUDE);
+  registerShaderRule("TANGENT_VECTOR_CULL_MAGNITUDE", TANGENT_VECTOR_CULL_MAGNITUDE);
   registerShaderRule("TRANSFORMATION_GIZMO_VEC", TRANSFORMATION_GIZMO_VEC);
 
   // cylinder things
@@ -2752,6 +3062,12 @@ void GLEngine::populateDefaultShadersAndRules() {
   registerShaderRule("CYLINDER_CULLPOS_FROM_MID", CYLINDER_CULLPOS_FROM_MID);
   registerShaderRule("CYLINDER_VARIABLE_SIZE", CYLINDER_VARIABLE_SIZE);
 
+  // polyline things
+  registerShaderRule("POLYLINE_PROPAGATE_VALUE", POLYLINE_PROPAGATE_VALUE);
+  registerShaderRule("POLYLINE_PROPAGATE_COLOR", POLYLINE_PROPAGATE_COLOR);
+  registerShaderRule("POLYLINE_PROPAGATE_PICK", POLYLINE_PROPAGATE_PICK);
+  registerShaderRule("POLYLINE_CULLPOS_FROM_MID", POLYLINE_CULLPOS_FROM_MID);
+
   // marching tets things
   registerShaderRule("SLICE_TETS_BASECOLOR_SHADE", SLICE_TETS_BASECOLOR_SHADE);
   registerShaderRule("SLICE_TETS_PROPAGATE_VALUE", SLICE_TETS_PROPAGATE_VALUE);
@@ -0,0 +1,293 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+
+#include "polyscope/render/opengl/shaders/polyline_shaders.h"
+
+namespace polyscope {
+namespace render {
+namespace backend_openGL3_glfw {
+
+// clang-format off
+
+// These POLYLINE shaders draw line strips (with primitive restart between strips) as camera-facing quads which have a
+// constant width in pixels, regardless of the distance to the camera. They are much cheaper than the raycast cylinders,
+// and read the per-node position buffer directly rather than expanded per-edge copies.
+
+const ShaderStageSpecification FLEX_POLYLINE_VERT_SHADER = {
+
+    ShaderStageType::Vertex,
+
+    // uniforms
+    {
+        {"u_modelView", RenderDataType::Matrix44Float},
+    }, 
+
+    // attributes
+    {
+        {"a_position", RenderDataType::Vector3Float},
+    },
+
+    {}, // textures
+
+    // source
+R"(
+        ${ GLSL_VERSION }$
+
+        in vec3 a_position;
+        uniform mat4 u_modelView;
+        
+        ${ VERT_DECLARATIONS }$
+        
+        void main()
+        {
+            gl_Position = u_modelView * vec4(a_position, 1.0);
+
+            ${ VERT_ASSIGNMENTS }$
+        }
+)"
+};
+
+const ShaderStageSpecification FLEX_POLYLINE_GEOM_SHADER = {
+    
+    ShaderStageType::Geometry,
+    
+    // uniforms
+    {
+        {"u_projMatrix", RenderDataType::Matrix44Float},
+        {"u_viewport", RenderDataType::Vector4Float},
+        {"u_lineWidth", RenderDataType::Float},
+    }, 
+
+    // attributes
+    {
+    },
+
+    {}, // textures
+
+    // source
+R"(
+        ${ GLSL_VERSION }$
+
+        layout(lines) in;
+        layout(triangle_strip, max_vertices=4) out;
+        uniform mat4 u_projMatrix;
+        uniform vec4 u_viewport;
+        uniform float u_lineWidth;
+        out vec3 tailView;
+        out vec3 tipView;
+        out float tEdge;
+        out float sAcross;
+
+        ${ GEOM_DECLARATIONS }$
+
+        void main() {
+
+            vec3 tailViewVal = gl_in[0].gl_Position.xyz / gl_in[0].gl_Position.w;
+            vec3 tipViewVal = gl_in[1].gl_Position.xyz / gl_in[1].gl_Position.w;
+            vec4 tailProj = u_projMatrix * gl_in[0].gl_Position;
+            vec4 tipProj = u_projMatrix * gl_in[1].gl_Position;
+
+            // Direction of the segment in pixel coordinates
+            vec2 viewportDim = u_viewport.zw;
+            vec2 screenDir = (tipProj.xy / tipProj.w - tailProj.xy / tailProj.w) * viewportDim;
+            if(dot(screenDir, screenDir) < 1e-12) {
+              screenDir = vec2(1., 0.);
+            }
+            screenDir = normalize(screenDir);
+
+            // Offset perpendicular to the segment, by half the line width in NDC units
+            vec2 perpNDC = vec2(-screenDir.y, screenDir.x) * u_lineWidth / viewportDim;
+            vec4 dTail = vec4(perpNDC * tailProj.w, 0., 0.);
+            vec4 dTip = vec4(perpNDC * tipProj.w, 0., 0.);
+
+            ${ GEOM_COMPUTE_BEFORE_EMIT }$
+    
+            // Emit the vertices as a triangle strip
+            int iEnd;
+            iEnd = 0; ${ GEOM_PER_EMIT }$ tailView = tailViewVal; tipView = tipViewVal; tEdge = 0.; sAcross = -1.; gl_Position = tailProj - dTail; EmitVertex(); 
+            iEnd = 0; ${ GEOM_PER_EMIT }$ tailView = tailViewVal; tipView = tipViewVal; tEdge = 0.; sAcross = 1.; gl_Position = tailProj + dTail; EmitVertex(); 
+            iEnd = 1; ${ GEOM_PER_EMIT }$ tailView = tailViewVal; tipView = tipViewVal; tEdge = 1.; sAcross = -1.; gl_Position = tipProj - dTip; EmitVertex(); 
+            iEnd = 1; ${ GEOM_PER_EMIT }$ tailView = tailViewVal; tipView = tipViewVal; tEdge = 1.; sAcross = 1.; gl_Position = tipProj + dTip; EmitVertex(); 
+    
+            EndPrimitive();
+        }
+
+)"
+};
+
+
+const ShaderStageSpecification FLEX_POLYLINE_FRAG_SHADER = {
+    
+    ShaderStageType::Fragment,
+    
+    // uniforms
+    {
+    }, 
+
+    { }, // attributes
+    
+    // textures 
+    {
+    },
+ 
+    // source
+R"(
+        ${ GLSL_VERSION }$
+        in vec3 tailView;
+        in vec3 tipView;
+        in float tEdge;
+        in float sAcross;
+        layout(location = 0) out vec4 outputF;
+
+        ${ FRAG_DECLARATIONS }$
+
+        void main()
+        {
+           float depth = gl_FragCoord.z;
+           ${ GLOBAL_FRAGMENT_FILTER_PREP }$
+           ${ GLOBAL_FRAGMENT_FILTER }$
+          
+           // Shading
+           ${ GENERATE_SHADE_VALUE }$
+           ${ GENERATE_SHADE_COLOR }$
+
+           // Lighting
+           // (bend the normal across the width of the line, so it is lit like a thin tube)
+           vec3 posView = mix(tailView, tipView, tEdge);
+           vec3 dirToCam = normalize(-posView);
+           vec3 sideDir = cross(tipView - tailView, dirToCam);
+           if(dot(sideDir, sideDir) > 0.) {
+             sideDir = normalize(sideDir);
+           }
+           float sClamp = clamp(sAcross, -1., 1.);
+           vec3 shadeNormal = normalize(sClamp * sideDir + sqrt(1. - sClamp * sClamp) * dirToCam);
+           ${ GENERATE_LIT_COLOR }$
+
+           // Set alpha
+           float alphaOut = 1.0;
+           ${ GENERATE_ALPHA }$
+
+           // Write output
+           outputF = vec4(litColor, alphaOut);
+        }
+)"
+};
+
+// == Rules
+
+// interpolates a per-node value along each segment
+const ShaderReplacementRule POLYLINE_PROPAGATE_VALUE (
+    /* rule name */ "POLYLINE_PROPAGATE_VALUE",
+    { /* replacement sources */
+      {"VERT_DECLARATIONS", R"(
+          in float a_value;
+          out float a_valueToGeom;
+        )"},
+      {"VERT_ASSIGNMENTS", R"(
+          a_valueToGeom = a_value;
+        )"},
+      {"GEOM_DECLARATIONS", R"(
+          in float a_valueToGeom[];
+          out float a_valueToFrag;
+        )"},
+      {"GEOM_PER_EMIT", R"(
+          a_valueToFrag = a_valueToGeom[iEnd]; 
+        )"},
+      {"FRAG_DECLARATIONS", R"(
+          in float a_valueToFrag;
+        )"},
+      {"GENERATE_SHADE_VALUE", R"(
+          float shadeValue = a_valueToFrag;
+        )"},
+    },
+    /* uniforms */ {},
+    /* attributes */ {
+      {"a_value", RenderDataType::Float},
+    },
+    /* textures */ {}
+);
+
+// interpolates a per-node color along each segment
+const ShaderReplacementRule POLYLINE_PROPAGATE_COLOR (
+    /* rule name */ "POLYLINE_PROPAGATE_COLOR",
+    { /* replacement sources */
+      {"VERT_DECLARATIONS", R"(
+          in vec3 a_color;
+          out vec3 a_colorToGeom;
+        )"},
+      {"VERT_ASSIGNMENTS", R"(
+          a_colorToGeom = a_color;
+        )"},
+      {"GEOM_DECLARATIONS", R"(
+          in vec3 a_colorToGeom[];
+          out vec3 a_colorToFrag;
+        )"},
+      {"GEOM_PER_EMIT", R"(
+          a_colorToFrag = a_colorToGeom[iEnd]; 
+        )"},
+      {"FRAG_DECLARATIONS", R"(
+          in vec3 a_colorToFrag;
+        )"},
+      {"GENERATE_SHADE_VALUE", R"(
+          vec3 shadeColor = a_colorToFrag;
+        )"},
+    },
+    /* uniforms */ {},
+    /* attributes */ {
+      {"a_color", RenderDataType::Vector3Float},
+    },
+    /* textures */ {}
+);
+
+// data for picking: each half of a segment gets the (un-interpolated) pick color of the nearer node
+const ShaderReplacementRule POLYLINE_PROPAGATE_PICK (
+    /* rule name */ "POLYLINE_PROPAGATE_PICK",
+    { /* replacement sources */
+      {"VERT_DECLARATIONS", R"(
+          in vec3 a_color;
+          out vec3 a_colorToGeom;
+        )"},
+      {"VERT_ASSIGNMENTS", R"(
+          a_colorToGeom = a_color;
+        )"},
+      {"GEOM_DECLARATIONS", R"(
+          in vec3 a_colorToGeom[];
+          flat out vec3 a_colorTailToFrag;
+          flat out vec3 a_colorTipToFrag;
+        )"},
+      {"GEOM_PER_EMIT", R"(
+          a_colorTailToFrag = a_colorToGeom[0]; 
+          a_colorTipToFrag = a_colorToGeom[1]; 
+        )"},
+      {"FRAG_DECLARATIONS", R"(
+          flat in vec3 a_colorTailToFrag;
+          flat in vec3 a_colorTipToFrag;
+        )"},
+      {"GENERATE_SHADE_VALUE", R"(
+          vec3 shadeColor = (tEdge < 0.5) ? a_colorTailToFrag : a_colorTipToFrag;
+        )"},
+    },
+    /* uniforms */ {},
+    /* attributes */ {
+      {"a_color", RenderDataType::Vector3Float},
+    },
+    /* textures */ {}
+);
+
+const ShaderReplacementRule POLYLINE_CULLPOS_FROM_MID (
+    /* rule name */ "POLYLINE_CULLPOS_FROM_MID",
+    { /* replacement sources */
+      {"GLOBAL_FRAGMENT_FILTER_PREP", R"(
+          vec3 cullPos = 0.5 * (tailView + tipView);
+        )"},
+    },
+    /* uniforms */ {},
+    /* attributes */ {},
+    /* textures */ {}
+);
+
+// clang-format on
+
+} // namespace backend_openGL3_glfw
+} // namespace render
+} // namespace polyscope
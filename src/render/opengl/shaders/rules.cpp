@@ -311,6 +311,44 @@ const ShaderReplacementRule CULL_POS_FROM_VIEW (
 );
 
 
+// Positions stored as 16-bit fixed point within a bounding box arrive in [0,1]^3 (see BufferQuantization)
+const ShaderReplacementRule DEQUANTIZE_POSITION (
+    /* rule name */ "DEQUANTIZE_POSITION",
+    { /* replacement sources */
+      {"VERT_DECLARATIONS", R"(
+          uniform vec3 u_positionDequantizeOffset;
+          uniform vec3 u_positionDequantizeScale;
+        )"},
+      {"VERT_DECODE_POSITION", R"(
+          position = u_positionDequantizeOffset + position * u_positionDequantizeScale;
+        )"},
+    },
+    /* uniforms */ {
+      {"u_positionDequantizeOffset", RenderDataType::Vector3Float},
+      {"u_positionDequantizeScale", RenderDataType::Vector3Float},
+    },
+    /* attributes */ {},
+    /* textures */ {}
+);
+
+// Octahedral-encoded normals arrive as (x, y, 0), with xy in [-1,1]^2
+const ShaderReplacementRule DECODE_OCTAHEDRAL_NORMAL (
+    /* rule name */ "DECODE_OCTAHEDRAL_NORMAL",
+    { /* replacement sources */
+      {"VERT_DECODE_NORMAL", R"(
+          normal = vec3(normal.xy, 1. - abs(normal.x) - abs(normal.y));
+          float octFold = max(-normal.z, 0.);
+          normal.x += normal.x >= 0. ? -octFold : octFold;
+          normal.y += normal.y >= 0. ? -octFold : octFold;
+          normal = normalize(normal);
+        )"},
+    },
+    /* uniforms */ {},
+    /* attributes */ {},
+    /* textures */ {}
+);
+
+
 ShaderReplacementRule generateSlicePlaneRule(std::string uniquePostfix) {
 
   std::string centerUniformName = "u_slicePlaneCenter_" + uniquePostfix;
@@ -47,9 +47,13 @@ R"(
         
         void main()
         {
-            gl_Position = u_projMatrix * u_modelView * vec4(a_vertexPositions,1.);
+            vec3 position = a_vertexPositions;
+            vec3 normal = a_vertexNormals;
+            ${ VERT_DECODE_POSITION }$
+            ${ VERT_DECODE_NORMAL }$
+            gl_Position = u_projMatrix * u_modelView * vec4(position,1.);
             
-            a_vertexNormalToFrag = mat3(u_modelView) * a_vertexNormals;
+            a_vertexNormalToFrag = mat3(u_modelView) * normal;
             a_barycoordToFrag = a_barycoord;
 
             ${ VERT_ASSIGNMENTS }$
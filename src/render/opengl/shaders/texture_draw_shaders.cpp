@@ -180,8 +180,13 @@ R"(
     // Build a ray corresponding to this fragment
     vec2 depthRange = vec2(gl_DepthRange.near, gl_DepthRange.far);
     vec3 viewRay = fragmentViewPosition(u_viewport, depthRange, u_invProjMatrix, gl_FragCoord);
-    // (source is implicit at origin)
-    vec3 viewPos = normalize(viewRay) * depth;
+    // (perspective rays start at the origin, orthographic rays run along -Z from the z=0 plane)
+    vec3 viewPos;
+    if(u_projMatrix[3][3] == 1.) {
+      viewPos = vec3(viewRay.xy, -depth);
+    } else {
+      viewPos = normalize(viewRay) * depth;
+    }
     float fragdepth = fragDepthFromView(u_projMatrix, depthRange, viewPos);
     gl_FragDepth = fragdepth;
 
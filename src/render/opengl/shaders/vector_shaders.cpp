@@ -40,7 +40,9 @@ R"(
 
         void main()
         {
-            gl_Position = u_modelView * vec4(a_position,1.0);
+            vec3 position = a_position;
+            ${ VERT_DECODE_POSITION }$
+            gl_Position = u_modelView * vec4(position,1.0);
             vector = u_modelView * vec4(a_vector, 0.0);
             
             ${ VERT_ASSIGNMENTS }$
@@ -85,7 +87,9 @@ R"(
 
         void main()
         {
-            gl_Position = u_modelView * vec4(a_position,1.0);
+            vec3 position = a_position;
+            ${ VERT_DECODE_POSITION }$
+            gl_Position = u_modelView * vec4(position,1.0);
           
             vec2 rotTangentVector = a_tangentVector;
             if(u_vectorRotRad != 0.) {
@@ -139,6 +143,8 @@ R"(
 
         void main() {
 
+            ${ GEOM_COMPUTE_BEFORE_EMIT }$
+
             // Build an orthogonal basis
             vec3 tailViewVal = gl_in[0].gl_Position.xyz / gl_in[0].gl_Position.w;
             vec3 vecViewVal = vector[0].xyz;
@@ -329,6 +335,55 @@ const ShaderReplacementRule VECTOR_CULLPOS_FROM_TAIL(
     /* textures */ {}
 );
 
+// skip vectors whose (input) magnitude is below a threshold
+const ShaderReplacementRule VECTOR_CULL_MAGNITUDE(
+    /* rule name */ "VECTOR_CULL_MAGNITUDE",
+    { /* replacement sources */
+      {"VERT_DECLARATIONS", R"(
+          out float a_vectorMagnitudeToGeom;
+        )"},
+      {"VERT_ASSIGNMENTS", R"(
+          a_vectorMagnitudeToGeom = length(a_vector);
+        )"},
+      {"GEOM_DECLARATIONS", R"(
+          in float a_vectorMagnitudeToGeom[];
+          uniform float u_vectorMagnitudeThreshold;
+        )"},
+      {"GEOM_COMPUTE_BEFORE_EMIT", R"(
+          if(a_vectorMagnitudeToGeom[0] < u_vectorMagnitudeThreshold) return;
+        )"},
+    },
+    /* uniforms */ {
+      {"u_vectorMagnitudeThreshold", RenderDataType::Float},
+    },
+    /* attributes */ {},
+    /* textures */ {}
+);
+
+const ShaderReplacementRule TANGENT_VECTOR_CULL_MAGNITUDE(
+    /* rule name */ "TANGENT_VECTOR_CULL_MAGNITUDE",
+    { /* replacement sources */
+      {"VERT_DECLARATIONS", R"(
+          out float a_vectorMagnitudeToGeom;
+        )"},
+      {"VERT_ASSIGNMENTS", R"(
+          a_vectorMagnitudeToGeom = length(a_tangentVector);
+        )"},
+      {"GEOM_DECLARATIONS", R"(
+          in float a_vectorMagnitudeToGeom[];
+          uniform float u_vectorMagnitudeThreshold;
+        )"},
+      {"GEOM_COMPUTE_BEFORE_EMIT", R"(
+          if(a_vectorMagnitudeToGeom[0] < u_vectorMagnitudeThreshold) return;
+        )"},
+    },
+    /* uniforms */ {
+      {"u_vectorMagnitudeThreshold", RenderDataType::Float},
+    },
+    /* attributes */ {},
+    /* textures */ {}
+);
+
 
 // clang-format on
 
@@ -0,0 +1,195 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/render/quantization.h"
+
+#include "polyscope/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace polyscope {
+namespace render {
+
+namespace {
+
+// Entries per parallel work item when encoding whole buffers
+const size_t quantizeChunkSize = 1 << 16;
+
+// Encode data[start, start+count)
+template <typename Q, typename F>
+std::vector<Q> encodeArray(const std::vector<glm::vec3>& data, size_t start, size_t count, F encode) {
+  std::vector<Q> out(count);
+  parallelForChunks(count, quantizeChunkSize, [&](size_t, size_t chunkStart, size_t chunkEnd) {
+    for (size_t i = chunkStart; i < chunkEnd; i++) {
+      out[i] = encode(data[start + i]);
+    }
+  });
+  return out;
+}
+
+// Upload encoded data, converting only the updated range unless the buffer needs all of it
+template <typename Q, typename F>
+void setEncodedDataRange(AttributeBuffer& buff, const std::vector<glm::vec3>& data, size_t start, size_t count,
+                         F encode) {
+  if (buff.setDataRangeReallocates(data.size())) {
+    buff.setDataRange(encodeArray<Q>(data, 0, data.size(), encode), start, count);
+  } else {
+    buff.setDataSubrange(encodeArray<Q>(data, start, count, encode), start, data.size());
+  }
+}
+
+float unitToUNorm(float x, float maxVal) { return std::round(glm::clamp(x, 0.f, 1.f) * maxVal); }
+
+} // namespace
+
+glm::vec3 QuantizationBounds::dequantizeOffset() const {
+  if (lower.x > upper.x) return glm::vec3{0., 0., 0.};
+  return lower;
+}
+
+glm::vec3 QuantizationBounds::dequantizeScale() const { return glm::max(upper - lower, glm::vec3{0., 0., 0.}); }
+
+RenderDataType quantizedRenderDataType(BufferQuantization q) {
+  switch (q) {
+  case BufferQuantization::None:
+    return RenderDataType::Vector3Float;
+  case BufferQuantization::UNorm16InBounds:
+    return RenderDataType::Vector3UShortNorm;
+  case BufferQuantization::UNorm8:
+    return RenderDataType::Vector4UByteNorm;
+  case BufferQuantization::Octahedral16:
+    return RenderDataType::Vector2ShortNorm;
+  }
+  return RenderDataType::Vector3Float;
+}
+
+QuantizationBounds expandQuantizationBounds(QuantizationBounds bounds, const std::vector<glm::vec3>& data, size_t start,
+                                            size_t count) {
+  if (start + count > data.size()) exception("quantization bounds range is out of bounds");
+
+  // Per-chunk boxes, combined afterwards
+  std::vector<QuantizationBounds> chunkBounds(parallelChunkCount(count, quantizeChunkSize));
+  parallelForChunks(count, quantizeChunkSize, [&](size_t iChunk, size_t chunkStart, size_t chunkEnd) {
+    QuantizationBounds& b = chunkBounds[iChunk];
+    for (size_t i = start + chunkStart; i < start + chunkEnd; i++) {
+      b.lower = glm::min(b.lower, data[i]);
+      b.upper = glm::max(b.upper, data[i]);
+    }
+  });
+
+  for (const QuantizationBounds& b : chunkBounds) {
+    bounds.lower = glm::min(bounds.lower, b.lower);
+    bounds.upper = glm::max(bounds.upper, b.upper);
+  }
+  return bounds;
+}
+
+QuantizationBounds computeQuantizationBounds(const std::vector<glm::vec3>& data) {
+  return expandQuantizationBounds(QuantizationBounds(), data, 0, data.size());
+}
+
+// == Single values
+
+glm::u16vec3 quantizeUNorm16(glm::vec3 p, const QuantizationBounds& bounds) {
+  glm::vec3 offset = bounds.dequantizeOffset();
+  glm::vec3 scale = bounds.dequantizeScale();
+  glm::u16vec3 q;
+  for (int j = 0; j < 3; j++) {
+    float t = scale[j] > 0. ? (p[j] - offset[j]) / scale[j] : 0.f;
+    q[j] = static_cast<uint16_t>(unitToUNorm(t, 65535.f));
+  }
+  return q;
+}
+
+glm::vec3 dequantizeUNorm16(glm::u16vec3 q, const QuantizationBounds& bounds) {
+  return bounds.dequantizeOffset() + glm::vec3(q) / 65535.f * bounds.dequantizeScale();
+}
+
+glm::u8vec4 quantizeUNorm8(glm::vec3 c) {
+  return glm::u8vec4(static_cast<uint8_t>(unitToUNorm(c.x, 255.f)), static_cast<uint8_t>(unitToUNorm(c.y, 255.f)),
+                     static_cast<uint8_t>(unitToUNorm(c.z, 255.f)), 255);
+}
+
+glm::vec3 dequantizeUNorm8(glm::u8vec4 q) { return glm::vec3(q.x, q.y, q.z) / 255.f; }
+
+glm::i16vec2 encodeOctahedral16(glm::vec3 n) {
+
+  // Project on to the octahedron |x|+|y|+|z| = 1, and fold the lower half over the diagonals
+  float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+  if (l1 == 0.) return glm::i16vec2(0, 0);
+  glm::vec2 e = glm::vec2(n.x, n.y) / l1;
+  if (n.z < 0.) {
+    glm::vec2 folded{(1.f - std::abs(e.y)) * (e.x >= 0. ? 1.f : -1.f),
+                     (1.f - std::abs(e.x)) * (e.y >= 0. ? 1.f : -1.f)};
+    e = folded;
+  }
+
+  return glm::i16vec2(static_cast<int16_t>(std::round(glm::clamp(e.x, -1.f, 1.f) * 32767.f)),
+                      static_cast<int16_t>(std::round(glm::clamp(e.y, -1.f, 1.f) * 32767.f)));
+}
+
+glm::vec3 decodeOctahedral16(glm::i16vec2 q) {
+  // (same steps as the DECODE_OCTAHEDRAL_NORMAL shader rule)
+  glm::vec2 e = glm::max(glm::vec2(q) / 32767.f, glm::vec2(-1.f));
+  glm::vec3 n{e.x, e.y, 1.f - std::abs(e.x) - std::abs(e.y)};
+  float t = std::max(-n.z, 0.f);
+  n.x += n.x >= 0. ? -t : t;
+  n.y += n.y >= 0. ? -t : t;
+  return glm::normalize(n);
+}
+
+// == Whole arrays
+
+std::vector<glm::u16vec3> quantizeUNorm16(const std::vector<glm::vec3>& data, const QuantizationBounds& bounds) {
+  return encodeArray<glm::u16vec3>(data, 0, data.size(), [&](glm::vec3 p) { return quantizeUNorm16(p, bounds); });
+}
+
+std::vector<glm::u8vec4> quantizeUNorm8(const std::vector<glm::vec3>& data) {
+  return encodeArray<glm::u8vec4>(data, 0, data.size(), [](glm::vec3 c) { return quantizeUNorm8(c); });
+}
+
+std::vector<glm::i16vec2> encodeOctahedral16(const std::vector<glm::vec3>& data) {
+  return encodeArray<glm::i16vec2>(data, 0, data.size(), [](glm::vec3 n) { return encodeOctahedral16(n); });
+}
+
+void setQuantizedAttributeBufferData(AttributeBuffer& buff, BufferQuantization q, const std::vector<glm::vec3>& data,
+                                     const QuantizationBounds& bounds) {
+  switch (q) {
+  case BufferQuantization::None:
+    buff.setData(data);
+    break;
+  case BufferQuantization::UNorm16InBounds:
+    buff.setData(quantizeUNorm16(data, bounds));
+    break;
+  case BufferQuantization::UNorm8:
+    buff.setData(quantizeUNorm8(data));
+    break;
+  case BufferQuantization::Octahedral16:
+    buff.setData(encodeOctahedral16(data));
+    break;
+  }
+}
+
+void setQuantizedAttributeBufferDataRange(AttributeBuffer& buff, BufferQuantization q,
+                                          const std::vector<glm::vec3>& data, const QuantizationBounds& bounds,
+                                          size_t start, size_t count) {
+  if (start + count > data.size()) exception("setDataRange() range is out of bounds");
+  switch (q) {
+  case BufferQuantization::None:
+    buff.setDataRange(data, start, count);
+    break;
+  case BufferQuantization::UNorm16InBounds:
+    setEncodedDataRange<glm::u16vec3>(buff, data, start, count,
+                                      [&](glm::vec3 p) { return quantizeUNorm16(p, bounds); });
+    break;
+  case BufferQuantization::UNorm8:
+    setEncodedDataRange<glm::u8vec4>(buff, data, start, count, [](glm::vec3 c) { return quantizeUNorm8(c); });
+    break;
+  case BufferQuantization::Octahedral16:
+    setEncodedDataRange<glm::i16vec2>(buff, data, start, count, [](glm::vec3 n) { return encodeOctahedral16(n); });
+    break;
+  }
+}
+
+} // namespace render
+} // namespace polyscope
@@ -262,5 +262,88 @@ std::vector<glm::uvec4> getAttributeBufferDataRange<glm::uvec4>(AttributeBuffer&
   return buff.getDataRange_uvec4(ind, count);
 }
 
+// == Set buffer data at a range of locations
+
+template <>
+void setAttributeBufferDataRange<float>(AttributeBuffer& buff, const std::vector<float>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<double>(AttributeBuffer& buff, const std::vector<double>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<glm::vec2>(AttributeBuffer& buff, const std::vector<glm::vec2>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<glm::vec3>(AttributeBuffer& buff, const std::vector<glm::vec3>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<glm::vec4>(AttributeBuffer& buff, const std::vector<glm::vec4>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<std::array<glm::vec3, 2>>(AttributeBuffer& buff,
+                                                          const std::vector<std::array<glm::vec3, 2>>& data,
+                                                          size_t start, size_t count) {
+  exception("setAttributeBufferDataRange() is not supported for array-valued buffers");
+}
+
+template <>
+void setAttributeBufferDataRange<std::array<glm::vec3, 3>>(AttributeBuffer& buff,
+                                                          const std::vector<std::array<glm::vec3, 3>>& data,
+                                                          size_t start, size_t count) {
+  exception("setAttributeBufferDataRange() is not supported for array-valued buffers");
+}
+
+template <>
+void setAttributeBufferDataRange<std::array<glm::vec3, 4>>(AttributeBuffer& buff,
+                                                          const std::vector<std::array<glm::vec3, 4>>& data,
+                                                          size_t start, size_t count) {
+  exception("setAttributeBufferDataRange() is not supported for array-valued buffers");
+}
+
+template <>
+void setAttributeBufferDataRange<uint32_t>(AttributeBuffer& buff, const std::vector<uint32_t>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<int32_t>(AttributeBuffer& buff, const std::vector<int32_t>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<glm::uvec2>(AttributeBuffer& buff, const std::vector<glm::uvec2>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<glm::uvec3>(AttributeBuffer& buff, const std::vector<glm::uvec3>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
+template <>
+void setAttributeBufferDataRange<glm::uvec4>(AttributeBuffer& buff, const std::vector<glm::uvec4>& data, size_t start,
+                                      size_t count) {
+  buff.setDataRange(data, start, count);
+}
+
 } // namespace render
 } // namespace polyscope
@@ -38,14 +38,19 @@ void RenderImageQuantityBase::addOptionsPopupEntries() {
 
 void RenderImageQuantityBase::updateGeometryBuffers(const std::vector<float>& newDepthData,
                                                     const std::vector<glm::vec3>& newNormalData) {
+  if (newDepthData.size() != nPix() || newNormalData.size() != nPix()) {
+    exception("render image quantity " + name + " updated with data of the wrong size");
+  }
+
   depthData = newDepthData;
   normalData = newNormalData;
 
-  // if prepared, re-prepare
-  // TODO do a fast update in the same buffer here
+  // if prepared, update the existing textures (which the shader program is already bound to)
   if (textureDepth) {
-    prepareGeometryBuffers();
+    textureDepth->setData(depthData);
+    textureNormal->setData(normalData);
   }
+  requestRedraw();
 }
 
 void RenderImageQuantityBase::prepareGeometryBuffers() {
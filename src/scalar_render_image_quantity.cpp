@@ -99,6 +99,26 @@ void ScalarRenderImageQuantity::prepare() {
 }
 
 
+void ScalarRenderImageQuantity::updateBuffers(const std::vector<float>& newDepthData,
+                                              const std::vector<glm::vec3>& newNormalData,
+                                              const std::vector<double>& newScalarData) {
+  if (newDepthData.size() != nPix() || newNormalData.size() != nPix() || newScalarData.size() != nPix()) {
+    exception("render image quantity " + name + " updated with data of the wrong size");
+  }
+
+  values.data = newScalarData;
+  values.markHostBufferUpdated();
+  if (textureScalar) {
+    std::vector<float> floatData(values.data.size());
+    for (size_t i = 0; i < values.data.size(); i++) {
+      floatData[i] = static_cast<float>(values.data[i]);
+    }
+    textureScalar->setData(floatData);
+  }
+
+  updateGeometryBuffers(newDepthData, newNormalData);
+}
+
 std::string ScalarRenderImageQuantity::niceName() { return name + " (scalar render image)"; }
 
 ScalarRenderImageQuantity* ScalarRenderImageQuantity::setEnabled(bool newEnabled) {
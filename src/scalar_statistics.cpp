@@ -0,0 +1,229 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/scalar_statistics.h"
+
+#include "polyscope/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace polyscope {
+
+namespace {
+
+// Index of the bin containing x, for nBins bins of width binWidth starting at lower
+size_t binIndex(double x, double lower, double binWidth, size_t nBins) {
+  if (!(binWidth > 0.)) return 0;
+  double iBinf = (x - lower) / binWidth;
+  if (!(iBinf > 0.)) return 0;
+  return std::min(static_cast<size_t>(iBinf), nBins - 1);
+}
+
+} // namespace
+
+ScalarStatistics computeScalarStatistics(const std::vector<double>& values, bool withHistograms) {
+
+  ScalarStatistics stats;
+  size_t nChunks = parallelChunkCount(values.size(), statisticsChunkSize);
+  std::vector<ScalarStatistics> chunkStats(nChunks);
+  if (withHistograms) stats.chunks.resize(nChunks);
+
+  // First pass: the range and counts of each chunk, then its histogram over its own range
+  parallelForChunks(values.size(), statisticsChunkSize, [&](size_t iChunk, size_t start, size_t end) {
+    ScalarStatistics& s = chunkStats[iChunk];
+    double minVal = std::numeric_limits<double>::infinity();
+    double maxVal = -std::numeric_limits<double>::infinity();
+    for (size_t i = start; i < end; i++) {
+      double x = values[i];
+      if (std::isfinite(x)) {
+        minVal = std::min(minVal, x);
+        maxVal = std::max(maxVal, x);
+        s.finiteCount++;
+      } else if (std::isnan(x)) {
+        s.nanCount++;
+      } else {
+        s.infCount++;
+      }
+    }
+    s.min = minVal;
+    s.max = maxVal;
+
+    // Bin the chunk over its own range, while it is still in cache
+    if (!withHistograms) return;
+    ScalarStatistics::ChunkHistogram& h = stats.chunks[iChunk];
+    h.min = minVal;
+    h.max = maxVal;
+    if (s.finiteCount == 0) return;
+    h.cumulativeCounts.assign(statisticsChunkBinCount, 0);
+    h.binMin.assign(statisticsChunkBinCount, std::numeric_limits<double>::infinity());
+    h.binMax.assign(statisticsChunkBinCount, -std::numeric_limits<double>::infinity());
+    double binWidth = (maxVal - minVal) / statisticsChunkBinCount;
+    for (size_t i = start; i < end; i++) {
+      double x = values[i];
+      if (std::isfinite(x)) {
+        size_t iBin = binIndex(x, minVal, binWidth, statisticsChunkBinCount);
+        h.cumulativeCounts[iBin]++;
+        h.binMin[iBin] = std::min(h.binMin[iBin], x);
+        h.binMax[iBin] = std::max(h.binMax[iBin], x);
+      }
+    }
+    for (size_t iBin = 1; iBin < statisticsChunkBinCount; iBin++) {
+      h.cumulativeCounts[iBin] += h.cumulativeCounts[iBin - 1];
+    }
+  });
+
+  // Merge the chunks, dropping the histograms of chunks with no finite values
+  bool anyFinite = false;
+  size_t iPack = 0;
+  for (size_t iChunk = 0; iChunk < nChunks; iChunk++) {
+    const ScalarStatistics& s = chunkStats[iChunk];
+    stats.nanCount += s.nanCount;
+    stats.infCount += s.infCount;
+    if (s.finiteCount == 0) continue;
+    stats.min = anyFinite ? std::min(stats.min, s.min) : s.min;
+    stats.max = anyFinite ? std::max(stats.max, s.max) : s.max;
+    stats.finiteCount += s.finiteCount;
+    anyFinite = true;
+    if (!withHistograms) continue;
+    if (iPack != iChunk) stats.chunks[iPack] = std::move(stats.chunks[iChunk]);
+    iPack++;
+  }
+  if (!withHistograms) return stats;
+  stats.chunks.resize(iPack);
+
+  // Second pass: the exact histogram over the overall range, with the same bin edges in every chunk
+  std::pair<double, double> range = stats.robustRange();
+  size_t nBins = statisticsHistogramBinCount;
+  double binWidth = (range.second - range.first) / nBins;
+  std::vector<std::vector<uint32_t>> chunkCounts(nChunks);
+  parallelForChunks(values.size(), statisticsChunkSize, [&](size_t iChunk, size_t start, size_t end) {
+    if (chunkStats[iChunk].finiteCount == 0) return;
+    std::vector<uint32_t>& counts = chunkCounts[iChunk];
+    counts.assign(nBins, 0);
+    for (size_t i = start; i < end; i++) {
+      double x = values[i];
+      if (std::isfinite(x)) {
+        counts[binIndex(x, range.first, binWidth, nBins)]++;
+      }
+    }
+  });
+  stats.rangeHistogram.assign(nBins, 0.);
+  for (const std::vector<uint32_t>& counts : chunkCounts) {
+    for (size_t iBin = 0; iBin < counts.size(); iBin++) {
+      stats.rangeHistogram[iBin] += counts[iBin];
+    }
+  }
+
+  return stats;
+}
+
+std::future<ScalarStatistics> computeScalarStatisticsAsync(std::vector<double> values) {
+  std::shared_ptr<std::promise<ScalarStatistics>> promise = std::make_shared<std::promise<ScalarStatistics>>();
+  std::future<ScalarStatistics> result = promise->get_future();
+  std::shared_ptr<std::vector<double>> data = std::make_shared<std::vector<double>>(std::move(values));
+  std::thread([promise, data]() {
+    try {
+      promise->set_value(computeScalarStatistics(*data));
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  }).detach();
+  return result;
+}
+
+size_t ScalarStatistics::countAtMost(double x) const {
+  double count = 0.;
+  for (const ChunkHistogram& h : chunks) {
+    const std::vector<uint32_t>& cumulative = h.cumulativeCounts;
+    size_t nBins = cumulative.size();
+    if (x < h.min) continue;
+    if (x >= h.max) {
+      count += cumulative.back();
+      continue;
+    }
+    double binWidth = (h.max - h.min) / nBins;
+    size_t iBin = binIndex(x, h.min, binWidth, nBins);
+    double before = iBin == 0 ? 0. : cumulative[iBin - 1];
+    double inBin = cumulative[iBin] - before;
+    if (inBin == 0. || x < h.binMin[iBin]) {
+      count += before;
+    } else if (x >= h.binMax[iBin]) {
+      count += cumulative[iBin];
+    } else {
+      // interpolate over the values in the bin
+      double t = (x - h.binMin[iBin]) / (h.binMax[iBin] - h.binMin[iBin]);
+      count += before + t * inBin;
+    }
+  }
+  return static_cast<size_t>(count);
+}
+
+double ScalarStatistics::percentile(double p) const {
+  if (finiteCount == 0) return 0.;
+  p = std::min(std::max(p, 0.), 1.);
+  size_t target = static_cast<size_t>(std::ceil(p * finiteCount));
+
+  // bisect for the smallest value with at least the target count below it
+  double lower = min;
+  double upper = max;
+  for (int iIter = 0; iIter < 64 && lower < upper; iIter++) {
+    double mid = lower + (upper - lower) / 2.;
+    if (mid <= lower || mid >= upper) break;
+    if (countAtMost(mid) >= target) {
+      upper = mid;
+    } else {
+      lower = mid;
+    }
+  }
+  return upper;
+}
+
+std::pair<double, double> ScalarStatistics::robustRange(double rangeEPS) const {
+  if (finiteCount == 0) {
+    return std::make_pair(-1.0, 1.0);
+  }
+
+  double minVal = min;
+  double maxVal = max;
+  double maxMag = std::max(std::abs(minVal), std::abs(maxVal));
+
+  // Hack to do less ugly things when constants (or near-constant) are passed in
+  if (maxMag < rangeEPS) {
+    maxVal = rangeEPS;
+    minVal = -rangeEPS;
+  } else if ((maxVal - minVal) / maxMag < rangeEPS) {
+    double mid = (minVal + maxVal) / 2.0;
+    maxVal = mid + maxMag * rangeEPS;
+    minVal = mid - maxMag * rangeEPS;
+  }
+
+  return std::make_pair(minVal, maxVal);
+}
+
+std::vector<double> ScalarStatistics::histogram(double lower, double upper, size_t nBins) const {
+  if (nBins == rangeHistogram.size() && std::make_pair(lower, upper) == robustRange()) {
+    return rangeHistogram;
+  }
+
+  std::vector<double> result(nBins, 0.);
+  if (nBins == 0) return result;
+
+  // each chunk bin is counted in the bin containing the center of its values
+  double newBinWidth = (upper - lower) / nBins;
+  for (const ChunkHistogram& h : chunks) {
+    size_t nChunkBins = h.cumulativeCounts.size();
+    for (size_t iBin = 0; iBin < nChunkBins; iBin++) {
+      uint32_t count = h.cumulativeCounts[iBin] - (iBin == 0 ? 0 : h.cumulativeCounts[iBin - 1]);
+      if (count == 0) continue;
+      double center = (h.binMin[iBin] + h.binMax[iBin]) / 2.;
+      if (center < lower || center > upper) continue;
+      result[binIndex(center, lower, newBinWidth, nBins)] += count;
+    }
+  }
+  return result;
+}
+
+} // namespace polyscope
@@ -0,0 +1,344 @@
+// Copyright 2017-2023, Nicholas Sharp and the Polyscope contributors. https://polyscope.run
+
+#include "polyscope/scene_file.h"
+
+#include "polyscope/curve_network.h"
+#include "polyscope/messages.h"
+#include "polyscope/point_cloud.h"
+#include "polyscope/polyscope.h"
+#include "polyscope/surface_mesh.h"
+#include "polyscope/volume_mesh.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace polyscope {
+
+namespace {
+
+// The fixed-size header at the start of every scene file
+struct SceneFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark; // written as sceneFileByteOrderMark, reads differently on a machine of the other endianness
+  uint64_t tocOffset;
+  uint64_t tocBytes;
+  uint64_t entryCount;
+  char padding[24];
+};
+static_assert(sizeof(SceneFileHeader) == sceneFileAlignment, "scene file header should be one alignment block");
+
+const char sceneFileMagic[8] = {'P', 'S', 'S', 'C', 'E', 'N', 'E', '\0'};
+const uint32_t sceneFileByteOrderMark = 0x01020304;
+
+size_t valueTypeSize(SceneFileValueType type) {
+  switch (type) {
+  case SceneFileValueType::UInt8:
+    return 1;
+  case SceneFileValueType::UInt32:
+  case SceneFileValueType::Float:
+    return 4;
+  case SceneFileValueType::UInt64:
+  case SceneFileValueType::Double:
+    return 8;
+  }
+  return 0;
+}
+
+} // namespace
+
+// =======================================================
+// === Writer
+// =======================================================
+
+SceneFileWriter::SceneFileWriter(std::string filename_)
+    : filename(filename_), out(filename_, std::ios::out | std::ios::binary | std::ios::trunc) {
+  if (!out) exception("could not open scene file " + filename + " for writing");
+
+  // placeholder for the header, which is filled in once the table of contents has been written
+  writePadding(sizeof(SceneFileHeader));
+}
+
+SceneFileWriter::~SceneFileWriter() {
+  if (finished) return;
+  try {
+    finish();
+  } catch (const std::exception& e) {
+    error("failed to finish writing scene file " + filename + ": " + e.what());
+  }
+}
+
+void SceneFileWriter::writeString(const std::string& key, const std::string& value) {
+  writeArray(key, std::vector<char>(value.begin(), value.end()));
+}
+
+void SceneFileWriter::writeIndexArray(const std::string& key, const std::vector<size_t>& values) {
+  writeArray(key, std::vector<uint64_t>(values.begin(), values.end()));
+}
+
+void SceneFileWriter::writeRaw(const std::string& key, SceneFileValueType type, uint32_t components, uint64_t count,
+                               const void* data, size_t nBytes) {
+  if (finished) exception("scene file " + filename + " has already been finished, cannot write " + key);
+
+  // each array starts on an aligned boundary, so it can be used straight from a memory mapping
+  writePadding((sceneFileAlignment - currentOffset % sceneFileAlignment) % sceneFileAlignment);
+
+  entries.push_back(Entry{key, type, components, count, currentOffset});
+  out.write(static_cast<const char*>(data), nBytes);
+  currentOffset += nBytes;
+
+  if (!out) exception("failed writing " + key + " to scene file " + filename);
+}
+
+void SceneFileWriter::writePadding(size_t nBytes) {
+  static const char zeros[sceneFileAlignment] = {};
+  while (nBytes > 0) {
+    size_t n = std::min(nBytes, sceneFileAlignment);
+    out.write(zeros, n);
+    currentOffset += n;
+    nBytes -= n;
+  }
+}
+
+void SceneFileWriter::finish() {
+  if (finished) return;
+  finished = true;
+
+  // == Table of contents
+  writePadding((sceneFileAlignment - currentOffset % sceneFileAlignment) % sceneFileAlignment);
+  uint64_t tocOffset = currentOffset;
+  for (const Entry& entry : entries) {
+    uint32_t keyLength = entry.key.size();
+    uint32_t type = static_cast<uint32_t>(entry.type);
+    out.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+    out.write(entry.key.data(), keyLength);
+    out.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    out.write(reinterpret_cast<const char*>(&entry.components), sizeof(entry.components));
+    out.write(reinterpret_cast<const char*>(&entry.count), sizeof(entry.count));
+    out.write(reinterpret_cast<const char*>(&entry.offset), sizeof(entry.offset));
+    currentOffset += sizeof(keyLength) + keyLength + sizeof(type) + sizeof(entry.components) + sizeof(entry.count) +
+                     sizeof(entry.offset);
+  }
+
+  // == Header
+  SceneFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, sceneFileMagic, sizeof(sceneFileMagic));
+  header.version = sceneFileVersion;
+  header.byteOrderMark = sceneFileByteOrderMark;
+  header.tocOffset = tocOffset;
+  header.tocBytes = currentOffset - tocOffset;
+  header.entryCount = entries.size();
+  out.seekp(0);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  out.close();
+  if (!out) exception("failed writing scene file " + filename);
+}
+
+// =======================================================
+// === Reader
+// =======================================================
+
+SceneFileReader::SceneFileReader(std::string filename_) : filename(filename_), file(filename_) {
+
+  // == Header
+  if (file.size() < sizeof(SceneFileHeader)) exception(filename + " is not a Polyscope scene file (too short)");
+  SceneFileHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, sceneFileMagic, sizeof(sceneFileMagic)) != 0) {
+    exception(filename + " is not a Polyscope scene file");
+  }
+  if (header.byteOrderMark != sceneFileByteOrderMark) {
+    exception("scene file " + filename + " was written on a machine with a different byte order");
+  }
+  version = header.version;
+  if (version > sceneFileVersion) {
+    exception("scene file " + filename + " was written by a newer version of Polyscope (file version " +
+              std::to_string(version) + ", this version reads up to " + std::to_string(sceneFileVersion) + ")");
+  }
+  if (header.tocOffset > file.size() || header.tocBytes > file.size() - header.tocOffset) {
+    exception("scene file " + filename + " is truncated");
+  }
+
+  // == Table of contents
+  const char* toc = file.data() + header.tocOffset;
+  const char* tocEnd = toc + header.tocBytes;
+  auto readTOC = [&](void* dst, size_t nBytes) {
+    if (static_cast<size_t>(tocEnd - toc) < nBytes) exception("scene file " + filename + " is truncated");
+    std::memcpy(dst, toc, nBytes);
+    toc += nBytes;
+  };
+  for (uint64_t iEntry = 0; iEntry < header.entryCount; iEntry++) {
+    uint32_t keyLength;
+    readTOC(&keyLength, sizeof(keyLength));
+    std::string key(keyLength, '\0');
+    readTOC(&key[0], keyLength);
+
+    uint32_t type;
+    Entry entry;
+    readTOC(&type, sizeof(type));
+    readTOC(&entry.components, sizeof(entry.components));
+    readTOC(&entry.count, sizeof(entry.count));
+    readTOC(&entry.offset, sizeof(entry.offset));
+    entry.type = static_cast<SceneFileValueType>(type);
+
+    size_t typeSize = valueTypeSize(entry.type);
+    if (typeSize == 0) exception("scene file " + filename + " entry " + key + " has an unknown type");
+    // (divide rather than multiply, so a corrupt count cannot overflow past the test)
+    uint64_t elementBytes = entry.components * static_cast<uint64_t>(typeSize);
+    if (entry.offset % sceneFileAlignment != 0 || entry.offset > file.size() || elementBytes == 0 ||
+        entry.count > (file.size() - entry.offset) / elementBytes) {
+      exception("scene file " + filename + " entry " + key + " is out of bounds");
+    }
+
+    entries[key] = entry;
+  }
+}
+
+bool SceneFileReader::hasArray(const std::string& key) const { return entries.find(key) != entries.end(); }
+
+std::vector<std::string> SceneFileReader::arrayKeys() const {
+  std::vector<std::string> keys;
+  for (const auto& entry : entries) keys.push_back(entry.first);
+  return keys;
+}
+
+const SceneFileReader::Entry& SceneFileReader::findEntry(const std::string& key, SceneFileValueType type,
+                                                         uint32_t components) const {
+  auto it = entries.find(key);
+  if (it == entries.end()) exception("scene file " + filename + " has no entry " + key);
+  if (it->second.type != type || it->second.components != components) {
+    exception("scene file " + filename + " entry " + key + " does not have the expected type");
+  }
+  return it->second;
+}
+
+std::string SceneFileReader::readString(const std::string& key) const {
+  size_t count;
+  const char* data = arrayData<char>(key, count);
+  return std::string(data, count);
+}
+
+std::vector<size_t> SceneFileReader::readIndexArray(const std::string& key) const {
+  size_t count;
+  const uint64_t* data = arrayData<uint64_t>(key, count);
+  return std::vector<size_t>(data, data + count);
+}
+
+// =======================================================
+// === Quantities
+// =======================================================
+
+void writeSceneFileQuantityCount(SceneFileWriter& writer, const std::string& structurePrefix, size_t count) {
+  writer.writeValue<uint64_t>(structurePrefix + "quantityCount", count);
+}
+
+std::string sceneFileQuantityPrefix(const std::string& structurePrefix, size_t iQuantity) {
+  return structurePrefix + "quantity/" + std::to_string(iQuantity) + "/";
+}
+
+std::vector<double> SceneFileQuantity::readValues() const { return reader.readArray<double>(prefix + "values"); }
+
+DataType SceneFileQuantity::readDataType() const {
+  uint32_t dataType = reader.readValue<uint32_t>(prefix + "dataType");
+  if (dataType > static_cast<uint32_t>(DataType::MAGNITUDE)) {
+    exception("scene file " + reader.filename + " quantity " + name + " has an unknown data type");
+  }
+  return static_cast<DataType>(dataType);
+}
+
+std::vector<glm::vec3> SceneFileQuantity::readColors() const { return reader.readArray<glm::vec3>(prefix + "colors"); }
+
+std::vector<glm::vec3> SceneFileQuantity::readVectors() const {
+  return reader.readArray<glm::vec3>(prefix + "vectors");
+}
+
+VectorType SceneFileQuantity::readVectorType() const {
+  uint32_t vectorType = reader.readValue<uint32_t>(prefix + "vectorType");
+  if (vectorType > static_cast<uint32_t>(VectorType::AMBIENT)) {
+    exception("scene file " + reader.filename + " quantity " + name + " has an unknown vector type");
+  }
+  return static_cast<VectorType>(vectorType);
+}
+
+void SceneFileQuantity::warnUnsupported(const std::string& structureName) const {
+  warning("scene file " + reader.filename + " has quantity " + name + " on " + structureName + " of kind " + kind +
+          ", which cannot be loaded on that structure");
+}
+
+std::vector<SceneFileQuantity> sceneFileQuantities(const SceneFileReader& reader, const std::string& structurePrefix) {
+  std::vector<SceneFileQuantity> quantities;
+  if (!reader.hasArray(structurePrefix + "quantityCount")) return quantities;
+  uint64_t count = reader.readValue<uint64_t>(structurePrefix + "quantityCount");
+  for (size_t iQ = 0; iQ < count; iQ++) {
+    std::string prefix = sceneFileQuantityPrefix(structurePrefix, iQ);
+    quantities.push_back(
+        SceneFileQuantity{reader, prefix, reader.readString(prefix + "kind"), reader.readString(prefix + "name")});
+  }
+  return quantities;
+}
+
+// =======================================================
+// === Scenes
+// =======================================================
+
+void writeSceneFile(std::string filename) {
+  SceneFileWriter writer(filename);
+
+  size_t iStructure = 0;
+  for (auto& typeMap : state::structures) {
+    for (auto& entry : typeMap.second) {
+      Structure* structure = entry.second;
+      std::string prefix = "structure/" + std::to_string(iStructure) + "/";
+
+      if (!structure->writeToSceneFile(writer, prefix)) {
+        warning("scene files cannot hold structures of type " + structure->typeName(),
+                "skipped " + structure->name);
+        continue;
+      }
+
+      writer.writeString(prefix + "type", structure->typeName());
+      writer.writeString(prefix + "name", structure->name);
+      writer.writeValue<uint8_t>(prefix + "enabled", structure->isEnabled());
+      writer.writeValue<glm::mat4>(prefix + "transform", structure->getTransform());
+      iStructure++;
+    }
+  }
+  writer.writeValue<uint64_t>("structureCount", iStructure);
+
+  writer.finish();
+}
+
+void loadSceneFile(std::string filename) {
+  checkInitialized();
+
+  SceneFileReader reader(filename);
+
+  uint64_t nStructures = reader.readValue<uint64_t>("structureCount");
+  for (size_t iStructure = 0; iStructure < nStructures; iStructure++) {
+    std::string prefix = "structure/" + std::to_string(iStructure) + "/";
+    std::string type = reader.readString(prefix + "type");
+    std::string name = reader.readString(prefix + "name");
+
+    Structure* structure = nullptr;
+    if (type == PointCloud::structureTypeName) {
+      structure = PointCloud::createFromSceneFile(reader, prefix, name);
+    } else if (type == SurfaceMesh::structureTypeName) {
+      structure = SurfaceMesh::createFromSceneFile(reader, prefix, name);
+    } else if (type == CurveNetwork::structureTypeName) {
+      structure = CurveNetwork::createFromSceneFile(reader, prefix, name);
+    } else if (type == VolumeMesh::structureTypeName) {
+      structure = VolumeMesh::createFromSceneFile(reader, prefix, name);
+    } else {
+      warning("scene file " + filename + " has a structure of unknown type " + type, "skipped " + name);
+      continue;
+    }
+
+    registerStructure(structure, true);
+    structure->setTransform(reader.readValue<glm::mat4>(prefix + "transform"));
+    structure->setEnabled(reader.readValue<uint8_t>(prefix + "enabled"));
+  }
+}
+
+} // namespace polyscope
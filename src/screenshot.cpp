@@ -2,12 +2,30 @@
 
 #include "polyscope/screenshot.h"
 
+#include "polyscope/parallel.h"
+#include "polyscope/pick.h"
 #include "polyscope/polyscope.h"
 
 #include "stb_image_write.h"
 
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace polyscope {
 
@@ -33,20 +51,14 @@ bool hasExtension(std::string str, std::string ext) {
   }
 }
 
-} // namespace
-
-
-void saveImage(std::string name, unsigned char* buffer, int w, int h, int channels) {
-
-  // our buffers are from openGL, so they are flipped
-  stbi_flip_vertically_on_write(1);
-  stbi_write_png_compression_level = 0;
+// Write an image file, without touching stb's global settings (so it can run on any thread, see setImageWriteOptions())
+bool writeImageFile(const std::string& name, unsigned char* buffer, int w, int h, int channels) {
 
   // Auto-detect filename
   if (hasExtension(name, ".png")) {
-    stbi_write_png(name.c_str(), w, h, channels, buffer, channels * w);
+    return stbi_write_png(name.c_str(), w, h, channels, buffer, channels * w);
   } else if (hasExtension(name, ".jpg") || hasExtension(name, "jpeg")) {
-    stbi_write_jpg(name.c_str(), w, h, channels, buffer, 100);
+    return stbi_write_jpg(name.c_str(), w, h, channels, buffer, 100);
 
     // TGA seems to display different on different machines: our fault or theirs?
     // Both BMP and TGA need alpha channel stripped? bmp doesn't seem to work even with this
@@ -59,11 +71,35 @@ void saveImage(std::string name, unsigned char* buffer, int w, int h, int channe
 
   } else {
     // Fall back on png
-    stbi_write_png(name.c_str(), w, h, channels, buffer, channels * w);
+    return stbi_write_png(name.c_str(), w, h, channels, buffer, channels * w);
   }
 }
 
-void screenshot(std::string filename, bool transparentBG) {
+// stb's write settings are globals which every write reads. They are set once, before the first write (so before any
+// background writer exists), and never assigned again, so they cannot race with writes on other threads.
+void setImageWriteOptions() {
+  static std::once_flag optionsSet;
+  std::call_once(optionsSet, []() {
+    // our buffers are from openGL, so they are flipped
+    stbi_flip_vertically_on_write(1);
+    stbi_write_png_compression_level = 0;
+  });
+}
+
+void setOpaque(std::vector<unsigned char>& buff, int w, int h) {
+  for (int j = 0; j < h; j++) {
+    for (int i = 0; i < w; i++) {
+      int ind = i + j * w;
+      buff[4 * ind + 3] = std::numeric_limits<unsigned char>::max();
+    }
+  }
+}
+
+// Rows per chunk when post-processing images in parallel
+const size_t rowChunkSize = 16;
+
+// Render the current view and read it back as RGBA in to buff
+void renderScreenshot(bool transparentBG, std::vector<unsigned char>& buff, int& w, int& h) {
 
   render::engine->useAltDisplayBuffer = true;
   if (transparentBG) render::engine->lightCopy = true; // copy directly in to buffer without blending
@@ -82,43 +118,660 @@ void screenshot(std::string filename, bool transparentBG) {
   }
 
   // these _should_ always be accurate
-  int w = view::bufferWidth;
-  int h = view::bufferHeight;
-  std::vector<unsigned char> buff = render::engine->displayBufferAlt->readBuffer();
-
-  // Set alpha to 1
-  if (!transparentBG) {
-    for (int j = 0; j < h; j++) {
-      for (int i = 0; i < w; i++) {
-        int ind = i + j * w;
-        buff[4 * ind + 3] = std::numeric_limits<unsigned char>::max();
-      }
-    }
-  }
-
-  // Save to file
-  saveImage(filename, &(buff.front()), w, h, 4);
+  w = view::bufferWidth;
+  h = view::bufferHeight;
+  render::engine->displayBufferAlt->readBuffer(buff);
 
   render::engine->useAltDisplayBuffer = false;
   if (transparentBG) render::engine->lightCopy = false;
 }
 
-void screenshot(bool transparentBG) {
+// Copy an RGBA image read back from openGL, flipping it so the top row comes first
+void copyFlippedRGBA(const unsigned char* src, unsigned char* dst, int w, int h, bool opaque) {
+  size_t rowBytes = 4 * static_cast<size_t>(w);
+  parallelForChunks(h, rowChunkSize, [&](size_t, size_t start, size_t end) {
+    for (size_t j = start; j < end; j++) {
+      const unsigned char* srcRow = src + (h - 1 - j) * rowBytes;
+      unsigned char* dstRow = dst + j * rowBytes;
+      std::copy(srcRow, srcRow + rowBytes, dstRow);
+      if (opaque) {
+        for (size_t i = 0; i < static_cast<size_t>(w); i++) {
+          dstRow[4 * i + 3] = std::numeric_limits<unsigned char>::max();
+        }
+      }
+    }
+  });
+}
 
+std::string nextScreenshotName(bool& transparentBG) {
   char buff[50];
   snprintf(buff, 50, "screenshot_%06zu%s", state::screenshotInd, options::screenshotExtension.c_str());
-  std::string defaultName(buff);
+  state::screenshotInd++;
 
   // only pngs can be written with transparency
   if (!hasExtension(options::screenshotExtension, ".png")) {
     transparentBG = false;
   }
 
+  return std::string(buff);
+}
+
+// === Background writer for screenshotAsync()
+
+struct PendingScreenshot {
+  std::string filename;
+  std::vector<unsigned char> pixels;
+  int w;
+  int h;
+  bool transparentBG;
+};
+
+class ScreenshotWriter {
+public:
+  ~ScreenshotWriter() {
+    // finish any pending writes (but don't throw from here)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobFinished.wait(lock, [&]() { return nPending == 0; });
+      stopping = true;
+    }
+    queueChanged.notify_all();
+    for (std::thread& t : workers) {
+      t.join();
+    }
+  }
+
+  void push(PendingScreenshot&& job) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (workers.empty()) {
+      size_t nWorkers = parallelThreadCount();
+      for (size_t i = 0; i < nWorkers; i++) {
+        workers.emplace_back([this]() { work(); });
+      }
+    }
+
+    // bounded memory: wait for room
+    size_t maxPending = std::max(options::maxPendingScreenshots, 1);
+    jobFinished.wait(lock, [&]() { return nPending < maxPending; });
+
+    queue.push_back(std::move(job));
+    nPending++;
+    queueChanged.notify_one();
+  }
+
+  void flush() {
+    std::vector<std::string> failed;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobFinished.wait(lock, [&]() { return nPending == 0; });
+      std::swap(failed, failedFilenames);
+    }
+    if (!failed.empty()) {
+      exception("failed to write screenshot " + failed.front() + " (and " + std::to_string(failed.size() - 1) +
+                " others)");
+    }
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable queueChanged;
+  std::condition_variable jobFinished;
+  std::deque<PendingScreenshot> queue;
+  size_t nPending = 0; // queued or in progress
+  std::vector<std::string> failedFilenames;
+  std::vector<std::thread> workers;
+  bool stopping = false;
+
+  void work() {
+    while (true) {
+      PendingScreenshot job;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        queueChanged.wait(lock, [&]() { return stopping || !queue.empty(); });
+        if (queue.empty()) return; // stopping
+        job = std::move(queue.front());
+        queue.pop_front();
+      }
+
+      if (!job.transparentBG) {
+        setOpaque(job.pixels, job.w, job.h);
+      }
+      bool success = writeImageFile(job.filename, &(job.pixels.front()), job.w, job.h, 4);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!success) failedFilenames.push_back(job.filename);
+        nPending--;
+      }
+      jobFinished.notify_all();
+    }
+  }
+};
+
+ScreenshotWriter& screenshotWriter() {
+  static ScreenshotWriter writer;
+  return writer;
+}
+
+// === Raw frame streams
+
+// Write all of the data to a file descriptor, retrying on partial writes
+bool writeToFD(int fd, const unsigned char* data, size_t size) {
+  while (size > 0) {
+#ifdef _WIN32
+    int nWritten = _write(fd, data, static_cast<unsigned int>(std::min<size_t>(size, 1 << 30)));
+#else
+    ssize_t nWritten = write(fd, data, size);
+    if (nWritten < 0 && errno == EINTR) continue;
+#endif
+    if (nWritten <= 0) return false;
+    data += nWritten;
+    size -= nWritten;
+  }
+  return true;
+}
+
+class FrameStream {
+public:
+  ~FrameStream() {
+    if (isOpen) close();
+  }
+
+  void open(std::function<bool(const unsigned char*, size_t)> writeFunc_, std::function<void()> closeFunc_,
+            FrameStreamFormat format_, int fps_) {
+    checkCanOpen(fps_);
+    writeFunc = writeFunc_;
+    closeFunc = closeFunc_;
+    format = format_;
+    fps = fps_;
+    w = -1;
+    h = -1;
+    isOpen = true;
+  }
+
+  // Throws if open() would, so callers can check before acquiring anything
+  void checkCanOpen(int fps_) const {
+    if (isOpen) exception("a frame stream is already open, call closeFrameStream() first");
+    if (fps_ <= 0) exception("frame stream fps must be positive");
+  }
+
+  void writeFrame(bool transparentBG) {
+    if (!isOpen) exception("no frame stream is open, call openFrameStream() first");
+
+    int frameW, frameH;
+    renderScreenshot(transparentBG, readback, frameW, frameH);
+
+    if (w == -1) {
+      w = frameW;
+      h = frameH;
+      if (format == FrameStreamFormat::Y4M) {
+        char header[100];
+        int headerLen = snprintf(header, 100, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", w, h, fps);
+        write(reinterpret_cast<unsigned char*>(header), headerLen);
+      }
+    } else if (frameW != w || frameH != h) {
+      exception("frame stream size changed from " + std::to_string(w) + "x" + std::to_string(h) + " to " +
+                std::to_string(frameW) + "x" + std::to_string(frameH) + ", all frames must be the same size");
+    }
+
+    switch (format) {
+    case FrameStreamFormat::RGBA:
+      encodeRGBA(transparentBG);
+      break;
+    case FrameStreamFormat::Y4M:
+      encodeY4M();
+      break;
+    }
+    write(&encoded.front(), encoded.size());
+  }
+
+  void close() {
+    if (!isOpen) exception("no frame stream is open");
+    isOpen = false;
+    if (closeFunc) closeFunc();
+    writeFunc = nullptr;
+    closeFunc = nullptr;
+  }
+
+  bool isOpen = false;
+
+private:
+  std::function<bool(const unsigned char*, size_t)> writeFunc;
+  std::function<void()> closeFunc;
+  FrameStreamFormat format = FrameStreamFormat::RGBA;
+  int fps = 30;
+  int w = -1;
+  int h = -1;
+
+  // reused between frames
+  std::vector<unsigned char> readback;
+  std::vector<unsigned char> encoded;
+
+  void write(const unsigned char* data, size_t size) {
+    if (!writeFunc(data, size)) {
+      exception("failed to write to frame stream");
+    }
+  }
+
+  // In both formats the rows are flipped, since the readback is from openGL
+  void encodeRGBA(bool transparentBG) {
+    encoded.resize(4 * static_cast<size_t>(w) * h);
+    copyFlippedRGBA(&readback.front(), &encoded.front(), w, h, !transparentBG);
+  }
+
+  void encodeY4M() {
+    // "FRAME\n" followed by full-resolution Y, U and V planes
+    const char frameTag[] = "FRAME\n";
+    const size_t tagLen = sizeof(frameTag) - 1;
+    size_t planeSize = static_cast<size_t>(w) * h;
+    encoded.resize(tagLen + 3 * planeSize);
+    std::copy(frameTag, frameTag + tagLen, encoded.begin());
+    unsigned char* yPlane = &encoded[tagLen];
+    unsigned char* uPlane = yPlane + planeSize;
+    unsigned char* vPlane = uPlane + planeSize;
+
+    parallelForChunks(h, rowChunkSize, [&](size_t, size_t start, size_t end) {
+      for (size_t j = start; j < end; j++) {
+        const unsigned char* src = &readback[(h - 1 - j) * 4 * static_cast<size_t>(w)];
+        for (size_t i = 0; i < static_cast<size_t>(w); i++) {
+          // BT.601, limited range
+          int r = src[4 * i + 0];
+          int g = src[4 * i + 1];
+          int b = src[4 * i + 2];
+          size_t ind = j * w + i;
+          yPlane[ind] = static_cast<unsigned char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+          uPlane[ind] = static_cast<unsigned char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+          vPlane[ind] = static_cast<unsigned char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+      }
+    });
+  }
+};
+
+FrameStream& frameStream() {
+  static FrameStream stream;
+  return stream;
+}
+
+// === Offscreen rendering
+
+// Temporarily render at a different size than the window, restoring the window's size when it goes out of scope. The
+// screen buffers follow lazily: draw() resizes them only when they do not match, and they keep the offscreen size until
+// the next frame at the window size. So consecutive offscreen renders at one size reallocate nothing.
+class ScopedBufferSize {
+public:
+  ScopedBufferSize(int w, int h) : oldW(view::bufferWidth), oldH(view::bufferHeight) {
+    view::bufferWidth = w;
+    view::bufferHeight = h;
+  }
+  ~ScopedBufferSize() {
+    view::bufferWidth = oldW;
+    view::bufferHeight = oldH;
+    requestRedraw();
+  }
+
+private:
+  int oldW, oldH;
+};
+
+// Readback buffers for renderToBuffer(), reused between calls
+struct OffscreenReadback {
+  std::vector<unsigned char> color;
+  std::vector<float> depth;
+  std::vector<float> pick;
+};
+
+OffscreenReadback& offscreenReadback() {
+  static OffscreenReadback readback;
+  return readback;
+}
+
+// === Streaming PNG output for screenshotTiled()
+
+// Writes a PNG a few rows at a time. The image data is stored with uncompressed deflate blocks, so nothing but the
+// current rows needs to be in memory, and each call to writeRows() becomes one IDAT chunk.
+class StreamingPNGWriter {
+public:
+  StreamingPNGWriter(std::string filename, int w_, int h_) : file(filename, std::ios::binary), w(w_), h(h_) {
+    if (!file) exception("could not open " + filename + " for writing");
+
+    const unsigned char signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<unsigned char> header;
+    pushBigEndian(header, w);
+    pushBigEndian(header, h);
+    header.push_back(8); // bit depth
+    header.push_back(6); // RGBA
+    header.push_back(0); // compression, filter, interlace: defaults
+    header.push_back(0);
+    header.push_back(0);
+    writeChunk("IHDR", header);
+
+    // zlib stream header: deflate with a 32k window, no dictionary
+    chunkData.push_back(0x78);
+    chunkData.push_back(0x01);
+  }
+
+  // Append rows of RGBA pixels, top to bottom
+  void writeRows(const unsigned char* pixels, int nRows) {
+    size_t rowBytes = 4 * static_cast<size_t>(w);
+
+    // each scanline is prefixed with its filter type (0, none)
+    scanlines.resize(nRows * (rowBytes + 1));
+    for (int j = 0; j < nRows; j++) {
+      unsigned char* dst = &scanlines[j * (rowBytes + 1)];
+      dst[0] = 0;
+      std::copy(pixels + j * rowBytes, pixels + (j + 1) * rowBytes, dst + 1);
+    }
+    adler = adler32(adler, &scanlines.front(), scanlines.size());
+
+    // split in to stored blocks, which hold at most 65535 bytes each
+    const size_t maxBlockSize = 65535;
+    for (size_t start = 0; start < scanlines.size(); start += maxBlockSize) {
+      size_t blockSize = std::min(maxBlockSize, scanlines.size() - start);
+      pushStoredBlockHeader(blockSize, false);
+      chunkData.insert(chunkData.end(), scanlines.begin() + start, scanlines.begin() + start + blockSize);
+    }
+    writeChunk("IDAT", chunkData);
+    chunkData.clear();
+
+    rowsWritten += nRows;
+  }
+
+  void close() {
+    if (rowsWritten != h) exception("PNG stream closed after " + std::to_string(rowsWritten) + " of " +
+                                    std::to_string(h) + " rows");
+
+    // an empty final block ends the deflate stream, followed by the zlib checksum
+    pushStoredBlockHeader(0, true);
+    pushBigEndian(chunkData, adler);
+    writeChunk("IDAT", chunkData);
+    writeChunk("IEND", std::vector<unsigned char>());
+
+    file.close();
+    if (!file) exception("failed to write PNG file");
+  }
+
+private:
+  std::ofstream file;
+  int w, h;
+  int rowsWritten = 0;
+  uint32_t adler = 1;
+  std::vector<unsigned char> scanlines; // reused between calls
+  std::vector<unsigned char> chunkData;
+
+  static void pushBigEndian(std::vector<unsigned char>& data, uint32_t val) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      data.push_back(static_cast<unsigned char>((val >> shift) & 0xFF));
+    }
+  }
+
+  void pushStoredBlockHeader(size_t blockSize, bool isFinal) {
+    chunkData.push_back(isFinal ? 1 : 0);
+    uint16_t len = static_cast<uint16_t>(blockSize);
+    uint16_t nlen = ~len;
+    chunkData.push_back(len & 0xFF);
+    chunkData.push_back(len >> 8);
+    chunkData.push_back(nlen & 0xFF);
+    chunkData.push_back(nlen >> 8);
+  }
+
+  void writeChunk(const char* type, const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> lengthBytes;
+    pushBigEndian(lengthBytes, static_cast<uint32_t>(data.size()));
+    file.write(reinterpret_cast<const char*>(&lengthBytes.front()), 4);
+
+    uint32_t crc = crc32(0xFFFFFFFFu, reinterpret_cast<const unsigned char*>(type), 4);
+    file.write(type, 4);
+    if (!data.empty()) {
+      crc = crc32(crc, &data.front(), data.size());
+      file.write(reinterpret_cast<const char*>(&data.front()), data.size());
+    }
+
+    std::vector<unsigned char> crcBytes;
+    pushBigEndian(crcBytes, crc ^ 0xFFFFFFFFu);
+    file.write(reinterpret_cast<const char*>(&crcBytes.front()), 4);
+  }
+
+  static uint32_t crc32(uint32_t crc, const unsigned char* data, size_t size) {
+    static const std::array<uint32_t, 256> table = []() {
+      std::array<uint32_t, 256> t;
+      for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+          c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        t[i] = c;
+      }
+      return t;
+    }();
+    for (size_t i = 0; i < size; i++) {
+      crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+  }
+
+  static uint32_t adler32(uint32_t adler, const unsigned char* data, size_t size) {
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+    while (size > 0) {
+      // defer the modulo as long as the sums cannot overflow
+      size_t n = std::min<size_t>(size, 5552);
+      for (size_t i = 0; i < n; i++) {
+        a += data[i];
+        b += a;
+      }
+      a %= 65521;
+      b %= 65521;
+      data += n;
+      size -= n;
+    }
+    return (b << 16) | a;
+  }
+};
+
+} // namespace
+
+
+void saveImage(std::string name, unsigned char* buffer, int w, int h, int channels) {
+  setImageWriteOptions();
+  writeImageFile(name, buffer, w, h, channels);
+}
+
+void screenshot(std::string filename, bool transparentBG) {
+
+  int w, h;
+  std::vector<unsigned char> buff;
+  renderScreenshot(transparentBG, buff, w, h);
+
+  // Set alpha to 1
+  if (!transparentBG) {
+    setOpaque(buff, w, h);
+  }
+
+  // Save to file
+  saveImage(filename, &(buff.front()), w, h, 4);
+}
+
+void screenshot(bool transparentBG) {
+  std::string defaultName = nextScreenshotName(transparentBG);
   screenshot(defaultName, transparentBG);
+}
 
-  state::screenshotInd++;
+void screenshotAsync(std::string filename, bool transparentBG) {
+  PendingScreenshot job;
+  job.filename = filename;
+  job.transparentBG = transparentBG;
+  renderScreenshot(transparentBG, job.pixels, job.w, job.h);
+
+  setImageWriteOptions(); // before the first job reaches a worker
+  screenshotWriter().push(std::move(job));
+}
+
+void screenshotAsync(bool transparentBG) {
+  std::string defaultName = nextScreenshotName(transparentBG);
+  screenshotAsync(defaultName, transparentBG);
 }
 
+void flushScreenshots() { screenshotWriter().flush(); }
+
 void resetScreenshotIndex() { state::screenshotInd = 0; }
 
+void renderToBuffer(int width, int height, RenderBufferData& data, bool transparentBG, bool withDepth,
+                    bool withPickInds) {
+  if (width <= 0 || height <= 0) exception("renderToBuffer() size must be positive");
+  size_t nPixels = static_cast<size_t>(width) * height;
+
+  data.width = width;
+  data.height = height;
+  data.color.resize(4 * nPixels);
+  data.depth.resize(withDepth ? nPixels : 0);
+  data.pickInds.resize(withPickInds ? nPixels : 0);
+
+  renderToBuffer(width, height, &data.color.front(), withDepth ? &data.depth.front() : nullptr,
+                 withPickInds ? &data.pickInds.front() : nullptr, transparentBG);
+}
+
+void renderToBuffer(int width, int height, unsigned char* color, float* depth, size_t* pickInds, bool transparentBG) {
+  if (width <= 0 || height <= 0) exception("renderToBuffer() size must be positive");
+
+  OffscreenReadback& readback = offscreenReadback();
+  ScopedBufferSize scopedSize(width, height);
+
+  int w, h;
+  renderScreenshot(transparentBG, readback.color, w, h);
+  if (color) {
+    copyFlippedRGBA(&readback.color.front(), color, w, h, !transparentBG);
+  }
+
+  if (depth) {
+    // the scene buffer is supersampled, take one sample per output pixel
+    render::FrameBuffer* sceneBuffer = render::engine->sceneBuffer.get();
+    sceneBuffer->readDepthBuffer(readback.depth);
+    size_t ssaa = render::engine->getSSAAFactor();
+    size_t sceneW = sceneBuffer->getSizeX();
+    size_t sceneH = sceneBuffer->getSizeY();
+    parallelForChunks(h, rowChunkSize, [&](size_t, size_t start, size_t end) {
+      for (size_t j = start; j < end; j++) {
+        size_t sceneRow = sceneH - 1 - std::min(ssaa * j, sceneH - 1);
+        for (size_t i = 0; i < static_cast<size_t>(w); i++) {
+          size_t sceneCol = std::min(ssaa * i, sceneW - 1);
+          depth[j * w + i] = readback.depth[sceneRow * sceneW + sceneCol];
+        }
+      }
+    });
+  }
+
+  if (pickInds) {
+    if (pick::renderPickBuffer()) {
+      render::engine->pickFramebuffer->readFloat4Buffer(readback.pick);
+      parallelForChunks(h, rowChunkSize, [&](size_t, size_t start, size_t end) {
+        for (size_t j = start; j < end; j++) {
+          const float* src = &readback.pick[4 * (h - 1 - j) * static_cast<size_t>(w)];
+          for (size_t i = 0; i < static_cast<size_t>(w); i++) {
+            pickInds[j * w + i] = pick::vecToInd(glm::vec3{src[4 * i + 0], src[4 * i + 1], src[4 * i + 2]});
+          }
+        }
+      });
+    } else {
+      std::fill(pickInds, pickInds + static_cast<size_t>(w) * h, 0);
+    }
+  }
+}
+
+void renderTiled(int width, int height, std::function<void(const unsigned char*, int, int)> stripCallback,
+                 bool transparentBG, int tileSize) {
+  if (width <= 0 || height <= 0) exception("renderTiled() size must be positive");
+  if (tileSize <= 0) exception("renderTiled() tile size must be positive");
+
+  // Every tile is rendered at the same buffer size, so the buffers are resized only once for the whole image. Tiles on
+  // the right and bottom edges extend past the image, and only the part inside it is kept.
+  int tileW = std::min(tileSize, width);
+  int tileH = std::min(tileSize, height);
+  ScopedBufferSize scopedSize(tileW, tileH);
+
+  std::vector<unsigned char>& tile = offscreenReadback().color;
+  std::vector<unsigned char> strip;
+  size_t stripRowBytes = 4 * static_cast<size_t>(width);
+
+  try {
+    for (int y0 = 0; y0 < height; y0 += tileH) {
+      int th = std::min(tileH, height - y0);
+      strip.resize(stripRowBytes * th);
+
+      for (int x0 = 0; x0 < width; x0 += tileW) {
+        int tw = std::min(tileW, width - x0);
+
+        view::setProjectionTile(width, height, x0, y0, tileW, tileH);
+        int w, h;
+        renderScreenshot(transparentBG, tile, w, h);
+
+        // the readback is from openGL, so the top row of the tile is the last one
+        parallelForChunks(th, rowChunkSize, [&](size_t, size_t start, size_t end) {
+          for (size_t j = start; j < end; j++) {
+            const unsigned char* src = &tile[4 * (h - 1 - j) * static_cast<size_t>(w)];
+            unsigned char* dst = &strip[j * stripRowBytes + 4 * static_cast<size_t>(x0)];
+            std::copy(src, src + 4 * static_cast<size_t>(tw), dst);
+            if (!transparentBG) {
+              for (size_t i = 0; i < static_cast<size_t>(tw); i++) {
+                dst[4 * i + 3] = std::numeric_limits<unsigned char>::max();
+              }
+            }
+          }
+        });
+      }
+      view::clearProjectionTile();
+
+      stripCallback(&strip.front(), y0, th);
+    }
+  } catch (...) {
+    view::clearProjectionTile();
+    throw;
+  }
+}
+
+void screenshotTiled(std::string filename, int width, int height, bool transparentBG, int tileSize) {
+  if (width <= 0 || height <= 0) exception("screenshotTiled() size must be positive");
+  StreamingPNGWriter writer(filename, width, height);
+  renderTiled(
+      width, height, [&](const unsigned char* pixels, int, int nRows) { writer.writeRows(pixels, nRows); },
+      transparentBG, tileSize);
+  writer.close();
+}
+
+void openFrameStream(std::string filename, FrameStreamFormat format, int fps) {
+  frameStream().checkCanOpen(fps); // before opening the file, so it is not leaked
+  std::FILE* file = std::fopen(filename.c_str(), "wb");
+  if (!file) exception("could not open frame stream file " + filename);
+  frameStream().open(
+      [file](const unsigned char* data, size_t size) { return std::fwrite(data, 1, size, file) == size; },
+      [file]() { std::fclose(file); }, format, fps);
+}
+
+void openFrameStreamFD(int fileDescriptor, FrameStreamFormat format, int fps) {
+  if (fileDescriptor < 0) exception("invalid file descriptor for frame stream");
+  frameStream().open([fileDescriptor](const unsigned char* data,
+                                      size_t size) { return writeToFD(fileDescriptor, data, size); },
+                     nullptr, format, fps);
+}
+
+void openFrameStreamCallback(std::function<void(const unsigned char*, size_t)> callback, FrameStreamFormat format,
+                             int fps) {
+  if (!callback) exception("frame stream callback is empty");
+  frameStream().open(
+      [callback](const unsigned char* data, size_t size) {
+        callback(data, size);
+        return true;
+      },
+      nullptr, format, fps);
+}
+
+void writeFrame(bool transparentBG) { frameStream().writeFrame(transparentBG); }
+
+void closeFrameStream() { frameStream().close(); }
+
+bool frameStreamIsOpen() { return frameStream().isOpen; }
+
 } // namespace polyscope
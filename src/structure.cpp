@@ -2,6 +2,7 @@
 
 #include "polyscope/structure.h"
 
+#include "polyscope/bounds.h"
 #include "polyscope/polyscope.h"
 
 #include "imgui.h"
@@ -154,10 +155,33 @@ void Structure::buildCustomOptionsUI() {}
 
 void Structure::refresh() {
   updateObjectSpaceBounds();
+  objectSpaceBoundsStale = false;
   requestRedraw();
 }
 
+void Structure::objectSpaceBoundsChanged() {
+  if (options::deferStructureBounds) {
+    markObjectSpaceBoundsStale();
+  } else {
+    updateObjectSpaceBounds();
+    objectSpaceBoundsStale = false;
+  }
+}
+
+void Structure::markObjectSpaceBoundsStale() {
+  objectSpaceBoundsStale = true;
+  objectSpaceBoundsStaleDraw = internal::drawCount;
+}
+
+void Structure::ensureObjectSpaceBoundsUpdated() {
+  if (objectSpaceBoundsStale) {
+    updateObjectSpaceBounds();
+    objectSpaceBoundsStale = false;
+  }
+}
+
 std::tuple<glm::vec3, glm::vec3> Structure::boundingBox() {
+  ensureObjectSpaceBoundsUpdated();
   const glm::mat4x4& T = objectTransform.get();
   glm::vec4 lh = T * glm::vec4(std::get<0>(objectSpaceBoundingBox), 1.);
   glm::vec3 l = glm::vec3(lh) / lh.w;
@@ -167,6 +191,7 @@ std::tuple<glm::vec3, glm::vec3> Structure::boundingBox() {
 }
 
 float Structure::lengthScale() {
+  ensureObjectSpaceBoundsUpdated();
   // compute the scaling caused by the object transform
   const glm::mat4x4& T = objectTransform.get();
   float transScale = abs(glm::determinant(glm::mat3x3(T))) / T[3][3];
@@ -219,6 +244,38 @@ void Structure::rescaleToUnit() {
 
 bool Structure::hasExtents() { return true; }
 
+bool Structure::objectSpaceBoundsReadyForCulling() {
+  if (objectSpaceBoundsStale) {
+    // marked stale before the previous draw and not since, so the geometry has settled
+    if (internal::drawCount <= objectSpaceBoundsStaleDraw + 1) return false;
+    ensureObjectSpaceBoundsUpdated();
+  }
+  return true;
+}
+
+bool Structure::mayBeInView() {
+  if (!isCullable() || !objectSpaceBoundsReadyForCulling()) return true;
+
+  std::array<glm::vec4, 6> planes =
+      frustumPlanes(view::getCameraPerspectiveMatrix() * view::getCameraViewMatrix());
+  if (!boxMayIntersectFrustum(planes, objectTransform.get(), std::get<0>(objectSpaceBoundingBox),
+                              std::get<1>(objectSpaceBoundingBox), cullingMargin())) {
+    return false;
+  }
+
+  const OcclusionDepthMap* occlusion = internal::currentOcclusionDepthMap();
+  if (occlusion && !boxMayBeUnoccluded(*occlusion, objectTransform.get(), std::get<0>(objectSpaceBoundingBox),
+                                       std::get<1>(objectSpaceBoundingBox), cullingMargin())) {
+    internal::occlusionCulledCount++;
+    return false;
+  }
+  return true;
+}
+
+bool Structure::isCullable() { return false; }
+
+float Structure::cullingMargin() { return 0.; }
+
 glm::mat4 Structure::getModelView() { return view::getCameraViewMatrix() * objectTransform.get(); }
 
 std::vector<std::string> Structure::addStructureRules(std::vector<std::string> initRules) {
@@ -285,6 +342,8 @@ std::string Structure::uniquePrefix() { return typeName() + "#" + name + "#"; }
 
 void Structure::remove() { removeStructure(typeName(), name); }
 
+bool Structure::writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) { return false; }
+
 
 Structure* Structure::setTransparency(float newVal) {
   transparency = newVal;
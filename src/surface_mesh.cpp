@@ -3,15 +3,18 @@
 #include "polyscope/surface_mesh.h"
 
 #include "glm/fwd.hpp"
+#include "polyscope/bounds.h"
 #include "polyscope/combining_hash_functions.h"
 #include "polyscope/pick.h"
 #include "polyscope/polyscope.h"
 #include "polyscope/render/engine.h"
+#include "polyscope/scene_file.h"
 
 #include "imgui.h"
 #include "polyscope/types.h"
 #include "polyscope/utilities.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
 
@@ -63,7 +66,13 @@ backFaceColor(          uniquePrefix() + "backFaceColor",   glm::vec3(1.f - surf
 shadeStyle(             uniquePrefix() + "shadeStyle",      MeshShadeStyle::Flat)
 
 // clang-format on
-{}
+{
+  if (options::compactRenderBuffers) {
+    vertexPositions.setDeviceQuantization(BufferQuantization::UNorm16InBounds);
+    vertexNormals.setDeviceQuantization(BufferQuantization::Octahedral16);
+    faceNormals.setDeviceQuantization(BufferQuantization::Octahedral16);
+  }
+}
 
 SurfaceMesh::SurfaceMesh(std::string name_, const std::vector<glm::vec3>& vertexPositions_,
                          const std::vector<uint32_t>& faceIndsEntries_, const std::vector<uint32_t>& faceIndsStart_)
@@ -74,7 +83,19 @@ SurfaceMesh::SurfaceMesh(std::string name_, const std::vector<glm::vec3>& vertex
   faceIndsStart = faceIndsStart_;
 
   computeConnectivityData();
-  updateObjectSpaceBounds();
+  objectSpaceBoundsChanged();
+}
+
+SurfaceMesh::SurfaceMesh(std::string name_, std::vector<glm::vec3>&& vertexPositions_,
+                         std::vector<uint32_t>&& faceIndsEntries_, std::vector<uint32_t>&& faceIndsStart_)
+    : SurfaceMesh(name_) {
+
+  vertexPositionsData = std::move(vertexPositions_);
+  faceIndsEntries = std::move(faceIndsEntries_);
+  faceIndsStart = std::move(faceIndsStart_);
+
+  computeConnectivityData();
+  objectSpaceBoundsChanged();
 }
 
 SurfaceMesh::SurfaceMesh(std::string name_, const std::vector<glm::vec3>& vertexPositions_,
@@ -85,25 +106,52 @@ SurfaceMesh::SurfaceMesh(std::string name_, const std::vector<glm::vec3>& vertex
   nestedFacesToFlat(facesIn);
 
   computeConnectivityData();
-  updateObjectSpaceBounds();
+  objectSpaceBoundsChanged();
+}
+
+SurfaceMesh* registerSurfaceMeshFlat(std::string name, std::vector<glm::vec3>&& vertexPositions,
+                                     std::vector<uint32_t>&& faceIndsEntries, std::vector<uint32_t>&& faceIndsStart) {
+  checkInitialized();
+
+  SurfaceMesh* s =
+      new SurfaceMesh(name, std::move(vertexPositions), std::move(faceIndsEntries), std::move(faceIndsStart));
+
+  bool success = registerStructure(s);
+  if (!success) {
+    safeDelete(s);
+  }
+
+  return s;
 }
 
 void SurfaceMesh::nestedFacesToFlat(const std::vector<std::vector<size_t>>& nestedInds) {
 
-  faceIndsStart.clear();
-  faceIndsEntries.clear();
-  faceIndsStart.push_back(0);
+  // Size the flat arrays up front, rather than growing them one index at a time
+  faceIndsStart.resize(nestedInds.size() + 1);
+  faceIndsStart[0] = 0;
+  for (size_t iF = 0; iF < nestedInds.size(); iF++) {
+    faceIndsStart[iF + 1] = faceIndsStart[iF] + nestedInds[iF].size();
+  }
 
-  for (const std::vector<size_t>& face : nestedInds) {
-    for (size_t iV : face) {
-      faceIndsEntries.push_back(iV);
-    }
-    faceIndsStart.push_back(faceIndsEntries.size());
+  faceIndsEntries.resize(faceIndsStart.back());
+  for (size_t iF = 0; iF < nestedInds.size(); iF++) {
+    std::copy(nestedInds[iF].begin(), nestedInds[iF].end(), faceIndsEntries.begin() + faceIndsStart[iF]);
   }
 }
 
 void SurfaceMesh::computeConnectivityData() {
 
+  // validate the face starts, which may come straight from the user
+  if (faceIndsStart.empty() || faceIndsStart.front() != 0 || faceIndsStart.back() != faceIndsEntries.size()) {
+    exception("SurfaceMesh " + name +
+              " face start array should begin with 0 and end with the number of face entries");
+  }
+  for (size_t iF = 0; iF + 1 < faceIndsStart.size(); iF++) {
+    if (faceIndsStart[iF + 1] < faceIndsStart[iF] + 3) {
+      exception("SurfaceMesh " + name + " face " + std::to_string(iF) + " has fewer than 3 vertices");
+    }
+  }
+
   // some number-of-elements arithmetic
   size_t numFaces = faceIndsStart.size() - 1;
   nCornersCount = faceIndsEntries.size();
@@ -698,6 +746,8 @@ void SurfaceMesh::draw() {
 
   render::engine->setBackfaceCull(backFacePolicy.get() == BackFacePolicy::Cull);
 
+  updateVisibleDrawRanges();
+
   // If no quantity is drawing the surface, we should draw it
   if (dominantQuantity == nullptr) {
 
@@ -760,6 +810,9 @@ void SurfaceMesh::drawPick() {
 
   // Set uniforms
   setStructureUniforms(*pickProgram);
+  updateVisibleDrawRanges();
+  setVisibleDrawRanges(*pickProgram);
+  vertexPositions.setDequantizeUniforms(*pickProgram);
 
   pickProgram->draw();
 
@@ -1002,11 +1055,20 @@ std::vector<std::string> SurfaceMesh::addSurfaceMeshRules(std::vector<std::strin
     if (wantsCullPosition()) {
       initRules.push_back("MESH_PROPAGATE_CULLPOS");
     }
+
+    initRules = vertexPositions.addDequantizeRules(initRules);
+    if (getShadeStyle() == MeshShadeStyle::Smooth) {
+      initRules = vertexNormals.addDequantizeRules(initRules);
+    } else {
+      initRules = faceNormals.addDequantizeRules(initRules);
+    }
   }
   return initRules;
 }
 
 void SurfaceMesh::setSurfaceMeshUniforms(render::ShaderProgram& p) {
+  setVisibleDrawRanges(p);
+  vertexPositions.setDequantizeUniforms(p);
   if (getEdgeWidth() > 0) {
     p.setUniform("u_edgeWidth", getEdgeWidth() * render::engine->getCurrentPixelScaling());
     p.setUniform("u_edgeColor", getEdgeColor());
@@ -1299,26 +1361,202 @@ void SurfaceMesh::refresh() {
   QuantityStructure<SurfaceMesh>::refresh(); // call base class version, which refreshes quantities
 }
 
+bool SurfaceMesh::writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) {
+
+  // == Geometry and connectivity, with the triangulation computed from it on construction
+  writeBufferToSceneFile(writer, prefix + "vertexPositions", vertexPositions);
+  writer.writeArray(prefix + "faceIndsStart", faceIndsStart);
+  writer.writeArray(prefix + "faceIndsEntries", faceIndsEntries);
+  writeBufferToSceneFile(writer, prefix + "triangleVertexInds", triangleVertexInds);
+  writeBufferToSceneFile(writer, prefix + "triangleFaceInds", triangleFaceInds);
+  writeBufferToSceneFile(writer, prefix + "baryCoord", baryCoord);
+  writeBufferToSceneFile(writer, prefix + "edgeIsReal", edgeIsReal);
+
+  // == Indexing conventions
+  writer.writeIndexArray(prefix + "edgePerm", edgePerm);
+  writer.writeIndexArray(prefix + "halfedgePerm", halfedgePerm);
+  writer.writeIndexArray(prefix + "cornerPerm", cornerPerm);
+  writer.writeValue<uint64_t>(prefix + "edgeDataSize", edgeDataSize);
+  writer.writeValue<uint64_t>(prefix + "halfedgeDataSize", halfedgeDataSize);
+  writer.writeValue<uint64_t>(prefix + "cornerDataSize", cornerDataSize);
+  writer.writeValue<uint64_t>(prefix + "nEdgesCount", nEdgesCount);
+  writer.writeArray(prefix + "elementsUsed",
+                    std::vector<uint8_t>{edgesHaveBeenUsed, halfedgesHaveBeenUsed, cornersHaveBeenUsed});
+
+  // == Connectivity and geometry which is computed lazily, if it has been computed
+  if (!twinHalfedge.empty()) writer.writeIndexArray(prefix + "twinHalfedge", twinHalfedge);
+  if (!halfedgeEdgeCorrespondence.empty()) {
+    writer.writeArray(prefix + "halfedgeEdgeCorrespondence", halfedgeEdgeCorrespondence);
+  }
+  writeComputedBufferToSceneFile(writer, prefix + "triangleCornerInds", triangleCornerInds);
+  writeComputedBufferToSceneFile(writer, prefix + "triangleAllEdgeInds", triangleAllEdgeInds);
+  writeComputedBufferToSceneFile(writer, prefix + "triangleAllHalfedgeInds", triangleAllHalfedgeInds);
+  writeComputedBufferToSceneFile(writer, prefix + "triangleAllCornerInds", triangleAllCornerInds);
+  writeComputedBufferToSceneFile(writer, prefix + "faceNormals", faceNormals);
+  writeComputedBufferToSceneFile(writer, prefix + "faceCenters", faceCenters);
+  writeComputedBufferToSceneFile(writer, prefix + "faceAreas", faceAreas);
+  writeComputedBufferToSceneFile(writer, prefix + "vertexNormals", vertexNormals);
+  writeComputedBufferToSceneFile(writer, prefix + "vertexAreas", vertexAreas);
+  writeComputedBufferToSceneFile(writer, prefix + "defaultFaceTangentBasisX", defaultFaceTangentBasisX);
+  writeComputedBufferToSceneFile(writer, prefix + "defaultFaceTangentBasisY", defaultFaceTangentBasisY);
+
+  // == Quantities
+  size_t iQ = 0;
+  for (auto& entry : quantities) {
+    std::string qPrefix = sceneFileQuantityPrefix(prefix, iQ);
+    Quantity& q = *entry.second;
+    if (writeScalarQuantityToSceneFile<SurfaceVertexScalarQuantity>(writer, qPrefix, "vertexScalar", q) ||
+        writeScalarQuantityToSceneFile<SurfaceFaceScalarQuantity>(writer, qPrefix, "faceScalar", q) ||
+        writeColorQuantityToSceneFile<SurfaceVertexColorQuantity>(writer, qPrefix, "vertexColor", q) ||
+        writeColorQuantityToSceneFile<SurfaceFaceColorQuantity>(writer, qPrefix, "faceColor", q) ||
+        writeVectorQuantityToSceneFile<SurfaceVertexVectorQuantity>(writer, qPrefix, "vertexVector", q) ||
+        writeVectorQuantityToSceneFile<SurfaceFaceVectorQuantity>(writer, qPrefix, "faceVector", q)) {
+      iQ++;
+    } else {
+      warning("scene files cannot hold this kind of quantity", "skipped " + q.name + " on surface mesh " + name);
+    }
+  }
+  writeSceneFileQuantityCount(writer, prefix, iQ);
+
+  return true;
+}
+
+SurfaceMesh* SurfaceMesh::createFromSceneFile(const SceneFileReader& reader, const std::string& prefix,
+                                              std::string name) {
+  std::unique_ptr<SurfaceMesh> mesh(new SurfaceMesh(name));
+
+  // == Geometry and connectivity
+  // (this takes the place of computeConnectivityData())
+  readBufferFromSceneFile(reader, prefix + "vertexPositions", mesh->vertexPositions);
+  reader.readArray(prefix + "faceIndsStart", mesh->faceIndsStart);
+  reader.readArray(prefix + "faceIndsEntries", mesh->faceIndsEntries);
+  readBufferFromSceneFile(reader, prefix + "triangleVertexInds", mesh->triangleVertexInds);
+  readBufferFromSceneFile(reader, prefix + "triangleFaceInds", mesh->triangleFaceInds);
+  readBufferFromSceneFile(reader, prefix + "baryCoord", mesh->baryCoord);
+  readBufferFromSceneFile(reader, prefix + "edgeIsReal", mesh->edgeIsReal);
+
+  if (mesh->faceIndsStart.empty() || mesh->faceIndsStart.back() != mesh->faceIndsEntries.size()) {
+    exception("scene file " + reader.filename + " has inconsistent faces for surface mesh " + name);
+  }
+  mesh->nCornersCount = mesh->faceIndsEntries.size();
+  mesh->nFacesTriangulationCount = mesh->nCornersCount - 2 * mesh->nFaces();
+  size_t nTriCorners = 3 * mesh->nFacesTriangulation();
+  if (mesh->triangleVertexInds.data.size() != nTriCorners || mesh->triangleFaceInds.data.size() != nTriCorners ||
+      mesh->baryCoord.data.size() != nTriCorners || mesh->edgeIsReal.data.size() != nTriCorners) {
+    exception("scene file " + reader.filename + " has an inconsistent triangulation for surface mesh " + name);
+  }
+
+  // == Indexing conventions
+  mesh->edgePerm = reader.readIndexArray(prefix + "edgePerm");
+  mesh->halfedgePerm = reader.readIndexArray(prefix + "halfedgePerm");
+  mesh->cornerPerm = reader.readIndexArray(prefix + "cornerPerm");
+  mesh->vertexDataSize = mesh->nVertices();
+  mesh->faceDataSize = mesh->nFaces();
+  mesh->edgeDataSize = reader.readValue<uint64_t>(prefix + "edgeDataSize");
+  mesh->halfedgeDataSize = reader.readValue<uint64_t>(prefix + "halfedgeDataSize");
+  mesh->cornerDataSize = reader.readValue<uint64_t>(prefix + "cornerDataSize");
+  mesh->nEdgesCount = reader.readValue<uint64_t>(prefix + "nEdgesCount");
+  std::vector<uint8_t> elementsUsed = reader.readArray<uint8_t>(prefix + "elementsUsed");
+  if (elementsUsed.size() == 3) {
+    mesh->edgesHaveBeenUsed = elementsUsed[0];
+    mesh->halfedgesHaveBeenUsed = elementsUsed[1];
+    mesh->cornersHaveBeenUsed = elementsUsed[2];
+  }
+
+  // == Lazily-computed connectivity and geometry
+  if (reader.hasArray(prefix + "twinHalfedge")) mesh->twinHalfedge = reader.readIndexArray(prefix + "twinHalfedge");
+  reader.readArrayIfPresent(prefix + "halfedgeEdgeCorrespondence", mesh->halfedgeEdgeCorrespondence);
+  readComputedBufferFromSceneFile(reader, prefix + "triangleCornerInds", mesh->triangleCornerInds);
+  readComputedBufferFromSceneFile(reader, prefix + "triangleAllEdgeInds", mesh->triangleAllEdgeInds);
+  readComputedBufferFromSceneFile(reader, prefix + "triangleAllHalfedgeInds", mesh->triangleAllHalfedgeInds);
+  readComputedBufferFromSceneFile(reader, prefix + "triangleAllCornerInds", mesh->triangleAllCornerInds);
+  readComputedBufferFromSceneFile(reader, prefix + "faceNormals", mesh->faceNormals);
+  readComputedBufferFromSceneFile(reader, prefix + "faceCenters", mesh->faceCenters);
+  readComputedBufferFromSceneFile(reader, prefix + "faceAreas", mesh->faceAreas);
+  readComputedBufferFromSceneFile(reader, prefix + "vertexNormals", mesh->vertexNormals);
+  readComputedBufferFromSceneFile(reader, prefix + "vertexAreas", mesh->vertexAreas);
+  readComputedBufferFromSceneFile(reader, prefix + "defaultFaceTangentBasisX", mesh->defaultFaceTangentBasisX);
+  readComputedBufferFromSceneFile(reader, prefix + "defaultFaceTangentBasisY", mesh->defaultFaceTangentBasisY);
+
+  mesh->objectSpaceBoundsChanged();
+
+  // == Quantities
+  for (const SceneFileQuantity& q : sceneFileQuantities(reader, prefix)) {
+    if (q.kind == "vertexScalar") {
+      q.restoreScalar(mesh->addVertexScalarQuantityImpl(q.name, q.readValues(), q.readDataType()));
+    } else if (q.kind == "faceScalar") {
+      q.restoreScalar(mesh->addFaceScalarQuantityImpl(q.name, q.readValues(), q.readDataType()));
+    } else if (q.kind == "vertexColor") {
+      q.restore(mesh->addVertexColorQuantityImpl(q.name, q.readColors()));
+    } else if (q.kind == "faceColor") {
+      q.restore(mesh->addFaceColorQuantityImpl(q.name, q.readColors()));
+    } else if (q.kind == "vertexVector") {
+      q.restore(mesh->addVertexVectorQuantityImpl(q.name, q.readVectors(), q.readVectorType()));
+    } else if (q.kind == "faceVector") {
+      q.restore(mesh->addFaceVectorQuantityImpl(q.name, q.readVectors(), q.readVectorType()));
+    } else {
+      q.warnUnsupported(name);
+    }
+  }
+
+  return mesh.release();
+}
+
 void SurfaceMesh::updateObjectSpaceBounds() {
 
   vertexPositions.ensureHostBufferPopulated();
+  computePointBounds(vertexPositions.data, objectSpaceBoundingBox, objectSpaceLengthScale);
+  cullingBlockBoxesStale = true;
+}
+
+bool SurfaceMesh::isCullable() { return quantitiesStayWithinBounds(); }
+
+namespace {
+const size_t meshCullingBlockTriangles = 1024;
+}
+
+void SurfaceMesh::updateVisibleDrawRanges() {
+  useVisibleDrawRanges = false;
+
+  // Block culling only touches the programs which draw the surface itself, so other quantities don't matter here
+  if (!options::enableViewCulling || nFacesTriangulation() <= meshCullingBlockTriangles) return;
+  if (!objectSpaceBoundsReadyForCulling()) return; // a stale bounds recompute also marks the block boxes stale
+  size_t blockSize = 3 * meshCullingBlockTriangles; // in triangle corners
+  if (cullingBlockBoxesStale) {
+    triangleVertexInds.ensureHostBufferPopulated();
+    computeIndexedBlockBounds(vertexPositions.data, triangleVertexInds.data, blockSize, cullingBlockBoxes);
+    cullingBlockBoxesStale = false;
+  }
 
-  // bounding box
-  glm::vec3 min = glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
-  glm::vec3 max = -glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
-  for (const glm::vec3& p : vertexPositions.data) {
-    min = componentwiseMin(min, p);
-    max = componentwiseMax(max, p);
+  std::array<glm::vec4, 6> planes =
+      frustumPlanes(view::getCameraPerspectiveMatrix() * view::getCameraViewMatrix());
+  const glm::mat4& T = objectTransform.get();
+  const OcclusionDepthMap* occlusion = internal::currentOcclusionDepthMap();
+
+  std::vector<size_t> visibleBlocks;
+  for (size_t iBlock = 0; iBlock < cullingBlockBoxes.size(); iBlock++) {
+    if (boxMayIntersectFrustum(planes, T, std::get<0>(cullingBlockBoxes[iBlock]),
+                               std::get<1>(cullingBlockBoxes[iBlock]))) {
+      if (occlusion && !boxMayBeUnoccluded(*occlusion, T, std::get<0>(cullingBlockBoxes[iBlock]),
+                                           std::get<1>(cullingBlockBoxes[iBlock]))) {
+        internal::occlusionCulledCount++;
+        continue;
+      }
+      visibleBlocks.push_back(iBlock);
+    }
   }
-  objectSpaceBoundingBox = std::make_tuple(min, max);
+  if (visibleBlocks.size() == cullingBlockBoxes.size()) return;
 
-  // length scale, as twice the radius from the center of the bounding box
-  glm::vec3 center = 0.5f * (min + max);
-  float lengthScale = 0.0;
-  for (const glm::vec3& p : vertexPositions.data) {
-    lengthScale = std::max(lengthScale, glm::length2(p - center));
+  visibleDrawRanges = blockIndicesToRanges(visibleBlocks, blockSize, 3 * nFacesTriangulation());
+  useVisibleDrawRanges = true;
+}
+
+void SurfaceMesh::setVisibleDrawRanges(render::ShaderProgram& p) {
+  if (useVisibleDrawRanges) {
+    p.setDrawRanges(visibleDrawRanges);
+  } else {
+    p.clearDrawRanges();
   }
-  objectSpaceLengthScale = 2 * std::sqrt(lengthScale);
 }
 
 std::string SurfaceMesh::typeName() { return structureTypeName; }
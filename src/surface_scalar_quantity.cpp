@@ -62,11 +62,7 @@ SurfaceVertexScalarQuantity::SurfaceVertexScalarQuantity(std::string name, const
                                                          SurfaceMesh& mesh_, DataType dataType_)
     : SurfaceScalarQuantity(name, mesh_, "vertex", values_, dataType_)
 
-{
-  values.ensureHostBufferPopulated();
-  parent.vertexAreas.ensureHostBufferPopulated();
-  hist.buildHistogram(values.data); // rebuild to incorporate weights
-}
+{}
 
 void SurfaceVertexScalarQuantity::createProgram() {
   // Create the program to draw this quantity
@@ -94,11 +90,7 @@ SurfaceFaceScalarQuantity::SurfaceFaceScalarQuantity(std::string name, const std
                                                      SurfaceMesh& mesh_, DataType dataType_)
     : SurfaceScalarQuantity(name, mesh_, "face", values_, dataType_)
 
-{
-  values.ensureHostBufferPopulated();
-  parent.faceAreas.ensureHostBufferPopulated();
-  hist.buildHistogram(values.data); // rebuild to incorporate weights
-}
+{}
 
 void SurfaceFaceScalarQuantity::createProgram() {
   // Create the program to draw this quantity
@@ -129,10 +121,7 @@ SurfaceEdgeScalarQuantity::SurfaceEdgeScalarQuantity(std::string name, const std
                                                      SurfaceMesh& mesh_, DataType dataType_)
     : SurfaceScalarQuantity(name, mesh_, "edge", values_, dataType_)
 
-{
-  values.ensureHostBufferPopulated();
-  hist.buildHistogram(values.data); // rebuild to incorporate weights
-}
+{}
 
 void SurfaceEdgeScalarQuantity::createProgram() {
   // Create the program to draw this quantity
@@ -161,10 +150,7 @@ SurfaceHalfedgeScalarQuantity::SurfaceHalfedgeScalarQuantity(std::string name, c
                                                              SurfaceMesh& mesh_, DataType dataType_)
     : SurfaceScalarQuantity(name, mesh_, "halfedge", values_, dataType_)
 
-{
-  values.ensureHostBufferPopulated();
-  hist.buildHistogram(values.data);
-}
+{}
 
 void SurfaceHalfedgeScalarQuantity::createProgram() {
   // Create the program to draw this quantity
@@ -192,10 +178,7 @@ SurfaceCornerScalarQuantity::SurfaceCornerScalarQuantity(std::string name, const
                                                          SurfaceMesh& mesh_, DataType dataType_)
     : SurfaceScalarQuantity(name, mesh_, "corner", values_, dataType_)
 
-{
-  values.ensureHostBufferPopulated();
-  hist.buildHistogram(values.data);
-}
+{}
 
 void SurfaceCornerScalarQuantity::createProgram() {
   // Create the program to draw this quantity
@@ -17,6 +17,8 @@ namespace polyscope {
 SurfaceVectorQuantity::SurfaceVectorQuantity(std::string name, SurfaceMesh& mesh_, MeshElement definedOn_)
     : SurfaceMeshQuantity(name, mesh_) {}
 
+bool SurfaceVectorQuantity::drawsOutsideStructureBounds() { return true; }
+
 
 // ========================================================
 // ==========           Vertex Vector            ==========
@@ -44,6 +44,12 @@ glm::dualquat flightTargetViewR, flightInitialViewR;
 glm::vec3 flightTargetViewT, flightInitialViewT;
 float flightTargetFov, flightInitialFov;
 
+// Projection tile, see setProjectionTile()
+namespace {
+bool useProjectionTile = false;
+int tileFullWidth, tileFullHeight, tileX, tileY, tileWidth, tileHeight;
+} // namespace
+
 
 // Small helpers
 std::string to_string(ProjectionMode mode) {
@@ -349,7 +355,7 @@ void setViewToCamera(const CameraParameters& p) {
 }
 
 CameraParameters getCameraParametersForCurrentView() {
-  double aspectRatio = (float)bufferWidth / bufferHeight;
+  double aspectRatio = useProjectionTile ? (float)tileFullWidth / tileFullHeight : (float)bufferWidth / bufferHeight;
   return CameraParameters(CameraIntrinsics::fromFoVDegVerticalAndAspect(fov, aspectRatio),
                           CameraExtrinsics::fromMatrix(viewMat));
 }
@@ -360,22 +366,54 @@ glm::mat4 getCameraPerspectiveMatrix() {
   double farClip = farClipRatio * state::lengthScale;
   double nearClip = nearClipRatio * state::lengthScale;
   double fovRad = glm::radians(fov);
-  double aspectRatio = (float)bufferWidth / bufferHeight;
+  double aspectRatio = useProjectionTile ? (float)tileFullWidth / tileFullHeight : (float)bufferWidth / bufferHeight;
+
+  glm::mat4 projMat(1.0f);
   switch (projectionMode) {
   case ProjectionMode::Perspective: {
-    return glm::perspective(fovRad, aspectRatio, nearClip, farClip);
+    projMat = glm::perspective(fovRad, aspectRatio, nearClip, farClip);
     break;
   }
   case ProjectionMode::Orthographic: {
     double vert = tan(fovRad / 2.) * state::lengthScale * 2.;
     double horiz = vert * aspectRatio;
-    return glm::ortho(-horiz, horiz, -vert, vert, nearClip, farClip);
+    projMat = glm::ortho(-horiz, horiz, -vert, vert, nearClip, farClip);
     break;
   }
   }
-  return glm::mat4(1.0f); // unreachable
+
+  if (useProjectionTile) {
+    // map the tile's range of normalized device coordinates to [-1,1]
+    float xMin = -1.f + 2.f * tileX / tileFullWidth;
+    float xMax = -1.f + 2.f * (tileX + tileWidth) / tileFullWidth;
+    float yMax = 1.f - 2.f * tileY / tileFullHeight;
+    float yMin = 1.f - 2.f * (tileY + tileHeight) / tileFullHeight;
+    glm::mat4 tileMat(1.0f);
+    tileMat[0][0] = 2.f / (xMax - xMin);
+    tileMat[1][1] = 2.f / (yMax - yMin);
+    tileMat[3][0] = -(xMax + xMin) / (xMax - xMin);
+    tileMat[3][1] = -(yMax + yMin) / (yMax - yMin);
+    projMat = tileMat * projMat;
+  }
+
+  return projMat;
 }
 
+void setProjectionTile(int fullWidth, int fullHeight, int tileX_, int tileY_, int tileWidth_, int tileHeight_) {
+  if (fullWidth <= 0 || fullHeight <= 0 || tileWidth_ <= 0 || tileHeight_ <= 0) {
+    exception("projection tile sizes must be positive");
+  }
+  useProjectionTile = true;
+  tileFullWidth = fullWidth;
+  tileFullHeight = fullHeight;
+  tileX = tileX_;
+  tileY = tileY_;
+  tileWidth = tileWidth_;
+  tileHeight = tileHeight_;
+}
+
+void clearProjectionTile() { useProjectionTile = false; }
+
 
 glm::vec3 getCameraWorldPosition() {
   // This will work no matter how the view matrix is constructed...
@@ -2,11 +2,13 @@
 
 #include "polyscope/volume_mesh.h"
 
+#include "polyscope/bounds.h"
 #include "polyscope/color_management.h"
 #include "polyscope/combining_hash_functions.h"
 #include "polyscope/pick.h"
 #include "polyscope/polyscope.h"
 #include "polyscope/render/engine.h"
+#include "polyscope/scene_file.h"
 #include "polyscope/utilities.h"
 #include "polyscope/volume_mesh_quantity.h"
 
@@ -95,8 +97,7 @@ const std::vector<std::vector<std::array<size_t, 3>>> VolumeMesh::stencilHex =
  };
 // clang-format on
 
-VolumeMesh::VolumeMesh(std::string name, const std::vector<glm::vec3>& vertexPositions_,
-                       const std::vector<std::array<uint32_t, 8>>& cellIndices_)
+VolumeMesh::VolumeMesh(std::string name)
     : QuantityStructure<VolumeMesh>(name, typeName()),
       // clang-format off
 
@@ -119,11 +120,6 @@ faceType(               uniquePrefix() + "faceType",            faceTypeData),
 faceNormals(            uniquePrefix() + "faceNormals",         faceNormalsData,        std::bind(&VolumeMesh::computeFaceNormals, this)),
 cellCenters(            uniquePrefix() + "cellCenters",         cellCentersData,        std::bind(&VolumeMesh::computeCellCenters, this)),         
 
-
-// == core input data
-cells(cellIndices_),
-vertexPositionsData(vertexPositions_), 
-
 // == persistent options
 color(uniquePrefix() + "color", getNextUniqueColor()),
 interiorColor(uniquePrefix() + "interiorColor", color.get()),
@@ -142,10 +138,30 @@ activeLevelSetQuantity(nullptr)
   glm::vec3 desatColorHSV = RGBtoHSV(color.get());
   desatColorHSV.y *= 0.3;
   interiorColor.setPassive(HSVtoRGB(desatColorHSV));
+}
+
+VolumeMesh::VolumeMesh(std::string name, const std::vector<glm::vec3>& vertexPositions_,
+                       const std::vector<std::array<uint32_t, 8>>& cellIndices_)
+    : VolumeMesh(name) {
+
+  cells = cellIndices_;
+  vertexPositionsData = vertexPositions_;
 
   computeCounts();
   computeConnectivityData();
-  updateObjectSpaceBounds();
+  objectSpaceBoundsChanged();
+}
+
+VolumeMesh::VolumeMesh(std::string name, std::vector<glm::vec3>&& vertexPositions_,
+                       std::vector<std::array<uint32_t, 8>>&& cellIndices_)
+    : VolumeMesh(name) {
+
+  cells = std::move(cellIndices_);
+  vertexPositionsData = std::move(vertexPositions_);
+
+  computeCounts();
+  computeConnectivityData();
+  objectSpaceBoundsChanged();
 }
 
 void VolumeMesh::computeCounts() {
@@ -907,6 +923,99 @@ void VolumeMesh::refresh() {
   QuantityStructure<VolumeMesh>::refresh(); // call base class version, which refreshes quantities
 }
 
+bool VolumeMesh::writeToSceneFile(SceneFileWriter& writer, const std::string& prefix) {
+
+  // == Geometry and connectivity, with the split triangulation computed from it on construction
+  writeBufferToSceneFile(writer, prefix + "vertexPositions", vertexPositions);
+  writer.writeArray(prefix + "cells", cells);
+  writer.writeArray(prefix + "faceIsInterior", faceIsInterior);
+  writeBufferToSceneFile(writer, prefix + "triangleVertexInds", triangleVertexInds);
+  writeBufferToSceneFile(writer, prefix + "triangleFaceInds", triangleFaceInds);
+  writeBufferToSceneFile(writer, prefix + "triangleCellInds", triangleCellInds);
+  writeBufferToSceneFile(writer, prefix + "baryCoord", baryCoord);
+  writeBufferToSceneFile(writer, prefix + "edgeIsReal", edgeIsReal);
+  writeBufferToSceneFile(writer, prefix + "faceType", faceType);
+
+  // == Connectivity and geometry which is computed lazily, if it has been computed
+  if (!tets.empty()) writer.writeArray(prefix + "tets", tets);
+  writeComputedBufferToSceneFile(writer, prefix + "faceNormals", faceNormals);
+  writeComputedBufferToSceneFile(writer, prefix + "cellCenters", cellCenters);
+
+  // == Quantities
+  size_t iQ = 0;
+  for (auto& entry : quantities) {
+    std::string qPrefix = sceneFileQuantityPrefix(prefix, iQ);
+    Quantity& q = *entry.second;
+    if (writeScalarQuantityToSceneFile<VolumeMeshVertexScalarQuantity>(writer, qPrefix, "vertexScalar", q) ||
+        writeScalarQuantityToSceneFile<VolumeMeshCellScalarQuantity>(writer, qPrefix, "cellScalar", q) ||
+        writeColorQuantityToSceneFile<VolumeMeshVertexColorQuantity>(writer, qPrefix, "vertexColor", q) ||
+        writeColorQuantityToSceneFile<VolumeMeshCellColorQuantity>(writer, qPrefix, "cellColor", q) ||
+        writeVectorQuantityToSceneFile<VolumeMeshVertexVectorQuantity>(writer, qPrefix, "vertexVector", q) ||
+        writeVectorQuantityToSceneFile<VolumeMeshCellVectorQuantity>(writer, qPrefix, "cellVector", q)) {
+      iQ++;
+    } else {
+      warning("scene files cannot hold this kind of quantity", "skipped " + q.name + " on volume mesh " + name);
+    }
+  }
+  writeSceneFileQuantityCount(writer, prefix, iQ);
+
+  return true;
+}
+
+VolumeMesh* VolumeMesh::createFromSceneFile(const SceneFileReader& reader, const std::string& prefix,
+                                            std::string name) {
+  std::unique_ptr<VolumeMesh> mesh(new VolumeMesh(name));
+
+  // == Geometry and connectivity
+  // (this takes the place of computeCounts() and computeConnectivityData())
+  readBufferFromSceneFile(reader, prefix + "vertexPositions", mesh->vertexPositions);
+  reader.readArray(prefix + "cells", mesh->cells);
+  reader.readArray(prefix + "faceIsInterior", mesh->faceIsInterior);
+  readBufferFromSceneFile(reader, prefix + "triangleVertexInds", mesh->triangleVertexInds);
+  readBufferFromSceneFile(reader, prefix + "triangleFaceInds", mesh->triangleFaceInds);
+  readBufferFromSceneFile(reader, prefix + "triangleCellInds", mesh->triangleCellInds);
+  readBufferFromSceneFile(reader, prefix + "baryCoord", mesh->baryCoord);
+  readBufferFromSceneFile(reader, prefix + "edgeIsReal", mesh->edgeIsReal);
+  readBufferFromSceneFile(reader, prefix + "faceType", mesh->faceType);
+
+  mesh->nFacesCount = mesh->faceIsInterior.size();
+  mesh->nFacesTriangulationCount = mesh->triangleVertexInds.data.size() / 3;
+  size_t nTriCorners = 3 * mesh->nFacesTriangulation();
+  if (mesh->triangleVertexInds.data.size() != nTriCorners || mesh->triangleFaceInds.data.size() != nTriCorners ||
+      mesh->triangleCellInds.data.size() != nTriCorners || mesh->baryCoord.data.size() != nTriCorners ||
+      mesh->edgeIsReal.data.size() != nTriCorners || mesh->faceType.data.size() != mesh->nFaces()) {
+    exception("scene file " + reader.filename + " has an inconsistent triangulation for volume mesh " + name);
+  }
+
+  // == Lazily-computed connectivity and geometry
+  reader.readArrayIfPresent(prefix + "tets", mesh->tets);
+  readComputedBufferFromSceneFile(reader, prefix + "faceNormals", mesh->faceNormals);
+  readComputedBufferFromSceneFile(reader, prefix + "cellCenters", mesh->cellCenters);
+
+  mesh->objectSpaceBoundsChanged();
+
+  // == Quantities
+  for (const SceneFileQuantity& q : sceneFileQuantities(reader, prefix)) {
+    if (q.kind == "vertexScalar") {
+      q.restoreScalar(mesh->addVertexScalarQuantityImpl(q.name, q.readValues(), q.readDataType()));
+    } else if (q.kind == "cellScalar") {
+      q.restoreScalar(mesh->addCellScalarQuantityImpl(q.name, q.readValues(), q.readDataType()));
+    } else if (q.kind == "vertexColor") {
+      q.restore(mesh->addVertexColorQuantityImpl(q.name, q.readColors()));
+    } else if (q.kind == "cellColor") {
+      q.restore(mesh->addCellColorQuantityImpl(q.name, q.readColors()));
+    } else if (q.kind == "vertexVector") {
+      q.restore(mesh->addVertexVectorQuantityImpl(q.name, q.readVectors(), q.readVectorType()));
+    } else if (q.kind == "cellVector") {
+      q.restore(mesh->addCellVectorQuantityImpl(q.name, q.readVectors(), q.readVectorType()));
+    } else {
+      q.warnUnsupported(name);
+    }
+  }
+
+  return mesh.release();
+}
+
 void VolumeMesh::geometryChanged() {
   recomputeGeometryIfPopulated();
   requestRedraw();
@@ -930,25 +1039,11 @@ VolumeCellType VolumeMesh::cellType(size_t i) const {
 void VolumeMesh::updateObjectSpaceBounds() {
 
   vertexPositions.ensureHostBufferPopulated();
-
-  // bounding box
-  glm::vec3 min = glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
-  glm::vec3 max = -glm::vec3{1, 1, 1} * std::numeric_limits<float>::infinity();
-  for (const glm::vec3& p : vertexPositions.data) {
-    min = componentwiseMin(min, p);
-    max = componentwiseMax(max, p);
-  }
-  objectSpaceBoundingBox = std::make_tuple(min, max);
-
-  // length scale, as twice the radius from the center of the bounding box
-  glm::vec3 center = 0.5f * (min + max);
-  float lengthScale = 0.0;
-  for (const glm::vec3& p : vertexPositions.data) {
-    lengthScale = std::max(lengthScale, glm::length2(p - center));
-  }
-  objectSpaceLengthScale = 2 * std::sqrt(lengthScale);
+  computePointBounds(vertexPositions.data, objectSpaceBoundingBox, objectSpaceLengthScale);
 }
 
+bool VolumeMesh::isCullable() { return quantitiesStayWithinBounds(); }
+
 std::string VolumeMesh::typeName() { return structureTypeName; }
 
 
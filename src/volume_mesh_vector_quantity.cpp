@@ -15,6 +15,8 @@ namespace polyscope {
 VolumeMeshVectorQuantity::VolumeMeshVectorQuantity(std::string name, VolumeMesh& mesh_, VolumeMeshElement definedOn_)
     : VolumeMeshQuantity(name, mesh_), definedOn(definedOn_) {}
 
+bool VolumeMeshVectorQuantity::drawsOutsideStructureBounds() { return true; }
+
 
 // ========================================================
 // ==========           Vertex Vector            ==========
@@ -158,6 +158,21 @@ struct FakeMatrix {
 };
 FakeMatrix fakeMatrix_int{{{1, 2, 3}, {4, 5, 6}}};
 
+// A wannabe Eigen matrix (or block) with strided storage
+struct FakeStridedMatrix {
+  enum { IsRowMajor = 0 };
+  std::vector<float> storage; // column-major, with padding between columns
+  long long int nRows;
+  long long int paddedRows;
+  long long int rows() const { return nRows; }
+  long long int cols() const { return 3; }
+  long long int innerStride() const { return 1; }
+  long long int outerStride() const { return paddedRows; }
+  const float* data() const { return storage.data(); }
+  float operator()(int i, int j) const { return storage[j * paddedRows + i]; }
+};
+FakeStridedMatrix fakeStridedMatrix{{1, 4, -1, 2, 5, -1, 3, 6, -1}, 2, 3};
+
 
 // Nested list access with paren-vector
 struct UserArrayParenBracketCustom {
@@ -341,6 +356,34 @@ TEST(ArrayAdaptorTests, adaptor_array_vectors) {
   EXPECT_NEAR((polyscope::standardizeVectorArray<glm::vec2, 2>(userVec2sList))[0][0], 0.1, 1e-5);
 }
 
+// Test the bulk conversion paths for contiguous and strided data, with enough entries to span several chunks
+TEST(ArrayAdaptorTests, adaptor_bulk_conversion) {
+
+  // contiguous scalars, with a type conversion
+  std::vector<float> manyFloats(200000);
+  for (size_t i = 0; i < manyFloats.size(); i++) manyFloats[i] = 0.5f * i;
+  std::vector<double> manyDoubles = polyscope::standardizeArray<double>(manyFloats);
+  ASSERT_EQ(manyDoubles.size(), manyFloats.size());
+  EXPECT_EQ(manyDoubles[0], 0.);
+  EXPECT_EQ(manyDoubles[123457], 0.5 * 123457);
+  EXPECT_EQ(manyDoubles.back(), 0.5 * (manyFloats.size() - 1));
+
+  // contiguous vectors, same and different element type
+  std::vector<glm::vec3> manyVecs(100000);
+  for (size_t i = 0; i < manyVecs.size(); i++) manyVecs[i] = glm::vec3(i, 2. * i, 3. * i);
+  std::vector<glm::vec3> vecsOut = polyscope::standardizeVectorArray<glm::vec3, 3>(manyVecs);
+  ASSERT_EQ(vecsOut.size(), manyVecs.size());
+  EXPECT_EQ(vecsOut[76543], manyVecs[76543]);
+  std::vector<std::array<double, 3>> manyArrs{{0.1, 0.2, 0.3}, {0.4, 0.5, 0.6}};
+  EXPECT_NEAR((polyscope::standardizeVectorArray<glm::vec3, 3>(manyArrs))[1][2], 0.6, 1e-5);
+
+  // strided matrix storage, skipping the padding
+  std::vector<glm::vec3> stridedOut = polyscope::standardizeVectorArray<glm::vec3, 3>(fakeStridedMatrix);
+  ASSERT_EQ(stridedOut.size(), 2);
+  EXPECT_EQ(stridedOut[0], glm::vec3(1, 2, 3));
+  EXPECT_EQ(stridedOut[1], glm::vec3(4, 5, 6));
+}
+
 
 // Test that nested access works
 TEST(ArrayAdaptorTests, adaptor_nested_array) {
@@ -14,6 +14,8 @@
 #include "gtest/gtest.h"
 
 #include <array>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <list>
 #include <string>
@@ -88,3 +90,138 @@ TEST_F(PolyscopeTest, GroundPlaneTest) {
 
   polyscope::removeAllStructures();
 }
+
+// ============================================================
+// =============== Screenshot tests
+// ============================================================
+
+TEST_F(PolyscopeTest, ScreenshotAsync) {
+  auto psMesh = registerTriangleMesh();
+
+  std::vector<std::string> filenames;
+  for (int i = 0; i < 6; i++) {
+    filenames.push_back("test_screenshot_async_" + std::to_string(i) + ".png");
+    polyscope::screenshotAsync(filenames.back(), i % 2 == 0);
+  }
+  polyscope::flushScreenshots();
+
+  for (const std::string& filename : filenames) {
+    std::ifstream file(filename);
+    EXPECT_TRUE(file.good());
+    file.close();
+    std::remove(filename.c_str());
+  }
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, RenderToBuffer) {
+  auto psMesh = registerTriangleMesh();
+  int oldWidth = polyscope::view::bufferWidth;
+  int oldHeight = polyscope::view::bufferHeight;
+
+  polyscope::RenderBufferData data;
+  polyscope::renderToBuffer(64, 32, data);
+  EXPECT_EQ(data.width, 64);
+  EXPECT_EQ(data.height, 32);
+  EXPECT_EQ(data.color.size(), 4u * 64 * 32);
+  EXPECT_TRUE(data.depth.empty());
+  EXPECT_TRUE(data.pickInds.empty());
+
+  // reuse the same buffers with all channels
+  polyscope::renderToBuffer(48, 40, data, false, true, true);
+  EXPECT_EQ(data.color.size(), 4u * 48 * 40);
+  EXPECT_EQ(data.depth.size(), 48u * 40);
+  EXPECT_EQ(data.pickInds.size(), 48u * 40);
+  EXPECT_EQ(data.color[3], 255);
+
+  // caller-provided memory
+  std::vector<unsigned char> color(4 * 16 * 16);
+  std::vector<float> depth(16 * 16);
+  polyscope::renderToBuffer(16, 16, &color.front(), &depth.front());
+
+  // the window size is restored, and the screen buffers keep the offscreen size until the next frame
+  EXPECT_EQ(polyscope::view::bufferWidth, oldWidth);
+  EXPECT_EQ(polyscope::view::bufferHeight, oldHeight);
+  EXPECT_EQ(polyscope::render::engine->displayBufferAlt->getSizeX(), 16u);
+  polyscope::show(3);
+  EXPECT_EQ(polyscope::render::engine->displayBufferAlt->getSizeX(), static_cast<unsigned int>(oldWidth));
+
+  EXPECT_THROW(polyscope::renderToBuffer(0, 16, data), std::runtime_error);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, RenderTiled) {
+  auto psMesh = registerTriangleMesh();
+  glm::mat4 projBefore = polyscope::view::getCameraPerspectiveMatrix();
+  int widthBefore = polyscope::view::bufferWidth;
+  int heightBefore = polyscope::view::bufferHeight;
+
+  std::vector<int> stripStarts;
+  int nRows = 0;
+  polyscope::renderTiled(
+      300, 200,
+      [&](const unsigned char*, int firstRow, int stripRows) {
+        stripStarts.push_back(firstRow);
+        nRows += stripRows;
+      },
+      true, 128);
+  EXPECT_EQ(stripStarts, (std::vector<int>{0, 128}));
+  EXPECT_EQ(nRows, 200);
+
+  std::string filename = "test_screenshot_tiled.png";
+  polyscope::screenshotTiled(filename, 300, 200, false, 128);
+  std::ifstream file(filename);
+  EXPECT_TRUE(file.good());
+  file.close();
+  std::remove(filename.c_str());
+
+  // the usual projection and buffer size are restored
+  EXPECT_EQ(polyscope::view::getCameraPerspectiveMatrix(), projBefore);
+  EXPECT_EQ(polyscope::view::bufferWidth, widthBefore);
+  EXPECT_EQ(polyscope::view::bufferHeight, heightBefore);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, FrameStream) {
+  auto psMesh = registerTriangleMesh();
+  size_t nPixels = static_cast<size_t>(polyscope::view::bufferWidth) * polyscope::view::bufferHeight;
+
+  { // raw RGBA to a callback
+    size_t nBytes = 0;
+    polyscope::openFrameStreamCallback([&](const unsigned char*, size_t size) { nBytes += size; });
+    EXPECT_TRUE(polyscope::frameStreamIsOpen());
+    for (int i = 0; i < 3; i++) {
+      polyscope::writeFrame();
+    }
+    polyscope::closeFrameStream();
+    EXPECT_FALSE(polyscope::frameStreamIsOpen());
+    EXPECT_EQ(nBytes, 3 * 4 * nPixels);
+  }
+
+  { // Y4M to a file
+    std::string filename = "test_frame_stream.y4m";
+    polyscope::openFrameStream(filename, polyscope::FrameStreamFormat::Y4M, 24);
+    EXPECT_THROW(polyscope::openFrameStream(filename), std::runtime_error);
+    for (int i = 0; i < 2; i++) {
+      polyscope::writeFrame();
+    }
+    polyscope::closeFrameStream();
+
+    std::ifstream file(filename, std::ios::binary);
+    std::string header;
+    std::getline(file, header);
+    EXPECT_EQ(header.rfind("YUV4MPEG2 W", 0), 0u);
+    file.seekg(0, std::ios::end);
+    size_t fileSize = file.tellg();
+    EXPECT_EQ(fileSize, header.size() + 1 + 2 * (6 + 3 * nPixels));
+    file.close();
+    std::remove(filename.c_str());
+  }
+
+  EXPECT_THROW(polyscope::writeFrame(), std::runtime_error);
+
+  polyscope::removeAllStructures();
+}
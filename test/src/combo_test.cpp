@@ -2,6 +2,11 @@
 
 #include "polyscope_test.h"
 
+#include "polyscope/scene_file.h"
+
+#include <cstdio>
+#include <fstream>
+
 
 // ============================================================
 // =============== Combo test
@@ -178,3 +183,78 @@ TEST_F(PolyscopeTest, OrthoViewTest) {
 
   polyscope::removeAllStructures();
 }
+
+
+// Write a few structures to a binary scene file, then load them back in place of the originals
+TEST_F(PolyscopeTest, SceneFileRoundTrip) {
+
+  auto psMesh = registerTriangleMesh();
+  std::vector<double> vScalar(psMesh->nVertices(), 7.);
+  psMesh->addVertexScalarQuantity("vScalar", vScalar)->setMapRange({0., 10.})->setEnabled(true);
+  psMesh->vertexNormals.ensureHostBufferPopulated();
+
+  auto psPoints = registerPointCloud();
+  std::vector<glm::vec3> colors(psPoints->nPoints(), {.1, .2, .3});
+  psPoints->addColorQuantity("colors", colors);
+  psPoints->setPosition(glm::vec3{1., 2., 3.});
+
+  auto psCurve = registerCurveNetwork();
+  std::vector<glm::vec3> vals(psCurve->nEdges(), {1., 2., 3.});
+  psCurve->addEdgeVectorQuantity("vals", vals);
+
+  auto volData = getVolumeMeshData();
+  polyscope::registerVolumeMesh("vol", std::get<0>(volData), std::get<1>(volData))->ensureHaveTets();
+
+  std::string filename = "test_scene.psb";
+  polyscope::writeSceneFile(filename);
+  polyscope::removeAllStructures();
+  polyscope::loadSceneFile(filename);
+
+  polyscope::SurfaceMesh* mesh = polyscope::getSurfaceMesh("test1");
+  EXPECT_EQ(mesh->nVertices(), std::get<0>(getTriangleMesh()).size());
+  EXPECT_EQ(mesh->nFacesTriangulation(), std::get<1>(getTriangleMesh()).size());
+  EXPECT_TRUE(mesh->vertexNormals.hasData());
+  auto q1 = mesh->getQuantity("vScalar");
+  ASSERT_NE(q1, nullptr);
+  EXPECT_TRUE(q1->isEnabled());
+  EXPECT_EQ(dynamic_cast<polyscope::SurfaceVertexScalarQuantity*>(q1)->getMapRange().second, 10.);
+
+  polyscope::PointCloud* points = polyscope::getPointCloud("test1");
+  EXPECT_EQ(points->nPoints(), getPoints().size());
+  EXPECT_EQ(points->getPosition(), glm::vec3(1., 2., 3.));
+  EXPECT_NE(points->getQuantity("colors"), nullptr);
+
+  polyscope::CurveNetwork* curve = polyscope::getCurveNetwork("test1");
+  EXPECT_EQ(curve->nEdges(), std::get<1>(getCurveNetwork()).size());
+  EXPECT_NE(curve->getQuantity("vals"), nullptr);
+
+  polyscope::VolumeMesh* vol = polyscope::getVolumeMesh("vol");
+  EXPECT_EQ(vol->nCells(), 2);
+  EXPECT_FALSE(vol->tets.empty());
+
+  polyscope::show(3);
+
+  // Files which are not scene files are rejected
+  {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out << "not a scene file";
+  }
+  EXPECT_THROW(polyscope::loadSceneFile(filename), std::runtime_error);
+
+  // So are entries whose size would overflow past the bounds check. The last table of contents entry ends with its
+  // count and offset; a count of 2^61 + 1 doubles is 8 bytes after wrapping.
+  {
+    polyscope::SceneFileWriter writer(filename);
+    writer.writeValue<double>("x", 1.);
+  }
+  {
+    std::fstream out(filename, std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(-16, std::ios::end);
+    uint64_t count = (uint64_t(1) << 61) + 1;
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  }
+  EXPECT_THROW(polyscope::SceneFileReader reader(filename), std::runtime_error);
+
+  polyscope::removeAllStructures();
+  std::remove(filename.c_str());
+}
@@ -29,6 +29,106 @@ TEST_F(PolyscopeTest, CurveNetworkAppearance) {
   polyscope::removeAllStructures();
 }
 
+TEST_F(PolyscopeTest, CurveNetworkLineMode) {
+  auto psCurve = registerCurveNetwork();
+
+  psCurve->setRenderMode(polyscope::CurveNetworkRenderMode::Line);
+  EXPECT_EQ(psCurve->getRenderMode(), polyscope::CurveNetworkRenderMode::Line);
+  psCurve->setLineWidth(3.);
+  EXPECT_EQ(psCurve->getLineWidth(), 3.);
+  psCurve->setLineSimplificationTolerance(4.);
+  EXPECT_EQ(psCurve->getLineSimplificationTolerance(), 4.);
+  polyscope::show(3);
+
+  // quantities draw as lines too
+  std::vector<double> vScalar(psCurve->nNodes(), 7.);
+  std::vector<glm::vec3> eColors(psCurve->nEdges(), glm::vec3{.2, .3, .4});
+  psCurve->addNodeScalarQuantity("vScalar", vScalar)->setEnabled(true);
+  polyscope::show(3);
+  psCurve->addEdgeColorQuantity("eColor", eColors)->setEnabled(true);
+  polyscope::show(3);
+
+  polyscope::pick::evaluatePickQuery(77, 88);
+
+  psCurve->setRenderMode(polyscope::CurveNetworkRenderMode::Tube);
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, CurveNetworkLineLOD) {
+  // a long straight line of short segments, split in to many blocks
+  size_t nNodes = 32 * polyscope::lineLODBlockEdges + 1;
+  float edgeLen = 0.01;
+  std::vector<glm::vec3> nodes(nNodes);
+  for (size_t i = 0; i < nNodes; i++) nodes[i] = glm::vec3{edgeLen * i, 0., 0.};
+  auto psCurve = polyscope::registerCurveNetworkLine("line", nodes);
+  psCurve->setRenderMode(polyscope::CurveNetworkRenderMode::Line);
+  float tolerance = 4.;
+  psCurve->setLineSimplificationTolerance(tolerance);
+  polyscope::show(3);
+
+  // Every simplified segment must span at most the tolerance on screen (single edges are drawn whatever their length).
+  // Returns the number of segments drawn, and whether any of them is a single edge (full detail).
+  auto checkDrawnSegments = [&](size_t& nSegments, bool& anyFullDetail) {
+    glm::mat4 viewProj = polyscope::view::getCameraPerspectiveMatrix() * polyscope::view::getCameraViewMatrix();
+    glm::vec4 viewport = polyscope::render::engine->getCurrentViewport();
+    glm::vec2 halfViewport{viewport[2] / 2., viewport[3] / 2.};
+    const std::vector<uint32_t>& inds = psCurve->lineStripInds;
+    nSegments = 0;
+    anyFullDetail = false;
+    for (size_t i = 0; i + 1 < inds.size(); i++) {
+      if (inds[i] == polyscope::INVALID_IND_32 || inds[i + 1] == polyscope::INVALID_IND_32) continue;
+      nSegments++;
+      if (inds[i + 1] - inds[i] == 1) {
+        anyFullDetail = true;
+        continue;
+      }
+      glm::vec4 a = viewProj * glm::vec4(nodes[inds[i]], 1.);
+      glm::vec4 b = viewProj * glm::vec4(nodes[inds[i + 1]], 1.);
+      glm::vec2 screenA = glm::vec2(a) / a.w * halfViewport;
+      glm::vec2 screenB = glm::vec2(b) / b.w * halfViewport;
+      EXPECT_LE(glm::length(screenA - screenB), tolerance * 1.001);
+    }
+  };
+  size_t nSegments;
+  bool anyFullDetail;
+
+  // zoomed in on one end: full detail there, and the rest of the line is off screen
+  polyscope::view::lookAt(glm::vec3{0., 0., 0.5}, glm::vec3{0., 0., 0.});
+  polyscope::show(3);
+  std::vector<size_t> levels = psCurve->getLineLODLevels();
+  ASSERT_EQ(levels.size(), 32u);
+  EXPECT_EQ(levels.front(), 0u);
+  EXPECT_EQ(levels.back(), polyscope::INVALID_IND);
+  checkDrawnSegments(nSegments, anyFullDetail);
+  EXPECT_TRUE(anyFullDetail);
+  EXPECT_LT(nSegments, 4 * polyscope::lineLODBlockEdges);
+
+  // from far away, every block is coarser but still within the tolerance
+  glm::vec3 center = 0.5f * (nodes.front() + nodes.back());
+  polyscope::view::lookAt(center + glm::vec3{0., 0., 200.}, center);
+  polyscope::show(3);
+  for (size_t level : psCurve->getLineLODLevels()) EXPECT_GT(level, 0u);
+  checkDrawnSegments(nSegments, anyFullDetail);
+  EXPECT_FALSE(anyFullDetail);
+  EXPECT_LT(nSegments, nNodes / 2);
+
+  // seen at a grazing angle from one end, the near blocks are finer than the far ones
+  polyscope::view::lookAt(glm::vec3{-1., 0., 0.2}, glm::vec3{0., 0., 0.});
+  polyscope::show(3);
+  levels = psCurve->getLineLODLevels();
+  EXPECT_LT(levels.front(), levels.back());
+  checkDrawnSegments(nSegments, anyFullDetail);
+
+  // no simplification when disabled
+  psCurve->setLineSimplificationTolerance(0.);
+  polyscope::show(3);
+  for (size_t level : psCurve->getLineLODLevels()) EXPECT_TRUE(level == 0u || level == polyscope::INVALID_IND);
+
+  polyscope::removeAllStructures();
+}
+
 TEST_F(PolyscopeTest, CurveNetworkPick) {
   auto psCurve = registerCurveNetwork();
 
@@ -178,3 +178,200 @@ TEST_F(PolyscopeTest, ImplicitSurfaceRenderImageQuantityTest) {
 
   polyscope::removeAllStructures();
 }
+
+TEST_F(PolyscopeTest, ImplicitSurfaceParallelTest) {
+
+  auto sphereSDF = [](glm::vec3 p) { return glm::length(p) - 1.f; };
+  auto sphereSDFBatch = [](const std::vector<glm::vec3>& pos) {
+    std::vector<float> vals(pos.size());
+    for (size_t i = 0; i < pos.size(); i++) {
+      vals[i] = glm::length(pos[i]) - 1.f;
+    }
+    return vals;
+  };
+
+  polyscope::ImplicitRenderOpts opts;
+  opts.subsampleFactor = 8;
+
+  // parallel and serial marching give the same image
+  opts.parallel = true;
+  std::vector<float> depthParallel = std::get<2>(polyscope::renderImplicitSurfaceFromCurrentView(sphereSDFBatch, opts));
+  opts.parallel = false;
+  std::vector<float> depthSerial = std::get<2>(polyscope::renderImplicitSurfaceFromCurrentView(sphereSDFBatch, opts));
+  EXPECT_EQ(depthParallel, depthSerial);
+
+  opts.parallel = true;
+  polyscope::renderImplicitSurface("sphere sdf", sphereSDF, opts);
+  polyscope::renderImplicitSurfaceBatch("sphere sdf batch", sphereSDFBatch, opts);
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, ImplicitSurfaceReuseTest) {
+
+  auto sphereSDF = [](glm::vec3 p) { return glm::length(p) - 1.f; };
+  auto sphereColor = [](glm::vec3 p) { return glm::abs(p); };
+  auto sphereScalar = [](glm::vec3 p) { return p.x; };
+
+  polyscope::ImplicitRenderOpts opts;
+  opts.subsampleFactor = 8;
+
+  // re-rendering with the same name and size updates the existing quantity
+  polyscope::DepthRenderImageQuantity* qDepth = polyscope::renderImplicitSurface("sphere sdf", sphereSDF, opts);
+  qDepth->setEnabled(true);
+  polyscope::show(3);
+  EXPECT_EQ(polyscope::renderImplicitSurface("sphere sdf", sphereSDF, opts), qDepth);
+  EXPECT_TRUE(qDepth->isEnabled());
+  polyscope::show(3);
+
+  polyscope::ColorRenderImageQuantity* qColor =
+      polyscope::renderImplicitSurfaceColor("sphere color", sphereSDF, sphereColor, opts);
+  polyscope::show(3);
+  EXPECT_EQ(polyscope::renderImplicitSurfaceColor("sphere color", sphereSDF, sphereColor, opts), qColor);
+  polyscope::show(3);
+
+  polyscope::ScalarRenderImageQuantity* qScalar =
+      polyscope::renderImplicitSurfaceScalar("sphere scalar", sphereSDF, sphereScalar, opts);
+  polyscope::show(3);
+  EXPECT_EQ(polyscope::renderImplicitSurfaceScalar("sphere scalar", sphereSDF, sphereScalar, opts), qScalar);
+  polyscope::show(3);
+
+  // a different size replaces it
+  opts.subsampleFactor = 4;
+  polyscope::DepthRenderImageQuantity* qDepth2 = polyscope::renderImplicitSurface("sphere sdf", sphereSDF, opts);
+  EXPECT_EQ(qDepth2->getDimX(), static_cast<size_t>(polyscope::view::bufferWidth / 4));
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, ImplicitSurfaceProgressiveTest) {
+
+  auto sphereSDF = [](glm::vec3 p) { return glm::length(p) - 1.f; };
+  auto sphereColor = [](glm::vec3 p) { return glm::abs(p); };
+
+  polyscope::ImplicitRenderOpts opts;
+  opts.subsampleFactor = 16;
+  opts.progressiveInitialStride = 4;
+
+  std::unique_ptr<polyscope::ImplicitProgressiveRenderer> renderer =
+      polyscope::renderImplicitSurfaceProgressive("sphere sdf progressive", sphereSDF, opts);
+  EXPECT_EQ(renderer->getCurrentStride(), 4u);
+  while (!renderer->refine()) {
+  }
+  EXPECT_TRUE(renderer->isComplete());
+  EXPECT_EQ(renderer->getCurrentStride(), 1u);
+  EXPECT_TRUE(renderer->refine());
+  EXPECT_NE(polyscope::getGlobalFloatingQuantityStructure()->getFloatingQuantity("sphere sdf progressive"), nullptr);
+
+  std::unique_ptr<polyscope::ImplicitProgressiveRenderer> colorRenderer =
+      polyscope::renderImplicitSurfaceColorProgressive("sphere color progressive", sphereSDF, sphereColor, opts);
+  polyscope::show(3);
+  while (!colorRenderer->refine()) {
+  }
+  EXPECT_NE(polyscope::getGlobalFloatingQuantityStructure()->getFloatingQuantity("sphere color progressive"), nullptr);
+
+  renderer.reset();
+  colorRenderer.reset();
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, ImplicitSurfaceCameraTest) {
+
+  auto sphereSDFBatch = [](const std::vector<glm::vec3>& pos) {
+    std::vector<float> vals(pos.size());
+    for (size_t i = 0; i < pos.size(); i++) {
+      vals[i] = glm::length(pos[i]) - 1.f;
+    }
+    return vals;
+  };
+
+  polyscope::ImplicitRenderOpts opts;
+  opts.subsampleFactor = 8;
+
+  // the current view may be orthographic
+  polyscope::view::projectionMode = polyscope::ProjectionMode::Orthographic;
+  polyscope::renderImplicitSurfaceBatch("sphere sdf ortho", sphereSDFBatch, opts);
+  polyscope::show(3);
+  polyscope::view::projectionMode = polyscope::ProjectionMode::Perspective;
+
+  // render from other cameras, without the current view
+  polyscope::CameraParameters params(
+      polyscope::CameraIntrinsics::fromFoVDegVerticalAndAspect(60., 2.),
+      polyscope::CameraExtrinsics::fromVectors(glm::vec3{0., 0., 5.}, glm::vec3{0., 0., -1.}, glm::vec3{0., 1., 0.}));
+  std::vector<polyscope::ImplicitRenderCamera> cameras{
+      polyscope::ImplicitRenderCamera::perspective(params, 64, 32),
+      polyscope::ImplicitRenderCamera::orthographic(params.extrinsics, 4., 32, 32),
+  };
+  std::vector<polyscope::ImplicitRenderResult> results =
+      polyscope::renderImplicitSurfaceFromCameras(sphereSDFBatch, cameras, opts);
+
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0].dimX, 64u);
+  EXPECT_EQ(results[0].dimY, 32u);
+  EXPECT_EQ(results[0].depth.size(), 64u * 32u);
+  EXPECT_NEAR(results[0].depth[16 * 64 + 32], 4., 1e-2);
+  EXPECT_NEAR(results[1].depth[16 * 32 + 16], 4., 1e-2);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, ImplicitSurfaceGradientSoATest) {
+
+  auto sphereSDF = [](glm::vec3 p) { return glm::length(p) - 1.f; };
+  auto sphereGrad = [](glm::vec3 p) { return p; };
+  auto sphereSDFSoA = [](const float* x, const float* y, const float* z, float* vals, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      vals[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]) - 1.f;
+    }
+  };
+
+  polyscope::ImplicitRenderOpts opts;
+  opts.subsampleFactor = 8;
+
+  polyscope::renderImplicitSurfaceWithGradient("sphere sdf gradient", sphereSDF, sphereGrad, opts);
+  polyscope::renderImplicitSurfaceBatchSoA("sphere sdf soa", sphereSDFSoA, opts);
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, ImplicitSurfaceAccelerationTest) {
+
+  auto sphereSDFBatch = [](const std::vector<glm::vec3>& pos) {
+    std::vector<float> vals(pos.size());
+    for (size_t i = 0; i < pos.size(); i++) {
+      vals[i] = glm::length(pos[i]) - 1.f;
+    }
+    return vals;
+  };
+
+  polyscope::ImplicitRenderOpts opts;
+  opts.subsampleFactor = 8;
+  std::vector<float> depthRef = std::get<2>(polyscope::renderImplicitSurfaceFromCurrentView(sphereSDFBatch, opts));
+
+  // bounding boxes and cone prepasses do not change the image
+  opts.useBoundingBox = true;
+  opts.boundingBoxMin = glm::vec3{-1.1, -1.1, -1.1};
+  opts.boundingBoxMax = glm::vec3{1.1, 1.1, 1.1};
+  opts.conePrepassFactor = 4;
+  opts.warmStart = std::make_shared<polyscope::ImplicitWarmStart>();
+  for (int iRender = 0; iRender < 2; iRender++) {
+    std::vector<float> depth = std::get<2>(polyscope::renderImplicitSurfaceFromCurrentView(sphereSDFBatch, opts));
+    ASSERT_EQ(depth.size(), depthRef.size());
+    for (size_t i = 0; i < depth.size(); i++) {
+      if (std::isinf(depthRef[i])) {
+        EXPECT_TRUE(std::isinf(depth[i]));
+      } else {
+        EXPECT_NEAR(depth[i], depthRef[i], 1e-3);
+      }
+    }
+  }
+  EXPECT_TRUE(opts.warmStart->valid);
+
+  polyscope::renderImplicitSurfaceBatch("sphere sdf accelerated", sphereSDFBatch, opts);
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
@@ -3,18 +3,27 @@
 #include "polyscope/types.h"
 #include "polyscope_test.h"
 
+#include "polyscope/bounds.h"
 #include "polyscope/curve_network.h"
 #include "polyscope/implicit_surface.h"
 #include "polyscope/pick.h"
 #include "polyscope/point_cloud.h"
 #include "polyscope/polyscope.h"
+#include "polyscope/quantity_sequence.h"
+#include "polyscope/render/colormap_lut.h"
+#include "polyscope/render/quantization.h"
 #include "polyscope/surface_mesh.h"
 #include "polyscope/volume_mesh.h"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <string>
 #include <vector>
@@ -113,6 +122,124 @@ TEST_F(PolyscopeTest, PointCloudScalar) {
   polyscope::removeAllStructures();
 }
 
+TEST_F(PolyscopeTest, PointCloudScalarStatistics) {
+  // values 0, 1, 2, ... with a NaN and a large outlier
+  size_t nPts = 1000;
+  std::vector<glm::vec3> points(nPts);
+  std::vector<double> vScalar(nPts);
+  for (size_t i = 0; i < nPts; i++) {
+    points[i] = glm::vec3{i, 0., 0.};
+    vScalar[i] = i;
+  }
+  auto psPoints = polyscope::registerPointCloud("test1", points);
+  vScalar[0] = std::numeric_limits<double>::quiet_NaN();
+  vScalar[1] = 1e6;
+  auto q1 = psPoints->addScalarQuantity("vScalar", vScalar);
+
+  const polyscope::ScalarStatistics& stats = q1->getDataStatistics();
+  EXPECT_EQ(stats.nanCount, 1u);
+  EXPECT_EQ(stats.finiteCount, vScalar.size() - 1);
+  EXPECT_EQ(stats.min, 2.);
+  EXPECT_EQ(stats.max, 1e6);
+  EXPECT_EQ(q1->getDataRange().second, 1e6);
+
+  // the outlier does not affect the percentiles
+  double n = static_cast<double>(vScalar.size());
+  EXPECT_NEAR(stats.percentile(0.5), n / 2., n * 0.02);
+  q1->resetMapRangeToPercentiles(1., 99.);
+  EXPECT_LT(q1->getMapRange().second, n);
+
+  // the histogram over the data range is exact, also across chunks
+  std::vector<double> manyValues(3 * polyscope::statisticsChunkSize);
+  for (size_t i = 0; i < manyValues.size(); i++) {
+    manyValues[i] = std::sin(0.001 * i) * std::sqrt(static_cast<double>(i));
+  }
+  polyscope::ScalarStatistics manyStats = polyscope::computeScalarStatistics(manyValues);
+  std::pair<double, double> range = manyStats.robustRange();
+  size_t nBins = polyscope::statisticsHistogramBinCount;
+  double binWidth = (range.second - range.first) / nBins;
+  std::vector<double> expectedCounts(nBins, 0.);
+  for (double x : manyValues) {
+    expectedCounts[std::min(static_cast<size_t>((x - range.first) / binWidth), nBins - 1)] += 1.;
+  }
+  EXPECT_EQ(manyStats.histogram(range.first, range.second, nBins), expectedCounts);
+  q1->setEnabled(true);
+  polyscope::show(3);
+
+  // statistics are recomputed after an update
+  for (size_t i = 0; i < vScalar.size(); i++) {
+    vScalar[i] = -static_cast<double>(i);
+  }
+  q1->updateData(vScalar);
+  EXPECT_EQ(q1->getDataStatistics().nanCount, 0u);
+  EXPECT_EQ(q1->getDataStatistics().min, -(n - 1.));
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, PointCloudSequence) {
+  auto psPoints = registerPointCloud();
+  size_t nPts = psPoints->nPoints();
+  auto qScalar = psPoints->addScalarQuantity("vScalar", std::vector<double>(nPts, 0.));
+  auto qColor = psPoints->addColorQuantity("vColor", std::vector<glm::vec3>(nPts, glm::vec3{0., 0., 0.}));
+  auto qVector = psPoints->addVectorQuantity("vVector", std::vector<glm::vec3>(nPts, glm::vec3{1., 0., 0.}));
+
+  // frames in memory: frame i has every value equal to i
+  size_t nFrames = 10;
+  std::vector<std::vector<float>> scalarFrames, vec3Frames;
+  for (size_t i = 0; i < nFrames; i++) {
+    scalarFrames.push_back(std::vector<float>(nPts, static_cast<float>(i)));
+    vec3Frames.push_back(std::vector<float>(3 * nPts, static_cast<float>(i)));
+  }
+
+  // positions from a memory-mapped file, after a 4-byte header
+  std::string filename = "test_point_cloud_sequence.bin";
+  {
+    std::ofstream out(filename, std::ios::binary);
+    uint32_t header = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const std::vector<float>& frame : vec3Frames) {
+      out.write(reinterpret_cast<const char*>(&frame.front()), frame.size() * sizeof(float));
+    }
+  }
+
+  {
+    polyscope::Timeline timeline("test timeline", 4);
+    auto vec3Source = std::make_shared<polyscope::MemoryFrameSource>(vec3Frames);
+    timeline.addPositionSequence(psPoints, std::make_shared<polyscope::MappedFileFrameSource>(filename, 3 * nPts, 4));
+    timeline.addScalarSequence(qScalar, std::make_shared<polyscope::MemoryFrameSource>(scalarFrames));
+    timeline.addColorSequence(qColor, vec3Source);
+    timeline.addVectorSequence(qVector, vec3Source);
+    EXPECT_EQ(timeline.frameCount(), nFrames);
+
+    // wrong frame size
+    EXPECT_THROW(timeline.addScalarSequence(qScalar, vec3Source), std::runtime_error);
+
+    // a structure of another type with the same name gets its own sequence
+    auto psCurve = polyscope::registerCurveNetworkLine(psPoints->name, psPoints->points.data);
+    EXPECT_NO_THROW(timeline.addPositionSequence(psCurve, vec3Source));
+
+    timeline.setFrame(7);
+    EXPECT_EQ(qScalar->values.getValue(0), 7.);
+    EXPECT_EQ(qColor->colors.getValue(0), glm::vec3(7., 7., 7.));
+    EXPECT_EQ(psPoints->points.getValue(0), glm::vec3(7., 7., 7.));
+    polyscope::show(3);
+
+    timeline.setPlaying(true);
+    polyscope::show(3);
+
+    // sequences whose target has been removed are skipped
+    psPoints->removeQuantity("vScalar");
+    timeline.setFrame(2);
+    EXPECT_EQ(qColor->colors.getValue(0), glm::vec3(2., 2., 2.));
+    polyscope::show(3);
+  }
+
+  std::remove(filename.c_str());
+  polyscope::removeAllStructures();
+}
+
 TEST_F(PolyscopeTest, PointCloudVector) {
   auto psPoints = registerPointCloud();
 
@@ -128,6 +255,242 @@ TEST_F(PolyscopeTest, PointCloudVector) {
 }
 
 
+TEST_F(PolyscopeTest, PointCloudVectorDecimation) {
+  auto psPoints = registerPointCloud();
+
+  std::vector<glm::vec3> vals(psPoints->nPoints(), {1., 2., 3.});
+  vals[0] = glm::vec3{0., 0., 0.};
+  auto q1 = psPoints->addVectorQuantity("vals", vals);
+  q1->setEnabled(true);
+
+  q1->setVectorMagnitudeThreshold(0.5);
+  EXPECT_EQ(q1->getVectorMagnitudeThreshold(), 0.5);
+  polyscope::show(3);
+
+  q1->setVectorDecimationPixels(16.);
+  EXPECT_EQ(q1->getVectorDecimationPixels(), 16.);
+  polyscope::show(3);
+
+  // tiny cells are clamped, so the cell grid stays bounded
+  q1->setVectorDecimationPixels(1e-6);
+  EXPECT_EQ(q1->getVectorDecimationPixels(), polyscope::minVectorDecimationPixels);
+  polyscope::show(3);
+  q1->setVectorDecimationPixels(0.);
+  EXPECT_EQ(q1->getVectorDecimationPixels(), 0.);
+  q1->setVectorDecimationPixels(16.);
+
+  q1->updateData(vals);
+  polyscope::show(3);
+
+  // moving the roots bumps their buffer version, which re-selects the decimated vectors
+  uint64_t rootsVersion = psPoints->points.getDataVersion();
+  std::vector<glm::vec3> newPositions(psPoints->nPoints(), glm::vec3{0.5, 0.5, 0.5});
+  psPoints->updatePointPositions(newPositions);
+  EXPECT_GT(psPoints->points.getDataVersion(), rootsVersion);
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, PointCloudStreaming) {
+  auto psPoints = registerPointCloud();
+  size_t n = psPoints->nPoints();
+
+  auto q1 = psPoints->addScalarQuantity("vals", std::vector<double>(n, 1.));
+  q1->setEnabled(true);
+  polyscope::show(3);
+
+  // grow
+  std::vector<glm::vec3> newPoints = {{2., 0., 0.}, {0., 2., 0.}, {0., 0., 2.}};
+  psPoints->appendPoints(newPoints);
+  q1->setRangeUpdate(polyscope::ScalarRangeUpdate::Running);
+  q1->appendData(std::vector<double>{1., 2., 30.});
+  EXPECT_EQ(psPoints->nPoints(), n + 3);
+  EXPECT_EQ(q1->getDataRange().second, 30.); // appended values grow a running range
+  EXPECT_EQ(q1->getDataStatistics().max, 30.);
+  polyscope::show(3);
+
+  // ring buffer, including an append larger than the ring
+  psPoints->setMaxStreamSize(n + 4);
+  EXPECT_EQ(psPoints->getMaxStreamSize(), n + 4);
+  psPoints->appendPoints(newPoints);
+  EXPECT_EQ(psPoints->nPoints(), n + 4);
+  polyscope::show(3);
+  psPoints->appendPoints(std::vector<glm::vec3>(2 * n + 10, glm::vec3{1., 1., 1.}));
+  EXPECT_EQ(psPoints->nPoints(), n + 4);
+  polyscope::show(3);
+
+  EXPECT_THROW(psPoints->setMaxStreamSize(1), std::runtime_error);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, PointCloudCompactBuffers) {
+  polyscope::options::compactRenderBuffers = true;
+  auto psPoints = registerPointCloud();
+  size_t n = psPoints->nPoints();
+
+  std::vector<glm::vec3> vColors(n, glm::vec3{.2, .3, .4});
+  auto q1 = psPoints->addColorQuantity("vcolor", vColors);
+  q1->setEnabled(true);
+  auto q2 = psPoints->addVectorQuantity("vals", std::vector<glm::vec3>(n, {1., 2., 3.}));
+  q2->setEnabled(true);
+  polyscope::show(3);
+  EXPECT_EQ(psPoints->points.getRenderAttributeBuffer()->getType(), polyscope::RenderDataType::Vector3UShortNorm);
+  EXPECT_EQ(q1->colors.getRenderAttributeBuffer()->getType(), polyscope::RenderDataType::Vector4UByteNorm);
+  polyscope::pick::evaluatePickQuery(77, 88);
+
+  psPoints->setPointRenderMode(polyscope::PointRenderMode::Quad);
+  polyscope::show(3);
+
+  // host data keeps full precision
+  std::vector<glm::vec3> points = getPoints();
+  psPoints->updatePointPositions(points);
+  EXPECT_EQ(psPoints->getPointPosition(1), points[1]);
+  polyscope::show(3);
+
+  // partial updates and appends outside the current bounds
+  psPoints->updatePointPositionsRange(1, std::vector<glm::vec3>{{5., 0., 0.}});
+  psPoints->appendPoints(std::vector<glm::vec3>{{0., -5., 0.}});
+  q1->appendData(std::vector<glm::vec3>{{1., 0., 0.}});
+  polyscope::show(3);
+
+  // a range update inside the bounds only encodes that range
+  psPoints->updatePointPositionsRange(2, std::vector<glm::vec3>{{0., 0., 0.}});
+  EXPECT_EQ(psPoints->points.getRenderAttributeBuffer()->getDataSize(), static_cast<int64_t>(n + 1));
+  polyscope::show(3);
+
+  // direct writes to quantized device buffers are not allowed
+  EXPECT_THROW(psPoints->points.markRenderAttributeBufferUpdated(), std::runtime_error);
+
+  polyscope::options::compactRenderBuffers = false;
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, CompactBufferEncoding) {
+  using namespace polyscope::render;
+
+  std::vector<glm::vec3> points = {{-1., 2., 0.}, {3., 2., 0.5}, {0., 2., 1.}};
+  QuantizationBounds bounds = computeQuantizationBounds(points);
+  EXPECT_EQ(bounds.lower, glm::vec3(-1., 2., 0.));
+  EXPECT_EQ(bounds.upper, glm::vec3(3., 2., 1.));
+  for (glm::vec3 p : points) {
+    glm::vec3 back = dequantizeUNorm16(quantizeUNorm16(p, bounds), bounds);
+    EXPECT_LT(glm::length(back - p), 1e-4);
+  }
+
+  glm::vec3 color{.2, .5, 1.};
+  EXPECT_LT(glm::length(dequantizeUNorm8(quantizeUNorm8(color)) - color), 1e-2);
+
+  std::vector<glm::vec3> normals = {{0., 0., 1.}, {0., 0., -1.}, {1., 0., 0.}, {-.3, .5, -.8}, {.6, -.7, .1}};
+  for (glm::vec3 n : normals) {
+    n = glm::normalize(n);
+    EXPECT_LT(glm::length(decodeOctahedral16(encodeOctahedral16(n)) - n), 1e-3);
+  }
+}
+
+TEST_F(PolyscopeTest, PointCloudBounds) {
+  auto psPoints = registerPointCloud();
+
+  // partial update grows the bounds
+  psPoints->updatePointPositionsRange(1, std::vector<glm::vec3>{{5., 0., 0.}, {0., -5., 0.}});
+  glm::vec3 bboxMin, bboxMax;
+  std::tie(bboxMin, bboxMax) = psPoints->boundingBox();
+  EXPECT_EQ(bboxMax.x, 5.);
+  EXPECT_EQ(bboxMin.y, -5.);
+  EXPECT_GE(psPoints->lengthScale(), 10.);
+  polyscope::show(3);
+
+  // full updates are recomputed lazily
+  psPoints->updatePointPositions(getPoints());
+  std::tie(bboxMin, bboxMax) = psPoints->boundingBox();
+  EXPECT_LT(bboxMax.x, 5.);
+
+  // deferred bounds on registration
+  polyscope::options::deferStructureBounds = true;
+  auto psPoints2 = polyscope::registerPointCloud("points2", getPoints());
+  EXPECT_GT(psPoints2->lengthScale(), 0.);
+  polyscope::options::deferStructureBounds = false;
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, PointCloudViewCulling) {
+  // large enough to be split in to several culling blocks
+  std::vector<glm::vec3> points;
+  for (size_t i = 0; i < 20000; i++) {
+    points.push_back(glm::vec3{0.001 * i, 0., 0.});
+  }
+  auto psPoints = polyscope::registerPointCloud("big", points);
+  auto q1 = psPoints->addScalarQuantity("vals", std::vector<double>(points.size(), 1.));
+  q1->setEnabled(true);
+  polyscope::show(3);
+
+  // look at one end, so some blocks are outside the view
+  polyscope::view::lookAt(glm::vec3{0., 0., 0.5}, glm::vec3{0., 0., 0.});
+  polyscope::show(3);
+  EXPECT_TRUE(psPoints->mayBeInView());
+
+  // move the whole cloud out of view
+  psPoints->setPosition(glm::vec3{1e6, 1e6, 1e6});
+  EXPECT_FALSE(psPoints->mayBeInView());
+  polyscope::show(3);
+
+  // right after a position update the bounds are stale, so it is not culled until the geometry settles
+  psPoints->updatePointPositions(points);
+  EXPECT_TRUE(psPoints->mayBeInView());
+  polyscope::show(3);
+  EXPECT_FALSE(psPoints->mayBeInView());
+
+  polyscope::options::enableViewCulling = false;
+  polyscope::show(3);
+  polyscope::options::enableViewCulling = true;
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, PointCloudOcclusionCulling) {
+  // a depth buffer with an occluder at the origin covering the middle of the view
+  glm::mat4 viewProj = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f) *
+                       glm::lookAt(glm::vec3{0., 0., 5.}, glm::vec3{0., 0., 0.}, glm::vec3{0., 1., 0.});
+  glm::vec4 clipOrigin = viewProj * glm::vec4{0., 0., 0., 1.};
+  float occluderDepth = 0.5f * clipOrigin.z / clipOrigin.w + 0.5f;
+  size_t res = 64;
+  std::vector<float> depth(res * res, 1.);
+  for (size_t y = res / 4; y < 3 * res / 4; y++) {
+    for (size_t x = res / 4; x < 3 * res / 4; x++) {
+      depth[y * res + x] = occluderDepth;
+    }
+  }
+  polyscope::OcclusionDepthMap map;
+  glm::mat4 I(1.);
+  glm::vec3 h{0.1, 0.1, 0.1};
+  EXPECT_TRUE(polyscope::boxMayBeUnoccluded(map, I, -h, h)); // invalid map
+  polyscope::buildOcclusionDepthMap(depth, res, res, viewProj, map);
+  EXPECT_EQ(map.levelSizes.back(), glm::uvec2(1, 1));
+
+  glm::vec3 behind{0., 0., -2.};
+  glm::vec3 inFront{0., 0., 2.};
+  glm::vec3 besideBehind{3., 0., -2.};
+  glm::vec3 aroundCamera{0., 0., 5.};
+  EXPECT_FALSE(polyscope::boxMayBeUnoccluded(map, I, behind - h, behind + h));
+  EXPECT_TRUE(polyscope::boxMayBeUnoccluded(map, I, inFront - h, inFront + h));
+  EXPECT_TRUE(polyscope::boxMayBeUnoccluded(map, I, besideBehind - h, besideBehind + h));
+  EXPECT_TRUE(polyscope::boxMayBeUnoccluded(map, I, aroundCamera - h, aroundCamera + h));
+  EXPECT_TRUE(polyscope::boxMayBeUnoccluded(map, I, behind - h, behind + h, 3.)); // margin reaches past the occluder
+
+  // in the main loop
+  auto psPoints = registerPointCloud();
+  polyscope::options::enableOcclusionCulling = true;
+  polyscope::show(3);
+  EXPECT_TRUE(psPoints->mayBeInView());
+  polyscope::options::enableOcclusionCulling = false;
+  polyscope::show(3);
+
+  polyscope::removeAllStructures();
+}
+
 TEST_F(PolyscopeTest, PointCloudParam) {
   auto psPoints = registerPointCloud();
   std::vector<glm::vec2> param(psPoints->nPoints(), glm::vec2{.2, .3});
@@ -154,6 +517,45 @@ TEST_F(PolyscopeTest, PointCloudParam) {
 }
 
 
+TEST_F(PolyscopeTest, PointCloudScalarMappedColors) {
+  auto psPoints = registerPointCloud();
+  size_t n = psPoints->nPoints();
+  std::vector<double> vScalar(n);
+  for (size_t i = 0; i < n; i++) vScalar[i] = static_cast<double>(i) / (n - 1);
+  vScalar[0] = std::numeric_limits<double>::quiet_NaN();
+  auto q1 = psPoints->addScalarQuantity("vScalar", vScalar);
+  q1->setMapRange({0., 1.});
+
+  // matches sampling the colormap directly
+  const polyscope::render::ValueColorMap& cmap = polyscope::render::engine->getColorMap(q1->getColorMap());
+  std::vector<glm::vec3> colors = q1->getMappedColors();
+  ASSERT_EQ(colors.size(), n);
+  EXPECT_EQ(colors[0], glm::vec3(0., 0., 0.));
+  for (size_t i = 1; i < n; i++) {
+    glm::vec3 expected = cmap.getValue(std::min(vScalar[i], 0.999999));
+    EXPECT_LT(glm::length(colors[i] - expected), 1e-2);
+  }
+
+  // values outside the range are clamped, isolines darken alternate bands
+  polyscope::render::ColorMapLUT lut(cmap);
+  polyscope::render::ColorMapParams params;
+  params.range = {0., 1.};
+  params.isolinesEnabled = true;
+  params.isolineWidth = 0.25;
+  params.isolineDarkness = 0.5;
+  std::vector<glm::vec3> mapped = lut.mapValues({-3.2, 0.1, 0.3, 3.}, params);
+  EXPECT_EQ(mapped[0], lut.sample(0.) * 0.5f); // -3.2 lies in a dark band, like 0.3
+  EXPECT_EQ(mapped[1], lut.sample(0.1));
+  EXPECT_EQ(mapped[2], lut.sample(0.3) * 0.5f);
+  EXPECT_EQ(mapped[3], lut.sample(1.));
+
+  std::vector<glm::u8vec3> colors8 = q1->getMappedColorsRGB8();
+  ASSERT_EQ(colors8.size(), n);
+  EXPECT_EQ(colors8[n - 1], glm::u8vec3(glm::round(colors[n - 1] * 255.f)));
+
+  polyscope::removeAllStructures();
+}
+
 TEST_F(PolyscopeTest, PointCloudScalarRadius) {
   auto psPoints = registerPointCloud();
   std::vector<double> vScalar(psPoints->nPoints(), 7.);
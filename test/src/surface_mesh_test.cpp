@@ -2,6 +2,11 @@
 
 #include "polyscope_test.h"
 
+#include "polyscope/mesh_io.h"
+
+#include <cstdio>
+#include <fstream>
+
 // ============================================================
 // =============== Surface mesh tests
 // ============================================================
@@ -168,6 +173,44 @@ TEST_F(PolyscopeTest, SurfaceMeshScalarVertex) {
   polyscope::removeAllStructures();
 }
 
+TEST_F(PolyscopeTest, SurfaceMeshScalarVertexTimeSeries) {
+  auto psMesh = registerTriangleMesh();
+  std::vector<double> vScalar(psMesh->nVertices(), 7.);
+  auto q1 = psMesh->addVertexScalarQuantity("vScalar", vScalar);
+  q1->setEnabled(true);
+  polyscope::show(3);
+
+  // fixed range: new values leave the range alone
+  vScalar[0] = 100.;
+  q1->updateData(vScalar);
+  std::pair<double, double> fixedRange = q1->getDataRange();
+  EXPECT_LT(fixedRange.second, 100.);
+  polyscope::show(3);
+
+  // running range: grows to cover each frame
+  q1->setRangeUpdate(polyscope::ScalarRangeUpdate::Running);
+  for (int iFrame = 0; iFrame < 5; iFrame++) {
+    vScalar[0] = -10. * iFrame;
+    q1->updateData(vScalar);
+    polyscope::show(1);
+  }
+  EXPECT_EQ(q1->getDataRange().first, -40.);
+  EXPECT_EQ(q1->getMapRange().first, -40.);
+
+  // a map range set by hand is kept, until it is reset
+  q1->setMapRange({0., 5.});
+  vScalar[0] = -100.;
+  q1->updateData(vScalar);
+  EXPECT_EQ(q1->getDataRange().first, -100.);
+  EXPECT_EQ(q1->getMapRange().first, 0.);
+  q1->resetMapRange();
+  vScalar[0] = -200.;
+  q1->updateData(vScalar);
+  EXPECT_EQ(q1->getMapRange().first, -200.);
+
+  polyscope::removeAllStructures();
+}
+
 TEST_F(PolyscopeTest, SurfaceMeshScalarFace) {
   auto psMesh = registerTriangleMesh();
   std::vector<double> fScalar(psMesh->nFaces(), 8.);
@@ -365,3 +408,136 @@ TEST_F(PolyscopeTest, SurfaceMeshOneForm) {
   polyscope::show(3);
   polyscope::removeAllStructures();
 }
+
+TEST_F(PolyscopeTest, LoadSurfaceMeshFiles) {
+
+  // OBJ, with texture coordinates, negative indices, a quad and a line continuation
+  {
+    std::ofstream out("test_mesh.obj");
+    out << "# test\nv 0 0 0\nv 1 0 0\nv 1 1 0\r\nv 0 1 -1.5e-1\nvt 0 0\nf 1/1 2/1 3/1\nf -4 -2 \\\n -1\nf 1 2 3 4\n";
+  }
+  polyscope::SurfaceMesh* psMesh = polyscope::loadSurfaceMesh("obj", "test_mesh.obj");
+  EXPECT_EQ(psMesh->nVertices(), 4);
+  EXPECT_EQ(psMesh->nFaces(), 3);
+  EXPECT_EQ(psMesh->faceIndsStart, std::vector<uint32_t>({0, 3, 6, 10}));
+  EXPECT_EQ(psMesh->faceIndsEntries, std::vector<uint32_t>({0, 1, 2, 0, 2, 3, 0, 1, 2, 3}));
+  EXPECT_FLOAT_EQ(psMesh->vertexPositions.data[3].z, -0.15f);
+  polyscope::show(3);
+
+  // Binary PLY, with an extra face property before the indices
+  {
+    std::ofstream out("test_mesh.ply", std::ios::binary);
+    out << "ply\nformat binary_little_endian 1.0\nelement vertex 4\nproperty float x\nproperty float y\n"
+        << "property float z\nelement face 2\nproperty uchar flags\nproperty list uchar int vertex_indices\n"
+        << "end_header\n";
+    for (int i = 0; i < 4; i++) {
+      float pos[3] = {static_cast<float>(i % 2), static_cast<float>(i / 2), 0.f};
+      out.write(reinterpret_cast<const char*>(pos), sizeof(pos));
+    }
+    uint8_t flags = 0;
+    uint8_t degree = 3;
+    int32_t tri[3] = {0, 1, 3};
+    out.write(reinterpret_cast<const char*>(&flags), 1);
+    out.write(reinterpret_cast<const char*>(&degree), 1);
+    out.write(reinterpret_cast<const char*>(tri), sizeof(tri));
+    degree = 4;
+    int32_t quad[4] = {0, 1, 3, 2};
+    out.write(reinterpret_cast<const char*>(&flags), 1);
+    out.write(reinterpret_cast<const char*>(&degree), 1);
+    out.write(reinterpret_cast<const char*>(quad), sizeof(quad));
+  }
+  polyscope::MeshFileData data = polyscope::readMeshFile("test_mesh.ply");
+  EXPECT_EQ(data.vertexPositions.size(), 4);
+  EXPECT_EQ(data.vertexPositions[3], glm::vec3(1., 1., 0.));
+  EXPECT_EQ(data.faceIndsStart, std::vector<uint32_t>({0, 3, 7}));
+  EXPECT_EQ(data.faceIndsEntries, std::vector<uint32_t>({0, 1, 3, 0, 1, 3, 2}));
+  polyscope::loadSurfaceMesh("ply", "test_mesh.ply");
+  polyscope::show(3);
+
+  // Indices past the last vertex are an error
+  {
+    std::ofstream out("test_mesh.obj");
+    out << "v 0 0 0\nf 1 2 3\n";
+  }
+  EXPECT_THROW(polyscope::readMeshFile("test_mesh.obj"), std::runtime_error);
+
+  std::remove("test_mesh.obj");
+  std::remove("test_mesh.ply");
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, SurfaceMeshFlatFaces) {
+  std::vector<glm::vec3> points = std::get<0>(getTriangleMesh());
+
+  // Flat arrays, of any adaptable type
+  std::vector<size_t> entries = {1, 3, 2, 3, 1, 0, 2, 0, 1, 0, 2, 3};
+  std::vector<size_t> starts = {0, 3, 6, 9, 12};
+  polyscope::SurfaceMesh* psMesh = polyscope::registerSurfaceMeshFlat("flat", points, entries, starts);
+  EXPECT_EQ(psMesh->nFaces(), 4);
+  EXPECT_EQ(psMesh->nEdges(), 6);
+  polyscope::show(3);
+
+  // Moved in
+  std::vector<uint32_t> quadEntries = {0, 1, 2, 3};
+  std::vector<uint32_t> quadStarts = {0, 4};
+  psMesh = polyscope::registerSurfaceMeshFlat("flat quad", std::vector<glm::vec3>(points), std::move(quadEntries),
+                                              std::move(quadStarts));
+  EXPECT_EQ(psMesh->nFaces(), 1);
+  EXPECT_EQ(psMesh->nCorners(), 4);
+
+  // Fixed degree
+  std::vector<std::array<int, 3>> triangles = {{{1, 3, 2}}, {{3, 1, 0}}, {{2, 0, 1}}, {{0, 2, 3}}};
+  psMesh = polyscope::registerSurfaceMeshFixedDegree("tris", points, &triangles[0][0], triangles.size(), 3);
+  EXPECT_EQ(psMesh->faceIndsEntries, std::vector<uint32_t>({1, 3, 2, 3, 1, 0, 2, 0, 1, 0, 2, 3}));
+  EXPECT_EQ(psMesh->faceIndsStart, std::vector<uint32_t>({0, 3, 6, 9, 12}));
+  polyscope::show(3);
+
+  // Fixed degree, column-major storage through explicit strides, and from an adaptable array
+  std::vector<int> colMajor = {1, 3, 2, 0, 3, 1, 0, 2, 2, 0, 1, 3};
+  psMesh = polyscope::registerSurfaceMeshFixedDegree("tris col", points, &colMajor[0], 4, 3, 1, 4);
+  EXPECT_EQ(psMesh->faceIndsEntries, std::vector<uint32_t>({1, 3, 2, 3, 1, 0, 2, 0, 1, 0, 2, 3}));
+  psMesh = polyscope::registerSurfaceMeshFixedDegree<3>("tris array", points, triangles);
+  EXPECT_EQ(psMesh->faceIndsEntries, std::vector<uint32_t>({1, 3, 2, 3, 1, 0, 2, 0, 1, 0, 2, 3}));
+  EXPECT_EQ(psMesh->faceIndsStart, std::vector<uint32_t>({0, 3, 6, 9, 12}));
+
+  // Bad face starts
+  std::vector<size_t> badStarts = {0, 3, 6, 9, 11};
+  EXPECT_THROW(polyscope::registerSurfaceMeshFlat("bad", points, entries, badStarts), std::runtime_error);
+
+  polyscope::removeAllStructures();
+}
+
+TEST_F(PolyscopeTest, SurfaceMeshCompactBuffers) {
+  polyscope::options::compactRenderBuffers = true;
+  auto psMesh = registerTriangleMesh();
+  polyscope::show(3);
+  EXPECT_EQ(psMesh->vertexPositions.getIndexedRenderAttributeBuffer(psMesh->triangleVertexInds)->getType(),
+            polyscope::RenderDataType::Vector3UShortNorm);
+
+  psMesh->setSmoothShade(true);
+  psMesh->setEdgeWidth(1.0);
+  auto qColor = psMesh->addVertexColorQuantity("vcolor", std::vector<glm::vec3>(psMesh->nVertices(), {.2, .3, .4}));
+  qColor->setEnabled(true);
+  auto qVec = psMesh->addVertexVectorQuantity("vecs", std::vector<glm::vec3>(psMesh->nVertices(), {1., 2., 3.}));
+  qVec->setEnabled(true);
+  polyscope::show(3);
+  polyscope::pick::evaluatePickQuery(77, 88);
+
+  // updates re-encode relative to the new bounds
+  std::vector<glm::vec3> points = std::get<0>(getTriangleMesh());
+  for (glm::vec3& p : points) p *= 10.;
+  psMesh->updateVertexPositions(points);
+  EXPECT_EQ(psMesh->vertexPositions.getValue(0), points[0]);
+  polyscope::show(3);
+
+  // range updates re-encode only the corners of the updated vertices, unless the bounds grow
+  psMesh->vertexPositions.data[1] *= 0.5;
+  psMesh->vertexPositions.markHostBufferRangeUpdated(1, 1);
+  polyscope::show(3);
+  psMesh->vertexPositions.data[1] *= 100.;
+  psMesh->vertexPositions.markHostBufferRangeUpdated(1, 1);
+  polyscope::show(3);
+
+  polyscope::options::compactRenderBuffers = false;
+  polyscope::removeAllStructures();
+}
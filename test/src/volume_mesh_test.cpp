@@ -2,6 +2,11 @@
 
 #include "polyscope_test.h"
 
+#include "polyscope/mesh_io.h"
+
+#include <cstdio>
+#include <fstream>
+
 // ============================================================
 // =============== Volume mesh tests
 // ============================================================
@@ -228,3 +233,26 @@ TEST_F(PolyscopeTest, VolumeMeshInspect) {
 
   polyscope::removeLastSceneSlicePlane();
 }
+
+TEST_F(PolyscopeTest, LoadVolumeMeshFile) {
+  {
+    std::ofstream out("test_mesh.mesh");
+    out << "MeshVersionFormatted 1\nDimension 3\nVertices\n5\n0 0 0 0\n1 0 0 0\n0 1 0 0\n0 0 1 0\n1 1 1 0\n"
+        << "Triangles\n1\n1 2 3 0\nTetrahedra\n2\n1 2 3 4 0\n2 3 4 5 0\nEnd\n";
+  }
+
+  polyscope::MeshFileData data = polyscope::readMeshFile("test_mesh.mesh");
+  EXPECT_EQ(data.nFaces(), 1);
+  ASSERT_EQ(data.cells.size(), 2);
+  EXPECT_EQ(data.cells[1][0], 1);
+  EXPECT_EQ(data.cells[1][3], 4);
+  EXPECT_EQ(data.cells[1][4], polyscope::INVALID_IND_32);
+
+  polyscope::VolumeMesh* psVol = polyscope::loadVolumeMesh("vol", "test_mesh.mesh");
+  EXPECT_EQ(psVol->nVertices(), 5);
+  EXPECT_EQ(psVol->nCells(), 2);
+  polyscope::show(3);
+
+  std::remove("test_mesh.mesh");
+  polyscope::removeAllStructures();
+}